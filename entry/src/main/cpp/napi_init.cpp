@@ -16,11 +16,15 @@
 #include "napi/native_api.h"
 #include "common/log_common.h"
 #include "plugin/plugin_manager.h"
+#include "utils/job_system.h"
 
 EXTERN_C_START
 static napi_value Init(napi_env env, napi_value exports)
 {
     SAMPLE_LOGI("napi init");
+    // 任务系统线程随模块（env）的生命周期启动和回收
+    JobSystem::Acquire();
+    napi_add_env_cleanup_hook(env, [](void*) { JobSystem::Release(); }, nullptr);
     PluginManager::GetInstance()->Export(env, exports);
     return exports;
 }
@@ -19,6 +19,7 @@
 #include <string>
 #include "common/log_common.h"
 #include "plugin_manager.h"
+#include "samples/paper_cut_library_napi.h"
 
 PluginManager *PluginManager::GetInstance()
 {
@@ -63,6 +64,9 @@ void PluginManager::Export(napi_env env, napi_value exports)
         return;
     }
 
+    // 模块级接口（作品库）：普通 import 与 XComponent context 都可用
+    PaperCutLibraryNapi::Export(env, exports);
+
     napi_value exportInstance = nullptr;
     if (napi_get_named_property(env, exports, OH_NATIVE_XCOMPONENT_OBJ, &exportInstance) != napi_ok) {
         SAMPLE_LOGE("Export: napi_get_named_property fail");
@@ -0,0 +1,180 @@
+//
+// Created on 2026/10/17.
+// 动作列表二进制打包格式实现
+//
+
+#include "paper_cut_action_codec.h"
+#include <cstring>
+#include <utility>
+
+namespace {
+constexpr size_t HEADER_SIZE = 20;
+constexpr size_t ACTION_ENTRY_SIZE = 16;
+constexpr size_t POINT_SIZE = 8;
+constexpr uint8_t MAX_TOOL = static_cast<uint8_t>(ToolMode::DRAFT_ERASER);
+
+inline size_t Align4(size_t n)
+{
+    return (n + 3) & ~static_cast<size_t>(3);
+}
+
+// 目标平台（ARM64 / x86_64）均为小端，直接按字节拷贝
+template <typename T>
+inline void Put(uint8_t*& cursor, T value)
+{
+    std::memcpy(cursor, &value, sizeof(T));
+    cursor += sizeof(T);
+}
+
+template <typename T>
+inline T Get(const uint8_t*& cursor)
+{
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+size_t TotalIdBytes(const std::vector<Action>& actions)
+{
+    size_t bytes = 0;
+    for (const auto& action : actions) {
+        bytes += action.id.size();
+    }
+    return bytes;
+}
+
+size_t TotalPoints(const std::vector<Action>& actions)
+{
+    size_t points = 0;
+    for (const auto& action : actions) {
+        points += action.points.size();
+    }
+    return points;
+}
+} // namespace
+
+namespace ActionBinaryCodec {
+
+size_t EncodedSize(const std::vector<Action>& actions)
+{
+    return HEADER_SIZE + actions.size() * ACTION_ENTRY_SIZE + Align4(TotalIdBytes(actions)) +
+           TotalPoints(actions) * POINT_SIZE;
+}
+
+bool Encode(const std::vector<Action>& actions, uint8_t* out, size_t size)
+{
+    const size_t idBytes = TotalIdBytes(actions);
+    const size_t pointCount = TotalPoints(actions);
+    if (!out || size != EncodedSize(actions) || actions.size() > UINT32_MAX || pointCount > UINT32_MAX ||
+        idBytes > UINT32_MAX) {
+        return false;
+    }
+
+    uint8_t* cursor = out;
+    Put<uint32_t>(cursor, MAGIC);
+    Put<uint16_t>(cursor, VERSION);
+    Put<uint16_t>(cursor, static_cast<uint16_t>(HEADER_SIZE));
+    Put<uint32_t>(cursor, static_cast<uint32_t>(actions.size()));
+    Put<uint32_t>(cursor, static_cast<uint32_t>(pointCount));
+    Put<uint32_t>(cursor, static_cast<uint32_t>(idBytes));
+
+    for (const auto& action : actions) {
+        if (action.id.size() > UINT16_MAX || action.points.size() > UINT32_MAX) {
+            return false;
+        }
+        Put<uint8_t>(cursor, static_cast<uint8_t>(action.type));
+        Put<uint8_t>(cursor, static_cast<uint8_t>(action.tool));
+        Put<uint16_t>(cursor, static_cast<uint16_t>(action.id.size()));
+        Put<uint32_t>(cursor, static_cast<uint32_t>(action.points.size()));
+        Put<int64_t>(cursor, action.timestamp);
+    }
+
+    for (const auto& action : actions) {
+        std::memcpy(cursor, action.id.data(), action.id.size());
+        cursor += action.id.size();
+    }
+    const size_t padding = Align4(idBytes) - idBytes;
+    std::memset(cursor, 0, padding);
+    cursor += padding;
+
+    // 点块：所有动作的点依次连续写入
+    for (const auto& action : actions) {
+        for (const auto& point : action.points) {
+            Put<float>(cursor, point.x);
+            Put<float>(cursor, point.y);
+        }
+    }
+    return cursor == out + size;
+}
+
+bool Encode(const std::vector<Action>& actions, std::vector<uint8_t>* out)
+{
+    if (!out) {
+        return false;
+    }
+    out->resize(EncodedSize(actions));
+    return Encode(actions, out->data(), out->size());
+}
+
+bool Decode(const uint8_t* data, size_t size, std::vector<Action>* out)
+{
+    if (!data || !out || size < HEADER_SIZE) {
+        return false;
+    }
+    const uint8_t* cursor = data;
+    const uint32_t magic = Get<uint32_t>(cursor);
+    const uint16_t version = Get<uint16_t>(cursor);
+    const uint16_t headerSize = Get<uint16_t>(cursor);
+    const uint32_t actionCount = Get<uint32_t>(cursor);
+    const uint32_t pointCount = Get<uint32_t>(cursor);
+    const uint32_t idBytes = Get<uint32_t>(cursor);
+    if (magic != MAGIC || version == 0 || version > VERSION || headerSize < HEADER_SIZE || headerSize > size) {
+        return false;
+    }
+
+    // 先校验各段长度，避免按损坏的计数分配内存
+    const uint64_t required = static_cast<uint64_t>(headerSize) +
+                              static_cast<uint64_t>(actionCount) * ACTION_ENTRY_SIZE + Align4(idBytes) +
+                              static_cast<uint64_t>(pointCount) * POINT_SIZE;
+    if (required != size) {
+        return false;
+    }
+    cursor = data + headerSize;
+    const uint8_t* ids = cursor + static_cast<size_t>(actionCount) * ACTION_ENTRY_SIZE;
+    const uint8_t* points = ids + Align4(idBytes);
+
+    std::vector<Action> actions(actionCount);
+    uint64_t idUsed = 0;
+    uint64_t pointsUsed = 0;
+    for (auto& action : actions) {
+        const uint8_t type = Get<uint8_t>(cursor);
+        const uint8_t tool = Get<uint8_t>(cursor);
+        const uint16_t idLength = Get<uint16_t>(cursor);
+        const uint32_t actionPoints = Get<uint32_t>(cursor);
+        action.timestamp = Get<int64_t>(cursor);
+        if (type > static_cast<uint8_t>(ActionType::STROKE) || tool > MAX_TOOL ||
+            idUsed + idLength > idBytes || pointsUsed + actionPoints > pointCount) {
+            return false;
+        }
+        action.type = static_cast<ActionType>(type);
+        action.tool = static_cast<ToolMode>(tool);
+        action.id.assign(reinterpret_cast<const char*>(ids + idUsed), idLength);
+        idUsed += idLength;
+
+        action.points.resize(actionPoints);
+        const uint8_t* src = points + pointsUsed * POINT_SIZE;
+        for (auto& point : action.points) {
+            point.x = Get<float>(src);
+            point.y = Get<float>(src);
+        }
+        pointsUsed += actionPoints;
+    }
+    if (idUsed != idBytes || pointsUsed != pointCount) {
+        return false;
+    }
+    *out = std::move(actions);
+    return true;
+}
+
+} // namespace ActionBinaryCodec
@@ -0,0 +1,35 @@
+//
+// Created on 2026/10/17.
+// 动作列表的二进制打包格式（getActionsBinary / setActionsBinary）
+//
+// 纯 C++ 实现，不依赖 NAPI / native_drawing。
+//
+
+#ifndef PAPERCUTTING_PAPER_CUT_ACTION_CODEC_H
+#define PAPERCUTTING_PAPER_CUT_ACTION_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "paper_cut_types.h"
+
+// 布局（小端，所有段 4 字节对齐）：
+//   Header        : magic "PCAB" | version u16 | headerSize u16 | actionCount u32 | pointCount u32 | idBytes u32
+//   Action table  : actionCount 项，每项 type u8 | tool u8 | idLength u16 | pointCount u32 | timestamp i64
+//   Id block      : 所有 id 的 UTF-8 字节依次拼接，补齐到 4 字节
+//   Point block   : pointCount 个点，float32 x | float32 y 交错连续存放
+// 解码时按 headerSize 跳过未知的头部扩展字段，便于后续版本追加字段。
+namespace ActionBinaryCodec {
+constexpr uint32_t MAGIC = 0x42414350;  // "PCAB"
+constexpr uint16_t VERSION = 1;
+
+// 编码后的总字节数（用于预先分配 ArrayBuffer）
+size_t EncodedSize(const std::vector<Action>& actions);
+// 编码到调用方提供的内存，size 必须等于 EncodedSize(actions)
+bool Encode(const std::vector<Action>& actions, uint8_t* out, size_t size);
+bool Encode(const std::vector<Action>& actions, std::vector<uint8_t>* out);
+// 解码；数据截断、版本不支持或计数不一致时返回 false 且不修改 out
+bool Decode(const uint8_t* data, size_t size, std::vector<Action>* out);
+} // namespace ActionBinaryCodec
+
+#endif // PAPERCUTTING_PAPER_CUT_ACTION_CODEC_H
@@ -8,12 +8,13 @@
 #include <cmath>
 #include <algorithm>
 #include <functional>
-#include <native_drawing/drawing_bitmap.h>
-#include <native_drawing/drawing_rect.h>
-#include <native_drawing/drawing_matrix.h>
 #include <sstream>
 #include <chrono>
-#include <sys/mman.h>
+#include <cstring>
+#include <cstdint>
+#include "utils/coverage_span.h"
+#include "utils/job_system.h"
+#include "utils/svg_writer.h"
 
 // LOG_TAG is already defined in hilog/log.h, so we don't redefine it
 #define LOGI(...) ((void)OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, "PaperCutEngine", __VA_ARGS__))
@@ -21,50 +22,200 @@
 
 namespace {
 // 用真圆弧生成扇形 wedge，避免 lineTo 采样造成的“锯齿/折线感”
-OH_Drawing_Path* CreateWedgePath(float radius, float startAngleRad, float sweepAngleRad)
+RasterPath CreateWedgePath(float radius, float startAngleRad, float sweepAngleRad)
 {
-    OH_Drawing_Path* path = OH_Drawing_PathCreate();
+    RasterPath path;
     const float startX = cos(startAngleRad) * radius;
     const float startY = sin(startAngleRad) * radius;
     const float startDeg = startAngleRad * 180.0f / static_cast<float>(M_PI);
     const float sweepDeg = sweepAngleRad * 180.0f / static_cast<float>(M_PI);
     
-    OH_Drawing_PathMoveTo(path, 0, 0);
-    OH_Drawing_PathLineTo(path, startX, startY);
-    OH_Drawing_Rect* rect = OH_Drawing_RectCreate(-radius, -radius, radius, radius);
-    OH_Drawing_PathAddArc(path, rect, startDeg, sweepDeg);
-    OH_Drawing_RectDestroy(rect);
-    OH_Drawing_PathLineTo(path, 0, 0);
-    OH_Drawing_PathClose(path);
+    path.MoveTo(0, 0);
+    path.LineTo(startX, startY);
+    path.AddArc(-radius, -radius, radius, radius, startDeg, sweepDeg);
+    path.LineTo(0, 0);
+    path.Close();
     return path;
 }
+
+constexpr float PENCIL_STROKE_WIDTH = 3.0f;  // 草稿铅笔线宽（模型像素）
+constexpr float ERASER_STROKE_WIDTH = 8.0f;  // 草稿橡皮线宽
+constexpr int COVERAGE_ROWS_PER_JOB = 64;    // 几何预览光栅化的行条带高度
+
+// 铅笔/橡皮共用的平滑笔迹（中点二次贝塞尔）展开为圆头圆角的描边网格
+StrokeTessellator BuildDraftStroke(const std::vector<Point>& points, float width)
+{
+    StrokeTessellator stroke(width);
+    for (const Point& p : points) {
+        stroke.Append({p.x, p.y});
+    }
+    return stroke;
+}
+
+// 描边网格转为路径：分片都是正向，默认的非零规则填充即为描边
+RasterPath CreateStrokeMeshPath(StrokeTessellator& stroke)
+{
+    RasterPath path;
+    const std::vector<RasterPoint>& vertices = stroke.GetVertices();
+    for (const StrokeTessellator::Piece& piece : stroke.GetPieces()) {
+        path.AddPolyline(vertices.data() + piece.first, piece.count, true);
+    }
+    return path;
+}
+
+// 收集同尺寸的 A8 mask 像素；任一不满足返回 false（调用方回退到画布绘制）
+bool CollectA8Masks(RasterBitmap* const* masks, size_t count, std::vector<uint8_t*>* pixels, int* width)
+{
+    if (!masks || count == 0 || !masks[0]) return false;
+    *width = masks[0]->GetWidth();
+    const int height = masks[0]->GetHeight();
+    for (size_t i = 0; i < count; i++) {
+        if (!masks[i] || masks[i]->GetFormat() != RasterFormat::A8 || masks[i]->GetWidth() != *width ||
+            masks[i]->GetHeight() != height || !masks[i]->GetPixels()) {
+            return false;
+        }
+        pixels->push_back(static_cast<uint8_t*>(masks[i]->GetPixels()));
+    }
+    return true;
+}
+
+// 模型包围盒：折线顶点加上描边半宽
+CommandBounds PointsBounds(const std::vector<Point>& points, float outset)
+{
+    CommandBounds bounds;
+    for (const Point& p : points) {
+        bounds.Add(p);
+    }
+    bounds.Outset(outset);
+    return bounds;
+}
+
+// 草稿笔迹编译为显示列表：绘制过程中展开的网格与 points 一致时直接复用，否则（从作品加载）重新展开；
+// 网格复制到列表后释放。少于 2 个点不绘制，与实时笔迹一致
+void CompileDraftStroke(StrokeTessellator* stroke, const std::vector<Point>& points, float width, RasterBlend blend,
+                        DisplayList* list)
+{
+    list->Reset(blend, RasterFillRule::NON_ZERO);
+    if (stroke->GetWidth() != width || stroke->GetInputCount() != points.size()) {
+        *stroke = BuildDraftStroke(points, width);
+    }
+    if (stroke->GetInputCount() >= 2) {
+        const std::vector<RasterPoint>& vertices = stroke->GetVertices();
+        list->Reserve(vertices.size(), stroke->GetPieces().size());
+        for (const StrokeTessellator::Piece& piece : stroke->GetPieces()) {
+            list->AddContour(vertices.data() + piece.first, piece.count);
+        }
+    }
+    *stroke = StrokeTessellator();
+}
+
+// 轮廓按非零规则光栅化到 A8 mask：clear 为 false 时整张重写为覆盖率，为 true 时按覆盖率清除。
+// 按行条带并行，每个条带只处理自己的行（覆盖率与条带划分无关）
+void RasterizeContoursToA8(const std::vector<RasterPath::Contour>& contours, bool clear, RasterBitmap* mask)
+{
+    uint8_t* pixels = static_cast<uint8_t*>(mask->GetPixels());
+    const int width = mask->GetWidth();
+    JobSystem::Get().ParallelFor(mask->GetHeight(), COVERAGE_ROWS_PER_JOB, [&](int rowBegin, int rowEnd) {
+        if (!clear) {
+            std::memset(pixels + static_cast<size_t>(rowBegin) * width, 0,
+                        static_cast<size_t>(rowEnd - rowBegin) * width);
+        }
+        CoverageRasterizer rasterizer;
+        rasterizer.Begin(0, rowBegin, width, rowEnd);
+        rasterizer.AddContours(contours);
+        rasterizer.Fill(RasterFillRule::NON_ZERO, [&](int y, int x0, int x1, const uint8_t* coverage) {
+            uint8_t* row = pixels + static_cast<size_t>(y) * width + x0;
+            if (clear) {
+                CoverageSpan::ClearA8(row, coverage, x1 - x0);
+            } else {
+                std::memcpy(row, coverage, x1 - x0);
+            }
+        });
+    });
+}
+
+// 剪刀路径：折线首尾闭合。写入调用方的路径（先清空），每帧重建时可复用其容量
+void BuildCutPath(const std::vector<Point>& points, RasterPath* path)
+{
+    path->Reset();
+    if (points.empty()) {
+        return;
+    }
+    path->MoveTo(points[0].x, points[0].y);
+    for (size_t i = 1; i < points.size(); i++) {
+        path->LineTo(points[i].x, points[i].y);
+    }
+    path->Close();
+}
+
+RasterPath CreateCutPath(const std::vector<Point>& points)
+{
+    RasterPath path;
+    BuildCutPath(points, &path);
+    return path;
+}
+
+// 纸张轮廓（模型坐标，中心原点）
+RasterPath CreatePaperPath(PaperType type, float radius)
+{
+    RasterPath path;
+    if (type == PaperType::CIRCLE) {
+        path.AddCircle(0, 0, radius);
+    } else {
+        path.AddRect(-radius, -radius, radius, radius);
+    }
+    return path;
+}
+
+RasterPaint FillPaint(uint32_t color, bool antiAlias = false)
+{
+    RasterPaint paint;
+    paint.color = color;
+    paint.antiAlias = antiAlias;
+    return paint;
+}
+
+RasterPaint StrokePaint(uint32_t color, float width)
+{
+    RasterPaint paint;
+    paint.style = RasterPaintStyle::STROKE;
+    paint.color = color;
+    paint.strokeWidth = width;
+    return paint;
+}
 } // namespace
 
-PaperCutEngine::PaperCutEngine()
-    : nativeWindow_(nullptr)
+PaperCutEngine::PaperCutEngine(std::unique_ptr<RasterBackend> backend)
+    : backend_(std::move(backend))
+    , nativeWindow_(nullptr)
     , previewWindow_(nullptr)
     , canvasWidth_(CANVAS_SIZE)
     , canvasHeight_(CANVAS_SIZE)
+    , viewportWidth_(0)
+    , viewportHeight_(0)
+    , inputDirty_(false)
+    , offscreenDirty_(false)
+    , previewTileValid_(false)
+    , previewUnfoldMode_(PreviewUnfoldMode::CANVAS_STAMP)
+    , previewGeometryValid_(false)
+    , layersInitialized_(false)
     , currentToolMode_(ToolMode::SCISSORS)
     , foldMode_(FoldMode::FOUR)
     , paperType_(PaperType::CIRCLE)
     , paperColor_(0xFFC4161C)  // 默认红色
+    , backgroundColor_(0xFFFDF6E3)  // 默认米色
+    , historyVersion_(0)
+    , geometryCount_(0)
     , isDrawing_(false)
     , bezierClosed_(false)
     , bezierSharpMode_(false)
-    , inputBitmap_(nullptr)
-    , inputCanvas_(nullptr)
-    , inputDirty_(false)
-    , offscreenBitmap_(nullptr)
-    , offscreenCanvas_(nullptr)
-    , offscreenDirty_(false)
-    , layersInitialized_(false)
 {
 }
 
 PaperCutEngine::~PaperCutEngine()
 {
     DestroyLayers();
+    DestroyPreviewTile();
     nativeWindow_ = nullptr;
 }
 
@@ -86,63 +237,59 @@ bool PaperCutEngine::Initialize(OHNativeWindow* window, int width, int height)
     return true;
 }
 
-void PaperCutEngine::SetPreviewWindow(OHNativeWindow* window)
+bool PaperCutEngine::InitializeHeadless(int width, int height)
 {
-    previewWindow_ = window;
-    LOGI("Preview window set");
+    // 无窗口模式：只建立数据层，用于缩略图等离屏渲染（可在工作线程使用）
+    nativeWindow_ = nullptr;
+    canvasWidth_ = width > 0 ? width : CANVAS_SIZE;
+    canvasHeight_ = height > 0 ? height : CANVAS_SIZE;
+    InitializeLayers(canvasWidth_, canvasHeight_);
+    return layersInitialized_;
 }
 
-void PaperCutEngine::Render()
+bool PaperCutEngine::RenderPreviewToPixels(int width, int height, std::vector<uint32_t>* pixels)
 {
-    if (!nativeWindow_) {
-        LOGE("NativeWindow not initialized");
-        return;
-    }
-    
-    // 请求Buffer
-    OHNativeWindowBuffer* buffer = nullptr;
-    int fenceFd;
-    int ret = OH_NativeWindow_NativeWindowRequestBuffer(nativeWindow_, &buffer, &fenceFd);
-    if (ret != 0 || !buffer) {
-        LOGE("Failed to request buffer");
-        return;
+    if (!pixels || width <= 0 || height <= 0 || !layersInitialized_) {
+        return false;
     }
     
-    // 获取Buffer信息
-    BufferHandle* handle = OH_NativeWindow_GetBufferHandleFromNative(buffer);
-    if (!handle) {
-        LOGE("Failed to get buffer handle");
-        return;
+    std::unique_ptr<RasterBitmap> bitmap = backend_->CreateBitmap(width, height, RasterFormat::RGBA8888);
+    std::unique_ptr<RasterCanvas> canvas = backend_->CreateCanvas(bitmap.get());
+    if (!canvas) {
+        return false;
     }
+    // 透明底：缩略图只包含展开后的纸张，背景由使用方决定
+    canvas->Clear(0x00000000);
+    RenderPreviewCanvas(canvas.get());
     
-    // 使用mmap映射内存（按照官方示例的方式）
-    void* mappedAddr = mmap(handle->virAddr, handle->size, PROT_READ | PROT_WRITE, MAP_SHARED, handle->fd, 0);
-    if (mappedAddr == MAP_FAILED) {
-        LOGE("mmap failed");
-        return;
+    const uint32_t* src = static_cast<const uint32_t*>(bitmap->GetPixels());
+    const bool ok = (src != nullptr);
+    if (ok) {
+        pixels->assign(src, src + static_cast<size_t>(width) * height);
     }
-    
-    // 创建Bitmap
-    uint32_t width = static_cast<uint32_t>(handle->stride / 4);
-    uint32_t height = static_cast<uint32_t>(handle->height);
-    
-    OH_Drawing_Bitmap* bitmap = OH_Drawing_BitmapCreate();
-    // 开启 PREMUL 以便抗锯齿边缘能正确用 alpha 混合到背景
-    OH_Drawing_BitmapFormat format{COLOR_FORMAT_RGBA_8888, ALPHA_FORMAT_PREMUL};
-    OH_Drawing_BitmapBuild(bitmap, width, height, &format);
-    
-    // 创建Canvas
-    OH_Drawing_Canvas* canvas = OH_Drawing_CanvasCreate();
-    OH_Drawing_CanvasBind(canvas, bitmap);
+    return ok;
+}
+
+void PaperCutEngine::SetPreviewWindow(OHNativeWindow* window)
+{
+    previewWindow_ = window;
+    LOGI("Preview window set");
+}
+
+void PaperCutEngine::RenderTo(RasterCanvas* canvas)
+{
+    if (!canvas) return;
+    const int width = canvas->GetWidth();
+    const int height = canvas->GetHeight();
     
     // 清空画布
-    OH_Drawing_CanvasClear(canvas, 0xFFFDF6E3);  // 米色背景
+    canvas->Clear(backgroundColor_);  // 默认米色背景
     
     // 使用3层架构：先应用视图变换，然后合成 InputCanvas + OffscreenCanvas
     // 关键：目标渲染 buffer 尺寸会随布局变化（如 预览/编辑切换、分屏），
     // 但逻辑画布仍固定为 2048。这里必须按当前 buffer 尺寸做比例映射，否则会出现“畸形/偏移”。
     const float srcSize = static_cast<float>(std::min(canvasWidth_, canvasHeight_));
-    const float dstSize = static_cast<float>(std::min(static_cast<int>(width), static_cast<int>(height)));
+    const float dstSize = static_cast<float>(std::min(width, height));
     const float renderScale = (srcSize > 0.0f) ? (dstSize / srcSize) : 1.0f;
 
     float centerX = static_cast<float>(width) * 0.5f;
@@ -154,384 +301,69 @@ void PaperCutEngine::Render()
     float sectorAngle = isFullPaper ? (2.0f * M_PI) : ((2.0f * M_PI) / totalSegments);
     
     // 保存状态并应用视图变换（中心原点坐标系）
-    OH_Drawing_CanvasSave(canvas);
+    canvas->Save();
     ApplyViewTransform(canvas, centerX, centerY, renderScale);
     
     // 设置裁剪区域 - 纸张逻辑层（中心原点）
-    OH_Drawing_CanvasSave(canvas);
-    OH_Drawing_Path* clipPath = OH_Drawing_PathCreate();
+    canvas->Save();
+    RasterPath clipPath;
     if (isFullPaper) {
         // 0 折：整张纸可操作
-        if (paperType_ == PaperType::CIRCLE) {
-            OH_Drawing_PathAddCircle(clipPath, 0, 0, paperRadius, PATH_DIRECTION_CCW);
-        } else {
-            OH_Drawing_PathAddRect(clipPath, -paperRadius, -paperRadius, paperRadius, paperRadius, PATH_DIRECTION_CCW);
-        }
+        clipPath = CreatePaperPath(paperType_, paperRadius);
     } else {
         // WebEditor 对齐：折叠模式仅显示/操作 wedge（扇形裁剪）
         const float clipRadius = std::min(canvasWidth_, canvasHeight_) * CLIP_RADIUS_RATIO;
         const float startAngle = -M_PI / 2.0f;
-        OH_Drawing_PathDestroy(clipPath);
         clipPath = CreateWedgePath(clipRadius, startAngle, sectorAngle);
     }
-    OH_Drawing_CanvasClipPath(canvas, clipPath, OH_Drawing_CanvasClipOp::INTERSECT, true);
-    OH_Drawing_PathDestroy(clipPath);
+    canvas->ClipPath(clipPath, RasterClipOp::INTERSECT, true);
 
     // 合成 Offscreen + Input（两层 bitmap 都以中心为原点贴回）
     CompositeLayers(canvas);
 
-    OH_Drawing_CanvasRestore(canvas);  // 结束纸张裁剪
+    canvas->Restore();  // 结束纸张裁剪
     
     // 不再绘制折叠/扇形边界引导线（用户要求去掉黑线）
-    OH_Drawing_CanvasRestore(canvas);  // 结束全局变换
-    
-    // 获取bitmap的像素数据
-    void* bitmapAddr = OH_Drawing_BitmapGetPixels(bitmap);
-    uint32_t* value = static_cast<uint32_t*>(bitmapAddr);
-    uint32_t* pixel = static_cast<uint32_t*>(mappedAddr);
-    
-    if (pixel == nullptr || value == nullptr) {
-        LOGE("pixel or value is null");
-        munmap(mappedAddr, handle->size);
-        OH_Drawing_CanvasDestroy(canvas);
-        OH_Drawing_BitmapDestroy(bitmap);
-        return;
-    }
-    
-    // 手动复制像素数据（按照官方示例的方式）
-    for (uint32_t x = 0; x < width; x++) {
-        for (uint32_t y = 0; y < height; y++) {
-            *pixel++ = *value++;
-        }
-    }
-    
-    // 设置刷新区域
-    Region region{nullptr, 0};
-    
-    // 提交Buffer
-    OH_NativeWindow_NativeWindowFlushBuffer(nativeWindow_, buffer, fenceFd, region);
-    
-    // 释放内存映射
-    int result = munmap(mappedAddr, handle->size);
-    if (result == -1) {
-        LOGE("munmap failed!");
-    }
-    
-    // 释放资源
-    OH_Drawing_CanvasDestroy(canvas);
-    OH_Drawing_BitmapDestroy(bitmap);
+    canvas->Restore();  // 结束全局变换
 }
 
-void PaperCutEngine::RenderPreview()
+void PaperCutEngine::RenderPreviewTo(RasterCanvas* canvas)
 {
-    if (!previewWindow_) {
-        LOGE("PreviewWindow not initialized");
-        return;
-    }
-    
-    // 请求Buffer
-    OHNativeWindowBuffer* buffer = nullptr;
-    int fenceFd;
-    int ret = OH_NativeWindow_NativeWindowRequestBuffer(previewWindow_, &buffer, &fenceFd);
-    if (ret != 0 || !buffer) {
-        LOGE("Failed to request preview buffer");
-        return;
-    }
-    
-    // 获取Buffer信息
-    BufferHandle* handle = OH_NativeWindow_GetBufferHandleFromNative(buffer);
-    if (!handle) {
-        LOGE("Failed to get preview buffer handle");
-        return;
-    }
-    
-    // 使用mmap映射内存
-    void* mappedAddr = mmap(handle->virAddr, handle->size, PROT_READ | PROT_WRITE, MAP_SHARED, handle->fd, 0);
-    if (mappedAddr == MAP_FAILED) {
-        LOGE("mmap failed for preview");
-        return;
-    }
-    
-    // 创建Bitmap
-    uint32_t width = static_cast<uint32_t>(handle->stride / 4);
-    uint32_t height = static_cast<uint32_t>(handle->height);
-    
-    OH_Drawing_Bitmap* bitmap = OH_Drawing_BitmapCreate();
-    OH_Drawing_BitmapFormat format{COLOR_FORMAT_RGBA_8888, ALPHA_FORMAT_PREMUL};
-    OH_Drawing_BitmapBuild(bitmap, width, height, &format);
-    
-    // 创建Canvas
-    OH_Drawing_Canvas* canvas = OH_Drawing_CanvasCreate();
-    OH_Drawing_CanvasBind(canvas, bitmap);
+    if (!canvas) return;
     
     // 清空画布
-    OH_Drawing_CanvasClear(canvas, 0xFFFDF6E3);  // 米色背景
+    canvas->Clear(backgroundColor_);  // 默认米色背景
     
     // ③ PreviewCanvas - 展示层：只读 OffscreenCanvas，并进行旋转/镜像/对称展开
     RenderPreviewCanvas(canvas);
-    
-    // 获取bitmap的像素数据
-    void* bitmapAddr = OH_Drawing_BitmapGetPixels(bitmap);
-    uint32_t* value = static_cast<uint32_t*>(bitmapAddr);
-    uint32_t* pixel = static_cast<uint32_t*>(mappedAddr);
-    
-    if (pixel == nullptr || value == nullptr) {
-        LOGE("pixel or value is null for preview");
-        munmap(mappedAddr, handle->size);
-        OH_Drawing_CanvasDestroy(canvas);
-        OH_Drawing_BitmapDestroy(bitmap);
-        return;
-    }
-    
-    // 手动复制像素数据
-    for (uint32_t x = 0; x < width; x++) {
-        for (uint32_t y = 0; y < height; y++) {
-            *pixel++ = *value++;
-        }
-    }
-    
-    // 设置刷新区域
-    Region region{nullptr, 0};
-    
-    // 提交Buffer
-    OH_NativeWindow_NativeWindowFlushBuffer(previewWindow_, buffer, fenceFd, region);
-    
-    // 释放内存映射
-    int result = munmap(mappedAddr, handle->size);
-    if (result == -1) {
-        LOGE("munmap failed for preview!");
-    }
-    
-    // 释放资源
-    OH_Drawing_CanvasDestroy(canvas);
-    OH_Drawing_BitmapDestroy(bitmap);
-}
-
-void PaperCutEngine::RenderInputCanvas(OH_Drawing_Canvas* canvas)
-{
-    // 注意：RenderInputCanvas现在主要用于兼容旧代码
-    // 新的架构中，主渲染通过Render()方法使用CompositeLayers完成
-    // 这个方法保留用于可能需要单独渲染InputCanvas的场景
-    
-    if (!canvas) return;
-    
-    int width = OH_Drawing_CanvasGetWidth(canvas);
-    int height = OH_Drawing_CanvasGetHeight(canvas);
-    float centerX = width * 0.5f;
-    float centerY = height * 0.5f;
-    // 逻辑(2048) -> 目标 buffer 的比例映射
-    float srcSize = static_cast<float>(std::min(canvasWidth_, canvasHeight_));
-    float dstSize = static_cast<float>(std::min(width, height));
-    float renderScale = (srcSize > 0.0f) ? (dstSize / srcSize) : 1.0f;
-
-    // 纸张/裁剪半径在“模型坐标(2048)”中计算，依赖 renderScale 映射到屏幕
-    float paperRadius = std::min(canvasWidth_, canvasHeight_) * PAPER_RADIUS_RATIO;
-    float clipRadius = std::min(canvasWidth_, canvasHeight_) * CLIP_RADIUS_RATIO;
-    
-    bool isFullPaper = (foldMode_ == FoldMode::ZERO);
-    // 保存状态并应用视图变换（使用统一的变换函数）
-    OH_Drawing_CanvasSave(canvas);
-    ApplyViewTransform(canvas, centerX, centerY, renderScale);
-    
-    // 设置裁剪区域 - 纸张逻辑层（在变换后的坐标系统中，中心是(0,0)）
-    OH_Drawing_CanvasSave(canvas);
-    OH_Drawing_Path* clipPath = OH_Drawing_PathCreate();
-    
-    if (isFullPaper) {
-        if (paperType_ == PaperType::CIRCLE) {
-            OH_Drawing_PathAddCircle(clipPath, 0, 0, paperRadius, PATH_DIRECTION_CCW);
-        } else {
-            OH_Drawing_PathAddRect(clipPath, -paperRadius, -paperRadius,
-                                  paperRadius, paperRadius, PATH_DIRECTION_CCW);
-        }
-    } else {
-        int totalSegments = static_cast<int>(foldMode_) * 2;
-        float sectorAngle = (2.0f * M_PI) / totalSegments;
-        float startAngle = -M_PI / 2.0f;
-        float endAngle = startAngle + sectorAngle;
-        OH_Drawing_PathMoveTo(clipPath, 0, 0);
-        for (float angle = startAngle; angle <= endAngle; angle += 0.1f) {
-            float x = cos(angle) * clipRadius;
-            float y = sin(angle) * clipRadius;
-            OH_Drawing_PathLineTo(clipPath, x, y);
-        }
-        OH_Drawing_PathLineTo(clipPath, 0, 0);
-        OH_Drawing_PathClose(clipPath);
-    }
-    
-    OH_Drawing_CanvasClipPath(canvas, clipPath, OH_Drawing_CanvasClipOp::INTERSECT, true);
-    OH_Drawing_PathDestroy(clipPath);
-    
-    // 绘制纸张底色（在模型坐标系统中，中心是(0,0)）
-    OH_Drawing_Brush* brush = OH_Drawing_BrushCreate();
-    OH_Drawing_BrushSetColor(brush, paperColor_);
-    
-    OH_Drawing_Path* paperPath = OH_Drawing_PathCreate();
-    if (paperType_ == PaperType::CIRCLE) {
-        OH_Drawing_PathAddCircle(paperPath, 0, 0, paperRadius, PATH_DIRECTION_CCW);
-    } else {
-        OH_Drawing_PathAddRect(paperPath, -paperRadius, -paperRadius,
-                               paperRadius, paperRadius, PATH_DIRECTION_CCW);
-    }
-    
-    OH_Drawing_CanvasAttachBrush(canvas, brush);
-    OH_Drawing_CanvasDrawPath(canvas, paperPath);
-    OH_Drawing_CanvasDetachBrush(canvas);
-    
-    OH_Drawing_BrushDestroy(brush);
-    OH_Drawing_PathDestroy(paperPath);
-    
-    // 绘制已确认的裁剪（兼容旧代码，新架构中由OffscreenCanvas处理）
-    DrawActions(canvas);
-    
-    OH_Drawing_CanvasRestore(canvas);  // 结束裁剪
-    
-    // 绘制实时剪刀线预览（在变换后的坐标系统中）
-    if (isDrawing_ && currentToolMode_ == ToolMode::SCISSORS && currentPoints_.size() > 1) {
-        OH_Drawing_Path* previewPath = OH_Drawing_PathCreate();
-        if (currentPoints_.size() > 0) {
-            OH_Drawing_PathMoveTo(previewPath, currentPoints_[0].x, currentPoints_[0].y);
-            for (size_t i = 1; i < currentPoints_.size(); i++) {
-                OH_Drawing_PathLineTo(previewPath, currentPoints_[i].x, currentPoints_[i].y);
-            }
-            OH_Drawing_PathClose(previewPath);
-        }
-        
-        OH_Drawing_Brush* previewBrush = OH_Drawing_BrushCreate();
-        OH_Drawing_BrushSetColor(previewBrush, 0x59FFD700);  // 半透明金色
-        OH_Drawing_CanvasAttachBrush(canvas, previewBrush);
-        OH_Drawing_CanvasDrawPath(canvas, previewPath);
-        OH_Drawing_CanvasDetachBrush(canvas);
-        
-        OH_Drawing_BrushDestroy(previewBrush);
-        OH_Drawing_PathDestroy(previewPath);
-    }
-    
-    OH_Drawing_CanvasRestore(canvas);  // 结束视图变换
-}
-
-void PaperCutEngine::RenderOutputCanvas(OH_Drawing_Canvas* canvas)
-{
-    // RenderOutputCanvas用于预览渲染，应用对称展开变换
-    if (!canvas) return;
-    
-    int width = OH_Drawing_CanvasGetWidth(canvas);
-    int height = OH_Drawing_CanvasGetHeight(canvas);
-    float centerX = width * 0.5f;
-    float paperRadius = std::min(width, height) * PAPER_RADIUS_RATIO;
-    
-    bool isFullPaper = (foldMode_ == FoldMode::ZERO);
-    float centerY = isFullPaper ? (height * 0.5f) : (height - paperRadius);
-    
-    // 保存状态并应用基础变换（预览使用简化的变换，只应用缩放和平移到中心）
-    OH_Drawing_CanvasSave(canvas);
-    OH_Drawing_CanvasTranslate(canvas, centerX, centerY);
-    OH_Drawing_CanvasScale(canvas, drawState_.zoom, drawState_.zoom);
-    
-    // 绘制纸张底色（在模型坐标系统中，中心是(0,0)）
-    DrawPaperBase(canvas);
-    
-    // 应用对称变换绘制裁剪（镜像对称展开）
-    if (isFullPaper) {
-        // 全纸模式：直接绘制Actions
-        DrawActions(canvas);
-    } else {
-        // 折叠模式：应用镜像对称展开
-        // WebEditor 对齐：使用 2*N 段（偶数段旋转，奇数段按边界镜像）
-        int totalSegments = static_cast<int>(foldMode_) * 2;
-        float sectorAngle = (2.0f * M_PI) / totalSegments;
-        float startAngle = -M_PI / 2.0f;
-        
-        for (int i = 0; i < totalSegments; i++) {
-            OH_Drawing_CanvasSave(canvas);
-            
-            if (i % 2 == 0) {
-                // 偶数段：旋转 i * sectorAngle
-                OH_Drawing_CanvasRotate(canvas, i * sectorAngle * 180.0f / M_PI, 0, 0);
-            } else {
-                // 奇数段：绕边界做镜像（rotate 2*boundary + scaleY(-1)）
-                float boundary = startAngle + ((i + 1) / 2) * sectorAngle;
-                OH_Drawing_CanvasRotate(canvas, (2.0f * boundary) * 180.0f / M_PI, 0, 0);
-                OH_Drawing_CanvasScale(canvas, 1.0f, -1.0f);
-            }
-            
-            DrawActions(canvas);
-            OH_Drawing_CanvasRestore(canvas);
-        }
-    }
-    
-    OH_Drawing_CanvasRestore(canvas);
 }
 
 // 应用视图变换矩阵（将逻辑画布 2048 映射到目标 buffer 尺寸）
-void PaperCutEngine::ApplyViewTransform(OH_Drawing_Canvas* canvas, float centerX, float centerY, float renderScale)
+void PaperCutEngine::ApplyViewTransform(RasterCanvas* canvas, float centerX, float centerY, float renderScale)
 {
     if (!canvas) return;
     
-    bool isFullPaper = (foldMode_ == FoldMode::ZERO);
-    int totalSegments = isFullPaper ? 1 : (static_cast<int>(foldMode_) * 2);
-    float sectorAngle = isFullPaper ? (2.0f * M_PI) : ((2.0f * M_PI) / totalSegments);
-    float baseRotation = isFullPaper ? 0 : -sectorAngle / 2.0f;
-    float totalRotation = baseRotation + drawState_.rotation;
+    float totalRotation = ViewRotation();
     
     // WebEditor 对齐：以中心为原点的坐标系（不再 translate(-center) 回到左上角）
     // translate(center) -> scale(flip) -> scale(zoom) -> translate(pan + VIEW_OFFSET_Y) -> rotate
-    OH_Drawing_CanvasTranslate(canvas, centerX, centerY);
+    canvas->Translate(centerX, centerY);
     if (drawState_.isFlipped) {
-        OH_Drawing_CanvasScale(canvas, -1.0f, 1.0f);
+        canvas->Scale(-1.0f, 1.0f);
     }
     // renderScale：将“逻辑画布像素(2048)”缩放到当前 buffer 的最短边，避免分屏/旋转后偏移畸形
     const float s = VIEW_SCALE * drawState_.zoom * renderScale;
-    OH_Drawing_CanvasScale(canvas, s, s);
+    canvas->Scale(s, s);
     // VIEW_OFFSET_Y 以逻辑画布(2048)为基准
-    OH_Drawing_CanvasTranslate(canvas, drawState_.pan.x, drawState_.pan.y + canvasHeight_ * VIEW_OFFSET_Y_RATIO);
-    OH_Drawing_CanvasRotate(canvas, totalRotation * 180.0f / M_PI, 0, 0);
-}
-
-void PaperCutEngine::DrawPaperBase(OH_Drawing_Canvas* canvas)
-{
-    if (!canvas) return;
-    
-    // 注意：这个函数在RenderInputCanvas和RenderOutputCanvas中被调用
-    // RenderInputCanvas中坐标系统未变换，需要使用实际坐标
-    // RenderOutputCanvas中坐标系统已变换到(0,0)为中心，需要使用相对坐标
-    // 这里通过检查canvas的当前变换状态来判断，或者使用固定值
-    // 为了简化，我们假设在RenderInputCanvas中调用时使用实际坐标
-    // 在RenderOutputCanvas中调用时使用相对坐标(0,0)
-    
-    int width = OH_Drawing_CanvasGetWidth(canvas);
-    int height = OH_Drawing_CanvasGetHeight(canvas);
-    float paperRadius = std::min(width, height) * PAPER_RADIUS_RATIO;
-    
-    OH_Drawing_Brush* brush = OH_Drawing_BrushCreate();
-    OH_Drawing_BrushSetColor(brush, paperColor_);
-    OH_Drawing_BrushSetAntiAlias(brush, true);
-    
-    OH_Drawing_Path* path = OH_Drawing_PathCreate();
-    
-    if (paperType_ == PaperType::CIRCLE) {
-        // 圆形纸张 - 使用相对坐标，因为可能已经变换
-        OH_Drawing_PathAddCircle(path, 0, 0, paperRadius, PATH_DIRECTION_CCW);
-    } else {
-        // 方形纸张
-        OH_Drawing_PathAddRect(path, -paperRadius, -paperRadius, 
-                               paperRadius, paperRadius, PATH_DIRECTION_CCW);
-    }
-    
-    OH_Drawing_CanvasAttachBrush(canvas, brush);
-    OH_Drawing_CanvasDrawPath(canvas, path);
-    OH_Drawing_CanvasDetachBrush(canvas);
-    
-    OH_Drawing_BrushDestroy(brush);
-    OH_Drawing_PathDestroy(path);
+    canvas->Translate(drawState_.pan.x, drawState_.pan.y + canvasHeight_ * VIEW_OFFSET_Y_RATIO);
+    canvas->Rotate(totalRotation * 180.0f / M_PI);
 }
 
-void PaperCutEngine::DrawFoldLines(OH_Drawing_Canvas* canvas)
+void PaperCutEngine::DrawFoldLines(RasterCanvas* canvas)
 {
     if (!canvas) return;
     
-    // 注意：这个函数在RenderInputCanvas中被调用，此时坐标系统已经变换
-    // 中心点已经移动到(0,0)，所以使用相对坐标
+    // 调用时坐标系统已经过视图变换，中心点在(0,0)，所以使用相对坐标
     // WebEditor 对齐：几何以逻辑画布尺寸(2048)为基准，不依赖屏幕 buffer 尺寸
     float paperRadius = std::min(canvasWidth_, canvasHeight_) * PAPER_RADIUS_RATIO;
     float clipRadius = std::min(canvasWidth_, canvasHeight_) * CLIP_RADIUS_RATIO;
@@ -540,226 +372,33 @@ void PaperCutEngine::DrawFoldLines(OH_Drawing_Canvas* canvas)
     int totalSegments = isFullPaper ? 1 : (static_cast<int>(foldMode_) * 2);
     float sectorAngle = isFullPaper ? (2.0f * M_PI) : ((2.0f * M_PI) / totalSegments);
     
-    OH_Drawing_Pen* pen = OH_Drawing_PenCreate();
-    OH_Drawing_PenSetColor(pen, 0x80000000);  // 半透明黑色
-    OH_Drawing_PenSetWidth(pen, 2.0f);
-    
-    OH_Drawing_Path* path = OH_Drawing_PathCreate();
+    RasterPath path;
     
     if (isFullPaper) {
-        if (paperType_ == PaperType::CIRCLE) {
-            OH_Drawing_PathAddCircle(path, 0, 0, paperRadius, PATH_DIRECTION_CCW);
-        } else {
-            OH_Drawing_PathAddRect(path, -paperRadius, -paperRadius,
-                                  paperRadius, paperRadius, PATH_DIRECTION_CCW);
-        }
+        path = CreatePaperPath(paperType_, paperRadius);
     } else {
         float startAngle = -M_PI / 2.0f;
         float endAngle = startAngle + sectorAngle;
-        OH_Drawing_PathMoveTo(path, 0, 0);
+        path.MoveTo(0, 0);
         // 使用圆弧绘制扇形
         for (float angle = startAngle; angle <= endAngle; angle += 0.1f) {
             float x = cos(angle) * clipRadius;
             float y = sin(angle) * clipRadius;
-            OH_Drawing_PathLineTo(path, x, y);
-        }
-        OH_Drawing_PathLineTo(path, 0, 0);
-        OH_Drawing_PathClose(path);
-    }
-    
-    OH_Drawing_CanvasAttachPen(canvas, pen);
-    OH_Drawing_CanvasDrawPath(canvas, path);
-    OH_Drawing_CanvasDetachPen(canvas);
-    
-    OH_Drawing_PenDestroy(pen);
-    OH_Drawing_PathDestroy(path);
-}
-
-void PaperCutEngine::DrawActions(OH_Drawing_Canvas* canvas)
-{
-    if (!canvas) return;
-    
-    float paperRadius = std::min(canvasWidth_, canvasHeight_) * PAPER_RADIUS_RATIO;
-    
-    // 设置裁剪区域
-    OH_Drawing_CanvasSave(canvas);
-    OH_Drawing_Path* clipPath = OH_Drawing_PathCreate();
-    
-    if (paperType_ == PaperType::CIRCLE) {
-        OH_Drawing_PathAddCircle(clipPath, 0, 0, paperRadius, PATH_DIRECTION_CCW);
-    } else {
-        OH_Drawing_PathAddRect(clipPath, -paperRadius, -paperRadius,
-                              paperRadius, paperRadius, PATH_DIRECTION_CCW);
-    }
-    
-    OH_Drawing_CanvasClipPath(canvas, clipPath, OH_Drawing_CanvasClipOp::INTERSECT, true);
-    OH_Drawing_PathDestroy(clipPath);
-    
-    // 绘制所有动作
-    for (const auto& action : actions_) {
-        if (action.type == ActionType::CUT) {
-            // 裁剪操作：使用CanvasClipPath的DIFFERENCE模式实现镂空
-            OH_Drawing_CanvasSave(canvas);
-            OH_Drawing_Path* cutPath = OH_Drawing_PathCreate();
-            if (action.points.size() > 0) {
-                OH_Drawing_PathMoveTo(cutPath, action.points[0].x, action.points[0].y);
-                for (size_t i = 1; i < action.points.size(); i++) {
-                    OH_Drawing_PathLineTo(cutPath, action.points[i].x, action.points[i].y);
-                }
-                OH_Drawing_PathClose(cutPath);
-            }
-            // 使用DIFFERENCE模式裁剪，实现镂空效果
-            OH_Drawing_CanvasClipPath(canvas, cutPath, OH_Drawing_CanvasClipOp::DIFFERENCE, true);
-            OH_Drawing_PathDestroy(cutPath);
-            // 绘制一个大的矩形来清除裁剪区域
-            OH_Drawing_Brush* brush = OH_Drawing_BrushCreate();
-            OH_Drawing_BrushSetColor(brush, 0x00000000);  // 透明色
-            OH_Drawing_CanvasAttachBrush(canvas, brush);
-            OH_Drawing_Rect* clearRect = OH_Drawing_RectCreate(-10000, -10000, 10000, 10000);
-            OH_Drawing_CanvasDrawRect(canvas, clearRect);
-            OH_Drawing_CanvasDetachBrush(canvas);
-            OH_Drawing_BrushDestroy(brush);
-            OH_Drawing_RectDestroy(clearRect);
-            OH_Drawing_CanvasRestore(canvas);
-        } else if (action.type == ActionType::STROKE) {
-            // 笔触操作
-            if (action.tool == ToolMode::DRAFT_PEN) {
-                DrawPencilStroke(canvas, action.points);
-            } else if (action.tool == ToolMode::DRAFT_ERASER) {
-                ErasePencilStroke(canvas, action.points, 0xFFFDF6E3);  // 使用米色背景擦除
-            }
-        }
-    }
-    
-    // 绘制当前正在绘制的笔触
-    if (isDrawing_ && currentPoints_.size() > 1) {
-        if (currentToolMode_ == ToolMode::SCISSORS) {
-            // 实时预览裁剪区域
-            OH_Drawing_Path* previewPath = OH_Drawing_PathCreate();
-            if (currentPoints_.size() > 0) {
-                OH_Drawing_PathMoveTo(previewPath, currentPoints_[0].x, currentPoints_[0].y);
-                for (size_t i = 1; i < currentPoints_.size(); i++) {
-                    OH_Drawing_PathLineTo(previewPath, currentPoints_[i].x, currentPoints_[i].y);
-                }
-                OH_Drawing_PathClose(previewPath);
-            }
-            
-            OH_Drawing_Brush* brush = OH_Drawing_BrushCreate();
-            OH_Drawing_BrushSetColor(brush, 0x59FFD700);  // 半透明金色
-            OH_Drawing_CanvasAttachBrush(canvas, brush);
-            OH_Drawing_CanvasDrawPath(canvas, previewPath);
-            OH_Drawing_CanvasDetachBrush(canvas);
-            
-            OH_Drawing_BrushDestroy(brush);
-            OH_Drawing_PathDestroy(previewPath);
-        } else if (currentToolMode_ == ToolMode::DRAFT_PEN) {
-            DrawPencilStroke(canvas, currentPoints_);
-        } else if (currentToolMode_ == ToolMode::DRAFT_ERASER) {
-            ErasePencilStroke(canvas, currentPoints_, 0xFFFDF6E3);  // 使用米色背景擦除
+            path.LineTo(x, y);
         }
+        path.LineTo(0, 0);
+        path.Close();
     }
     
-    OH_Drawing_CanvasRestore(canvas);
+    canvas->DrawPath(path, StrokePaint(0x80000000, 2.0f));  // 半透明黑色
 }
 
-void PaperCutEngine::DrawPath(OH_Drawing_Canvas* canvas, const std::vector<Point>& points, bool closePath)
+void PaperCutEngine::DrawPencilStroke(RasterCanvas* canvas, StrokeTessellator& stroke)
 {
-    if (!canvas || points.size() < 2) return;
-    
-    OH_Drawing_Path* path = OH_Drawing_PathCreate();
-    OH_Drawing_PathMoveTo(path, points[0].x, points[0].y);
-    
-    if (points.size() == 2) {
-        OH_Drawing_PathLineTo(path, points[1].x, points[1].y);
-    } else {
-        // 使用二次贝塞尔曲线平滑连接
-        for (size_t i = 1; i < points.size() - 1; i++) {
-            float xc = (points[i].x + points[i + 1].x) * 0.5f;
-            float yc = (points[i].y + points[i + 1].y) * 0.5f;
-            OH_Drawing_PathQuadTo(path, points[i].x, points[i].y, xc, yc);
-        }
-        OH_Drawing_PathLineTo(path, points.back().x, points.back().y);
-    }
-    
-    if (closePath) {
-        OH_Drawing_PathClose(path);
-    }
+    if (!canvas || stroke.GetInputCount() < 2) return;
     
-    OH_Drawing_Pen* pen = OH_Drawing_PenCreate();
-    OH_Drawing_PenSetColor(pen, 0xFFFFD700);  // 金色
-    OH_Drawing_PenSetWidth(pen, 5.0f);
-    
-    OH_Drawing_CanvasAttachPen(canvas, pen);
-    OH_Drawing_CanvasDrawPath(canvas, path);
-    OH_Drawing_CanvasDetachPen(canvas);
-    
-    OH_Drawing_PenDestroy(pen);
-    OH_Drawing_PathDestroy(path);
-}
-
-void PaperCutEngine::DrawPencilStroke(OH_Drawing_Canvas* canvas, const std::vector<Point>& points)
-{
-    if (!canvas || points.size() < 2) return;
-    
-    OH_Drawing_Path* path = OH_Drawing_PathCreate();
-    OH_Drawing_PathMoveTo(path, points[0].x, points[0].y);
-    
-    for (size_t i = 1; i < points.size(); i++) {
-        if (i < points.size() - 1) {
-            float xc = (points[i].x + points[i + 1].x) * 0.5f;
-            float yc = (points[i].y + points[i + 1].y) * 0.5f;
-            OH_Drawing_PathQuadTo(path, points[i].x, points[i].y, xc, yc);
-        } else {
-            OH_Drawing_PathLineTo(path, points[i].x, points[i].y);
-        }
-    }
-    
-    OH_Drawing_Pen* pen = OH_Drawing_PenCreate();
-    OH_Drawing_PenSetColor(pen, 0xFFFFFFFF);  // 白色铅笔
-    OH_Drawing_PenSetWidth(pen, 3.0f);
-    // 注意：ROUND可能不存在，使用BUTT或移除这些设置
-    // OH_Drawing_PenSetCap(pen, OH_Drawing_PenLineCapStyle::BUTT);
-    // OH_Drawing_PenSetJoin(pen, OH_Drawing_PenLineJoinStyle::MITER);
-    
-    OH_Drawing_CanvasAttachPen(canvas, pen);
-    OH_Drawing_CanvasDrawPath(canvas, path);
-    OH_Drawing_CanvasDetachPen(canvas);
-    
-    OH_Drawing_PenDestroy(pen);
-    OH_Drawing_PathDestroy(path);
-}
-
-void PaperCutEngine::ErasePencilStroke(OH_Drawing_Canvas* canvas, const std::vector<Point>& points, uint32_t backgroundColor)
-{
-    if (!canvas || points.size() < 2) return;
-    
-    OH_Drawing_Path* path = OH_Drawing_PathCreate();
-    OH_Drawing_PathMoveTo(path, points[0].x, points[0].y);
-    
-    for (size_t i = 1; i < points.size(); i++) {
-        if (i < points.size() - 1) {
-            float xc = (points[i].x + points[i + 1].x) * 0.5f;
-            float yc = (points[i].y + points[i + 1].y) * 0.5f;
-            OH_Drawing_PathQuadTo(path, points[i].x, points[i].y, xc, yc);
-        } else {
-            OH_Drawing_PathLineTo(path, points[i].x, points[i].y);
-        }
-    }
-    
-    OH_Drawing_Pen* pen = OH_Drawing_PenCreate();
-    OH_Drawing_PenSetColor(pen, backgroundColor);  // 使用背景色擦除
-    OH_Drawing_PenSetWidth(pen, 8.0f);
-    // 注意：ROUND和DST_OUT可能不存在，移除这些设置
-    // OH_Drawing_PenSetCap(pen, OH_Drawing_PenLineCapStyle::BUTT);
-    // OH_Drawing_PenSetJoin(pen, OH_Drawing_PenLineJoinStyle::MITER);
-    // OH_Drawing_PenSetBlendMode(pen, OH_Drawing_BlendMode::CLEAR);
-    
-    OH_Drawing_CanvasAttachPen(canvas, pen);
-    OH_Drawing_CanvasDrawPath(canvas, path);
-    OH_Drawing_CanvasDetachPen(canvas);
-    
-    OH_Drawing_PenDestroy(pen);
-    OH_Drawing_PathDestroy(path);
+    // 白色铅笔：填充预先展开的圆头圆角网格（不依赖后端的描边端点/连接支持）
+    canvas->DrawPath(CreateStrokeMeshPath(stroke), FillPaint(0xFFFFFFFF, true));
 }
 
 void PaperCutEngine::SetToolMode(ToolMode mode)
@@ -777,14 +416,21 @@ void PaperCutEngine::SetFoldMode(FoldMode mode)
 
 void PaperCutEngine::SetPaperType(PaperType type)
 {
+    // 纸张形状只在合成/预览时作为裁剪应用，mask 与检查点都保持有效
     paperType_ = type;
 }
 
 void PaperCutEngine::SetPaperColor(uint32_t color)
 {
+    // 纸张颜色只在合成/预览时着色，不影响 mask，无需重放历史
     paperColor_ = color;
 }
 
+void PaperCutEngine::SetBackgroundColor(uint32_t color)
+{
+    backgroundColor_ = color;
+}
+
 void PaperCutEngine::StartDrawing(float x, float y)
 {
     if (isDrawing_) return;
@@ -794,33 +440,55 @@ void PaperCutEngine::StartDrawing(float x, float y)
     }
     
     isDrawing_ = true;
+    // 首点与 AddPoints 的后续点一样对齐到模型网格，保存/重新加载后重放结果不变
+    const Point start = SnapToModelGrid(Point(x, y));
     currentPoints_.clear();
-    currentPoints_.push_back(Point(x, y));
+    currentPoints_.push_back(start);
+    liveStroke_.Reset(currentToolMode_ == ToolMode::DRAFT_ERASER ? ERASER_STROKE_WIDTH : PENCIL_STROKE_WIDTH);
+    liveStroke_.Append({start.x, start.y});
     // InputCanvas 需要立即更新（临时路径）
     MarkInputDirty();
 }
 
 void PaperCutEngine::AddPoint(float x, float y)
 {
-    if (!isDrawing_) return;
-    // InputCanvas：丢弃扇形外点，保证 Offscreen（数据层）永不被污染
-    if (!IsPointInSector(x, y)) {
-        return;
-    }
+    const float xy[2] = {x, y};
+    AddPoints(xy, 1, false);
+}
+
+void PaperCutEngine::AddPoints(const float* xy, size_t count, bool screenSpace)
+{
+    if (!isDrawing_ || !xy || count == 0) return;
     
-    // 检查距离，避免点太密集
-    if (!currentPoints_.empty()) {
-        const Point& last = currentPoints_.back();
-        float dx = x - last.x;
-        float dy = y - last.y;
-        if (dx * dx + dy * dy < 100.0f) {  // 距离小于10像素
-            return;
+    const size_t before = currentPoints_.size();
+    currentPoints_.reserve(before + count);
+    for (size_t i = 0; i < count; i++) {
+        // 对齐到 1/16 像素网格，保证作品存储格式保存/加载无损
+        Point p = SnapToModelGrid(screenSpace ? ScreenToModel(xy[2 * i], xy[2 * i + 1])
+                                              : Point(xy[2 * i], xy[2 * i + 1]));
+        // InputCanvas：丢弃扇形外点，保证 Offscreen（数据层）永不被污染
+        if (!IsPointInSector(p.x, p.y)) {
+            continue;
+        }
+        
+        // 检查距离，避免点太密集
+        if (!currentPoints_.empty()) {
+            const Point& last = currentPoints_.back();
+            float dx = p.x - last.x;
+            float dy = p.y - last.y;
+            if (dx * dx + dy * dy < 100.0f) {  // 距离小于10像素
+                continue;
+            }
         }
+        
+        currentPoints_.push_back(p);
+        liveStroke_.Append({p.x, p.y});  // 增量展开：只有最后一段会在绘制时重建
     }
     
-    currentPoints_.push_back(Point(x, y));
-    // InputCanvas 需要更新（临时路径）
-    MarkInputDirty();
+    if (currentPoints_.size() != before) {
+        // InputCanvas 需要更新（临时路径）
+        MarkInputDirty();
+    }
 }
 
 void PaperCutEngine::FinishDrawing()
@@ -828,11 +496,9 @@ void PaperCutEngine::FinishDrawing()
     if (!isDrawing_ || currentPoints_.size() < 2) {
         isDrawing_ = false;
         currentPoints_.clear();
-        // 结束时清空 InputCanvas
-        if (inputCanvas_) {
-            OH_Drawing_CanvasClear(inputCanvas_, 0x00000000);
-            inputDirty_ = false;
-        }
+        liveStroke_.Reset(liveStroke_.GetWidth());
+        // 结束时清空 InputCanvas（临时路径不再绘制）
+        MarkInputDirty();
         return;
     }
     
@@ -841,9 +507,9 @@ void PaperCutEngine::FinishDrawing()
     if (currentToolMode_ == ToolMode::SCISSORS) {
         cmd = std::make_unique<CutCommand>(currentPoints_);
     } else if (currentToolMode_ == ToolMode::DRAFT_PEN) {
-        cmd = std::make_unique<PencilCommand>(currentPoints_);
+        cmd = std::make_unique<PencilCommand>(currentPoints_, std::move(liveStroke_));
     } else if (currentToolMode_ == ToolMode::DRAFT_ERASER) {
-        cmd = std::make_unique<EraserCommand>(currentPoints_, paperColor_);
+        cmd = std::make_unique<EraserCommand>(currentPoints_, std::move(liveStroke_));
     }
     
     if (cmd) {
@@ -854,16 +520,15 @@ void PaperCutEngine::FinishDrawing()
     isDrawing_ = false;
     currentPoints_.clear();
     // InputCanvas 在抬笔必须立即清空
-    if (inputCanvas_) {
-        OH_Drawing_CanvasClear(inputCanvas_, 0x00000000);
-        inputDirty_ = false;
-    }
+    MarkInputDirty();
 }
 
 void PaperCutEngine::CancelDrawing()
 {
     isDrawing_ = false;
     currentPoints_.clear();
+    // 取消的草稿不再保留已展开的描边网格
+    liveStroke_.Reset(liveStroke_.GetWidth());
 }
 
 void PaperCutEngine::AddBezierPoint(float x, float y)
@@ -890,6 +555,9 @@ void PaperCutEngine::CloseBezier()
         // 曲线模式
         finalPoints = CalculateSplinePoints(bezierPoints_, true);
     }
+    for (Point& p : finalPoints) {
+        p = SnapToModelGrid(p);
+    }
     
     // 创建CutCommand并应用到OffscreenCanvas
     auto cmd = std::make_unique<CutCommand>(finalPoints);
@@ -906,19 +574,17 @@ void PaperCutEngine::CancelBezier()
 
 void PaperCutEngine::Undo()
 {
-    // 使用命令模式的撤销
+    // 使用命令模式的撤销：回到最近检查点后只重放少量命令
     if (!commandHistory_.empty()) {
-        RevertCommandFromOffscreenCanvas();
+        SeekHistory(commandHistory_.size() - 1);
     }
 }
 
 void PaperCutEngine::Redo()
 {
-    // 使用命令模式的重做
+    // 使用命令模式的重做（不清空剩余的重做栈）
     if (!redoStack_.empty()) {
-        std::unique_ptr<ICommand> cmd = std::move(redoStack_.back());
-        redoStack_.pop_back();
-        ApplyCommandToOffscreenCanvas(std::move(cmd));
+        SeekHistory(commandHistory_.size() + 1);
     }
 }
 
@@ -954,16 +620,20 @@ void PaperCutEngine::SetFlip(bool flipped)
 void PaperCutEngine::AddAction(const Action& action)
 {
     // 兼容接口：把 Action 转成 Command 并写入 OffscreenCanvas（单向数据流）
+    std::vector<Point> points(action.points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        points[i] = SnapToModelGrid(action.points[i]);
+    }
     std::unique_ptr<ICommand> cmd;
-    if (action.points.empty()) {
+    if (points.empty()) {
         // 约定：空 points 视为 Clear
         cmd = std::make_unique<ClearCommand>();
     } else if (action.tool == ToolMode::SCISSORS) {
-        cmd = std::make_unique<CutCommand>(action.points);
+        cmd = std::make_unique<CutCommand>(points);
     } else if (action.tool == ToolMode::DRAFT_PEN) {
-        cmd = std::make_unique<PencilCommand>(action.points);
+        cmd = std::make_unique<PencilCommand>(points);
     } else if (action.tool == ToolMode::DRAFT_ERASER) {
-        cmd = std::make_unique<EraserCommand>(action.points, paperColor_);
+        cmd = std::make_unique<EraserCommand>(points);
     }
     if (cmd) {
         ApplyCommandToOffscreenCanvas(std::move(cmd));
@@ -988,16 +658,26 @@ void PaperCutEngine::SetActions(const std::vector<Action>& actions)
     // 从 Action 列表重建命令历史
     commandHistory_.clear();
     redoStack_.clear();
+    checkpoints_.clear();
+    commandGrid_.Truncate(0);
+    ++historyVersion_;
+    geometryCount_ = SIZE_MAX;
+    std::vector<Point> points;
     for (const auto& action : actions) {
+        // 旧作品的浮点坐标同样对齐到模型网格，与新输入保持一致
+        points.resize(action.points.size());
+        for (size_t i = 0; i < points.size(); i++) {
+            points[i] = SnapToModelGrid(action.points[i]);
+        }
         std::unique_ptr<ICommand> cmd;
-        if (action.points.empty()) {
+        if (points.empty()) {
             cmd = std::make_unique<ClearCommand>();
         } else if (action.tool == ToolMode::SCISSORS) {
-            cmd = std::make_unique<CutCommand>(action.points);
+            cmd = std::make_unique<CutCommand>(points);
         } else if (action.tool == ToolMode::DRAFT_PEN) {
-            cmd = std::make_unique<PencilCommand>(action.points);
+            cmd = std::make_unique<PencilCommand>(points);
         } else if (action.tool == ToolMode::DRAFT_ERASER) {
-            cmd = std::make_unique<EraserCommand>(action.points, paperColor_);
+            cmd = std::make_unique<EraserCommand>(points);
         }
         if (cmd) {
             commandHistory_.push_back(std::move(cmd));
@@ -1007,33 +687,63 @@ void PaperCutEngine::SetActions(const std::vector<Action>& actions)
     RenderOffscreenCanvas();
 }
 
+void PaperCutEngine::SetViewportSize(int width, int height)
+{
+    viewportWidth_ = width;
+    viewportHeight_ = height;
+}
+
 Point PaperCutEngine::ScreenToModel(float x, float y) const
 {
-    // 坐标转换逻辑
-    float centerX = canvasWidth_ * 0.5f;
-    float paperRadius = std::min(canvasWidth_, canvasHeight_) * PAPER_RADIUS_RATIO;
-    bool isFullPaper = (foldMode_ == FoldMode::ZERO);
-    // 0折：圆心在画布中心；其他折：圆心在x轴居中，y轴在底部
-    float centerY = isFullPaper ? (canvasHeight_ * 0.5f) : (canvasHeight_ - paperRadius);
+    // ApplyViewTransform 的逆变换：
+    // screen = center + flip(s * (pan + offset + rotate(θ) * model))
+    const float viewW = static_cast<float>(viewportWidth_ > 0 ? viewportWidth_ : canvasWidth_);
+    const float viewH = static_cast<float>(viewportHeight_ > 0 ? viewportHeight_ : canvasHeight_);
+    const float srcSize = static_cast<float>(std::min(canvasWidth_, canvasHeight_));
+    const float renderScale = (srcSize > 0.0f) ? (std::min(viewW, viewH) / srcSize) : 1.0f;
+    const float s = VIEW_SCALE * drawState_.zoom * renderScale;
+    if (s <= 0.0f) return Point(0, 0);
     
-    float modelX = (x - centerX) / (VIEW_SCALE * drawState_.zoom) - drawState_.pan.x;
-    float modelY = (y - centerY) / (VIEW_SCALE * drawState_.zoom) - drawState_.pan.y;
+    float vx = x - viewW * 0.5f;
+    float vy = y - viewH * 0.5f;
+    if (drawState_.isFlipped) {
+        vx = -vx;
+    }
+    vx = vx / s - drawState_.pan.x;
+    vy = vy / s - drawState_.pan.y - canvasHeight_ * VIEW_OFFSET_Y_RATIO;
     
-    return Point(modelX, modelY);
+    const float theta = ViewRotation();
+    const float c = std::cos(theta);
+    const float sn = std::sin(theta);
+    return Point(vx * c + vy * sn, -vx * sn + vy * c);
 }
 
 Point PaperCutEngine::ModelToScreen(float x, float y) const
 {
-    float centerX = canvasWidth_ * 0.5f;
-    float paperRadius = std::min(canvasWidth_, canvasHeight_) * PAPER_RADIUS_RATIO;
-    bool isFullPaper = (foldMode_ == FoldMode::ZERO);
-    // 0折：圆心在画布中心；其他折：圆心在x轴居中，y轴在底部
-    float centerY = isFullPaper ? (canvasHeight_ * 0.5f) : (canvasHeight_ - paperRadius);
-    
-    float screenX = (x + drawState_.pan.x) * (VIEW_SCALE * drawState_.zoom) + centerX;
-    float screenY = (y + drawState_.pan.y) * (VIEW_SCALE * drawState_.zoom) + centerY;
+    const float viewW = static_cast<float>(viewportWidth_ > 0 ? viewportWidth_ : canvasWidth_);
+    const float viewH = static_cast<float>(viewportHeight_ > 0 ? viewportHeight_ : canvasHeight_);
+    const float srcSize = static_cast<float>(std::min(canvasWidth_, canvasHeight_));
+    const float renderScale = (srcSize > 0.0f) ? (std::min(viewW, viewH) / srcSize) : 1.0f;
+    const float s = VIEW_SCALE * drawState_.zoom * renderScale;
     
-    return Point(screenX, screenY);
+    const float theta = ViewRotation();
+    const float c = std::cos(theta);
+    const float sn = std::sin(theta);
+    float vx = (x * c - y * sn + drawState_.pan.x) * s;
+    float vy = (x * sn + y * c + drawState_.pan.y + canvasHeight_ * VIEW_OFFSET_Y_RATIO) * s;
+    if (drawState_.isFlipped) {
+        vx = -vx;
+    }
+    return Point(vx + viewW * 0.5f, vy + viewH * 0.5f);
+}
+
+float PaperCutEngine::ViewRotation() const
+{
+    // 与 ApplyViewTransform 一致：折叠模式先旋转半个扇形，使扇形居中朝上
+    bool isFullPaper = (foldMode_ == FoldMode::ZERO);
+    float sectorAngle = isFullPaper ? (2.0f * M_PI) : ((2.0f * M_PI) / (static_cast<int>(foldMode_) * 2));
+    float baseRotation = isFullPaper ? 0 : -sectorAngle / 2.0f;
+    return baseRotation + drawState_.rotation;
 }
 
 std::vector<Point> PaperCutEngine::CalculateSplinePoints(const std::vector<Point>& points, bool closed) const
@@ -1080,47 +790,47 @@ std::vector<Point> PaperCutEngine::CalculateSplinePoints(const std::vector<Point
 
 // ========== 命令类实现 ==========
 
+// DisplayListCommand 实现
+void DisplayListCommand::Apply(RasterCanvas* canvas)
+{
+    if (!canvas) return;
+    Compile();
+    displayList_.Draw(canvas);
+}
+
+void DisplayListCommand::Revert(RasterCanvas*)
+{
+    // 撤销需要从检查点重建 OffscreenCanvas，这里不做任何操作
+    // 实际的撤销由引擎的 SeekHistory 完成
+}
+
+const DisplayList* DisplayListCommand::Compile()
+{
+    if (!compiled_) {
+        BuildDisplayList(&displayList_);
+        displayList_.Shrink();
+        compiled_ = true;
+    }
+    return &displayList_;
+}
+
 // CutCommand 实现
 CutCommand::CutCommand(const std::vector<Point>& points)
-    : points_(points)
+    : points_(points), bounds_(PointsBounds(points, 0.0f))
 {
     id_ = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count());
 }
 
-void CutCommand::Apply(OH_Drawing_Canvas* canvas)
+void CutCommand::BuildDisplayList(DisplayList* list)
 {
-    if (!canvas || points_.size() < 2) return;
-    
-    OH_Drawing_CanvasSave(canvas);
-    OH_Drawing_Path* cutPath = OH_Drawing_PathCreate();
-    if (points_.size() > 0) {
-        OH_Drawing_PathMoveTo(cutPath, points_[0].x, points_[0].y);
-        for (size_t i = 1; i < points_.size(); i++) {
-            OH_Drawing_PathLineTo(cutPath, points_[i].x, points_[i].y);
-        }
-        OH_Drawing_PathClose(cutPath);
+    // destination-out：按覆盖率清除路径内部像素，实现镂空效果（边缘抗锯齿）
+    list->Reset(RasterBlend::CLEAR, RasterFillRule::NON_ZERO);
+    list->Reserve(points_.size(), 1);
+    RasterPoint* polygon = list->AddContour(points_.size());
+    for (size_t i = 0; polygon && i < points_.size(); i++) {
+        polygon[i] = {points_[i].x, points_[i].y};
     }
-    // 使用DIFFERENCE模式裁剪，实现镂空效果
-    OH_Drawing_CanvasClipPath(canvas, cutPath, OH_Drawing_CanvasClipOp::DIFFERENCE, true);
-    OH_Drawing_PathDestroy(cutPath);
-    
-    // 绘制一个大的矩形来清除裁剪区域
-    OH_Drawing_Brush* brush = OH_Drawing_BrushCreate();
-    OH_Drawing_BrushSetColor(brush, 0x00000000);  // 透明色
-    OH_Drawing_CanvasAttachBrush(canvas, brush);
-    OH_Drawing_Rect* clearRect = OH_Drawing_RectCreate(-10000, -10000, 10000, 10000);
-    OH_Drawing_CanvasDrawRect(canvas, clearRect);
-    OH_Drawing_CanvasDetachBrush(canvas);
-    OH_Drawing_BrushDestroy(brush);
-    OH_Drawing_RectDestroy(clearRect);
-    OH_Drawing_CanvasRestore(canvas);
-}
-
-void CutCommand::Revert(OH_Drawing_Canvas* canvas)
-{
-    // 撤销裁剪操作需要重新渲染整个OffscreenCanvas，所以这里不做任何操作
-    // 实际的撤销由引擎的RenderOffscreenCanvas完成
 }
 
 Action CutCommand::ToAction() const
@@ -1137,262 +847,736 @@ Action CutCommand::ToAction() const
 
 // PencilCommand 实现
 PencilCommand::PencilCommand(const std::vector<Point>& points)
-    : points_(points)
+    : points_(points), bounds_(PointsBounds(points, PENCIL_STROKE_WIDTH * 0.5f))
+{
+    id_ = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+PencilCommand::PencilCommand(const std::vector<Point>& points, StrokeTessellator stroke)
+    : PencilCommand(points)
+{
+    stroke_ = std::move(stroke);
+}
+
+void PencilCommand::BuildDisplayList(DisplayList* list)
+{
+    CompileDraftStroke(&stroke_, points_, PENCIL_STROKE_WIDTH, RasterBlend::SRC_OVER, list);
+}
+
+Action PencilCommand::ToAction() const
+{
+    Action action;
+    action.id = id_;
+    action.type = ActionType::STROKE;
+    action.tool = ToolMode::DRAFT_PEN;
+    action.points = points_;
+    action.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return action;
+}
+
+// EraserCommand 实现
+EraserCommand::EraserCommand(const std::vector<Point>& points)
+    : points_(points), bounds_(PointsBounds(points, ERASER_STROKE_WIDTH * 0.5f))
 {
     id_ = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count());
 }
 
-void PencilCommand::Apply(OH_Drawing_Canvas* canvas)
+EraserCommand::EraserCommand(const std::vector<Point>& points, StrokeTessellator stroke)
+    : EraserCommand(points)
+{
+    stroke_ = std::move(stroke);
+}
+
+void EraserCommand::BuildDisplayList(DisplayList* list)
+{
+    // 草稿层是覆盖率 mask：直接清除笔迹覆盖率，与纸张颜色无关
+    CompileDraftStroke(&stroke_, points_, ERASER_STROKE_WIDTH, RasterBlend::CLEAR, list);
+}
+
+Action EraserCommand::ToAction() const
+{
+    Action action;
+    action.id = id_;
+    action.type = ActionType::STROKE;
+    action.tool = ToolMode::DRAFT_ERASER;
+    action.points = points_;
+    action.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return action;
+}
+
+// ClearCommand 实现
+ClearCommand::ClearCommand()
+{
+    id_ = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void ClearCommand::Apply(RasterCanvas* canvas)
+{
+    if (!canvas) return;
+    // 清空画布
+    canvas->Clear(0x00000000);  // 透明
+}
+
+void ClearCommand::Revert(RasterCanvas*)
+{
+    // 撤销清空操作需要重新渲染整个OffscreenCanvas，所以这里不做任何操作
+    // 实际的撤销由引擎的RenderOffscreenCanvas完成
+}
+
+Action ClearCommand::ToAction() const
+{
+    Action action;
+    action.id = id_;
+    action.type = ActionType::CUT;  // 使用CUT类型表示清空操作
+    action.tool = ToolMode::SCISSORS;
+    action.points.clear();
+    action.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return action;
+}
+
+void ClearCommand::SetPreviousCommands(std::vector<std::unique_ptr<ICommand>> commands)
+{
+    previousCommands_ = std::move(commands);
+}
+
+// ========== 离屏Canvas实现 ==========
+
+void PaperCutEngine::InitializeLayers(int width, int height)
+{
+    if (layersInitialized_) {
+        DestroyLayers();
+    }
+    
+    // InputCanvas - 交互层：临时路径直接画到目标画布上，不再持有整幅 RGBA bitmap
+    inputDirty_ = true;
+    
+    // OffscreenCanvas - 数据层：两张 A8 覆盖率 mask（颜色在合成时着色）
+    // ① 裁剪 mask：纸张存在的覆盖率（纸张形状为 255，CUT 清除）
+    // ② 草稿 mask：铅笔笔迹覆盖率（橡皮清除）
+    cutMaskBitmap_ = backend_->CreateBitmap(width, height, RasterFormat::A8);
+    cutMaskCanvas_ = backend_->CreateCanvas(cutMaskBitmap_.get());
+    draftBitmap_ = backend_->CreateBitmap(width, height, RasterFormat::A8);
+    draftCanvas_ = backend_->CreateCanvas(draftBitmap_.get());
+    if (!cutMaskCanvas_ || !draftCanvas_) {
+        LOGE("Failed to create layers: %dx%d", width, height);
+        DestroyLayers();
+        return;
+    }
+    cutMaskCanvas_->Clear(0x00000000);
+    draftCanvas_->Clear(0x00000000);
+    
+    // 尺寸可能变化，旧快照不再可用
+    checkpoints_.clear();
+    offscreenDirty_ = true;
+    layersInitialized_ = true;
+    
+    LOGI("Layers initialized: %dx%d", width, height);
+}
+
+void PaperCutEngine::DestroyLayers()
+{
+    // 画布先于其绑定的位图释放
+    cutMaskCanvas_.reset();
+    cutMaskBitmap_.reset();
+    draftCanvas_.reset();
+    draftBitmap_.reset();
+    
+    layersInitialized_ = false;
+    LOGI("Layers destroyed");
+}
+
+void PaperCutEngine::DrawOffscreenBase()
+{
+    // 裁剪 mask 与纸张形状无关：整幅都是“未剪”（255），纸张形状在合成/预览时再裁剪，
+    // 因此切换圆形/方形纸张不需要重放历史
+    cutMaskCanvas_->Clear(0xFF000000);
+    draftCanvas_->Clear(0x00000000);
+}
+
+void PaperCutEngine::BeginOffscreenModelSpace()
+{
+    float centerX = canvasWidth_ * 0.5f;
+    float centerY = canvasHeight_ * 0.5f;
+    
+    for (RasterCanvas* layer : {cutMaskCanvas_.get(), draftCanvas_.get()}) {
+        // 转换到模型坐标系统（不再按纸张边界裁剪，纸张边界由合成阶段负责）
+        layer->Save();
+        layer->Translate(centerX, centerY);
+    }
+}
+
+void PaperCutEngine::EndOffscreenModelSpace()
+{
+    for (RasterCanvas* layer : {cutMaskCanvas_.get(), draftCanvas_.get()}) {
+        layer->Restore();  // 结束坐标转换
+    }
+}
+
+RasterMatrix PaperCutEngine::LayerModelMatrix() const
+{
+    RasterMatrix matrix;
+    matrix.tx = canvasWidth_ * 0.5f;
+    matrix.ty = canvasHeight_ * 0.5f;
+    return matrix;
+}
+
+void PaperCutEngine::ApplyCommandToLayers(ICommand* cmd)
+{
+    ApplyCommandsToLayers(&cmd, 1);
+}
+
+void PaperCutEngine::ApplyCommandsToLayers(ICommand* const* cmds, size_t count, const RasterIRect* region)
+{
+    RasterBitmap* layers[2] = {cutMaskBitmap_.get(), draftBitmap_.get()};
+    std::vector<uint8_t*> pixels;
+    int width = 0;
+    const bool direct = CollectA8Masks(layers, 2, &pixels, &width);
+    const RasterMatrix matrix = LayerModelMatrix();
+    RasterIRect area = {0, 0, layers[0]->GetWidth(), layers[0]->GetHeight()};
+    if (region) {
+        area.Intersect(*region);
+    }
+    if (area.IsEmpty()) {
+        return;
+    }
+    // 每个命令只作用于它关心的 mask（CUT 同时清除纸张和其上的草稿）：下标为 CUT_MASK | DRAFT 位，
+    // 只在 direct 时使用
+    const int height = layers[0]->GetHeight();
+    const DisplayList::MaskSet maskSets[4] = {
+        {pixels.data(), 0, width, height},
+        {pixels.data(), 1, width, height},
+        {pixels.data() + (direct ? 1 : 0), 1, width, height},
+        {pixels.data(), 2, width, height},
+    };
+    struct Replay {
+        const DisplayList* list;
+        const DisplayList::MaskSet* masks;
+    };
+    std::vector<Replay> run;
+    size_t i = 0;
+    while (i < count) {
+        // 连续一段可编译为显示列表的命令一起按行条带并行：条带内按命令顺序重放（命令之间只有逐像素的先后依赖），
+        // 条带之间像素不相交，结果与逐条串行完全一致。编译在这里单线程完成，条带只读取列表
+        run.clear();
+        size_t end = i;
+        for (; direct && end < count && cmds[end]; end++) {
+            const DisplayList* list = cmds[end]->Compile();
+            if (!list) {
+                break;
+            }
+            const int layerBits = (cmds[end]->AffectsLayer(CommandLayer::CUT_MASK) ? 1 : 0) |
+                                  (cmds[end]->AffectsLayer(CommandLayer::DRAFT) ? 2 : 0);
+            run.push_back({list, &maskSets[layerBits]});
+        }
+        if (end > i) {
+            JobSystem& jobs = JobSystem::Get();
+            const int rows = area.bottom - area.top;
+            const int bands = jobs.GetConcurrency() > 1 ? jobs.GetConcurrency() * REPLAY_BANDS_PER_THREAD : 1;
+            const int bandHeight = std::max(REPLAY_MIN_BAND_HEIGHT, (rows + bands - 1) / bands);
+            jobs.ParallelFor(rows, bandHeight, [&](int rowBegin, int rowEnd) {
+                const RasterIRect band = {area.left, area.top + rowBegin, area.right, area.top + rowEnd};
+                // 光栅器格子与变换暂存区在条带内跨命令复用，只在容量不足时增长
+                CoverageRasterizer rasterizer;
+                std::vector<RasterPoint> scratch;
+                for (const Replay& replay : run) {
+                    replay.list->Rasterize(matrix, band, *replay.masks, &rasterizer, &scratch);
+                }
+            });
+            i = end;
+            continue;
+        }
+        ICommand* cmd = cmds[i++];
+        if (!cmd) {
+            continue;
+        }
+        for (RasterCanvas* layer : {cutMaskCanvas_.get(), draftCanvas_.get()}) {
+            if (!cmd->AffectsLayer(layer == cutMaskCanvas_.get() ? CommandLayer::CUT_MASK : CommandLayer::DRAFT)) {
+                continue;
+            }
+            if (region) {
+                // 画布处于模型坐标系（BeginOffscreenModelSpace），裁剪矩形换回模型坐标
+                RasterPath clip;
+                clip.AddRect(area.left - matrix.tx, area.top - matrix.ty, area.right - matrix.tx,
+                             area.bottom - matrix.ty);
+                layer->Save();
+                layer->ClipPath(clip, RasterClipOp::INTERSECT, false);
+            }
+            cmd->Apply(layer);
+            if (region) {
+                layer->Restore();
+            }
+        }
+    }
+}
+
+void PaperCutEngine::RenderOffscreenCanvas()
+{
+    if (!cutMaskCanvas_ || !layersInitialized_) return;
+    
+    RebuildOffscreenTo(commandHistory_.size(), SIZE_MAX);
+    offscreenDirty_ = false;
+}
+
+void PaperCutEngine::RebuildOffscreenTo(size_t count, size_t validCount)
 {
-    if (!canvas) return;
-    PaperCutEngine::DrawPencilStroke(canvas, points_);
+    if (!cutMaskCanvas_ || !draftCanvas_) return;
+    count = std::min(count, commandHistory_.size());
+    
+    size_t start = 0;
+    const HistoryCheckpoint* checkpoint = FindReplayOrigin(count, &start);
+    enum class Origin { BASE, CHECKPOINT, CURRENT } origin = checkpoint ? Origin::CHECKPOINT : Origin::BASE;
+    // 当前图层内容仍有效且更近时，直接在其上继续重放（前进方向）
+    if (validCount != SIZE_MAX && validCount <= count && validCount >= start) {
+        start = validCount;
+        origin = Origin::CURRENT;
+    }
+    
+    if (origin == Origin::BASE) {
+        DrawOffscreenBase();
+    } else if (origin == Origin::CHECKPOINT) {
+        void* cutPixels = cutMaskBitmap_->GetPixels();
+        void* draftPixels = draftBitmap_->GetPixels();
+        if (cutPixels && draftPixels) {
+            std::memcpy(cutPixels, checkpoint->cutMask.data(), checkpoint->cutMask.size());
+            std::memcpy(draftPixels, checkpoint->draft.data(), checkpoint->draft.size());
+        }
+    }
+    
+    BeginOffscreenModelSpace();
+    // 相邻检查点之间的命令作为一段一起重放（段内按行条带并行），段尾再打快照；
+    // 是否打快照只取决于命令数和代价，分段位置与逐条重放时完全相同
+    std::vector<ICommand*> segment;
+    for (size_t i = start; i < count; i++) {
+        segment.push_back(commandHistory_[i].get());
+        if (i + 1 == count || ShouldCaptureCheckpoint(i + 1)) {
+            ApplyCommandsToLayers(segment.data(), segment.size());
+            segment.clear();
+            MaybeCaptureCheckpoint(i + 1);
+        }
+    }
+    EndOffscreenModelSpace();
 }
 
-void PencilCommand::Revert(OH_Drawing_Canvas* canvas)
+const PaperCutEngine::HistoryCheckpoint* PaperCutEngine::FindReplayOrigin(size_t count, size_t* start) const
 {
-    // 撤销铅笔操作需要重新渲染整个OffscreenCanvas，所以这里不做任何操作
-    // 实际的撤销由引擎的RenderOffscreenCanvas完成
+    // ClearCommand 作为“分界点”：只需从最后一次 clear 之后开始重放
+    *start = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (dynamic_cast<ClearCommand*>(commandHistory_[i].get()) != nullptr) {
+            *start = i + 1;
+        }
+    }
+    // 最近的（不超过 count 的）检查点
+    for (auto it = checkpoints_.rbegin(); it != checkpoints_.rend(); ++it) {
+        if (it->commandCount <= count) {
+            if (it->commandCount < *start) {
+                break;
+            }
+            *start = it->commandCount;
+            return &(*it);
+        }
+    }
+    return nullptr;
 }
 
-Action PencilCommand::ToAction() const
+RasterIRect PaperCutEngine::CommandMaskRect(const ICommand* cmd) const
 {
-    Action action;
-    action.id = id_;
-    action.type = ActionType::STROKE;
-    action.tool = ToolMode::DRAFT_PEN;
-    action.points = points_;
-    action.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
-    return action;
+    const RasterIRect whole = {0, 0, canvasWidth_, canvasHeight_};
+    const CommandBounds* bounds = cmd ? cmd->GetBounds() : nullptr;
+    if (!bounds) {
+        return whole;
+    }
+    if (!(bounds->left <= bounds->right && bounds->top <= bounds->bottom)) {
+        return RasterIRect();  // 没有点的命令不改变任何像素
+    }
+    // 抗锯齿边缘只会写到包围盒所在的像素，外扩 1 像素容纳浮点误差；先限制到 mask 范围再取整
+    const RasterMatrix matrix = LayerModelMatrix();
+    auto clampTo = [](float v, int limit) { return std::min(std::max(v, -1.0f), static_cast<float>(limit) + 1.0f); };
+    RasterIRect rect;
+    rect.left = static_cast<int>(std::floor(clampTo(bounds->left + matrix.tx, canvasWidth_))) - 1;
+    rect.top = static_cast<int>(std::floor(clampTo(bounds->top + matrix.ty, canvasHeight_))) - 1;
+    rect.right = static_cast<int>(std::ceil(clampTo(bounds->right + matrix.tx, canvasWidth_))) + 1;
+    rect.bottom = static_cast<int>(std::ceil(clampTo(bounds->bottom + matrix.ty, canvasHeight_))) + 1;
+    rect.Intersect(whole);
+    return rect.IsEmpty() ? RasterIRect() : rect;
 }
 
-// EraserCommand 实现
-EraserCommand::EraserCommand(const std::vector<Point>& points, uint32_t backgroundColor)
-    : points_(points), backgroundColor_(backgroundColor)
+bool PaperCutEngine::ComputeDirtyRegion(size_t begin, size_t end, RasterIRect* region) const
 {
-    id_ = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count());
+    *region = RasterIRect();
+    for (size_t i = begin; i < end && i < commandHistory_.size(); i++) {
+        const ICommand* cmd = commandHistory_[i].get();
+        if (cmd && !cmd->GetBounds()) {
+            return false;  // CLEAR 等整张图层的命令
+        }
+        region->Union(CommandMaskRect(cmd));
+    }
+    return true;
 }
 
-void EraserCommand::Apply(OH_Drawing_Canvas* canvas)
+void PaperCutEngine::SyncCommandGrid()
 {
-    if (!canvas) return;
-    // 使用纸张颜色作为背景色来擦除
-    PaperCutEngine::ErasePencilStroke(canvas, points_, backgroundColor_);
+    if (commandGrid_.GetWidth() != canvasWidth_ || commandGrid_.GetHeight() != canvasHeight_) {
+        commandGrid_.Reset(canvasWidth_, canvasHeight_, COMMAND_GRID_CELL_SIZE);
+    }
+    commandGrid_.Truncate(commandHistory_.size());
+    for (size_t i = commandGrid_.GetCount(); i < commandHistory_.size(); i++) {
+        commandGrid_.Append(CommandMaskRect(commandHistory_[i].get()));
+    }
 }
 
-void EraserCommand::Revert(OH_Drawing_Canvas* canvas)
+bool PaperCutEngine::RebuildOffscreenRegion(size_t count, const RasterIRect& region)
 {
-    // 撤销橡皮操作需要重新渲染整个OffscreenCanvas，所以这里不做任何操作
-    // 实际的撤销由引擎的RenderOffscreenCanvas完成
+    uint8_t* cutPixels = static_cast<uint8_t*>(cutMaskBitmap_->GetPixels());
+    uint8_t* draftPixels = static_cast<uint8_t*>(draftBitmap_->GetPixels());
+    if (!cutPixels || !draftPixels || count > commandHistory_.size()) return false;
+    if (region.IsEmpty()) return true;
+    
+    size_t start = 0;
+    const HistoryCheckpoint* checkpoint = FindReplayOrigin(count, &start);
+    
+    // 网格里找出 [start, count) 中与脏矩形相交的命令；其余命令不会改变矩形内的像素
+    SyncCommandGrid();
+    std::vector<uint32_t> hits;
+    commandGrid_.Query(region, start, count, &hits);
+    std::vector<ICommand*> replay;
+    replay.reserve(hits.size());
+    for (uint32_t index : hits) {
+        replay.push_back(commandHistory_[index].get());
+    }
+    
+    // 矩形内恢复到起点状态：检查点的对应行，或纸张底色（裁剪 mask 255、草稿 0）
+    const size_t rowBytes = static_cast<size_t>(region.right - region.left);
+    for (int y = region.top; y < region.bottom; y++) {
+        const size_t offset = static_cast<size_t>(y) * canvasWidth_ + region.left;
+        if (checkpoint) {
+            std::memcpy(cutPixels + offset, checkpoint->cutMask.data() + offset, rowBytes);
+            std::memcpy(draftPixels + offset, checkpoint->draft.data() + offset, rowBytes);
+        } else {
+            std::memset(cutPixels + offset, 0xFF, rowBytes);
+            std::memset(draftPixels + offset, 0x00, rowBytes);
+        }
+    }
+    BeginOffscreenModelSpace();
+    ApplyCommandsToLayers(replay.data(), replay.size(), &region);
+    EndOffscreenModelSpace();
+    return true;
 }
 
-Action EraserCommand::ToAction() const
+bool PaperCutEngine::ShouldCaptureCheckpoint(size_t count) const
 {
-    Action action;
-    action.id = id_;
-    action.type = ActionType::STROKE;
-    action.tool = ToolMode::DRAFT_ERASER;
-    action.points = points_;
-    action.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
-    return action;
+    if (!cutMaskBitmap_ || !draftBitmap_ || count == 0 || count > commandHistory_.size()) return false;
+    
+    // 找到 count 之前最近的检查点
+    size_t prevCount = 0;
+    auto pos = checkpoints_.begin();
+    for (; pos != checkpoints_.end() && pos->commandCount < count; ++pos) {
+        prevCount = pos->commandCount;
+    }
+    if (pos != checkpoints_.end() && pos->commandCount == count) {
+        return false;  // 已存在
+    }
+    
+    // 间隔按命令数或估算的重放代价（点数）计算，任一达到阈值即打快照
+    size_t cost = 0;
+    for (size_t i = prevCount; i < count; i++) {
+        if (commandHistory_[i]) {
+            cost += commandHistory_[i]->EstimateRasterCost();
+        }
+    }
+    if (count - prevCount < CHECKPOINT_COMMAND_INTERVAL && cost < CHECKPOINT_COST_INTERVAL) {
+        return false;
+    }
+    
+    // 预算已满时，只有新快照不会被立刻淘汰才值得拷贝（否则每条命令都会“拷贝-淘汰”一次）
+    if (checkpoints_.size() >= MaxCheckpoints()) {
+        size_t nextCount = (pos != checkpoints_.end()) ? pos->commandCount : GetHistoryLength();
+        size_t minGap = SIZE_MAX;
+        for (size_t i = 0; i < checkpoints_.size(); i++) {
+            minGap = std::min(minGap, CheckpointMergeGap(i));
+        }
+        if (nextCount - prevCount <= minGap) {
+            return false;
+        }
+    }
+    return true;
 }
 
-// ClearCommand 实现
-ClearCommand::ClearCommand()
+void PaperCutEngine::MaybeCaptureCheckpoint(size_t count)
 {
-    id_ = std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count());
+    if (!ShouldCaptureCheckpoint(count)) return;
+    
+    const uint8_t* cutPixels = static_cast<const uint8_t*>(cutMaskBitmap_->GetPixels());
+    const uint8_t* draftPixels = static_cast<const uint8_t*>(draftBitmap_->GetPixels());
+    if (!cutPixels || !draftPixels) return;
+    // A8 mask 每像素 1 字节
+    const size_t pixelCount = static_cast<size_t>(canvasWidth_) * static_cast<size_t>(canvasHeight_);
+    HistoryCheckpoint checkpoint;
+    checkpoint.commandCount = count;
+    checkpoint.cutMask.assign(cutPixels, cutPixels + pixelCount);
+    checkpoint.draft.assign(draftPixels, draftPixels + pixelCount);
+    auto pos = checkpoints_.begin();
+    while (pos != checkpoints_.end() && pos->commandCount < count) {
+        ++pos;
+    }
+    checkpoints_.insert(pos, std::move(checkpoint));
+    
+    ThinCheckpoints();
 }
 
-void ClearCommand::Apply(OH_Drawing_Canvas* canvas)
+std::vector<size_t> PaperCutEngine::GetCheckpointCounts() const
 {
-    if (!canvas) return;
-    // 清空画布
-    OH_Drawing_CanvasClear(canvas, 0x00000000);  // 透明
+    std::vector<size_t> counts;
+    counts.reserve(checkpoints_.size());
+    for (const HistoryCheckpoint& checkpoint : checkpoints_) {
+        counts.push_back(checkpoint.commandCount);
+    }
+    return counts;
 }
 
-void ClearCommand::Revert(OH_Drawing_Canvas* canvas)
+size_t PaperCutEngine::GetCheckpointBytes() const
 {
-    // 撤销清空操作需要重新渲染整个OffscreenCanvas，所以这里不做任何操作
-    // 实际的撤销由引擎的RenderOffscreenCanvas完成
+    size_t bytes = 0;
+    for (const HistoryCheckpoint& checkpoint : checkpoints_) {
+        bytes += checkpoint.cutMask.size() + checkpoint.draft.size();
+    }
+    return bytes;
 }
 
-Action ClearCommand::ToAction() const
+size_t PaperCutEngine::MaxCheckpoints() const
 {
-    Action action;
-    action.id = id_;
-    action.type = ActionType::CUT;  // 使用CUT类型表示清空操作
-    action.tool = ToolMode::SCISSORS;
-    action.points.clear();
-    action.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
-    return action;
+    // 每个检查点包含裁剪 mask + 草稿 mask 两张 A8
+    const size_t bytesPerCheckpoint = static_cast<size_t>(canvasWidth_) * static_cast<size_t>(canvasHeight_) * 2;
+    if (bytesPerCheckpoint == 0) return 1;
+    return std::max<size_t>(1, CHECKPOINT_MEMORY_BUDGET / bytesPerCheckpoint);
 }
 
-void ClearCommand::SetPreviousCommands(std::vector<std::unique_ptr<ICommand>> commands)
+size_t PaperCutEngine::CheckpointMergeGap(size_t i) const
 {
-    previousCommands_ = std::move(commands);
+    // 删除第 i 个检查点后，其前后两段合并成的区间长度（命令数）
+    size_t prev = (i == 0) ? 0 : checkpoints_[i - 1].commandCount;
+    size_t next = (i + 1 < checkpoints_.size()) ? checkpoints_[i + 1].commandCount : GetHistoryLength();
+    return next - prev;
 }
 
-// ========== 离屏Canvas实现 ==========
-
-void PaperCutEngine::InitializeLayers(int width, int height)
+void PaperCutEngine::ThinCheckpoints()
 {
-    if (layersInitialized_) {
-        DestroyLayers();
+    // 超出预算时，每次删除一个“合并后区间最短”的检查点，使检查点在历史上尽量均匀
+    const size_t maxCheckpoints = MaxCheckpoints();
+    while (checkpoints_.size() > maxCheckpoints) {
+        size_t victim = 0;
+        size_t bestGap = SIZE_MAX;
+        for (size_t i = 0; i < checkpoints_.size(); i++) {
+            size_t gap = CheckpointMergeGap(i);
+            if (gap < bestGap) {
+                bestGap = gap;
+                victim = i;
+            }
+        }
+        checkpoints_.erase(checkpoints_.begin() + victim);
     }
-    
-    // 初始化InputCanvas - 交互层
-    inputBitmap_ = OH_Drawing_BitmapCreate();
-    OH_Drawing_BitmapFormat inputFormat{COLOR_FORMAT_RGBA_8888, ALPHA_FORMAT_PREMUL};
-    OH_Drawing_BitmapBuild(inputBitmap_, width, height, &inputFormat);
-    inputCanvas_ = OH_Drawing_CanvasCreate();
-    OH_Drawing_CanvasBind(inputCanvas_, inputBitmap_);
-    inputDirty_ = true;
-    
-    // 初始化OffscreenCanvas - 数据层（真实数据存储）
-    offscreenBitmap_ = OH_Drawing_BitmapCreate();
-    OH_Drawing_BitmapFormat offscreenFormat{COLOR_FORMAT_RGBA_8888, ALPHA_FORMAT_PREMUL};
-    OH_Drawing_BitmapBuild(offscreenBitmap_, width, height, &offscreenFormat);
-    offscreenCanvas_ = OH_Drawing_CanvasCreate();
-    OH_Drawing_CanvasBind(offscreenCanvas_, offscreenBitmap_);
-    
-    // 清空OffscreenCanvas为透明
-    OH_Drawing_CanvasClear(offscreenCanvas_, 0x00000000);
-    
-    offscreenDirty_ = true;
-    layersInitialized_ = true;
-    
-    LOGI("Layers initialized: %dx%d", width, height);
 }
 
-void PaperCutEngine::DestroyLayers()
+void PaperCutEngine::DropCheckpointsAfter(size_t count)
 {
-    if (inputCanvas_) {
-        OH_Drawing_CanvasDestroy(inputCanvas_);
-        inputCanvas_ = nullptr;
-    }
-    if (inputBitmap_) {
-        OH_Drawing_BitmapDestroy(inputBitmap_);
-        inputBitmap_ = nullptr;
+    while (!checkpoints_.empty() && checkpoints_.back().commandCount > count) {
+        checkpoints_.pop_back();
     }
+}
+
+void PaperCutEngine::ApplyCommandIncremental(ICommand* cmd)
+{
+    if (!cmd || !cutMaskCanvas_ || !draftCanvas_) return;
     
-    if (offscreenCanvas_) {
-        OH_Drawing_CanvasDestroy(offscreenCanvas_);
-        offscreenCanvas_ = nullptr;
-    }
-    if (offscreenBitmap_) {
-        OH_Drawing_BitmapDestroy(offscreenBitmap_);
-        offscreenBitmap_ = nullptr;
+    // ClearCommand：回到“只有纸张底色”的状态，与全量重建时的分界点语义一致
+    if (dynamic_cast<ClearCommand*>(cmd) != nullptr) {
+        DrawOffscreenBase();
+        return;
     }
     
-    layersInitialized_ = false;
-    LOGI("Layers destroyed");
+    // 其他命令只叠加到现有图层上，与全量重放使用相同的坐标系和纸张裁剪
+    BeginOffscreenModelSpace();
+    ApplyCommandToLayers(cmd);
+    EndOffscreenModelSpace();
 }
 
-void PaperCutEngine::RenderOffscreenCanvas()
+void PaperCutEngine::ApplyCommandToOffscreenCanvas(std::unique_ptr<ICommand> cmd)
 {
-    if (!offscreenCanvas_ || !layersInitialized_) return;
-    
-    // 清空OffscreenCanvas
-    OH_Drawing_CanvasClear(offscreenCanvas_, 0x00000000);  // 透明背景
-    
-    // OffscreenCanvas使用模型坐标系统(以canvas中心为原点)
-    float centerX = canvasWidth_ * 0.5f;
-    float centerY = canvasHeight_ * 0.5f;
-    float paperRadius = std::min(canvasWidth_, canvasHeight_) * PAPER_RADIUS_RATIO;
+    if (!cmd || !layersInitialized_) return;
     
-    // 转换到模型坐标系统
-    OH_Drawing_CanvasSave(offscreenCanvas_);
-    OH_Drawing_CanvasTranslate(offscreenCanvas_, centerX, centerY);
+    // 清空重做栈(新命令后不能再重做)，重做分支上的检查点随之失效
+    redoStack_.clear();
+    DropCheckpointsAfter(commandHistory_.size());
     
-    // 绘制纸张底色(在模型坐标系统中,中心是(0,0))
-    OH_Drawing_Brush* brush = OH_Drawing_BrushCreate();
-    OH_Drawing_BrushSetColor(brush, paperColor_);
-    OH_Drawing_BrushSetAntiAlias(brush, true);
+    // 将命令添加到历史
+    commandHistory_.push_back(std::move(cmd));
+    ++historyVersion_;
     
-    OH_Drawing_Path* paperPath = OH_Drawing_PathCreate();
-    if (paperType_ == PaperType::CIRCLE) {
-        OH_Drawing_PathAddCircle(paperPath, 0, 0, paperRadius, PATH_DIRECTION_CCW);
+    if (offscreenDirty_) {
+        // 图层已失效（纸张类型/颜色变化、尺寸变化等），只能全量重建
+        RenderOffscreenCanvas();
     } else {
-        OH_Drawing_PathAddRect(paperPath, -paperRadius, -paperRadius,
-                              paperRadius, paperRadius, PATH_DIRECTION_CCW);
+        // 增量路径：只把新命令画到现有图层上，避免每次抬笔都重放整个历史
+        ApplyCommandIncremental(commandHistory_.back().get());
+        MaybeCaptureCheckpoint(commandHistory_.size());
     }
+}
+
+void PaperCutEngine::SeekHistory(size_t index)
+{
+    const size_t current = commandHistory_.size();
+    index = std::min(index, GetHistoryLength());
+    if (index == current) return;
+    ++historyVersion_;
     
-    OH_Drawing_CanvasAttachBrush(offscreenCanvas_, brush);
-    OH_Drawing_CanvasDrawPath(offscreenCanvas_, paperPath);
-    OH_Drawing_CanvasDetachBrush(offscreenCanvas_);
-    
-    OH_Drawing_BrushDestroy(brush);
-    OH_Drawing_PathDestroy(paperPath);
+    // 后退时被撤销的命令只改变了它们包围盒的并集，只需重建这块脏矩形
+    RasterIRect dirty;
+    const bool regional = index < current && layersInitialized_ && !offscreenDirty_ &&
+                          ComputeDirtyRegion(index, current, &dirty);
     
-    // 设置裁剪区域（纸张边界）
-    OH_Drawing_CanvasSave(offscreenCanvas_);
-    OH_Drawing_Path* clipPath = OH_Drawing_PathCreate();
-    if (paperType_ == PaperType::CIRCLE) {
-        OH_Drawing_PathAddCircle(clipPath, 0, 0, paperRadius, PATH_DIRECTION_CCW);
+    if (index > current) {
+        // 前进：从重做栈取回命令（栈顶是紧接着的下一条）
+        while (commandHistory_.size() < index) {
+            commandHistory_.push_back(std::move(redoStack_.back()));
+            redoStack_.pop_back();
+        }
     } else {
-        OH_Drawing_PathAddRect(clipPath, -paperRadius, -paperRadius,
-                              paperRadius, paperRadius, PATH_DIRECTION_CCW);
+        // 后退：命令移到重做栈，检查点保留（仍属于同一条线性历史）
+        while (commandHistory_.size() > index) {
+            redoStack_.push_back(std::move(commandHistory_.back()));
+            commandHistory_.pop_back();
+        }
+        // 并集无法“减去”一条剪刀路径，矢量几何下次查询时重算
+        if (geometryCount_ > index) {
+            geometryCount_ = SIZE_MAX;
+        }
+        // 之后推入的新命令会复用这些下标
+        commandGrid_.Truncate(index);
     }
-    OH_Drawing_CanvasClipPath(offscreenCanvas_, clipPath, OH_Drawing_CanvasClipOp::INTERSECT, true);
-    OH_Drawing_PathDestroy(clipPath);
     
-    // ClearCommand 作为“分界点”：只渲染最后一次 clear 之后的命令
-    size_t startIndex = 0;
-    for (size_t i = 0; i < commandHistory_.size(); i++) {
-        if (dynamic_cast<ClearCommand*>(commandHistory_[i].get()) != nullptr) {
-            startIndex = i + 1;
+    if (!layersInitialized_) {
+        offscreenDirty_ = true;
+        return;
+    }
+    if (regional && RebuildOffscreenRegion(index, dirty)) {
+        return;
+    }
+    // 前进时当前图层可作为起点；后退无法在像素上“反向”执行，只能从检查点重放
+    const bool currentValid = !offscreenDirty_ && index > current;
+    RebuildOffscreenTo(index, currentValid ? current : SIZE_MAX);
+    offscreenDirty_ = false;
+}
+
+PaperGeometry& PaperCutEngine::GetPaperGeometry()
+{
+    geometry_.SetPaper(paperType_, std::min(canvasWidth_, canvasHeight_) * PAPER_RADIUS_RATIO);
+    size_t start = geometryCount_;
+    if (start > commandHistory_.size()) {
+        // 与 mask 重放相同：ClearCommand 是分界点，从最后一次清空之后开始
+        geometry_.Clear();
+        start = 0;
+        for (size_t i = 0; i < commandHistory_.size(); i++) {
+            if (dynamic_cast<ClearCommand*>(commandHistory_[i].get()) != nullptr) {
+                start = i + 1;
+            }
         }
     }
-    for (size_t i = startIndex; i < commandHistory_.size(); i++) {
-        const auto& cmd = commandHistory_[i];
-        if (cmd) {
-            cmd->Apply(offscreenCanvas_);
+    for (size_t i = start; i < commandHistory_.size(); i++) {
+        if (commandHistory_[i]) {
+            commandHistory_[i]->ApplyToGeometry(&geometry_);
         }
     }
-    
-    OH_Drawing_CanvasRestore(offscreenCanvas_);  // 结束裁剪
-    OH_Drawing_CanvasRestore(offscreenCanvas_);  // 结束坐标转换
-    offscreenDirty_ = false;
+    geometryCount_ = commandHistory_.size();
+    return geometry_;
 }
 
-void PaperCutEngine::ApplyCommandToOffscreenCanvas(std::unique_ptr<ICommand> cmd)
+void PaperCutEngine::GetExportContours(std::vector<RasterPath::Contour>* contours, float* extent)
 {
-    if (!cmd || !layersInitialized_) return;
+    // 与预览相同的 2N 段展开，只是作用在几何上：剩余纸张与扇形精确求交后旋转/镜像
+    GetPaperGeometry().GetUnfoldedContours(foldMode_, contours);
     
-    // 将命令添加到历史
-    commandHistory_.push_back(std::move(cmd));
-    
-    // 清空重做栈(新命令后不能再重做)
-    redoStack_.clear();
-    
-    // 标记需要重新渲染
-    offscreenDirty_ = true;
+    // 以中心为原点的正方形视口：至少包含整张纸，方形纸张旋转展开后的角点也不会被裁掉
+    float half = std::min(canvasWidth_, canvasHeight_) * PAPER_RADIUS_RATIO;
+    for (const auto& contour : *contours) {
+        for (const RasterPoint& p : contour.points) {
+            half = std::max(half, std::max(std::fabs(p.x), std::fabs(p.y)));
+        }
+    }
+    *extent = half;
+}
+
+bool PaperCutEngine::ExportSvg(int fd, int width, int height)
+{
+    if (fd < 0) return false;
     
-    // 重新渲染整个OffscreenCanvas（保证一致性）
-    RenderOffscreenCanvas();
+    std::vector<RasterPath::Contour> contours;
+    float extent = 0.0f;
+    GetExportContours(&contours, &extent);
+    const int size = static_cast<int>(std::ceil(extent * 2.0f));
+    SvgWriter writer(fd);
+    writer.Begin(-extent, -extent, extent * 2.0f, extent * 2.0f, width > 0 ? width : size, height > 0 ? height : size);
+    writer.AddPath(contours, paperColor_, RasterFillRule::NON_ZERO);
+    const bool ok = writer.Finish();
+    if (!ok) {
+        LOGE("ExportSvg: write failed");
+    }
+    return ok;
 }
 
-void PaperCutEngine::RevertCommandFromOffscreenCanvas()
+bool PaperCutEngine::ExportPng(int fd, int width, int height)
 {
-    if (commandHistory_.empty() || !layersInitialized_) return;
+    TiledPngExport::Image image;
+    if (fd < 0 || !PrepareExportPng(width, height, &image)) return false;
     
-    // 将最后一个命令移到重做栈
-    redoStack_.push_back(std::move(commandHistory_.back()));
-    commandHistory_.pop_back();
+    const bool ok = TiledPngExport::Write(fd, image);
+    if (!ok) {
+        LOGE("ExportPng: failed (%dx%d)", image.width, image.height);
+    }
+    return ok;
+}
+
+bool PaperCutEngine::IsValidExportSize(int width, int height)
+{
+    return width <= TiledPngExport::MAX_SIZE && height <= TiledPngExport::MAX_SIZE;
+}
+
+bool PaperCutEngine::PrepareExportPng(int width, int height, TiledPngExport::Image* image)
+{
+    // 尺寸无效时不快照轮廓：超大尺寸立即失败，不做任何几何工作
+    if (!image || !IsValidExportSize(width, height)) return false;
     
-    // 标记需要重新渲染
-    offscreenDirty_ = true;
+    std::vector<RasterPath::Contour>& contours = image->contours;
+    float extent = 0.0f;
+    GetExportContours(&contours, &extent);
+    const int size = static_cast<int>(std::ceil(extent * 2.0f));
+    width = width > 0 ? width : size;
+    height = height > 0 ? height : size;
     
-    // 重新渲染整个OffscreenCanvas（保证一致性）
-    RenderOffscreenCanvas();
+    // 视口等比缩放后居中（与 SVG 默认的 xMidYMid meet 一致），轮廓直接变换到输出像素
+    const float scale = std::min(width, height) / (extent * 2.0f);
+    const float centerX = width * 0.5f;
+    const float centerY = height * 0.5f;
+    for (auto& contour : contours) {
+        for (RasterPoint& p : contour.points) {
+            p.x = centerX + p.x * scale;
+            p.y = centerY + p.y * scale;
+        }
+    }
+    image->rule = RasterFillRule::NON_ZERO;
+    image->argb = paperColor_;
+    image->width = width;
+    image->height = height;
+    // 默认尺寸由取景范围决定，仍需检查
+    return IsValidExportSize(width, height);
 }
 
-void PaperCutEngine::CompositeLayers(OH_Drawing_Canvas* targetCanvas)
+void PaperCutEngine::CompositeLayers(RasterCanvas* targetCanvas)
 {
     if (!targetCanvas || !layersInitialized_) return;
     const bool isFullPaper = (foldMode_ == FoldMode::ZERO);
@@ -1403,78 +1587,64 @@ void PaperCutEngine::CompositeLayers(OH_Drawing_Canvas* targetCanvas)
     }
     
     // 目标 canvas 已经处在“中心原点 + 视图变换”坐标系中：
-    // bitmap（2048x2048）内容本身以像素坐标存储，因此需要以 (-CENTER,-CENTER) 贴回
+    // mask（2048x2048）内容本身以像素坐标存储，因此需要以 (-CENTER,-CENTER) 贴回。
+    // A8 bitmap 按画刷颜色着色：裁剪 mask 着纸张颜色，草稿 mask 着白色
     const float halfW = canvasWidth_ * 0.5f;
     const float halfH = canvasHeight_ * 0.5f;
-    if (offscreenBitmap_) {
-        OH_Drawing_CanvasDrawBitmap(targetCanvas, offscreenBitmap_, -halfW, -halfH);
+    // 纸张形状在这里作为裁剪应用（mask 本身不含纸张轮廓）
+    const float paperRadius = std::min(canvasWidth_, canvasHeight_) * PAPER_RADIUS_RATIO;
+    targetCanvas->Save();
+    targetCanvas->ClipPath(CreatePaperPath(paperType_, paperRadius), RasterClipOp::INTERSECT, true);
+    if (cutMaskBitmap_) {
+        const RasterPaint paperPaint = FillPaint(paperColor_);
+        targetCanvas->DrawBitmap(*cutMaskBitmap_, -halfW, -halfH, &paperPaint);
+    }
+    if (draftBitmap_) {
+        // 实时橡皮只扣除草稿层（与提交后的 EraserCommand 清除 draftBitmap_ 一致），
+        // 纸张与已剪出的镂空不受影响
+        const bool liveErase =
+            isDrawing_ && currentToolMode_ == ToolMode::DRAFT_ERASER && liveStroke_.GetInputCount() > 1;
+        if (liveErase) {
+            targetCanvas->Save();
+            targetCanvas->ClipPath(CreateStrokeMeshPath(liveStroke_), RasterClipOp::DIFFERENCE, true);
+        }
+        const RasterPaint draftPaint = FillPaint(0xFFFFFFFF);
+        targetCanvas->DrawBitmap(*draftBitmap_, -halfW, -halfH, &draftPaint);
+        if (liveErase) {
+            targetCanvas->Restore();
+        }
     }
+    targetCanvas->Restore();
     
-    // 更新InputCanvas（交互层，临时绘制）
-    if (inputDirty_) {
-        // 清空InputCanvas
-        OH_Drawing_CanvasClear(inputCanvas_, 0x00000000);  // 透明
+    // InputCanvas（交互层，临时绘制）：目标已在模型坐标系，直接画，不再经过整幅中间 bitmap
+    if (isDrawing_ && currentPoints_.size() > 1) {
+        targetCanvas->Save();
+
+        // WebEditor 对齐：
+        // - 草稿(铅笔/橡皮)必须被扇形 clip 约束
+        // - 剪刀金色预览线应在 clip 外也可见（Web 在 restore clip 后绘制）
+        if (!isFullPaper && currentToolMode_ != ToolMode::SCISSORS) {
+            float clipRadius = std::min(canvasWidth_, canvasHeight_) * CLIP_RADIUS_RATIO;
+            float sectorAngle2 = (2.0f * M_PI) / (static_cast<int>(foldMode_) * 2);
+            float startAngle = -M_PI / 2.0f;
+            targetCanvas->ClipPath(CreateWedgePath(clipRadius, startAngle, sectorAngle2), RasterClipOp::INTERSECT,
+                                   true);
+        }
         
-        // 绘制当前正在进行的绘制（实时预览）- 使用模型坐标
-        if (isDrawing_ && currentPoints_.size() > 1) {
-            // 转换模型坐标到屏幕坐标进行绘制
-            OH_Drawing_CanvasSave(inputCanvas_);
-            OH_Drawing_CanvasTranslate(inputCanvas_, halfW, halfH);
-
-            // WebEditor 对齐：
-            // - 草稿(铅笔/橡皮)必须被扇形 clip 约束
-            // - 剪刀金色预览线应在 clip 外也可见（Web 在 restore clip 后绘制）
-            if (!isFullPaper && currentToolMode_ != ToolMode::SCISSORS) {
-                float clipRadius = std::min(canvasWidth_, canvasHeight_) * CLIP_RADIUS_RATIO;
-                float sectorAngle2 = (2.0f * M_PI) / (static_cast<int>(foldMode_) * 2);
-                float startAngle = -M_PI / 2.0f;
-                OH_Drawing_Path* sectorPath = CreateWedgePath(clipRadius, startAngle, sectorAngle2);
-                OH_Drawing_CanvasClipPath(inputCanvas_, sectorPath, OH_Drawing_CanvasClipOp::INTERSECT, true);
-                OH_Drawing_PathDestroy(sectorPath);
-            }
-            
-            if (currentToolMode_ == ToolMode::SCISSORS) {
-                OH_Drawing_Path* previewPath = OH_Drawing_PathCreate();
-                if (currentPoints_.size() > 0) {
-                    OH_Drawing_PathMoveTo(previewPath, currentPoints_[0].x, currentPoints_[0].y);
-                    for (size_t i = 1; i < currentPoints_.size(); i++) {
-                        OH_Drawing_PathLineTo(previewPath, currentPoints_[i].x, currentPoints_[i].y);
-                    }
-                    OH_Drawing_PathClose(previewPath);
-                }
-                
-                // WebEditor：金色半透明填充 + 描边
-                OH_Drawing_Brush* brush = OH_Drawing_BrushCreate();
-                OH_Drawing_BrushSetColor(brush, 0x59FFD700);
-                OH_Drawing_CanvasAttachBrush(inputCanvas_, brush);
-                OH_Drawing_CanvasDrawPath(inputCanvas_, previewPath);
-                OH_Drawing_CanvasDetachBrush(inputCanvas_);
-                OH_Drawing_BrushDestroy(brush);
-
-                OH_Drawing_Pen* pen = OH_Drawing_PenCreate();
-                OH_Drawing_PenSetColor(pen, 0xFFFFD700);
-                OH_Drawing_PenSetWidth(pen, 5.0f);
-                OH_Drawing_PenSetAntiAlias(pen, true);
-                OH_Drawing_CanvasAttachPen(inputCanvas_, pen);
-                OH_Drawing_CanvasDrawPath(inputCanvas_, previewPath);
-                OH_Drawing_CanvasDetachPen(inputCanvas_);
-                OH_Drawing_PenDestroy(pen);
-                OH_Drawing_PathDestroy(previewPath);
-            } else if (currentToolMode_ == ToolMode::DRAFT_PEN) {
-                DrawPencilStroke(inputCanvas_, currentPoints_);
-            } else if (currentToolMode_ == ToolMode::DRAFT_ERASER) {
-                ErasePencilStroke(inputCanvas_, currentPoints_, paperColor_);
-            }
-            
-            OH_Drawing_CanvasRestore(inputCanvas_);
+        if (currentToolMode_ == ToolMode::SCISSORS) {
+            const RasterPath previewPath = CreateCutPath(currentPoints_);
+            // WebEditor：金色半透明填充 + 描边
+            targetCanvas->DrawPath(previewPath, FillPaint(0x59FFD700));
+            RasterPaint pen = StrokePaint(0xFFFFD700, 5.0f);
+            pen.antiAlias = true;
+            targetCanvas->DrawPath(previewPath, pen);
+        } else if (currentToolMode_ == ToolMode::DRAFT_PEN) {
+            DrawPencilStroke(targetCanvas, liveStroke_);
         }
-        inputDirty_ = false;
-    }
-    
-    // 绘制InputCanvas（交互层）
-    if (inputBitmap_) {
-        OH_Drawing_CanvasDrawBitmap(targetCanvas, inputBitmap_, -halfW, -halfH);
+        
+        targetCanvas->Restore();
     }
+    inputDirty_ = false;
 }
 
 bool PaperCutEngine::IsPointInSector(float x, float y) const
@@ -1503,15 +1673,17 @@ bool PaperCutEngine::IsPointInSector(float x, float y) const
     return shifted >= 0.0f && shifted <= sectorAngle;
 }
 
-void PaperCutEngine::RenderPreviewCanvas(OH_Drawing_Canvas* canvas)
+void PaperCutEngine::RenderPreviewCanvas(RasterCanvas* canvas)
 {
     // WebEditor 对齐的 PreviewCanvas：
     // - 只渲染“纸张 + CUT 镂空”（不显示铅笔草稿）
     // - 使用 2*N 段旋转/镜像展开
+    // 单个扇形 tile 只在历史/纸张/折数/尺寸变化时重建，这里只负责把 tile 盖印 2N 次，
+    // 因此预览代价与裁剪数量无关。
     if (!canvas || !layersInitialized_) return;
     
-    int width = OH_Drawing_CanvasGetWidth(canvas);
-    int height = OH_Drawing_CanvasGetHeight(canvas);
+    int width = canvas->GetWidth();
+    int height = canvas->GetHeight();
     float centerX = width * 0.5f;
     float centerY = height * 0.5f;
     
@@ -1524,62 +1696,308 @@ void PaperCutEngine::RenderPreviewCanvas(OH_Drawing_Canvas* canvas)
     float dstSize = static_cast<float>(std::min(width, height));
     float scale = (srcSize > 0.0f) ? (dstSize / srcSize) : 1.0f;
     
-    // ClearCommand 分界：只渲染最后一次 clear 之后的裁剪
-    size_t startIndex = 0;
-    for (size_t i = 0; i < commandHistory_.size(); i++) {
-        if (dynamic_cast<ClearCommand*>(commandHistory_[i].get()) != nullptr) {
-            startIndex = i + 1;
-        }
+    if (previewUnfoldMode_ == PreviewUnfoldMode::GEOMETRY) {
+        RenderPreviewGeometry(canvas, width, height, scale);
+        return;
     }
+    
+    RasterBitmap* tile = UpdatePreviewTile(scale);
+    if (!tile) return;
+    
+    // WebEditor：实时剪刀预览（在预览层做 cut 模拟），叠加到 tile 的临时副本上，仍只在 wedge 内生效
+    if (isDrawing_ && currentToolMode_ == ToolMode::SCISSORS && currentPoints_.size() > 1) {
+        tile = UpdateLivePreviewTile(scale);
+        if (!tile) return;
+    }
+    
+    if (previewUnfoldMode_ == PreviewUnfoldMode::POLAR_LUT) {
+        UnfoldPreviewByLut(canvas, tile, width, height);
+        return;
+    }
+    
+    const float tileLeft = static_cast<float>(previewTileKey_.left);
+    const float tileTop = static_cast<float>(previewTileKey_.top);
 
-    // 预览以画布中心为原点进行展开
-    OH_Drawing_CanvasSave(canvas);
-    OH_Drawing_CanvasTranslate(canvas, centerX, centerY);
-    OH_Drawing_CanvasScale(canvas, scale, scale);
-
-    // 纸张底色（只绘制一次）
-    DrawPaperBase(canvas);
+    // 预览以画布中心为原点进行展开（tile 已是预览像素尺度，这里只做旋转/镜像）
+    canvas->Save();
+    canvas->Translate(centerX, centerY);
     
     float startAngle = -M_PI / 2.0f;
     for (int i = 0; i < totalSegments; i++) {
-        OH_Drawing_CanvasSave(canvas);
+        canvas->Save();
         
         // WebEditor：偶数段旋转；奇数段按边界镜像（rotate 2*boundary + scaleY(-1)）
         if (isFullPaper) {
             // no-op
         } else if (i % 2 == 0) {
-            OH_Drawing_CanvasRotate(canvas, (i * sectorAngle) * 180.0f / M_PI, 0, 0);
+            canvas->Rotate((i * sectorAngle) * 180.0f / M_PI);
         } else {
             float boundary = startAngle + ((i + 1) / 2) * sectorAngle;
-            OH_Drawing_CanvasRotate(canvas, (2.0f * boundary) * 180.0f / M_PI, 0, 0);
-            OH_Drawing_CanvasScale(canvas, 1.0f, -1.0f);
+            canvas->Rotate((2.0f * boundary) * 180.0f / M_PI);
+            canvas->Scale(1.0f, -1.0f);
         }
+        
+        canvas->DrawBitmap(*tile, tileLeft, tileTop, nullptr);
+        
+        canvas->Restore();
+    }
+    
+    canvas->Restore();
+}
 
-        // WebEditor：每段只在“扇形 wedge”内应用裁剪（CLIP_RADIUS 足够大）
-        if (!isFullPaper) {
-            float clipRadius = std::min(canvasWidth_, canvasHeight_) * CLIP_RADIUS_RATIO;
-            OH_Drawing_Path* sectorPath = CreateWedgePath(clipRadius, startAngle, sectorAngle);
-            OH_Drawing_CanvasClipPath(canvas, sectorPath, OH_Drawing_CanvasClipOp::INTERSECT, true);
-            OH_Drawing_PathDestroy(sectorPath);
-        }
+void PaperCutEngine::UnfoldPreviewByLut(RasterCanvas* canvas, RasterBitmap* tile, int width, int height)
+{
+    if (width <= 0 || height <= 0) return;
+    
+    UnfoldGeometry geometry;
+    geometry.foldCount = static_cast<int>(foldMode_);
+    geometry.outWidth = width;
+    geometry.outHeight = height;
+    geometry.centerX = width * 0.5f;
+    geometry.centerY = height * 0.5f;
+    geometry.tileLeft = previewTileKey_.left;
+    geometry.tileTop = previewTileKey_.top;
+    geometry.tileWidth = tile->GetWidth();
+    geometry.tileHeight = tile->GetHeight();
+    // 查找表只依赖几何，折数/预览尺寸不变时跨帧复用
+    if (!previewLut_.Matches(geometry)) {
+        previewLut_.Build(geometry);
+    }
+    
+    if (!previewUnfoldBitmap_ || previewUnfoldBitmap_->GetWidth() != width ||
+        previewUnfoldBitmap_->GetHeight() != height) {
+        previewUnfoldBitmap_ = backend_->CreateBitmap(width, height, RasterFormat::RGBA8888);
+    }
+    
+    const uint32_t* tilePixels = static_cast<const uint32_t*>(tile->GetPixels());
+    uint32_t* outPixels = previewUnfoldBitmap_ ? static_cast<uint32_t*>(previewUnfoldBitmap_->GetPixels()) : nullptr;
+    if (!tilePixels || !outPixels) {
+        LOGE("UnfoldPreviewByLut: bitmap pixels unavailable");
+        return;
+    }
+    previewLut_.Gather(tilePixels, geometry.tileWidth, outPixels, width);
+    
+    // 展开结果带透明度，按 alpha 叠加到预览背景上
+    canvas->DrawBitmap(*previewUnfoldBitmap_, 0, 0, nullptr);
+}
 
-        // 应用所有 CUT 命令（destination-out 等价效果）
-        for (size_t k = startIndex; k < commandHistory_.size(); k++) {
-            auto* cut = dynamic_cast<CutCommand*>(commandHistory_[k].get());
-            if (!cut) continue;
-            // 复用 CutCommand::Apply 的逻辑（clip DIFFERENCE + 透明填充）
-            cut->Apply(canvas);
+void PaperCutEngine::RenderPreviewGeometry(RasterCanvas* canvas, int width, int height, float scale)
+{
+    if (width <= 0 || height <= 0) return;
+    
+    PreviewTileKey key;
+    key.historyVersion = historyVersion_;
+    key.foldMode = foldMode_;
+    key.paperType = paperType_;
+    key.scale = scale;
+    key.width = width;
+    key.height = height;
+    if (!previewCoverageBitmap_ || previewCoverageBitmap_->GetWidth() != width ||
+        previewCoverageBitmap_->GetHeight() != height) {
+        previewCoverageBitmap_ = backend_->CreateBitmap(width, height, RasterFormat::A8);
+        previewGeometryValid_ = false;
+    }
+    if (!previewCoverageBitmap_ || !previewCoverageBitmap_->GetPixels()) {
+        LOGE("RenderPreviewGeometry: coverage bitmap unavailable");
+        return;
+    }
+    
+    // 模型坐标（中心原点）-> 预览像素：与 tile 路径相同的比例，预览中心为原点
+    if (!previewGeometryValid_ || !(key == previewGeometryKey_)) {
+        RasterMatrix toDevice;
+        toDevice.a = scale;
+        toDevice.d = scale;
+        toDevice.tx = width * 0.5f;
+        toDevice.ty = height * 0.5f;
+        previewExpander_.Configure(foldMode_ == FoldMode::ZERO ? 0 : static_cast<int>(foldMode_), toDevice);
+        previewContours_.clear();
+        previewExpander_.Expand(GetPaperGeometry().GetPaperContours(), &previewContours_);
+        RasterizeContoursToA8(previewContours_, false, previewCoverageBitmap_.get());
+        previewGeometryKey_ = key;
+        previewGeometryValid_ = true;
+    }
+    
+    RasterBitmap* coverage = previewCoverageBitmap_.get();
+    // 实时剪刀路径：在已提交覆盖率的副本上按同样的展开清除
+    if (isDrawing_ && currentToolMode_ == ToolMode::SCISSORS && currentPoints_.size() > 2) {
+        if (!previewLiveCoverageBitmap_ || previewLiveCoverageBitmap_->GetWidth() != width ||
+            previewLiveCoverageBitmap_->GetHeight() != height) {
+            previewLiveCoverageBitmap_ = backend_->CreateBitmap(width, height, RasterFormat::A8);
+        }
+        void* livePixels = previewLiveCoverageBitmap_ ? previewLiveCoverageBitmap_->GetPixels() : nullptr;
+        if (livePixels) {
+            std::memcpy(livePixels, coverage->GetPixels(), static_cast<size_t>(width) * height);
+            std::vector<RasterPoint> polygon;
+            polygon.reserve(currentPoints_.size());
+            for (const Point& p : currentPoints_) {
+                polygon.push_back({p.x, p.y});
+            }
+            std::vector<RasterPath::Contour> liveContours;
+            previewExpander_.Expand(polygon.data(), polygon.size(), &liveContours);
+            RasterizeContoursToA8(liveContours, true, previewLiveCoverageBitmap_.get());
+            coverage = previewLiveCoverageBitmap_.get();
         }
+    }
+    
+    const RasterPaint paint = FillPaint(paperColor_);
+    canvas->DrawBitmap(*coverage, 0, 0, &paint);
+}
 
-        // WebEditor：实时剪刀预览（在预览层做 cut 模拟），但仍只在 wedge 内生效
-        if (isDrawing_ && currentToolMode_ == ToolMode::SCISSORS && currentPoints_.size() > 1) {
-            CutCommand liveCut(currentPoints_);
-            liveCut.Apply(canvas);
+void PaperCutEngine::ComputePreviewTileBounds(float scale, int* left, int* top, int* right, int* bottom) const
+{
+    // 纸张范围 [-r, r]²；折叠模式下再与扇形 wedge 的包围盒求交，tile 只覆盖一个扇形
+    const float paperRadius = std::min(canvasWidth_, canvasHeight_) * PAPER_RADIUS_RATIO;
+    float minX = -paperRadius;
+    float minY = -paperRadius;
+    float maxX = paperRadius;
+    float maxY = paperRadius;
+    
+    if (foldMode_ != FoldMode::ZERO) {
+        const float sectorAngle = (2.0f * M_PI) / (static_cast<int>(foldMode_) * 2);
+        const float startAngle = -M_PI / 2.0f;
+        const float endAngle = startAngle + sectorAngle;
+        // 方形纸张的角点距离为 r*sqrt(2)
+        const float reach = paperRadius * static_cast<float>(M_SQRT2);
+        float wMinX = 0.0f;
+        float wMinY = 0.0f;
+        float wMaxX = 0.0f;
+        float wMaxY = 0.0f;
+        auto extend = [&](float angle) {
+            float x = cos(angle) * reach;
+            float y = sin(angle) * reach;
+            wMinX = std::min(wMinX, x);
+            wMinY = std::min(wMinY, y);
+            wMaxX = std::max(wMaxX, x);
+            wMaxY = std::max(wMaxY, y);
+        };
+        extend(startAngle);
+        extend(endAngle);
+        // 弧经过的坐标轴方向
+        for (int k = -1; k <= 4; k++) {
+            float axis = k * static_cast<float>(M_PI_2);
+            if (axis > startAngle && axis < endAngle) {
+                extend(axis);
+            }
         }
-        
-        OH_Drawing_CanvasRestore(canvas);
+        minX = std::max(minX, wMinX);
+        minY = std::max(minY, wMinY);
+        maxX = std::min(maxX, wMaxX);
+        maxY = std::min(maxY, wMaxY);
     }
     
-    OH_Drawing_CanvasRestore(canvas);
+    // 外扩 1 像素给抗锯齿边缘
+    *left = static_cast<int>(std::floor(minX * scale)) - 1;
+    *top = static_cast<int>(std::floor(minY * scale)) - 1;
+    *right = static_cast<int>(std::ceil(maxX * scale)) + 1;
+    *bottom = static_cast<int>(std::ceil(maxY * scale)) + 1;
 }
 
+RasterBitmap* PaperCutEngine::UpdatePreviewTile(float scale)
+{
+    PreviewTileKey key;
+    key.historyVersion = historyVersion_;
+    key.foldMode = foldMode_;
+    key.paperType = paperType_;
+    key.paperColor = paperColor_;
+    key.scale = scale;
+    int right = 0;
+    int bottom = 0;
+    ComputePreviewTileBounds(scale, &key.left, &key.top, &right, &bottom);
+    const int tileWidth = right - key.left;
+    const int tileHeight = bottom - key.top;
+    if (tileWidth <= 0 || tileHeight <= 0) return nullptr;
+    
+    if (previewTileValid_ && previewTileBitmap_ && key == previewTileKey_) {
+        return previewTileBitmap_.get();
+    }
+    
+    // tile 由裁剪 mask 着色得到，先确保 mask 与当前历史一致
+    if (offscreenDirty_) {
+        RenderOffscreenCanvas();
+    }
+    
+    // 尺寸变化才重新分配
+    if (!previewTileBitmap_ || previewTileBitmap_->GetWidth() != tileWidth ||
+        previewTileBitmap_->GetHeight() != tileHeight) {
+        DestroyPreviewTile();
+        previewTileBitmap_ = backend_->CreateBitmap(tileWidth, tileHeight, RasterFormat::RGBA8888);
+        previewTileCanvas_ = backend_->CreateCanvas(previewTileBitmap_.get());
+        if (!previewTileCanvas_) {
+            DestroyPreviewTile();
+            return nullptr;
+        }
+    }
+    
+    previewTileCanvas_->Clear(0x00000000);
+    previewTileCanvas_->Save();
+    previewTileCanvas_->Translate(static_cast<float>(-key.left), static_cast<float>(-key.top));
+    previewTileCanvas_->Scale(scale, scale);
+    
+    // WebEditor：每段只在“扇形 wedge”内应用裁剪（CLIP_RADIUS 足够大）
+    if (foldMode_ != FoldMode::ZERO) {
+        const float clipRadius = std::min(canvasWidth_, canvasHeight_) * CLIP_RADIUS_RATIO;
+        const float sectorAngle = (2.0f * M_PI) / (static_cast<int>(foldMode_) * 2);
+        previewTileCanvas_->ClipPath(CreateWedgePath(clipRadius, -M_PI / 2.0f, sectorAngle), RasterClipOp::INTERSECT,
+                                     true);
+    }
+    
+    // 纸张形状裁剪 + 裁剪 mask 按纸张颜色着色：只是一遍 O(tile 像素) 的着色，
+    // 颜色/形状变化不需要重放命令
+    const float paperRadius = std::min(canvasWidth_, canvasHeight_) * PAPER_RADIUS_RATIO;
+    previewTileCanvas_->ClipPath(CreatePaperPath(paperType_, paperRadius), RasterClipOp::INTERSECT, true);
+    
+    // mask 是 2048 逻辑尺寸，缩小到预览尺寸时用线性采样保留抗锯齿边缘
+    const float halfW = canvasWidth_ * 0.5f;
+    const float halfH = canvasHeight_ * 0.5f;
+    const float src[4] = {0.0f, 0.0f, static_cast<float>(canvasWidth_), static_cast<float>(canvasHeight_)};
+    const float dst[4] = {-halfW, -halfH, halfW, halfH};
+    const RasterPaint paint = FillPaint(paperColor_, true);
+    previewTileCanvas_->DrawBitmapRect(*cutMaskBitmap_, src, dst, &paint, true);
+    
+    previewTileCanvas_->Restore();
+    previewTileKey_ = key;
+    previewTileValid_ = true;
+    return previewTileBitmap_.get();
+}
+
+RasterBitmap* PaperCutEngine::UpdateLivePreviewTile(float scale)
+{
+    if (!previewTileBitmap_) return nullptr;
+    const int tileWidth = previewTileBitmap_->GetWidth();
+    const int tileHeight = previewTileBitmap_->GetHeight();
+    if (!previewLiveBitmap_ || previewLiveBitmap_->GetWidth() != tileWidth ||
+        previewLiveBitmap_->GetHeight() != tileHeight) {
+        previewLiveCanvas_.reset();
+        previewLiveBitmap_ = backend_->CreateBitmap(tileWidth, tileHeight, RasterFormat::RGBA8888);
+        previewLiveCanvas_ = backend_->CreateCanvas(previewLiveBitmap_.get());
+        if (!previewLiveCanvas_) return nullptr;
+    }
+    
+    // 已提交的 tile + 当前剪刀路径：代价只与 tile 像素数有关
+    previewLiveCanvas_->Clear(0x00000000);
+    previewLiveCanvas_->DrawBitmap(*previewTileBitmap_, 0, 0, nullptr);
+    previewLiveCanvas_->Save();
+    previewLiveCanvas_->Translate(static_cast<float>(-previewTileKey_.left), static_cast<float>(-previewTileKey_.top));
+    previewLiveCanvas_->Scale(scale, scale);
+    // 与 CutCommand 相同的清除效果，但不构造命令：不复制点列、不编译显示列表，路径容量跨帧复用
+    BuildCutPath(currentPoints_, &liveCutPath_);
+    RasterPaint cutPaint = FillPaint(0xFFFFFFFF, true);
+    cutPaint.blend = RasterBlend::CLEAR;
+    previewLiveCanvas_->DrawPath(liveCutPath_, cutPaint);
+    previewLiveCanvas_->Restore();
+    return previewLiveBitmap_.get();
+}
+
+void PaperCutEngine::DestroyPreviewTile()
+{
+    // 画布先于其绑定的位图释放
+    previewTileCanvas_.reset();
+    previewTileBitmap_.reset();
+    previewLiveCanvas_.reset();
+    previewLiveBitmap_.reset();
+    previewUnfoldBitmap_.reset();
+    previewCoverageBitmap_.reset();
+    previewLiveCoverageBitmap_.reset();
+    previewTileValid_ = false;
+    previewGeometryValid_ = false;
+}
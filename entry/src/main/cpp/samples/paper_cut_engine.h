@@ -6,117 +6,149 @@
 #ifndef PAPERCUTTING_PAPER_CUT_ENGINE_H
 #define PAPERCUTTING_PAPER_CUT_ENGINE_H
 
-#include <native_drawing/drawing_canvas.h>
-#include <native_drawing/drawing_path.h>
-#include <native_drawing/drawing_brush.h>
-#include <native_drawing/drawing_pen.h>
-#include <native_drawing/drawing_color.h>
-#include <native_window/external_window.h>
 #include <vector>
 #include <string>
 #include <memory>
 #include <chrono>
+#include <cmath>
+#include "paper_cut_types.h"
+#include "paper_cut_geometry.h"
+#include "paper_cut_unfold.h"
+#include "utils/coverage_rasterizer.h"
+#include "utils/display_list.h"
+#include "utils/raster_backend.h"
+#include "utils/stroke_tessellator.h"
+#include "utils/tiled_png_export.h"
+#include "utils/uniform_grid.h"
 
-// 点结构
-struct Point {
-    float x;
-    float y;
-    
-    Point() : x(0), y(0) {}
-    Point(float x, float y) : x(x), y(y) {}
-};
-
-// 工具类型
-enum class ToolMode {
-    SCISSORS = 0,      // 剪刀（裁剪）
-    BEZIER = 1,        // 贝塞尔曲线
-    DRAFT_PEN = 2,     // 铅笔
-    DRAFT_ERASER = 3   // 橡皮
-};
+// 引擎本身只依赖 RasterBackend；NativeWindow 上屏与默认 native_drawing 后端在 paper_cut_engine_surface.cpp，
+// 因此本文件与 paper_cut_engine.cpp 可以脱离设备 SDK 编译（Linux 测试/基准使用 CpuRasterBackend）
+struct NativeWindow;
+typedef struct NativeWindow OHNativeWindow;
 
-// 折叠模式
-enum class FoldMode {
-    ZERO = 0,  // 不折叠（全纸）
-    ONE = 1,
-    TWO = 2,
-    THREE = 3,
-    FOUR = 4,
-    FIVE = 5,
-    SIX = 6,
-    SEVEN = 7,
-    EIGHT = 8
+// OffscreenCanvas 中的 A8 覆盖率图层
+enum class CommandLayer {
+    CUT_MASK = 0,   // 纸张覆盖率（CUT 清除）
+    DRAFT = 1       // 铅笔草稿覆盖率（橡皮清除）
 };
 
-// 纸张类型
-enum class PaperType {
-    CIRCLE = 0,   // 圆形
-    SQUARE = 1    // 方形
-};
+// 命令可能改变的模型区域（轴对齐包围盒，含描边半宽），构造时计算并缓存
+struct CommandBounds {
+    float left = INFINITY;
+    float top = INFINITY;
+    float right = -INFINITY;
+    float bottom = -INFINITY;
 
-// 动作类型
-enum class ActionType {
-    CUT = 0,      // 裁剪
-    STROKE = 1    // 笔触
-};
-
-// 动作结构（兼容旧代码）
-struct Action {
-    std::string id;
-    ActionType type;
-    ToolMode tool;
-    std::vector<Point> points;
-    int64_t timestamp;
-    
-    Action() : type(ActionType::CUT), tool(ToolMode::SCISSORS), timestamp(0) {}
+    void Add(const Point& p)
+    {
+        left = std::fmin(left, p.x);
+        top = std::fmin(top, p.y);
+        right = std::fmax(right, p.x);
+        bottom = std::fmax(bottom, p.y);
+    }
+    void Outset(float distance)
+    {
+        left -= distance;
+        top -= distance;
+        right += distance;
+        bottom += distance;
+    }
 };
 
 // 命令接口（Command Pattern）
 class ICommand {
 public:
     virtual ~ICommand() = default;
-    virtual void Apply(OH_Drawing_Canvas* canvas) = 0;  // 应用命令到画布
-    virtual void Revert(OH_Drawing_Canvas* canvas) = 0;  // 撤销命令
+    virtual bool AffectsLayer(CommandLayer layer) const = 0;  // 命令需要应用到哪些图层
+    virtual void Apply(RasterCanvas* canvas) = 0;  // 应用命令到画布
+    virtual void Revert(RasterCanvas* canvas) = 0;  // 撤销命令
+    // 编译为显示列表（模型坐标的展平轮廓 + 混合方式）：首次调用时构建并缓存，之后只读，
+    // 重放时各行条带在不同线程上并发光栅化同一列表。必须在单线程中调用；nullptr 表示不支持，回退到 Apply
+    virtual const DisplayList* Compile() { return nullptr; }
     virtual Action ToAction() const = 0;  // 转换为Action（用于序列化）
+    virtual size_t EstimateRasterCost() const { return 1; }  // 估算重放代价（用于历史检查点间隔）
+    virtual void ApplyToGeometry(PaperGeometry*) {}  // 更新矢量几何（只有 CUT / CLEAR 改变纸张形状）
+    // 命令可能改变的模型区域；nullptr 表示整张图层（CLEAR）
+    virtual const CommandBounds* GetBounds() const { return nullptr; }
+};
+
+// 以显示列表绘制的命令：Apply 与 mask 重放都使用同一份只编译一次的几何
+class DisplayListCommand : public ICommand {
+public:
+    void Apply(RasterCanvas* canvas) override;
+    void Revert(RasterCanvas* canvas) override;
+    const DisplayList* Compile() override;
+    
+protected:
+    virtual void BuildDisplayList(DisplayList* list) = 0;
+    
+private:
+    DisplayList displayList_;
+    bool compiled_ = false;
 };
 
 // 裁剪命令
-class CutCommand : public ICommand {
+class CutCommand : public DisplayListCommand {
 private:
     std::vector<Point> points_;
     std::string id_;
+    CommandBounds bounds_;
+    
+protected:
+    // 剪刀多边形，按覆盖率清除（同时作用于纸张与其上的草稿）
+    void BuildDisplayList(DisplayList* list) override;
     
 public:
     CutCommand(const std::vector<Point>& points);
-    void Apply(OH_Drawing_Canvas* canvas) override;
-    void Revert(OH_Drawing_Canvas* canvas) override;
+    bool AffectsLayer(CommandLayer) const override { return true; }  // 镂空同时带走其上的草稿
     Action ToAction() const override;
+    size_t EstimateRasterCost() const override { return points_.size(); }
+    void ApplyToGeometry(PaperGeometry* geometry) override { geometry->AddCut(points_); }
+    const CommandBounds* GetBounds() const override { return &bounds_; }
 };
 
 // 铅笔命令
-class PencilCommand : public ICommand {
+class PencilCommand : public DisplayListCommand {
 private:
     std::vector<Point> points_;
     std::string id_;
+    StrokeTessellator stroke_;  // 绘制过程中增量展开的描边网格，编译后释放
+    CommandBounds bounds_;
+    
+protected:
+    // 描边网格的各个分片，按覆盖率叠加
+    void BuildDisplayList(DisplayList* list) override;
     
 public:
     PencilCommand(const std::vector<Point>& points);
-    void Apply(OH_Drawing_Canvas* canvas) override;
-    void Revert(OH_Drawing_Canvas* canvas) override;
+    // 接管绘制过程中增量展开的网格（与 points 不一致时首次使用会重新展开）
+    PencilCommand(const std::vector<Point>& points, StrokeTessellator stroke);
+    bool AffectsLayer(CommandLayer layer) const override { return layer == CommandLayer::DRAFT; }
     Action ToAction() const override;
+    size_t EstimateRasterCost() const override { return points_.size(); }
+    const CommandBounds* GetBounds() const override { return &bounds_; }
 };
 
 // 橡皮命令
-class EraserCommand : public ICommand {
+class EraserCommand : public DisplayListCommand {
 private:
     std::vector<Point> points_;
     std::string id_;
-    uint32_t backgroundColor_ = 0xFFC4161C;
+    StrokeTessellator stroke_;  // 绘制过程中增量展开的描边网格，编译后释放
+    CommandBounds bounds_;
+    
+protected:
+    // 描边网格的各个分片，按覆盖率清除
+    void BuildDisplayList(DisplayList* list) override;
     
 public:
-    EraserCommand(const std::vector<Point>& points, uint32_t backgroundColor);
-    void Apply(OH_Drawing_Canvas* canvas) override;
-    void Revert(OH_Drawing_Canvas* canvas) override;
+    EraserCommand(const std::vector<Point>& points);
+    // 接管绘制过程中增量展开的网格（与 points 不一致时首次使用会重新展开）
+    EraserCommand(const std::vector<Point>& points, StrokeTessellator stroke);
+    bool AffectsLayer(CommandLayer layer) const override { return layer == CommandLayer::DRAFT; }
     Action ToAction() const override;
+    size_t EstimateRasterCost() const override { return points_.size(); }
+    const CommandBounds* GetBounds() const override { return &bounds_; }
 };
 
 // 清空命令
@@ -127,9 +159,11 @@ private:
     
 public:
     ClearCommand();
-    void Apply(OH_Drawing_Canvas* canvas) override;
-    void Revert(OH_Drawing_Canvas* canvas) override;
+    bool AffectsLayer(CommandLayer) const override { return true; }
+    void Apply(RasterCanvas* canvas) override;
+    void Revert(RasterCanvas* canvas) override;
     Action ToAction() const override;
+    void ApplyToGeometry(PaperGeometry* geometry) override { geometry->Clear(); }
     void SetPreviousCommands(std::vector<std::unique_ptr<ICommand>> commands);
 };
 
@@ -146,16 +180,23 @@ struct DrawState {
 // 剪纸绘制引擎类
 class PaperCutEngine {
 public:
-    PaperCutEngine();
+    PaperCutEngine();  // 设备默认：native_drawing 后端
+    explicit PaperCutEngine(std::unique_ptr<RasterBackend> backend);
     ~PaperCutEngine();
     
     // 初始化画布
     bool Initialize(OHNativeWindow* window, int width, int height);
+    bool InitializeHeadless(int width, int height);  // 无窗口初始化（离屏渲染缩略图）
     void SetPreviewWindow(OHNativeWindow* window);  // 设置预览窗口
     
     // 绘制主函数
     void Render();  // 渲染主画布（InputCanvas + OffscreenCanvas合成）
     void RenderPreview();  // 渲染预览画布（PreviewCanvas）
+    // 与后端无关的帧绘制：Render/RenderPreview 把 NativeWindow buffer 包装成画布后调用
+    void RenderTo(RasterCanvas* canvas);
+    void RenderPreviewTo(RasterCanvas* canvas);
+    // 把展开预览渲染到 RGBA_8888 预乘像素（透明底），不需要窗口
+    bool RenderPreviewToPixels(int width, int height, std::vector<uint32_t>* pixels);
     
     // 标记层需要更新
     void MarkInputDirty() { inputDirty_ = true; }
@@ -169,16 +210,27 @@ public:
     void SetFoldMode(FoldMode mode);
     FoldMode GetFoldMode() const { return foldMode_; }
     
+    // 预览展开方式
+    void SetPreviewUnfoldMode(PreviewUnfoldMode mode) { previewUnfoldMode_ = mode; }
+    PreviewUnfoldMode GetPreviewUnfoldMode() const { return previewUnfoldMode_; }
+    
     // 纸张设置
     void SetPaperType(PaperType type);
+    PaperType GetPaperType() const { return paperType_; }
     void SetPaperColor(uint32_t color);
     uint32_t GetPaperColor() const { return paperColor_; }
+    void SetBackgroundColor(uint32_t color);  // 编辑/预览画布背景色（合成时使用，无需重放）
+    uint32_t GetBackgroundColor() const { return backgroundColor_; }
     
     // 绘制操作
     void StartDrawing(float x, float y);
     void AddPoint(float x, float y);
+    // 批量追加：xy 为交错的 x/y 样本（共 count 个点），可包含历史/合并样本；
+    // screenSpace 为 true 时先经 ScreenToModel 转换。扇形过滤与 10px 抽稀逐点生效，只标记一次脏
+    void AddPoints(const float* xy, size_t count, bool screenSpace);
     void FinishDrawing();
     void CancelDrawing();
+    bool IsDrawing() const { return isDrawing_; }
     
     // 贝塞尔曲线操作
     void AddBezierPoint(float x, float y);
@@ -191,6 +243,14 @@ public:
     void Redo();
     void Clear();
     
+    // 历史定位：index 为已应用的命令数量，范围 [0, GetHistoryLength()]
+    void SeekHistory(size_t index);
+    size_t GetHistoryLength() const { return commandHistory_.size() + redoStack_.size(); }
+    size_t GetHistoryIndex() const { return commandHistory_.size(); }
+    // 当前保留的历史检查点（各自的命令数，升序）与其 mask 快照占用的字节数
+    std::vector<size_t> GetCheckpointCounts() const;
+    size_t GetCheckpointBytes() const;
+    
     // 变换操作
     void SetZoom(float zoom);
     void SetPan(float x, float y);
@@ -202,7 +262,8 @@ public:
     std::vector<Action> GetActions() const;  // 从命令历史生成Action列表
     void SetActions(const std::vector<Action>& actions);  // 从Action列表重建命令历史
     
-    // 坐标转换
+    // 坐标转换：屏幕坐标为编辑器 surface 的像素坐标（左上角原点），与 ApplyViewTransform 严格互逆
+    void SetViewportSize(int width, int height);
     Point ScreenToModel(float x, float y) const;
     Point ModelToScreen(float x, float y) const;
     
@@ -210,28 +271,78 @@ public:
     int GetCanvasWidth() const { return canvasWidth_; }
     int GetCanvasHeight() const { return canvasHeight_; }
     
+    // 数据层 mask（A8，canvasWidth x canvasHeight），测试/导出直接读取像素
+    const RasterBitmap* GetCutMask() const { return cutMaskBitmap_.get(); }
+    const RasterBitmap* GetDraftMask() const { return draftBitmap_.get(); }
+    RasterBackend* GetBackend() const { return backend_.get(); }
+    
+    // 矢量几何（纸张轮廓 - 剪刀路径并集），先同步到当前历史：新命令逐条合并，后退/重建历史后从最后一次清空重算
+    PaperGeometry& GetPaperGeometry();
+    // 把展开后的完整图案（纸张颜色填充、透明底）以 SVG 流式写入 fd（调用方负责打开/关闭）；
+    // width / height 为文档像素尺寸，<= 0 时取模型像素尺寸。矢量输出，任意分辨率下边缘都精确
+    bool ExportSvg(int fd, int width, int height);
+    // 同一展开图案的高分辨率 PNG（如 16384²），取景与 ExportSvg 相同；从矢量几何分块并行光栅化并流式写入 fd，
+    // 不经过固定 2048 的离屏图层，内存只有几条 tile 带
+    bool ExportPng(int fd, int width, int height);
+    // ExportPng 的前半段：只快照展开轮廓（输出像素坐标）与颜色，之后的 TiledPngExport::Write 不再访问引擎，
+    // NAPI 在引擎锁内调用它，再把耗时的光栅化/编码放到工作线程
+    bool PrepareExportPng(int width, int height, TiledPngExport::Image* image);
+    // 导出尺寸检查：不依赖引擎状态，调用方应在加锁与快照轮廓之前先行拒绝（<= 0 表示按内容取默认尺寸）
+    static bool IsValidExportSize(int width, int height);
+    
 private:
+    // 展开轮廓与导出取景：以中心为原点的正方形，半边长返回到 extent（至少包含整张纸）
+    void GetExportContours(std::vector<RasterPath::Contour>* contours, float* extent);
     // 3层画布架构（按照refactor.md重构）
     void InitializeLayers(int width, int height);
     void DestroyLayers();
     
-    // ① InputCanvas - 交互层（只处理输入和临时绘制）
-    void RenderInputCanvas(OH_Drawing_Canvas* canvas);
-    
     // ② OffscreenCanvas - 数据层（存储真实数据，通过命令应用）
     void RenderOffscreenCanvas();  // 重新渲染整个OffscreenCanvas（从所有命令）
+    void DrawOffscreenBase();  // 清空并绘制纸张底色
+    void BeginOffscreenModelSpace();  // 进入模型坐标系 + 纸张裁剪
+    void EndOffscreenModelSpace();
+    void ApplyCommandToLayers(ICommand* cmd);  // 按 AffectsLayer 把命令应用到裁剪/草稿 mask
+    // 按顺序应用一组命令：mask 可直接写像素时按行条带并行（条带内按命令顺序），否则逐条经画布；
+    // region 不为空时只改写其中的像素
+    void ApplyCommandsToLayers(ICommand* const* cmds, size_t count, const RasterIRect* region = nullptr);
+    RasterMatrix LayerModelMatrix() const;  // 模型坐标 -> mask 像素（与 BeginOffscreenModelSpace 一致）
+    void ApplyCommandIncremental(ICommand* cmd);  // 只把单个命令叠加到现有图层
     void ApplyCommandToOffscreenCanvas(std::unique_ptr<ICommand> cmd);
-    void RevertCommandFromOffscreenCanvas();
+    // 把 OffscreenCanvas 重建到“前 count 个命令”的状态：
+    // 从最近的检查点/ClearCommand/当前有效状态（validCount）中选代价最小的起点开始重放
+    void RebuildOffscreenTo(size_t count, size_t validCount);
+    // 重放起点：最后一次 ClearCommand 之后与最近检查点中较近的一个，返回检查点（从纸张底色开始时为 nullptr）
+    struct HistoryCheckpoint;
+    const HistoryCheckpoint* FindReplayOrigin(size_t count, size_t* start) const;
+    
+    // 撤销的脏区域重建：只恢复 region 内的像素（检查点/底色），再重放与 region 相交的命令
+    RasterIRect CommandMaskRect(const ICommand* cmd) const;  // 命令包围盒 -> mask 像素（不可界定时为整张 mask）
+    bool ComputeDirtyRegion(size_t begin, size_t end, RasterIRect* region) const;  // 历史 [begin, end) 的并集
+    void SyncCommandGrid();  // 网格索引补齐到当前历史
+    bool RebuildOffscreenRegion(size_t count, const RasterIRect& region);  // 不支持时返回 false，需全量重建
+    
+    // 历史检查点（OffscreenCanvas 像素快照）
+    void MaybeCaptureCheckpoint(size_t count);
+    bool ShouldCaptureCheckpoint(size_t count) const;  // 只依赖命令数/代价/预算，与图层内容无关
+    void ThinCheckpoints();
+    size_t MaxCheckpoints() const;
+    size_t CheckpointMergeGap(size_t i) const;
+    void DropCheckpointsAfter(size_t count);
     
     // ③ PreviewCanvas - 展示层（只渲染预览，应用旋转/镜像/对称展开）
-    void RenderPreviewCanvas(OH_Drawing_Canvas* canvas);
-    
-    // 旧版兼容函数
-    void RenderOutputCanvas(OH_Drawing_Canvas* canvas);
-    void DrawActions(OH_Drawing_Canvas* canvas);
+    void RenderPreviewCanvas(RasterCanvas* canvas);
+    // 单扇形 tile（预览像素尺度）：纸张 + 已提交的 CUT，只在 key 变化时重建
+    RasterBitmap* UpdatePreviewTile(float scale);
+    RasterBitmap* UpdateLivePreviewTile(float scale);  // tile + 实时剪刀路径
+    void ComputePreviewTileBounds(float scale, int* left, int* top, int* right, int* bottom) const;
+    void UnfoldPreviewByLut(RasterCanvas* canvas, RasterBitmap* tile, int width, int height);
+    // 几何展开：不经过 tile 与画布裁剪，覆盖率直接由展开后的轮廓光栅化得到
+    void RenderPreviewGeometry(RasterCanvas* canvas, int width, int height, float scale);
+    void DestroyPreviewTile();
     
     // 合成层（用于主渲染）
-    void CompositeLayers(OH_Drawing_Canvas* targetCanvas);  // 合成InputCanvas + OffscreenCanvas到目标画布
+    void CompositeLayers(RasterCanvas* targetCanvas);  // 合成InputCanvas + OffscreenCanvas到目标画布
     
     // 输入约束：判定点是否在当前扇形(sector)范围内（用于 InputCanvas 数据约束）
     bool IsPointInSector(float x, float y) const;
@@ -240,20 +351,15 @@ private:
     // 将“逻辑画布(2048)”坐标映射到当前渲染目标(buffer)尺寸：
     // - centerX/centerY 以目标 canvas 像素为基准（通常为 width/2,height/2）
     // - renderScale = min(dstW,dstH) / min(canvasWidth_,canvasHeight_)
-    void ApplyViewTransform(OH_Drawing_Canvas* canvas, float centerX, float centerY, float renderScale);
+    void ApplyViewTransform(RasterCanvas* canvas, float centerX, float centerY, float renderScale);
+    float ViewRotation() const;  // 视图总旋转角（弧度）
     
     // 绘制辅助函数
-    void DrawPaperBase(OH_Drawing_Canvas* canvas);
-    void DrawFoldLines(OH_Drawing_Canvas* canvas);
-    
-    // 绘制扇形路径（用于裁剪）
-    OH_Drawing_Path* CreateSectorPath(float centerX, float centerY, float radius, bool isFullPaper, float sectorAngle);
+    void DrawFoldLines(RasterCanvas* canvas);
     
 public:
     // 路径绘制（用于命令，需要public以便命令类访问）
-    static void DrawPath(OH_Drawing_Canvas* canvas, const std::vector<Point>& points, bool closePath);
-    static void DrawPencilStroke(OH_Drawing_Canvas* canvas, const std::vector<Point>& points);
-    static void ErasePencilStroke(OH_Drawing_Canvas* canvas, const std::vector<Point>& points, uint32_t backgroundColor);
+    static void DrawPencilStroke(RasterCanvas* canvas, StrokeTessellator& stroke);
 
 private:
     
@@ -262,24 +368,63 @@ private:
     std::vector<Point> CalculateSplinePoints(const std::vector<Point>& points, bool closed) const;
     
     // 画布管理
+    std::unique_ptr<RasterBackend> backend_;  // 所有离屏位图/画布都由它创建
     OHNativeWindow* nativeWindow_;
     OHNativeWindow* previewWindow_;  // 预览窗口
     int canvasWidth_;
     int canvasHeight_;
+    int viewportWidth_;   // 编辑器 surface 尺寸（0 表示未知，按逻辑画布尺寸处理）
+    int viewportHeight_;
     
     // 3层画布架构（按照refactor.md）
-    // ① InputCanvas - 交互层（临时绘制）
-    OH_Drawing_Bitmap* inputBitmap_;           // InputCanvas bitmap
-    OH_Drawing_Canvas* inputCanvas_;           // InputCanvas canvas
+    // ① InputCanvas - 交互层（临时绘制，合成时直接画到目标画布）
     bool inputDirty_;                          // InputCanvas是否需要重绘
     
-    // ② OffscreenCanvas - 数据层（真实数据存储）
-    OH_Drawing_Bitmap* offscreenBitmap_;       // OffscreenCanvas bitmap（数据真相层）
-    OH_Drawing_Canvas* offscreenCanvas_;       // OffscreenCanvas canvas
+    // ② OffscreenCanvas - 数据层（真实数据存储，A8 覆盖率，颜色在合成时着色）
+    std::unique_ptr<RasterBitmap> cutMaskBitmap_;  // 裁剪 mask：纸张存在 = 255（数据真相层）
+    std::unique_ptr<RasterCanvas> cutMaskCanvas_;
+    std::unique_ptr<RasterBitmap> draftBitmap_;    // 草稿 mask：铅笔笔迹覆盖率
+    std::unique_ptr<RasterCanvas> draftCanvas_;
     bool offscreenDirty_;                      // OffscreenCanvas是否需要重绘
     
     // ③ PreviewCanvas - 展示层（预览渲染，在RenderPreview时使用）
-    // 注意：PreviewCanvas不需要离屏bitmap，它直接从OffscreenCanvas读取并应用变换
+    // 只缓存一个扇形 tile，完整预览由 tile 旋转/镜像盖印 2N 次得到
+    struct PreviewTileKey {
+        uint64_t historyVersion = 0;
+        FoldMode foldMode = FoldMode::ZERO;
+        PaperType paperType = PaperType::CIRCLE;
+        uint32_t paperColor = 0;
+        float scale = 0.0f;
+        int left = 0;  // tile 左上角在预览像素坐标（中心原点）中的位置
+        int top = 0;
+        int width = 0;  // 几何展开的预览尺寸（tile 不使用，保持 0）
+        int height = 0;
+        
+        bool operator==(const PreviewTileKey& other) const
+        {
+            return historyVersion == other.historyVersion && foldMode == other.foldMode &&
+                   paperType == other.paperType && paperColor == other.paperColor &&
+                   scale == other.scale && left == other.left && top == other.top &&
+                   width == other.width && height == other.height;
+        }
+    };
+    std::unique_ptr<RasterBitmap> previewTileBitmap_;  // 缓存的扇形 tile
+    std::unique_ptr<RasterCanvas> previewTileCanvas_;
+    std::unique_ptr<RasterBitmap> previewLiveBitmap_;  // tile + 实时剪刀路径（绘制中使用）
+    std::unique_ptr<RasterCanvas> previewLiveCanvas_;
+    RasterPath liveCutPath_;  // 实时剪刀路径（每帧重建）
+    PreviewTileKey previewTileKey_;
+    bool previewTileValid_;
+    PreviewUnfoldMode previewUnfoldMode_;
+    PolarUnfoldLut previewLut_;                // 按 (折数, 预览尺寸, tile 范围) 缓存
+    std::unique_ptr<RasterBitmap> previewUnfoldBitmap_;  // LUT 展开结果
+    // 几何展开：已提交历史的覆盖率（A8，按 key 缓存）与叠加实时剪刀路径后的副本
+    SymmetryExpander previewExpander_;
+    std::vector<RasterPath::Contour> previewContours_;
+    std::unique_ptr<RasterBitmap> previewCoverageBitmap_;
+    std::unique_ptr<RasterBitmap> previewLiveCoverageBitmap_;
+    PreviewTileKey previewGeometryKey_;
+    bool previewGeometryValid_;
     
     bool layersInitialized_;                   // 层是否已初始化
     
@@ -288,19 +433,32 @@ private:
     FoldMode foldMode_;
     PaperType paperType_;
     uint32_t paperColor_;
+    uint32_t backgroundColor_;
     DrawState drawState_;
     
     // 命令历史（使用命令模式）
     std::vector<std::unique_ptr<ICommand>> commandHistory_;  // 已应用的命令
     std::vector<std::unique_ptr<ICommand>> redoStack_;       // 可重做的命令
     
-    // 动作列表（兼容旧接口，从命令生成）
-    std::vector<Action> actions_;
-    std::vector<Action> actionRedoStack_;  // Action类型的重做栈（兼容旧代码）
+    // 历史检查点：commandCount 个命令应用后的两张 mask，按 commandCount 升序
+    struct HistoryCheckpoint {
+        size_t commandCount;
+        std::vector<uint8_t> cutMask;
+        std::vector<uint8_t> draft;
+    };
+    std::vector<HistoryCheckpoint> checkpoints_;
+    // 命令包围盒（mask 像素）的均匀网格，编号即历史下标；撤销时截断，重建脏区域前补齐
+    UniformGrid commandGrid_;
+    uint64_t historyVersion_;  // 命令历史每次变化递增（预览 tile 等缓存的失效依据）
+    
+    // 矢量几何：对应 commandHistory_ 的前 geometryCount_ 个命令（SIZE_MAX 表示需要重算）
+    PaperGeometry geometry_;
+    size_t geometryCount_;
     
     // 当前绘制
     bool isDrawing_;
     std::vector<Point> currentPoints_;
+    StrokeTessellator liveStroke_;  // 当前草稿笔迹的增量展开，抬笔时交给命令
     
     // 贝塞尔曲线
     std::vector<Point> bezierPoints_;
@@ -316,6 +474,16 @@ private:
     static constexpr float VIEW_SCALE = 1.2f;
     // Web 版为了构图把画布整体下移；本项目需求是“默认居中展示”，因此设为 0
     static constexpr float VIEW_OFFSET_Y_RATIO = 0.0f;
+    // 检查点间隔：命令数或估算代价（点数）任一达到即打快照；总内存受预算限制
+    // （每个检查点为裁剪 + 草稿两张 2048² A8 mask，各 4MB 共 8MB，96MB 预算最多 12 个）
+    static constexpr size_t CHECKPOINT_COMMAND_INTERVAL = 32;
+    static constexpr size_t CHECKPOINT_COST_INTERVAL = 4096;
+    static constexpr size_t CHECKPOINT_MEMORY_BUDGET = 96 * 1024 * 1024;
+    static constexpr int COMMAND_GRID_CELL_SIZE = 128;  // 2048² mask 为 16x16 个格子
+    // 重放按行条带并行：每条带对段内所有命令各做一次顶点变换/边建立，条带数只取负载均衡所需
+    // （每线程若干条），且条带不低于最小高度
+    static constexpr int REPLAY_BANDS_PER_THREAD = 4;
+    static constexpr int REPLAY_MIN_BAND_HEIGHT = 64;
 };
 
 #endif // PAPERCUTTING_PAPER_CUT_ENGINE_H
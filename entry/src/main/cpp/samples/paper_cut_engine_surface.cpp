@@ -0,0 +1,53 @@
+//
+// Created on 2026/10/17.
+// 剪纸绘制引擎的设备相关部分：native_drawing 默认后端与 NativeWindow 上屏
+//
+
+#include "paper_cut_engine.h"
+#include <hilog/log.h>
+#include "utils/native_window_frame.h"
+#include "utils/raster_backend_drawing.h"
+
+#define LOGE(...) ((void)OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, "PaperCutEngine", __VA_ARGS__))
+
+PaperCutEngine::PaperCutEngine() : PaperCutEngine(std::make_unique<DrawingRasterBackend>()) {}
+
+void PaperCutEngine::Render()
+{
+    if (!nativeWindow_) {
+        LOGE("NativeWindow not initialized");
+        return;
+    }
+
+    // 零拷贝上屏：canvas 直接绑定到 mmap 后的 buffer 内存
+    NativeWindowFrame frame(nativeWindow_);
+    // 开启 PREMUL 以便抗锯齿边缘能正确用 alpha 混合到背景
+    if (!frame.Begin(ALPHA_FORMAT_PREMUL)) {
+        LOGE("Failed to begin frame");
+        return;
+    }
+    DrawingRasterCanvas canvas(frame.GetCanvas());
+    RenderTo(&canvas);
+
+    // 提交Buffer
+    frame.Flush();
+}
+
+void PaperCutEngine::RenderPreview()
+{
+    if (!previewWindow_) {
+        LOGE("PreviewWindow not initialized");
+        return;
+    }
+
+    NativeWindowFrame frame(previewWindow_);
+    if (!frame.Begin(ALPHA_FORMAT_PREMUL)) {
+        LOGE("Failed to begin preview frame");
+        return;
+    }
+    DrawingRasterCanvas canvas(frame.GetCanvas());
+    RenderPreviewTo(&canvas);
+
+    // 提交Buffer
+    frame.Flush();
+}
@@ -0,0 +1,172 @@
+//
+// Created on 2026/10/17.
+// 剪纸矢量几何实现
+//
+
+#include "paper_cut_geometry.h"
+#include <algorithm>
+#include <cmath>
+#include "paper_cut_unfold.h"
+#include "utils/polygon_boolean.h"
+
+namespace {
+constexpr float PAPER_FLATTEN_TOLERANCE = 0.02f;  // 圆形纸张展平弦高（模型像素），远小于 mask 的一个像素
+constexpr double FOLD_START_ANGLE = -M_PI / 2.0;  // 第一个扇形从正上方开始（与预览展开一致）
+constexpr double WEDGE_ARC_STEP = M_PI / 4.0;     // 扇形多边形外侧折线每段的最大转角
+
+// 第一个扇形：外侧用外切折线代替圆弧，半径 reach 以内与真扇形完全一致
+RasterPath::Contour CreateWedgeContour(double sweep, double reach)
+{
+    const int steps = std::max(1, static_cast<int>(std::ceil(sweep / WEDGE_ARC_STEP)));
+    const double radius = reach / std::cos(sweep / (2.0 * steps));
+    RasterPath::Contour wedge;
+    wedge.closed = true;
+    wedge.points.push_back({0.0f, 0.0f});
+    for (int k = 0; k <= steps; k++) {
+        const double angle = FOLD_START_ANGLE + sweep * k / steps;
+        wedge.points.push_back({static_cast<float>(std::cos(angle) * radius),
+                                static_cast<float>(std::sin(angle) * radius)});
+    }
+    return wedge;
+}
+
+struct Bounds {
+    float left = INFINITY;
+    float top = INFINITY;
+    float right = -INFINITY;
+    float bottom = -INFINITY;
+
+    void Add(float x, float y)
+    {
+        left = std::min(left, x);
+        top = std::min(top, y);
+        right = std::max(right, x);
+        bottom = std::max(bottom, y);
+    }
+    bool Intersects(const Bounds& other) const
+    {
+        return left <= other.right && other.left <= right && top <= other.bottom && other.top <= bottom;
+    }
+};
+
+Bounds ContourBounds(const RasterPath::Contour& contour)
+{
+    Bounds bounds;
+    for (const RasterPoint& p : contour.points) {
+        bounds.Add(p.x, p.y);
+    }
+    return bounds;
+}
+} // namespace
+
+void PaperGeometry::SetPaper(PaperType type, float radius)
+{
+    if (type == paperType_ && radius == paperRadius_) {
+        return;
+    }
+    paperType_ = type;
+    paperRadius_ = radius;
+    paperValid_ = false;
+}
+
+void PaperGeometry::Clear()
+{
+    cutUnion_.clear();
+    cutCount_ = 0;
+    paperValid_ = false;
+}
+
+void PaperGeometry::AddCut(const std::vector<Point>& points)
+{
+    if (points.size() < 3) {
+        return;
+    }
+    std::vector<RasterPath::Contour> cut(1);
+    cut[0].closed = true;
+    cut[0].points.reserve(points.size());
+    Bounds cutBounds;
+    for (const Point& p : points) {
+        cut[0].points.push_back({p.x, p.y});
+        cutBounds.Add(p.x, p.y);
+    }
+    cutCount_++;
+    paperValid_ = false;
+
+    // 包围盒与新路径不相交的轮廓不会被改变（孔也一样：路径碰不到它就仍在并集之外），原样保留
+    std::vector<RasterPath::Contour> touched;
+    std::vector<RasterPath::Contour> kept;
+    for (auto& contour : cutUnion_) {
+        (ContourBounds(contour).Intersects(cutBounds) ? touched : kept).push_back(std::move(contour));
+    }
+    PolygonBoolean::Compute(touched, RasterFillRule::NON_ZERO, cut, RasterFillRule::NON_ZERO, BooleanOp::UNION,
+                            &cutUnion_);
+    for (auto& contour : kept) {
+        cutUnion_.push_back(std::move(contour));
+    }
+}
+
+void PaperGeometry::UpdatePaper()
+{
+    if (paperValid_) {
+        return;
+    }
+    paperValid_ = true;
+    RasterPath paper;
+    if (paperType_ == PaperType::CIRCLE) {
+        paper.AddCircle(0, 0, paperRadius_);
+    } else {
+        paper.AddRect(-paperRadius_, -paperRadius_, paperRadius_, paperRadius_);
+    }
+    std::vector<RasterPath::Contour> outline;
+    paper.Flatten(RasterMatrix(), PAPER_FLATTEN_TOLERANCE, &outline);
+    PolygonBoolean::Compute(outline, RasterFillRule::NON_ZERO, cutUnion_, RasterFillRule::NON_ZERO,
+                            BooleanOp::DIFFERENCE, &paperContours_);
+    area_ = PolygonBoolean::Area(paperContours_);
+    perimeter_ = PolygonBoolean::Perimeter(paperContours_);
+}
+
+const std::vector<RasterPath::Contour>& PaperGeometry::GetPaperContours()
+{
+    UpdatePaper();
+    return paperContours_;
+}
+
+void PaperGeometry::GetUnfoldedContours(FoldMode mode, std::vector<RasterPath::Contour>* out)
+{
+    if (!out) {
+        return;
+    }
+    out->clear();
+    UpdatePaper();
+    const int foldCount = static_cast<int>(mode);
+    if (foldCount <= 0) {
+        *out = paperContours_;
+        return;
+    }
+    const int totalSegments = foldCount * 2;
+    const double sweep = 2.0 * M_PI / totalSegments;
+    // 方形纸张角点距离为 r * sqrt(2)，略放大保证纸张完全落在扇形多边形的弧线以内
+    const double reach = paperRadius_ * M_SQRT2 * 1.01 + 1.0;
+    const std::vector<RasterPath::Contour> wedge(1, CreateWedgeContour(sweep, reach));
+    std::vector<RasterPath::Contour> tile;
+    PolygonBoolean::Compute(paperContours_, RasterFillRule::NON_ZERO, wedge, RasterFillRule::NON_ZERO,
+                            BooleanOp::INTERSECTION, &tile);
+
+    // 扇形内的图案按预览相同的 2N 段旋转/镜像复制（镜像段已反转顶点顺序，外轮廓保持正向）
+    SymmetryExpander expander;
+    expander.Configure(foldCount, RasterMatrix());
+    out->reserve(tile.size() * expander.GetSegmentCount());
+    expander.Replicate(tile, out);
+}
+
+double PaperGeometry::GetArea()
+{
+    UpdatePaper();
+    return area_;
+}
+
+double PaperGeometry::GetPerimeter()
+{
+    UpdatePaper();
+    return perimeter_;
+}
@@ -0,0 +1,52 @@
+//
+// Created on 2026/10/17.
+// 剪纸矢量几何：纸张轮廓减去最后一次清空以来所有剪刀路径的并集（模型坐标，中心原点）
+//
+// 与 A8 mask 并行维护的分辨率无关表示：剪刀路径的并集随每条 CUT 增量合并（只有包围盒与新路径
+// 相交的轮廓参与布尔运算），剩余纸张在查询时按当前纸张形状做一次差集并缓存。
+// 缓存大小只与轮廓顶点数有关，不随光栅尺寸增长；面积、周长是精确的多边形量。
+// 展开时剩余纸张与第一个扇形精确求交，再按预览相同的 2N 段旋转/镜像复制，用于矢量导出。
+//
+
+#ifndef PAPERCUTTING_PAPER_CUT_GEOMETRY_H
+#define PAPERCUTTING_PAPER_CUT_GEOMETRY_H
+
+#include <cstddef>
+#include <vector>
+#include "paper_cut_types.h"
+#include "utils/raster_backend.h"
+
+class PaperGeometry {
+public:
+    // 纸张形状（与合成时的纸张裁剪一致）；变化时只使缓存的剩余纸张失效
+    void SetPaper(PaperType type, float radius);
+    // 回到未剪状态
+    void Clear();
+    // 并入一条剪刀路径：闭合折线，非零规则（与 CutCommand 光栅化一致）
+    void AddCut(const std::vector<Point>& points);
+
+    size_t GetCutCount() const { return cutCount_; }
+    // 剪刀路径并集（外轮廓正向、孔反向）
+    const std::vector<RasterPath::Contour>& GetCutUnion() const { return cutUnion_; }
+    // 剩余纸张 = 纸张轮廓 - 剪刀路径并集（外轮廓正向、孔反向）
+    const std::vector<RasterPath::Contour>& GetPaperContours();
+    double GetArea();       // 剩余纸张面积（模型像素²）
+    double GetPerimeter();  // 剩余纸张全部边界长度（含镂空孔）
+    // 展开后的完整图案：偶数段旋转、奇数段沿扇形边界镜像（与 RenderPreviewCanvas 一致），
+    // 所有轮廓保持外轮廓正向、孔反向；ZERO 折时即剩余纸张本身
+    void GetUnfoldedContours(FoldMode mode, std::vector<RasterPath::Contour>* out);
+
+private:
+    void UpdatePaper();
+
+    PaperType paperType_ = PaperType::CIRCLE;
+    float paperRadius_ = 0.0f;
+    std::vector<RasterPath::Contour> cutUnion_;
+    size_t cutCount_ = 0;
+    std::vector<RasterPath::Contour> paperContours_;  // 缓存的剩余纸张
+    double area_ = 0.0;
+    double perimeter_ = 0.0;
+    bool paperValid_ = false;
+};
+
+#endif // PAPERCUTTING_PAPER_CUT_GEOMETRY_H
@@ -0,0 +1,423 @@
+//
+// Created on 2026/10/17.
+// 作品库实现
+//
+
+#include "paper_cut_library.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+constexpr const char* INDEX_FILE = "index.tsv";
+constexpr const char* INDEX_HEADER = "PCLIB\t1";
+constexpr const char* WORKS_DIR = "works";
+constexpr const char* THUMBS_DIR = "thumbs";
+constexpr const char* THUMB_EXT = ".png";
+constexpr const char* FILE_URI_PREFIX = "file://";
+constexpr const char* WORK_EXT = ".pcw";
+constexpr const char* TMP_EXT = ".tmp";
+constexpr size_t INDEX_FIELDS = 7;
+
+bool EnsureDir(const std::string& path)
+{
+    if (mkdir(path.c_str(), 0755) == 0 || errno == EEXIST) {
+        struct stat st;
+        return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+    }
+    return false;
+}
+
+bool EndsWith(const std::string& s, const char* suffix)
+{
+    const size_t n = std::char_traits<char>::length(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+void RemoveTempFiles(const std::string& dirPath)
+{
+    DIR* dir = opendir(dirPath.c_str());
+    if (!dir) {
+        return;
+    }
+    while (dirent* entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (EndsWith(name, TMP_EXT)) {
+            unlink((dirPath + "/" + name).c_str());
+        }
+    }
+    closedir(dir);
+}
+
+// 先写同目录下的临时文件并 fsync，再 rename 覆盖目标（同一文件系统内原子）
+bool WriteFileAtomic(const std::string& path, const uint8_t* data, size_t size)
+{
+    const std::string tmp = path + TMP_EXT;
+    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < size) {
+        ssize_t n = write(fd, data + written, size - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            close(fd);
+            unlink(tmp.c_str());
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    if (fsync(fd) != 0 || close(fd) != 0) {
+        unlink(tmp.c_str());
+        return false;
+    }
+    if (rename(tmp.c_str(), path.c_str()) != 0) {
+        unlink(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ReadFile(const std::string& path, std::vector<uint8_t>* out)
+{
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 0) {
+        close(fd);
+        return false;
+    }
+    std::vector<uint8_t> buf(static_cast<size_t>(st.st_size));
+    size_t done = 0;
+    while (done < buf.size()) {
+        ssize_t n = read(fd, buf.data() + done, buf.size() - done);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        done += static_cast<size_t>(n);
+    }
+    close(fd);
+    if (done != buf.size()) {
+        return false;
+    }
+    *out = std::move(buf);
+    return true;
+}
+
+// 索引字段转义：'\\' '\t' '\n' '\r'
+void AppendEscaped(std::string& out, const std::string& field)
+{
+    for (char c : field) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            default: out += c; break;
+        }
+    }
+}
+
+std::string Unescape(const std::string& field)
+{
+    std::string out;
+    out.reserve(field.size());
+    for (size_t i = 0; i < field.size(); i++) {
+        if (field[i] != '\\' || i + 1 == field.size()) {
+            out += field[i];
+            continue;
+        }
+        const char c = field[++i];
+        out += (c == 't') ? '\t' : (c == 'n') ? '\n' : (c == 'r') ? '\r' : c;
+    }
+    return out;
+}
+
+std::vector<std::string> SplitTabs(const std::string& line)
+{
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        const size_t tab = line.find('\t', start);
+        fields.push_back(line.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+        if (tab == std::string::npos) {
+            return fields;
+        }
+        start = tab + 1;
+    }
+}
+} // namespace
+
+bool WorkLibrary::IsValidId(const std::string& id)
+{
+    if (id.empty() || id.size() > 128 || id[0] == '.') {
+        return false;
+    }
+    return std::all_of(id.begin(), id.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '-' ||
+               c == '.';
+    });
+}
+
+bool WorkLibrary::Open(const std::string& rootDir)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    open_ = false;
+    index_.clear();
+    root_ = rootDir;
+    while (root_.size() > 1 && root_.back() == '/') {
+        root_.pop_back();
+    }
+    if (root_.empty() || !EnsureDir(root_) || !EnsureDir(root_ + "/" + WORKS_DIR) ||
+        !EnsureDir(root_ + "/" + THUMBS_DIR)) {
+        return false;
+    }
+
+    // 清理上次异常退出遗留的临时文件
+    RemoveTempFiles(root_ + "/" + WORKS_DIR);
+    RemoveTempFiles(root_ + "/" + THUMBS_DIR);
+    unlink((root_ + "/" + INDEX_FILE + TMP_EXT).c_str());
+
+    if (!LoadIndex()) {
+        return false;
+    }
+    open_ = true;
+    return true;
+}
+
+bool WorkLibrary::IsOpen() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+std::vector<WorkMeta> WorkLibrary::List() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_;
+}
+
+bool WorkLibrary::Contains(const std::string& id) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return std::any_of(index_.begin(), index_.end(), [&id](const WorkMeta& m) { return m.id == id; });
+}
+
+bool WorkLibrary::Save(const WorkMeta& meta, const uint8_t* data, size_t size)
+{
+    if (!IsValidId(meta.id) || (!data && size > 0)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_ || !WriteFileAtomic(WorkPath(meta.id), data, size)) {
+        return false;
+    }
+    auto it = std::find_if(index_.begin(), index_.end(), [&meta](const WorkMeta& m) { return m.id == meta.id; });
+    std::string oldPreviewImage;
+    if (it != index_.end()) {
+        oldPreviewImage = it->previewImage;
+        *it = meta;
+    } else {
+        index_.push_back(meta);
+    }
+    if (!WriteIndexLocked()) {
+        return false;
+    }
+    if (oldPreviewImage != meta.previewImage) {
+        ReleasePreviewImageLocked(oldPreviewImage);
+    }
+    return true;
+}
+
+bool WorkLibrary::Load(const std::string& id, std::vector<uint8_t>* out) const
+{
+    if (!out || !IsValidId(id)) {
+        return false;
+    }
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_) {
+            return false;
+        }
+        path = WorkPath(id);
+    }
+    // 文件总是整体 rename 替换，读取无需持锁
+    return ReadFile(path, out);
+}
+
+bool WorkLibrary::Remove(const std::string& id)
+{
+    if (!IsValidId(id)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!open_) {
+        return false;
+    }
+    auto it = std::find_if(index_.begin(), index_.end(), [&id](const WorkMeta& m) { return m.id == id; });
+    if (it != index_.end()) {
+        const std::string previewImage = it->previewImage;
+        index_.erase(it);
+        if (!WriteIndexLocked()) {
+            return false;
+        }
+        ReleasePreviewImageLocked(previewImage);
+    }
+    unlink(WorkPath(id).c_str());
+    return true;
+}
+
+bool WorkLibrary::SetPreviewImage(const std::string& id, const std::string& previewImage)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(index_.begin(), index_.end(), [&id](const WorkMeta& m) { return m.id == id; });
+    if (!open_ || it == index_.end()) {
+        return false;
+    }
+    const std::string oldPreviewImage = it->previewImage;
+    it->previewImage = previewImage;
+    if (!WriteIndexLocked()) {
+        return false;
+    }
+    if (oldPreviewImage != previewImage) {
+        ReleasePreviewImageLocked(oldPreviewImage);
+    }
+    return true;
+}
+
+std::string WorkLibrary::ThumbnailUri(const std::string& key) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return FILE_URI_PREFIX + ThumbnailPath(key);
+}
+
+bool WorkLibrary::HasThumbnail(const std::string& key) const
+{
+    if (!IsValidId(key)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_ && access(ThumbnailPath(key).c_str(), F_OK) == 0;
+}
+
+bool WorkLibrary::WriteThumbnail(const std::string& key, const uint8_t* data, size_t size)
+{
+    if (!IsValidId(key) || !data || size == 0) {
+        return false;
+    }
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!open_) {
+            return false;
+        }
+        path = ThumbnailPath(key);
+    }
+    // 内容寻址：同一 key 的内容相同，并发写入谁先 rename 都一样
+    return WriteFileAtomic(path, data, size);
+}
+
+std::string WorkLibrary::WorkPath(const std::string& id) const
+{
+    return root_ + "/" + WORKS_DIR + "/" + id + WORK_EXT;
+}
+
+std::string WorkLibrary::ThumbnailPath(const std::string& key) const
+{
+    return root_ + "/" + THUMBS_DIR + "/" + key + THUMB_EXT;
+}
+
+void WorkLibrary::ReleasePreviewImageLocked(const std::string& previewImage)
+{
+    // 只清理本库生成的缩略图，外部引用（用户图片等）不动
+    const std::string prefix = std::string(FILE_URI_PREFIX) + root_ + "/" + THUMBS_DIR + "/";
+    if (previewImage.compare(0, prefix.size(), prefix) != 0) {
+        return;
+    }
+    const bool stillUsed = std::any_of(index_.begin(), index_.end(),
+                                       [&previewImage](const WorkMeta& m) { return m.previewImage == previewImage; });
+    if (!stillUsed) {
+        unlink(previewImage.c_str() + std::char_traits<char>::length(FILE_URI_PREFIX));
+    }
+}
+
+bool WorkLibrary::LoadIndex()
+{
+    std::vector<uint8_t> bytes;
+    const std::string path = root_ + "/" + INDEX_FILE;
+    if (access(path.c_str(), F_OK) != 0) {
+        return true;  // 新库：空索引
+    }
+    if (!ReadFile(path, &bytes)) {
+        return false;
+    }
+
+    const std::string text(bytes.begin(), bytes.end());
+    size_t start = 0;
+    bool headerSeen = false;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        const std::string line = text.substr(start, end - start);
+        start = end + 1;
+        if (!headerSeen) {
+            if (line != INDEX_HEADER) {
+                return false;
+            }
+            headerSeen = true;
+            continue;
+        }
+        const std::vector<std::string> fields = SplitTabs(line);
+        if (fields.size() < INDEX_FIELDS || !IsValidId(fields[0])) {
+            continue;  // 跳过损坏行，不影响其它作品
+        }
+        WorkMeta meta;
+        meta.id = fields[0];
+        meta.title = Unescape(fields[1]);
+        meta.date = std::strtoll(fields[2].c_str(), nullptr, 10);
+        meta.foldMode = static_cast<int32_t>(std::strtol(fields[3].c_str(), nullptr, 10));
+        meta.paperType = Unescape(fields[4]);
+        meta.paperColor = Unescape(fields[5]);
+        meta.previewImage = Unescape(fields[6]);
+        index_.push_back(std::move(meta));
+    }
+    return true;
+}
+
+bool WorkLibrary::WriteIndexLocked() const
+{
+    std::string text = INDEX_HEADER;
+    text += '\n';
+    for (const auto& meta : index_) {
+        text += meta.id;
+        text += '\t';
+        AppendEscaped(text, meta.title);
+        text += '\t';
+        text += std::to_string(meta.date);
+        text += '\t';
+        text += std::to_string(meta.foldMode);
+        text += '\t';
+        AppendEscaped(text, meta.paperType);
+        text += '\t';
+        AppendEscaped(text, meta.paperColor);
+        text += '\t';
+        AppendEscaped(text, meta.previewImage);
+        text += '\n';
+    }
+    return WriteFileAtomic(root_ + "/" + INDEX_FILE, reinterpret_cast<const uint8_t*>(text.data()), text.size());
+}
@@ -0,0 +1,71 @@
+//
+// Created on 2026/10/17.
+// 作品库：每个作品一个文件 + 小索引，保存/删除只触碰单个作品
+//
+// 纯 C++ 实现（POSIX 文件接口），Linux 上用普通目录即可测试。
+//
+
+#ifndef PAPERCUTTING_PAPER_CUT_LIBRARY_H
+#define PAPERCUTTING_PAPER_CUT_LIBRARY_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 索引项：画廊列表所需的全部信息，不含动作数据
+struct WorkMeta {
+    std::string id;
+    std::string title;
+    int64_t date = 0;
+    int32_t foldMode = 0;
+    std::string paperType;     // 'CIRCLE' / 'SQUARE'
+    std::string paperColor;    // '#RRGGBB'
+    std::string previewImage;  // 缩略图引用（文件路径或 URI），可为空
+};
+
+// 目录结构：
+//   <root>/index.tsv       每行一个作品的 WorkMeta（制表符分隔，字段内转义）
+//   <root>/works/<id>.pcw  作品数据（WorkCodec 格式，由调用方提供）
+//   <root>/thumbs/<key>.png 缩略图缓存（按内容寻址），索引中以 file:// 引用
+// 所有写入先写 .tmp 再 rename，进程中途退出不会留下半个文件。
+// 保存顺序为“数据 -> 索引”，删除顺序为“索引 -> 数据”，索引里的作品总有数据文件。
+class WorkLibrary {
+public:
+    bool Open(const std::string& rootDir);
+    bool IsOpen() const;
+
+    // 只返回索引（按保存顺序），不读取任何作品数据
+    std::vector<WorkMeta> List() const;
+    bool Contains(const std::string& id) const;
+
+    // 写入作品数据并更新索引；id 已存在时覆盖
+    bool Save(const WorkMeta& meta, const uint8_t* data, size_t size);
+    // 按需读取单个作品的数据（打开作品时调用）
+    bool Load(const std::string& id, std::vector<uint8_t>* out) const;
+    bool Remove(const std::string& id);
+    // 只更新索引中的缩略图引用；旧引用指向本库的缩略图且不再被使用时删除该文件
+    bool SetPreviewImage(const std::string& id, const std::string& previewImage);
+
+    // 缩略图缓存：key 为内容哈希，返回 file:// 引用
+    std::string ThumbnailUri(const std::string& key) const;
+    bool HasThumbnail(const std::string& key) const;
+    bool WriteThumbnail(const std::string& key, const uint8_t* data, size_t size);
+
+    // id 直接作为文件名，只允许字母、数字、'_'、'-'、'.'（不能以 '.' 开头）
+    static bool IsValidId(const std::string& id);
+
+private:
+    std::string WorkPath(const std::string& id) const;
+    std::string ThumbnailPath(const std::string& key) const;
+    void ReleasePreviewImageLocked(const std::string& previewImage);
+    bool LoadIndex();
+    bool WriteIndexLocked() const;
+
+    mutable std::mutex mutex_;
+    std::string root_;
+    std::vector<WorkMeta> index_;
+    bool open_ = false;
+};
+
+#endif // PAPERCUTTING_PAPER_CUT_LIBRARY_H
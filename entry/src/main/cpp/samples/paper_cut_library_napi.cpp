@@ -0,0 +1,355 @@
+//
+// Created on 2026/10/17.
+// 作品库 NAPI 绑定实现
+//
+
+#include "paper_cut_library_napi.h"
+#include "paper_cut_render.h"
+#include "paper_cut_thumbnail.h"
+#include "paper_cut_work_codec.h"
+#include <hilog/log.h>
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+
+static constexpr const char* LOG_LABEL = "PaperCutLibrary";
+#define LOGI(...) ((void)OH_LOG_Print(LOG_APP, LOG_INFO, LOG_DOMAIN, LOG_LABEL, __VA_ARGS__))
+#define LOGE(...) ((void)OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, LOG_LABEL, __VA_ARGS__))
+
+static std::string GetStringValue(napi_env env, napi_value value)
+{
+    size_t length = 0;
+    if (napi_get_value_string_utf8(env, value, nullptr, 0, &length) != napi_ok || length == 0) {
+        return std::string();
+    }
+    std::string result(length + 1, '\0');
+    napi_get_value_string_utf8(env, value, &result[0], result.size(), &length);
+    result.resize(length);
+    return result;
+}
+
+static std::string GetStringProperty(napi_env env, napi_value object, const char *name)
+{
+    napi_value value;
+    napi_valuetype type = napi_undefined;
+    if (napi_get_named_property(env, object, name, &value) != napi_ok ||
+        napi_typeof(env, value, &type) != napi_ok || type != napi_string) {
+        return std::string();
+    }
+    return GetStringValue(env, value);
+}
+
+static void SetStringProperty(napi_env env, napi_value object, const char *name, const std::string &text)
+{
+    napi_value value;
+    napi_create_string_utf8(env, text.c_str(), text.size(), &value);
+    napi_set_named_property(env, object, name, value);
+}
+
+// ArkTS SavedWork（不含 actions）-> WorkMeta
+static WorkMeta ParseMeta(napi_env env, napi_value object)
+{
+    WorkMeta meta;
+    meta.id = GetStringProperty(env, object, "id");
+    meta.title = GetStringProperty(env, object, "title");
+    meta.paperType = GetStringProperty(env, object, "paperType");
+    meta.paperColor = GetStringProperty(env, object, "paperColor");
+    meta.previewImage = GetStringProperty(env, object, "previewImage");
+
+    napi_value value;
+    double date = 0;
+    if (napi_get_named_property(env, object, "date", &value) == napi_ok) {
+        napi_get_value_double(env, value, &date);
+    }
+    meta.date = static_cast<int64_t>(date);
+    int32_t foldMode = 0;
+    if (napi_get_named_property(env, object, "foldMode", &value) == napi_ok) {
+        napi_get_value_int32(env, value, &foldMode);
+    }
+    meta.foldMode = foldMode;
+    return meta;
+}
+
+static napi_value CreateMeta(napi_env env, const WorkMeta &meta)
+{
+    napi_value object;
+    napi_value value;
+    napi_create_object(env, &object);
+    SetStringProperty(env, object, "id", meta.id);
+    if (!meta.title.empty()) {
+        SetStringProperty(env, object, "title", meta.title);
+    }
+    napi_create_double(env, static_cast<double>(meta.date), &value);
+    napi_set_named_property(env, object, "date", value);
+    napi_create_int32(env, meta.foldMode, &value);
+    napi_set_named_property(env, object, "foldMode", value);
+    SetStringProperty(env, object, "paperType", meta.paperType);
+    SetStringProperty(env, object, "paperColor", meta.paperColor);
+    if (!meta.previewImage.empty()) {
+        SetStringProperty(env, object, "previewImage", meta.previewImage);
+    }
+    return object;
+}
+
+static napi_value CreateBoolean(napi_env env, bool flag)
+{
+    napi_value result;
+    napi_get_boolean(env, flag, &result);
+    return result;
+}
+
+WorkLibrary &PaperCutLibraryNapi::GetLibrary()
+{
+    static WorkLibrary library;
+    return library;
+}
+
+void PaperCutLibraryNapi::Export(napi_env env, napi_value exports)
+{
+    napi_property_descriptor desc[] = {
+        {"libraryOpen", nullptr, Open, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"libraryList", nullptr, List, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"librarySave", nullptr, Save, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"libraryLoad", nullptr, Load, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"libraryRemove", nullptr, Remove, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"libraryImport", nullptr, Import, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"librarySetPreviewImage", nullptr, SetPreviewImage, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"libraryRenderThumbnail", nullptr, RenderThumbnail, nullptr, nullptr, nullptr, napi_default, nullptr},
+    };
+    if (napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc) != napi_ok) {
+        LOGE("Export: napi_define_properties failed");
+    }
+}
+
+napi_value PaperCutLibraryNapi::Open(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (argc < 1) {
+        LOGE("Open: insufficient arguments");
+        return CreateBoolean(env, false);
+    }
+
+    const std::string dir = GetStringValue(env, args[0]);
+    const bool ok = GetLibrary().Open(dir);
+    if (ok) {
+        LOGI("Open: %{public}s, %{public}zu works", dir.c_str(), GetLibrary().List().size());
+    } else {
+        LOGE("Open: failed to open %{public}s", dir.c_str());
+    }
+    return CreateBoolean(env, ok);
+}
+
+napi_value PaperCutLibraryNapi::List(napi_env env, napi_callback_info info)
+{
+    const std::vector<WorkMeta> works = GetLibrary().List();
+    napi_value result;
+    napi_create_array_with_length(env, works.size(), &result);
+    for (size_t i = 0; i < works.size(); i++) {
+        napi_set_element(env, result, static_cast<uint32_t>(i), CreateMeta(env, works[i]));
+    }
+    return result;
+}
+
+napi_value PaperCutLibraryNapi::Save(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    void *data = nullptr;
+    size_t size = 0;
+    if (argc < 2 || !PaperCutRender::GetBinaryArg(env, args[1], &data, &size)) {
+        LOGE("Save: expected (meta, ArrayBuffer)");
+        return CreateBoolean(env, false);
+    }
+
+    const WorkMeta meta = ParseMeta(env, args[0]);
+    const bool ok = GetLibrary().Save(meta, static_cast<const uint8_t *>(data), size);
+    if (!ok) {
+        LOGE("Save: failed, id=%{public}s", meta.id.c_str());
+    }
+    return CreateBoolean(env, ok);
+}
+
+napi_value PaperCutLibraryNapi::Load(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (argc < 1) {
+        LOGE("Load: insufficient arguments");
+        return nullptr;
+    }
+
+    const std::string id = GetStringValue(env, args[0]);
+    std::vector<uint8_t> bytes;
+    if (!GetLibrary().Load(id, &bytes)) {
+        LOGE("Load: no data for id=%{public}s", id.c_str());
+        return nullptr;
+    }
+
+    void *buffer = nullptr;
+    napi_value result = nullptr;
+    if (napi_create_arraybuffer(env, bytes.size(), &buffer, &result) != napi_ok || !buffer) {
+        LOGE("Load: napi_create_arraybuffer failed, size=%{public}zu", bytes.size());
+        return nullptr;
+    }
+    std::copy(bytes.begin(), bytes.end(), static_cast<uint8_t *>(buffer));
+    return result;
+}
+
+napi_value PaperCutLibraryNapi::Remove(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (argc < 1) {
+        LOGE("Remove: insufficient arguments");
+        return CreateBoolean(env, false);
+    }
+    return CreateBoolean(env, GetLibrary().Remove(GetStringValue(env, args[0])));
+}
+
+// 旧版 preferences 中的 JSON 作品迁移：对象格式 Action[] -> 紧凑格式文件
+napi_value PaperCutLibraryNapi::Import(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (argc < 1) {
+        LOGE("Import: insufficient arguments");
+        return CreateBoolean(env, false);
+    }
+
+    const WorkMeta meta = ParseMeta(env, args[0]);
+    std::vector<Action> actions;
+    if (argc >= 2) {
+        PaperCutRender::ParseActionArray(env, args[1], &actions);
+    }
+
+    WorkHeader header;
+    header.foldMode = static_cast<FoldMode>(std::clamp(meta.foldMode, 0, static_cast<int32_t>(FoldMode::EIGHT)));
+    header.paperType = (meta.paperType == "SQUARE") ? PaperType::SQUARE : PaperType::CIRCLE;
+    if (meta.paperColor.size() == 7 && meta.paperColor[0] == '#') {
+        header.paperColor = 0xFF000000 | static_cast<uint32_t>(std::strtoul(meta.paperColor.c_str() + 1, nullptr, 16));
+    }
+
+    std::vector<uint8_t> bytes;
+    WorkCodec::Encode(header, actions, &bytes);
+    const bool ok = GetLibrary().Save(meta, bytes.data(), bytes.size());
+    if (!ok) {
+        LOGE("Import: failed, id=%{public}s", meta.id.c_str());
+    }
+    return CreateBoolean(env, ok);
+}
+
+napi_value PaperCutLibraryNapi::SetPreviewImage(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    if (argc < 2) {
+        LOGE("SetPreviewImage: insufficient arguments");
+        return CreateBoolean(env, false);
+    }
+    return CreateBoolean(env,
+                         GetLibrary().SetPreviewImage(GetStringValue(env, args[0]), GetStringValue(env, args[1])));
+}
+
+struct ThumbnailTask {
+    napi_async_work work = nullptr;
+    napi_deferred deferred = nullptr;
+    std::string id;
+    int size = PaperCutThumbnail::DEFAULT_SIZE;
+    std::string uri;
+    std::string error;
+};
+
+// 工作线程：读取作品数据 -> 按内容哈希查缓存 -> 未命中时无窗口渲染并写入 PNG
+static void ExecuteThumbnailTask(napi_env env, void *data)
+{
+    auto *task = static_cast<ThumbnailTask *>(data);
+    WorkLibrary &library = PaperCutLibraryNapi::GetLibrary();
+    std::vector<uint8_t> workData;
+    if (!library.Load(task->id, &workData)) {
+        task->error = "work not found";
+        return;
+    }
+
+    const std::string key = PaperCutThumbnail::CacheKey(workData.data(), workData.size(), task->size);
+    // 渲染串行化：限制同时存在的无窗口引擎数量（每个持有两张 2048² mask），
+    // 同一作品的重复请求（保存时 + 画廊懒加载）在锁后直接命中缓存
+    static std::mutex renderMutex;
+    std::lock_guard<std::mutex> lock(renderMutex);
+    if (!library.HasThumbnail(key)) {
+        std::vector<uint8_t> png;
+        if (!PaperCutThumbnail::RenderPng(workData.data(), workData.size(), task->size, &png)) {
+            task->error = "render failed";
+            return;
+        }
+        if (!library.WriteThumbnail(key, png.data(), png.size())) {
+            task->error = "write failed";
+            return;
+        }
+    }
+    task->uri = library.ThumbnailUri(key);
+    if (!library.SetPreviewImage(task->id, task->uri)) {
+        // 作品在渲染期间被删除：缩略图留在缓存中，不影响结果
+        LOGI("RenderThumbnail: work %{public}s no longer in index", task->id.c_str());
+    }
+}
+
+static void CompleteThumbnailTask(napi_env env, napi_status status, void *data)
+{
+    auto *task = static_cast<ThumbnailTask *>(data);
+    if (status == napi_ok && task->error.empty()) {
+        napi_value uri;
+        napi_create_string_utf8(env, task->uri.c_str(), task->uri.size(), &uri);
+        napi_resolve_deferred(env, task->deferred, uri);
+    } else {
+        const std::string message = task->error.empty() ? "cancelled" : task->error;
+        LOGE("RenderThumbnail: %{public}s, id=%{public}s", message.c_str(), task->id.c_str());
+        napi_value text;
+        napi_value error;
+        napi_create_string_utf8(env, message.c_str(), message.size(), &text);
+        napi_create_error(env, nullptr, text, &error);
+        napi_reject_deferred(env, task->deferred, error);
+    }
+    // 提前失败时（参数无效 / 创建失败）还没有 async work
+    if (task->work) {
+        napi_delete_async_work(env, task->work);
+    }
+    delete task;
+}
+
+napi_value PaperCutLibraryNapi::RenderThumbnail(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+
+    auto *task = new ThumbnailTask();
+    napi_value promise;
+    napi_create_promise(env, &task->deferred, &promise);
+    if (argc >= 1) {
+        task->id = GetStringValue(env, args[0]);
+    }
+    if (argc >= 2) {
+        int32_t size = 0;
+        if (napi_get_value_int32(env, args[1], &size) == napi_ok && size > 0) {
+            task->size = std::min(size, PaperCutThumbnail::MAX_SIZE);
+        }
+    }
+
+    napi_value name;
+    napi_create_string_utf8(env, "PaperCutThumbnail", NAPI_AUTO_LENGTH, &name);
+    if (napi_create_async_work(env, nullptr, name, ExecuteThumbnailTask, CompleteThumbnailTask, task, &task->work) !=
+            napi_ok ||
+        napi_queue_async_work(env, task->work) != napi_ok) {
+        task->error = "queue failed";
+        CompleteThumbnailTask(env, napi_generic_failure, task);
+    }
+    return promise;
+}
@@ -0,0 +1,29 @@
+//
+// Created on 2026/10/17.
+// 作品库 NAPI 绑定：导出到模块对象（import papercut from 'libentry.so'），
+// 画廊页没有 XComponent 也能使用。
+//
+
+#ifndef PAPERCUTTING_PAPER_CUT_LIBRARY_NAPI_H
+#define PAPERCUTTING_PAPER_CUT_LIBRARY_NAPI_H
+
+#include "napi/native_api.h"
+#include "paper_cut_library.h"
+
+class PaperCutLibraryNapi {
+public:
+    static void Export(napi_env env, napi_value exports);
+    static WorkLibrary &GetLibrary();
+
+    static napi_value Open(napi_env env, napi_callback_info info);
+    static napi_value List(napi_env env, napi_callback_info info);
+    static napi_value Save(napi_env env, napi_callback_info info);
+    static napi_value Load(napi_env env, napi_callback_info info);
+    static napi_value Remove(napi_env env, napi_callback_info info);
+    static napi_value Import(napi_env env, napi_callback_info info);
+    static napi_value SetPreviewImage(napi_env env, napi_callback_info info);
+    // 异步生成缩略图（工作线程渲染 + PNG 编码），返回 Promise<string>（file:// 引用）
+    static napi_value RenderThumbnail(napi_env env, napi_callback_info info);
+};
+
+#endif // PAPERCUTTING_PAPER_CUT_LIBRARY_NAPI_H
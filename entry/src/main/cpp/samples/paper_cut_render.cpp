@@ -4,8 +4,12 @@
 //
 
 #include "paper_cut_render.h"
+#include "paper_cut_action_codec.h"
+#include "paper_cut_work_codec.h"
 #include "common/log_common.h"
+#include "utils/display_soloist_vsync.h"
 #include <hilog/log.h>
+#include <algorithm>
 #include <unordered_map>
 
 // hilog/log.h 已定义 LOG_TAG（可能为 NULL），避免宏重定义带来的告警/潜在 Werror
@@ -18,6 +22,8 @@ std::unordered_map<std::string, PaperCutRender *> PaperCutRender::g_instance;
 PaperCutRender::~PaperCutRender()
 {
     LOGI("~PaperCutRender");
+    // 先停渲染线程，再释放引擎
+    scheduler_.reset();
     engine_.reset();
     nativeWindow_ = nullptr;
     previewWindow_ = nullptr;
@@ -25,24 +31,169 @@ PaperCutRender::~PaperCutRender()
 
 void PaperCutRender::SetNativeWindow(OHNativeWindow *nativeWindow)
 {
-    nativeWindow_ = nativeWindow;
-    if (nativeWindow_ && engine_) {
-        uint64_t width = 2048;
-        uint64_t height = 2048;
-        engine_->Initialize(nativeWindow_, width, height);
-        LOGI("NativeWindow set for editor");
+    {
+        std::lock_guard<std::mutex> lock(engineMutex_);
+        nativeWindow_ = nativeWindow;
+        if (nativeWindow_ && engine_) {
+            uint64_t width = 2048;
+            uint64_t height = 2048;
+            engine_->Initialize(nativeWindow_, width, height);
+            LOGI("NativeWindow set for editor");
+        }
+    }
+    if (nativeWindow) {
+        EnsureScheduler();
+        RequestFrame(FRAME_SURFACE_EDITOR);
     }
 }
 
 void PaperCutRender::SetPreviewWindow(OHNativeWindow *nativeWindow)
 {
-    previewWindow_ = nativeWindow;
-    if (previewWindow_ && engine_) {
-        engine_->SetPreviewWindow(previewWindow_);
-        LOGI("PreviewWindow set");
+    {
+        std::lock_guard<std::mutex> lock(engineMutex_);
+        previewWindow_ = nativeWindow;
+        if (engine_) {
+            engine_->SetPreviewWindow(previewWindow_);
+            LOGI("PreviewWindow set");
+        }
+    }
+    if (nativeWindow) {
+        EnsureScheduler();
+        RequestFrame(FRAME_SURFACE_PREVIEW);
+    }
+}
+
+void PaperCutRender::EnsureScheduler()
+{
+    if (scheduler_) {
+        return;
+    }
+    auto scheduler = std::make_unique<FrameScheduler>(
+        std::make_unique<DisplaySoloistVsyncSource>(),
+        [this](uint32_t surfaces, int64_t) { PresentFrame(surfaces); });
+    if (!scheduler->Start()) {
+        // 没有 vsync 时退回到 JS 线程同步绘制（drawPaperCut 直接渲染）
+        LOGE("Frame scheduler failed to start, falling back to synchronous rendering");
+        return;
+    }
+    scheduler_ = std::move(scheduler);
+    LOGI("Render thread started");
+}
+
+void PaperCutRender::RequestFrame(uint32_t surfaces)
+{
+    if (scheduler_) {
+        scheduler_->RequestFrame(surfaces);
+    }
+}
+
+void PaperCutRender::PresentFrame(uint32_t surfaces)
+{
+    // 渲染线程：与 NAPI 调用共用引擎锁，每个表面每个 vsync 最多上屏一次
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    if (!engine_) {
+        return;
+    }
+    if ((surfaces & FRAME_SURFACE_EDITOR) && nativeWindow_) {
+        engine_->Render();
+    }
+    if ((surfaces & FRAME_SURFACE_PREVIEW) && previewWindow_) {
+        engine_->RenderPreview();
+    }
+}
+
+void PaperCutRender::SetViewportSize(uint64_t width, uint64_t height)
+{
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    if (engine_) {
+        engine_->SetViewportSize(static_cast<int>(width), static_cast<int>(height));
     }
 }
 
+void PaperCutRender::OnTouchEvent(const OH_NativeXComponent_TouchEvent &event,
+                                  const OH_NativeXComponent_HistoricalPoint *history, int32_t historySize)
+{
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    if (!engine_) {
+        return;
+    }
+    // 多指（捏合/平移手势）或输入被禁用：放弃当前笔画，交给 ArkTS 手势处理
+    if (!inputEnabled_ || event.numPoints > 1) {
+        if (engine_->IsDrawing()) {
+            engine_->CancelDrawing();
+            RequestFrame(FRAME_SURFACE_ALL);
+        }
+        return;
+    }
+    Point model = engine_->ScreenToModel(event.x, event.y);
+    switch (event.type) {
+        case OH_NATIVEXCOMPONENT_DOWN:
+            engine_->StartDrawing(model.x, model.y);
+            break;
+        case OH_NATIVEXCOMPONENT_MOVE: {
+            // 两次回调之间被合并的历史样本 + 当前点，一次批量追加（屏幕坐标）
+            std::vector<float> samples;
+            samples.reserve((historySize > 0 ? historySize : 0) * 2 + 2);
+            for (int32_t i = 0; i < historySize; i++) {
+                samples.push_back(history[i].x);
+                samples.push_back(history[i].y);
+            }
+            samples.push_back(event.x);
+            samples.push_back(event.y);
+            engine_->AddPoints(samples.data(), samples.size() / 2, true);
+            break;
+        }
+        case OH_NATIVEXCOMPONENT_UP:
+            engine_->AddPoint(model.x, model.y);
+            engine_->FinishDrawing();
+            break;
+        case OH_NATIVEXCOMPONENT_CANCEL:
+            engine_->CancelDrawing();
+            break;
+        default:
+            return;
+    }
+    RequestFrame(FRAME_SURFACE_ALL);
+}
+
+void PaperCutRender::OnMouseEvent(const OH_NativeXComponent_MouseEvent &event)
+{
+    if (event.button != OH_NATIVEXCOMPONENT_LEFT_BUTTON) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(engineMutex_);
+    if (!engine_ || !inputEnabled_) {
+        return;
+    }
+    // 鼠标左键同时可能产生触摸事件：StartDrawing 对重复按下、AddPoint 对重复点都是幂等的
+    Point model = engine_->ScreenToModel(event.x, event.y);
+    switch (event.action) {
+        case OH_NATIVEXCOMPONENT_MOUSE_PRESS:
+            engine_->StartDrawing(model.x, model.y);
+            break;
+        case OH_NATIVEXCOMPONENT_MOUSE_MOVE:
+            engine_->AddPoint(model.x, model.y);
+            break;
+        case OH_NATIVEXCOMPONENT_MOUSE_RELEASE:
+            engine_->FinishDrawing();
+            break;
+        default:
+            return;
+    }
+    RequestFrame(FRAME_SURFACE_ALL);
+}
+
+std::string PaperCutRender::GetEditorIdForPreview(const std::string &previewId)
+{
+    // xcomponent_preview 与 xcomponent_editor 成对出现：预览只读编辑器引擎的数据
+    std::string editorId = previewId;
+    size_t pos = editorId.find("preview");
+    if (pos != std::string::npos) {
+        editorId.replace(pos, std::string("preview").size(), "editor");
+    }
+    return editorId;
+}
+
 PaperCutRender *PaperCutRender::GetInstance(std::string &id)
 {
     if (g_instance.find(id) == g_instance.end()) {
@@ -110,9 +261,10 @@ static void OnSurfaceCreatedCB(OH_NativeXComponent *component, void *window)
     auto render = PaperCutRender::GetInstance(id);
     OHNativeWindow *nativeWindow = static_cast<OHNativeWindow *>(window);
     
-    // 根据ID判断是编辑器还是预览器
+    // 根据ID判断是编辑器还是预览器；预览窗口挂到成对的编辑器实例上，与编辑器共用引擎和渲染线程
     if (id.find("preview") != std::string::npos) {
-        render->SetPreviewWindow(nativeWindow);
+        std::string editorId = PaperCutRender::GetEditorIdForPreview(id);
+        PaperCutRender::GetInstance(editorId)->SetPreviewWindow(nativeWindow);
     } else {
         render->SetNativeWindow(nativeWindow);
     }
@@ -126,13 +278,117 @@ static void OnSurfaceCreatedCB(OH_NativeXComponent *component, void *window)
         LOGI("PaperCutRender xComponent width = %{public}llu, height = %{public}llu",
              static_cast<unsigned long long>(width),
              static_cast<unsigned long long>(height));
+        if (id.find("preview") == std::string::npos) {
+            render->SetViewportSize(width, height);
+        }
+    }
+}
+
+static void OnSurfaceChangedCB(OH_NativeXComponent *component, void *window)
+{
+    if ((component == nullptr) || (window == nullptr)) {
+        return;
+    }
+    char idStr[OH_XCOMPONENT_ID_LEN_MAX + 1] = {'\0'};
+    uint64_t idSize = OH_XCOMPONENT_ID_LEN_MAX + 1;
+    if (OH_NativeXComponent_GetXComponentId(component, idStr, &idSize) != OH_NATIVEXCOMPONENT_RESULT_SUCCESS) {
+        LOGE("OnSurfaceChangedCB: Unable to get XComponent id");
+        return;
+    }
+    std::string id(idStr);
+    uint64_t width;
+    uint64_t height;
+    if (OH_NativeXComponent_GetXComponentSize(component, window, &width, &height) !=
+        OH_NATIVEXCOMPONENT_RESULT_SUCCESS) {
+        return;
+    }
+    if (id.find("preview") != std::string::npos) {
+        std::string editorId = PaperCutRender::GetEditorIdForPreview(id);
+        PaperCutRender::GetInstance(editorId)->RequestFrame(FRAME_SURFACE_PREVIEW);
+    } else {
+        PaperCutRender *render = PaperCutRender::GetInstance(id);
+        render->SetViewportSize(width, height);
+        render->RequestFrame(FRAME_SURFACE_EDITOR);
+    }
+}
+
+static void DispatchTouchEventCB(OH_NativeXComponent *component, void *window)
+{
+    if ((component == nullptr) || (window == nullptr)) {
+        return;
+    }
+    char idStr[OH_XCOMPONENT_ID_LEN_MAX + 1] = {'\0'};
+    uint64_t idSize = OH_XCOMPONENT_ID_LEN_MAX + 1;
+    if (OH_NativeXComponent_GetXComponentId(component, idStr, &idSize) != OH_NATIVEXCOMPONENT_RESULT_SUCCESS) {
+        return;
+    }
+    std::string id(idStr);
+    // 预览只展示，不接收绘制输入
+    if (id.find("preview") != std::string::npos) {
+        return;
+    }
+    OH_NativeXComponent_TouchEvent touchEvent;
+    if (OH_NativeXComponent_GetTouchEvent(component, window, &touchEvent) != OH_NATIVEXCOMPONENT_RESULT_SUCCESS) {
+        LOGE("DispatchTouchEventCB: get touch event failed");
+        return;
+    }
+    // 高采样率屏幕上，两次回调之间的样本会被合并进历史点
+    int32_t historySize = 0;
+    OH_NativeXComponent_HistoricalPoint *history = nullptr;
+    if (touchEvent.type != OH_NATIVEXCOMPONENT_MOVE ||
+        OH_NativeXComponent_GetHistoricalPoints(component, window, &historySize, &history) !=
+            OH_NATIVEXCOMPONENT_RESULT_SUCCESS) {
+        historySize = 0;
+        history = nullptr;
+    }
+    PaperCutRender::GetInstance(id)->OnTouchEvent(touchEvent, history, historySize);
+}
+
+static void DispatchMouseEventCB(OH_NativeXComponent *component, void *window)
+{
+    if ((component == nullptr) || (window == nullptr)) {
+        return;
+    }
+    char idStr[OH_XCOMPONENT_ID_LEN_MAX + 1] = {'\0'};
+    uint64_t idSize = OH_XCOMPONENT_ID_LEN_MAX + 1;
+    if (OH_NativeXComponent_GetXComponentId(component, idStr, &idSize) != OH_NATIVEXCOMPONENT_RESULT_SUCCESS) {
+        return;
+    }
+    std::string id(idStr);
+    if (id.find("preview") != std::string::npos) {
+        return;
+    }
+    OH_NativeXComponent_MouseEvent mouseEvent;
+    if (OH_NativeXComponent_GetMouseEvent(component, window, &mouseEvent) != OH_NATIVEXCOMPONENT_RESULT_SUCCESS) {
+        return;
     }
+    PaperCutRender::GetInstance(id)->OnMouseEvent(mouseEvent);
+}
+
+static void DispatchHoverEventCB(OH_NativeXComponent *component, bool isHover)
+{
 }
 
 static void OnSurfaceDestroyedCB(OH_NativeXComponent *component, void *window)
 {
     LOGI("PaperCutRender OnSurfaceDestroyedCB");
-    // 清理资源
+    if (component == nullptr) {
+        return;
+    }
+    char idStr[OH_XCOMPONENT_ID_LEN_MAX + 1] = {'\0'};
+    uint64_t idSize = OH_XCOMPONENT_ID_LEN_MAX + 1;
+    if (OH_NativeXComponent_GetXComponentId(component, idStr, &idSize) != OH_NATIVEXCOMPONENT_RESULT_SUCCESS) {
+        LOGE("OnSurfaceDestroyedCB: Unable to get XComponent id");
+        return;
+    }
+    std::string id(idStr);
+    // 窗口失效后渲染线程不能再向它上屏
+    if (id.find("preview") != std::string::npos) {
+        std::string editorId = PaperCutRender::GetEditorIdForPreview(id);
+        PaperCutRender::GetInstance(editorId)->SetPreviewWindow(nullptr);
+    } else {
+        PaperCutRender::GetInstance(id)->SetNativeWindow(nullptr);
+    }
 }
 
 void PaperCutRender::RegisterCallback(OH_NativeXComponent *nativeXComponent)
@@ -140,10 +396,15 @@ void PaperCutRender::RegisterCallback(OH_NativeXComponent *nativeXComponent)
     LOGI("PaperCutRender register callback");
     renderCallback_.OnSurfaceCreated = OnSurfaceCreatedCB;
     renderCallback_.OnSurfaceDestroyed = OnSurfaceDestroyedCB;
-    // Callback must be initialized
-    renderCallback_.DispatchTouchEvent = nullptr;
-    renderCallback_.OnSurfaceChanged = nullptr;
+    // 触摸直接在 Native 层处理（不经过 ArkTS），降低落笔延迟
+    renderCallback_.DispatchTouchEvent = DispatchTouchEventCB;
+    renderCallback_.OnSurfaceChanged = OnSurfaceChangedCB;
     OH_NativeXComponent_RegisterCallback(nativeXComponent, &renderCallback_);
+    
+    // 鼠标左键绘制同样走 Native；右键平移仍由 ArkTS 处理视图状态
+    mouseCallback_.DispatchMouseEvent = DispatchMouseEventCB;
+    mouseCallback_.DispatchHoverEvent = DispatchHoverEventCB;
+    OH_NativeXComponent_RegisterMouseEventCallback(nativeXComponent, &mouseCallback_);
 }
 
 void PaperCutRender::Export(napi_env env, napi_value exports)
@@ -159,18 +420,32 @@ void PaperCutRender::Export(napi_env env, napi_value exports)
         {"initializeEngine", nullptr, InitializeEngine, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"startDrawing", nullptr, StartDrawing, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"addPoint", nullptr, AddPoint, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"addPoints", nullptr, AddPoints, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"finishDrawing", nullptr, FinishDrawing, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"setToolMode", nullptr, SetToolMode, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"setFoldMode", nullptr, SetFoldMode, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"setPreviewUnfoldMode", nullptr, SetPreviewUnfoldMode, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"setPaperType", nullptr, SetPaperType, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"setPaperColor", nullptr, SetPaperColor, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"setBackgroundColor", nullptr, SetBackgroundColor, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"undo", nullptr, Undo, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"redo", nullptr, Redo, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"seekHistory", nullptr, SeekHistory, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"getHistoryLength", nullptr, GetHistoryLength, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"getHistoryIndex", nullptr, GetHistoryIndex, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"getPaperMetrics", nullptr, GetPaperMetrics, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"exportSvg", nullptr, ExportSvg, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"exportPng", nullptr, ExportPng, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"clear", nullptr, Clear, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"getActions", nullptr, GetActions, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"setActions", nullptr, SetActions, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"getActionsBinary", nullptr, GetActionsBinary, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"setActionsBinary", nullptr, SetActionsBinary, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"getWorkBinary", nullptr, GetWorkBinary, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"setWorkBinary", nullptr, SetWorkBinary, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"setZoom", nullptr, SetZoom, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"setPan", nullptr, SetPan, nullptr, nullptr, nullptr, napi_default, nullptr},
+        {"setInputEnabled", nullptr, SetInputEnabled, nullptr, nullptr, nullptr, napi_default, nullptr},
         {"setPreviewWindow", nullptr, SetPreviewWindow, nullptr, nullptr, nullptr, napi_default, nullptr}
     };
     
@@ -182,7 +457,16 @@ void PaperCutRender::Export(napi_env env, napi_value exports)
 napi_value PaperCutRender::DrawPaperCut(napi_env env, napi_callback_info info)
 {
     PaperCutRender *render = GetRenderFromArgs(env, info);
-    if (render && render->engine_ && render->nativeWindow_) {
+    if (!render || !render->engine_) {
+        return nullptr;
+    }
+    // 有渲染线程时只标记脏，由下一个 vsync 合并上屏
+    if (render->scheduler_) {
+        render->RequestFrame(FRAME_SURFACE_EDITOR);
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
+    if (render->nativeWindow_) {
         render->engine_->Render();
     }
     return nullptr;
@@ -191,7 +475,15 @@ napi_value PaperCutRender::DrawPaperCut(napi_env env, napi_callback_info info)
 napi_value PaperCutRender::DrawPaperCutPreview(napi_env env, napi_callback_info info)
 {
     PaperCutRender *render = GetRenderFromArgs(env, info);
-    if (render && render->engine_ && render->previewWindow_) {
+    if (!render || !render->engine_) {
+        return nullptr;
+    }
+    if (render->scheduler_) {
+        render->RequestFrame(FRAME_SURFACE_PREVIEW);
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
+    if (render->previewWindow_) {
         render->engine_->RenderPreview();
     }
     return nullptr;
@@ -223,7 +515,9 @@ napi_value PaperCutRender::InitializeEngine(napi_env env, napi_callback_info inf
     napi_get_value_int32(env, args[2], &height);
     
     if (render->nativeWindow_) {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
         render->engine_->Initialize(render->nativeWindow_, width, height);
+        render->RequestFrame(FRAME_SURFACE_ALL);
         LOGI("Engine initialized: %dx%d", width, height);
     }
     
@@ -250,7 +544,9 @@ napi_value PaperCutRender::StartDrawing(napi_env env, napi_callback_info info)
     napi_get_value_double(env, args[0], &x);
     napi_get_value_double(env, args[1], &y);
     
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
     render->engine_->StartDrawing(static_cast<float>(x), static_cast<float>(y));
+    render->RequestFrame(FRAME_SURFACE_ALL);
     return nullptr;
 }
 
@@ -274,7 +570,54 @@ napi_value PaperCutRender::AddPoint(napi_env env, napi_callback_info info)
     napi_get_value_double(env, args[0], &x);
     napi_get_value_double(env, args[1], &y);
     
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
     render->engine_->AddPoint(static_cast<float>(x), static_cast<float>(y));
+    render->RequestFrame(FRAME_SURFACE_ALL);
+    return nullptr;
+}
+
+napi_value PaperCutRender::AddPoints(napi_env env, napi_callback_info info)
+{
+    size_t argc = 2;
+    napi_value args[2];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    if (argc < 1) {
+        LOGE("AddPoints: insufficient arguments");
+        return nullptr;
+    }
+    
+    // 直接读取 Float32Array 的底层内存（交错 x/y），不逐个取元素
+    bool isTypedArray = false;
+    if (napi_is_typedarray(env, args[0], &isTypedArray) != napi_ok || !isTypedArray) {
+        LOGE("AddPoints: arg0 is not a typed array");
+        return nullptr;
+    }
+    napi_typedarray_type type;
+    size_t length = 0;
+    void *data = nullptr;
+    napi_value arrayBuffer;
+    size_t byteOffset = 0;
+    if (napi_get_typedarray_info(env, args[0], &type, &length, &data, &arrayBuffer, &byteOffset) != napi_ok ||
+        type != napi_float32_array) {
+        LOGE("AddPoints: arg0 must be a Float32Array");
+        return nullptr;
+    }
+    
+    // 可选第二个参数：样本是否为 surface 像素坐标（默认与 addPoint 一致，为模型坐标）
+    bool screenSpace = false;
+    if (argc >= 2) {
+        napi_get_value_bool(env, args[1], &screenSpace);
+    }
+    
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    if (!render || !render->engine_) {
+        return nullptr;
+    }
+    
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
+    render->engine_->AddPoints(static_cast<const float *>(data), length / 2, screenSpace);
+    render->RequestFrame(FRAME_SURFACE_ALL);
     return nullptr;
 }
 
@@ -282,7 +625,9 @@ napi_value PaperCutRender::FinishDrawing(napi_env env, napi_callback_info info)
 {
     PaperCutRender *render = GetRenderFromArgs(env, info);
     if (render && render->engine_) {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
         render->engine_->FinishDrawing();
+        render->RequestFrame(FRAME_SURFACE_ALL);
     }
     return nullptr;
 }
@@ -306,7 +651,9 @@ napi_value PaperCutRender::SetToolMode(napi_env env, napi_callback_info info)
     int32_t mode;
     napi_get_value_int32(env, args[0], &mode);
     
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
     render->engine_->SetToolMode(static_cast<ToolMode>(mode));
+    render->RequestFrame(FRAME_SURFACE_EDITOR);
     return nullptr;
 }
 
@@ -329,7 +676,40 @@ napi_value PaperCutRender::SetFoldMode(napi_env env, napi_callback_info info)
     int32_t mode;
     napi_get_value_int32(env, args[0], &mode);
     
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
     render->engine_->SetFoldMode(static_cast<FoldMode>(mode));
+    render->RequestFrame(FRAME_SURFACE_ALL);
+    return nullptr;
+}
+
+napi_value PaperCutRender::SetPreviewUnfoldMode(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    if (argc < 1) {
+        LOGE("SetPreviewUnfoldMode: insufficient arguments");
+        return nullptr;
+    }
+    
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    if (!render || !render->engine_) {
+        return nullptr;
+    }
+    
+    int32_t mode;
+    napi_get_value_int32(env, args[0], &mode);
+    
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
+    PreviewUnfoldMode unfoldMode = PreviewUnfoldMode::CANVAS_STAMP;
+    if (mode == static_cast<int32_t>(PreviewUnfoldMode::POLAR_LUT)) {
+        unfoldMode = PreviewUnfoldMode::POLAR_LUT;
+    } else if (mode == static_cast<int32_t>(PreviewUnfoldMode::GEOMETRY)) {
+        unfoldMode = PreviewUnfoldMode::GEOMETRY;
+    }
+    render->engine_->SetPreviewUnfoldMode(unfoldMode);
+    render->RequestFrame(FRAME_SURFACE_PREVIEW);
     return nullptr;
 }
 
@@ -352,7 +732,9 @@ napi_value PaperCutRender::SetPaperType(napi_env env, napi_callback_info info)
     int32_t type;
     napi_get_value_int32(env, args[0], &type);
     
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
     render->engine_->SetPaperType(static_cast<PaperType>(type));
+    render->RequestFrame(FRAME_SURFACE_ALL);
     return nullptr;
 }
 
@@ -375,7 +757,34 @@ napi_value PaperCutRender::SetPaperColor(napi_env env, napi_callback_info info)
     uint32_t color;
     napi_get_value_uint32(env, args[0], &color);
     
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
     render->engine_->SetPaperColor(color);
+    render->RequestFrame(FRAME_SURFACE_ALL);
+    return nullptr;
+}
+
+napi_value PaperCutRender::SetBackgroundColor(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    if (argc < 1) {
+        LOGE("SetBackgroundColor: insufficient arguments");
+        return nullptr;
+    }
+    
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    if (!render || !render->engine_) {
+        return nullptr;
+    }
+    
+    uint32_t color;
+    napi_get_value_uint32(env, args[0], &color);
+    
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
+    render->engine_->SetBackgroundColor(color);
+    render->RequestFrame(FRAME_SURFACE_ALL);
     return nullptr;
 }
 
@@ -383,7 +792,9 @@ napi_value PaperCutRender::Undo(napi_env env, napi_callback_info info)
 {
     PaperCutRender *render = GetRenderFromArgs(env, info);
     if (render && render->engine_) {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
         render->engine_->Undo();
+        render->RequestFrame(FRAME_SURFACE_ALL);
     }
     return nullptr;
 }
@@ -392,16 +803,200 @@ napi_value PaperCutRender::Redo(napi_env env, napi_callback_info info)
 {
     PaperCutRender *render = GetRenderFromArgs(env, info);
     if (render && render->engine_) {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
         render->engine_->Redo();
+        render->RequestFrame(FRAME_SURFACE_ALL);
+    }
+    return nullptr;
+}
+
+napi_value PaperCutRender::SeekHistory(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    if (argc < 1) {
+        LOGE("SeekHistory: insufficient arguments");
+        return nullptr;
     }
+    
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    if (!render || !render->engine_) {
+        return nullptr;
+    }
+    
+    int64_t index = 0;
+    napi_get_value_int64(env, args[0], &index);
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
+    render->engine_->SeekHistory(index > 0 ? static_cast<size_t>(index) : 0);
+    render->RequestFrame(FRAME_SURFACE_ALL);
     return nullptr;
 }
 
+napi_value PaperCutRender::GetHistoryLength(napi_env env, napi_callback_info info)
+{
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    napi_value result;
+    size_t length = 0;
+    if (render && render->engine_) {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
+        length = render->engine_->GetHistoryLength();
+    }
+    napi_create_int64(env, static_cast<int64_t>(length), &result);
+    return result;
+}
+
+napi_value PaperCutRender::GetHistoryIndex(napi_env env, napi_callback_info info)
+{
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    napi_value result;
+    size_t index = 0;
+    if (render && render->engine_) {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
+        index = render->engine_->GetHistoryIndex();
+    }
+    napi_create_int64(env, static_cast<int64_t>(index), &result);
+    return result;
+}
+
+napi_value PaperCutRender::GetPaperMetrics(napi_env env, napi_callback_info info)
+{
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    double area = 0.0;
+    double perimeter = 0.0;
+    if (render && render->engine_) {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
+        // 矢量几何：精确面积/周长（模型像素），与 mask 分辨率无关
+        PaperGeometry& geometry = render->engine_->GetPaperGeometry();
+        area = geometry.GetArea();
+        perimeter = geometry.GetPerimeter();
+    }
+    napi_value result;
+    napi_value value;
+    napi_create_object(env, &result);
+    napi_create_double(env, area, &value);
+    napi_set_named_property(env, result, "area", value);
+    napi_create_double(env, perimeter, &value);
+    napi_set_named_property(env, result, "perimeter", value);
+    return result;
+}
+
+napi_value PaperCutRender::ExportSvg(napi_env env, napi_callback_info info)
+{
+    size_t argc = 3;
+    napi_value args[3];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    bool ok = false;
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    if (argc < 1) {
+        LOGE("ExportSvg: insufficient arguments");
+    } else if (render && render->engine_) {
+        // exportSvg(fd, width?, height?)：fd 由 ArkTS 侧 fileIo 打开，流式写入后由调用方关闭
+        int32_t fd = -1;
+        int32_t width = 0;
+        int32_t height = 0;
+        napi_get_value_int32(env, args[0], &fd);
+        if (argc >= 2) {
+            napi_get_value_int32(env, args[1], &width);
+        }
+        if (argc >= 3) {
+            napi_get_value_int32(env, args[2], &height);
+        }
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
+        ok = render->engine_->ExportSvg(fd, width, height);
+    }
+    napi_value result;
+    napi_get_boolean(env, ok, &result);
+    return result;
+}
+
+struct PngExportTask {
+    napi_async_work work = nullptr;
+    napi_deferred deferred = nullptr;
+    int fd = -1;
+    TiledPngExport::Image image;
+    bool ok = false;
+};
+
+// 工作线程：只使用快照出的轮廓，不再访问引擎，编辑/渲染不受影响
+static void ExecutePngExportTask(napi_env env, void *data)
+{
+    auto *task = static_cast<PngExportTask *>(data);
+    task->ok = TiledPngExport::Write(task->fd, task->image);
+}
+
+static void CompletePngExportTask(napi_env env, napi_status status, void *data)
+{
+    auto *task = static_cast<PngExportTask *>(data);
+    if (status == napi_ok && task->ok) {
+        napi_value undefined;
+        napi_get_undefined(env, &undefined);
+        napi_resolve_deferred(env, task->deferred, undefined);
+    } else {
+        LOGE("ExportPng: failed (%{public}dx%{public}d)", task->image.width, task->image.height);
+        napi_value text;
+        napi_value error;
+        napi_create_string_utf8(env, "export failed", NAPI_AUTO_LENGTH, &text);
+        napi_create_error(env, nullptr, text, &error);
+        napi_reject_deferred(env, task->deferred, error);
+    }
+    // 提前失败时（参数无效 / 创建失败）还没有 async work
+    if (task->work) {
+        napi_delete_async_work(env, task->work);
+    }
+    delete task;
+}
+
+napi_value PaperCutRender::ExportPng(napi_env env, napi_callback_info info)
+{
+    size_t argc = 3;
+    napi_value args[3];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    // exportPng(fd, width?, height?)：fd 在 Promise 完成前必须保持打开
+    auto *task = new PngExportTask();
+    napi_value promise;
+    napi_create_promise(env, &task->deferred, &promise);
+    int32_t width = 0;
+    int32_t height = 0;
+    if (argc >= 1) {
+        napi_get_value_int32(env, args[0], &task->fd);
+    }
+    if (argc >= 2) {
+        napi_get_value_int32(env, args[1], &width);
+    }
+    if (argc >= 3) {
+        napi_get_value_int32(env, args[2], &height);
+    }
+    
+    bool prepared = false;
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    // 尺寸先于加锁检查：超大尺寸直接失败，不占用引擎锁
+    if (render && render->engine_ && task->fd >= 0 && PaperCutEngine::IsValidExportSize(width, height)) {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
+        prepared = render->engine_->PrepareExportPng(width, height, &task->image);
+    }
+    napi_value name;
+    napi_create_string_utf8(env, "PaperCutExportPng", NAPI_AUTO_LENGTH, &name);
+    if (!prepared ||
+        napi_create_async_work(env, nullptr, name, ExecutePngExportTask, CompletePngExportTask, task, &task->work) !=
+            napi_ok ||
+        napi_queue_async_work(env, task->work) != napi_ok) {
+        // 参数无效时直接以失败完成
+        CompletePngExportTask(env, napi_generic_failure, task);
+    }
+    return promise;
+}
+
 napi_value PaperCutRender::Clear(napi_env env, napi_callback_info info)
 {
     PaperCutRender *render = GetRenderFromArgs(env, info);
     if (render && render->engine_) {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
         render->engine_->Clear();
+        render->RequestFrame(FRAME_SURFACE_ALL);
     }
     return nullptr;
 }
@@ -415,7 +1010,11 @@ napi_value PaperCutRender::GetActions(napi_env env, napi_callback_info info)
         return emptyArray;
     }
     
-    std::vector<Action> actions = render->engine_->GetActions();
+    std::vector<Action> actions;
+    {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
+        actions = render->engine_->GetActions();
+    }
     napi_value result;
     napi_create_array(env, &result);
     
@@ -470,37 +1069,42 @@ napi_value PaperCutRender::GetActions(napi_env env, napi_callback_info info)
     return result;
 }
 
-napi_value PaperCutRender::SetActions(napi_env env, napi_callback_info info)
+bool PaperCutRender::GetBinaryArg(napi_env env, napi_value value, void **data, size_t *size)
 {
-    size_t argc = 1;
-    napi_value args[1];
-    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
-    
-    PaperCutRender *render = GetRenderFromArgs(env, info);
-    if (!render || !render->engine_) {
-        return nullptr;
+    *data = nullptr;
+    *size = 0;
+    bool isArrayBuffer = false;
+    bool isTypedArray = false;
+    napi_is_arraybuffer(env, value, &isArrayBuffer);
+    if (isArrayBuffer) {
+        napi_get_arraybuffer_info(env, value, data, size);
+    } else if (napi_is_typedarray(env, value, &isTypedArray) == napi_ok && isTypedArray) {
+        napi_typedarray_type type;
+        size_t length = 0;
+        napi_value arrayBuffer;
+        size_t byteOffset = 0;
+        napi_get_typedarray_info(env, value, &type, &length, data, &arrayBuffer, &byteOffset);
+        *size = (type == napi_uint8_array || type == napi_int8_array) ? length : 0;
     }
-    
-    if (argc < 1) {
-        LOGE("SetActions: insufficient arguments");
-        return nullptr;
-    }
-    
+    return *data != nullptr && *size > 0;
+}
+
+bool PaperCutRender::ParseActionArray(napi_env env, napi_value array, std::vector<Action> *out)
+{
     bool isArray = false;
-    if (napi_is_array(env, args[0], &isArray) != napi_ok || !isArray) {
-        LOGE("SetActions: arg0 is not array");
-        return nullptr;
+    if (!out || napi_is_array(env, array, &isArray) != napi_ok || !isArray) {
+        return false;
     }
     
     uint32_t length = 0;
-    napi_get_array_length(env, args[0], &length);
+    napi_get_array_length(env, array, &length);
     
     std::vector<Action> actions;
     actions.reserve(length);
     
     for (uint32_t i = 0; i < length; i++) {
         napi_value actionObj;
-        if (napi_get_element(env, args[0], i, &actionObj) != napi_ok) {
+        if (napi_get_element(env, array, i, &actionObj) != napi_ok) {
             continue;
         }
         
@@ -576,10 +1180,173 @@ napi_value PaperCutRender::SetActions(napi_env env, napi_callback_info info)
         actions.push_back(action);
     }
     
+    *out = std::move(actions);
+    return true;
+}
+
+napi_value PaperCutRender::SetActions(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    if (!render || !render->engine_) {
+        return nullptr;
+    }
+    
+    if (argc < 1) {
+        LOGE("SetActions: insufficient arguments");
+        return nullptr;
+    }
+    
+    std::vector<Action> actions;
+    if (!ParseActionArray(env, args[0], &actions)) {
+        LOGE("SetActions: arg0 is not array");
+        return nullptr;
+    }
+    
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
+    render->engine_->SetActions(actions);
+    render->RequestFrame(FRAME_SURFACE_ALL);
+    return nullptr;
+}
+
+napi_value PaperCutRender::GetActionsBinary(napi_env env, napi_callback_info info)
+{
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    std::vector<Action> actions;
+    if (render && render->engine_) {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
+        actions = render->engine_->GetActions();
+    }
+    
+    // 直接编码进 ArrayBuffer 的内存，不为每个点创建 JS 对象
+    const size_t size = ActionBinaryCodec::EncodedSize(actions);
+    void *data = nullptr;
+    napi_value result = nullptr;
+    if (napi_create_arraybuffer(env, size, &data, &result) != napi_ok || !data) {
+        LOGE("GetActionsBinary: napi_create_arraybuffer failed, size=%{public}zu", size);
+        return nullptr;
+    }
+    if (!ActionBinaryCodec::Encode(actions, static_cast<uint8_t *>(data), size)) {
+        LOGE("GetActionsBinary: encode failed");
+        return nullptr;
+    }
+    return result;
+}
+
+napi_value PaperCutRender::SetActionsBinary(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    if (argc < 1) {
+        LOGE("SetActionsBinary: insufficient arguments");
+        return nullptr;
+    }
+    
+    void *data = nullptr;
+    size_t size = 0;
+    if (!GetBinaryArg(env, args[0], &data, &size)) {
+        LOGE("SetActionsBinary: arg0 must be an ArrayBuffer or Uint8Array");
+        return nullptr;
+    }
+    
+    std::vector<Action> actions;
+    if (!ActionBinaryCodec::Decode(static_cast<const uint8_t *>(data), size, &actions)) {
+        LOGE("SetActionsBinary: invalid or unsupported data, size=%{public}zu", size);
+        return nullptr;
+    }
+    
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    if (!render || !render->engine_) {
+        return nullptr;
+    }
+    
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
     render->engine_->SetActions(actions);
+    render->RequestFrame(FRAME_SURFACE_ALL);
     return nullptr;
 }
 
+napi_value PaperCutRender::GetWorkBinary(napi_env env, napi_callback_info info)
+{
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    if (!render || !render->engine_) {
+        return nullptr;
+    }
+    
+    WorkHeader header;
+    std::vector<Action> actions;
+    {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
+        header.foldMode = render->engine_->GetFoldMode();
+        header.paperType = render->engine_->GetPaperType();
+        header.paperColor = render->engine_->GetPaperColor();
+        actions = render->engine_->GetActions();
+    }
+    
+    std::vector<uint8_t> bytes;
+    WorkCodec::Encode(header, actions, &bytes);
+    void *data = nullptr;
+    napi_value result = nullptr;
+    if (napi_create_arraybuffer(env, bytes.size(), &data, &result) != napi_ok || !data) {
+        LOGE("GetWorkBinary: napi_create_arraybuffer failed, size=%{public}zu", bytes.size());
+        return nullptr;
+    }
+    std::copy(bytes.begin(), bytes.end(), static_cast<uint8_t *>(data));
+    return result;
+}
+
+napi_value PaperCutRender::SetWorkBinary(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    void *data = nullptr;
+    size_t size = 0;
+    if (argc < 1 || !GetBinaryArg(env, args[0], &data, &size)) {
+        LOGE("SetWorkBinary: arg0 must be an ArrayBuffer or Uint8Array");
+        return nullptr;
+    }
+    
+    WorkHeader header;
+    std::vector<Action> actions;
+    if (!WorkCodec::Decode(static_cast<const uint8_t *>(data), size, &header, &actions)) {
+        LOGE("SetWorkBinary: invalid or unsupported data, size=%{public}zu", size);
+        return nullptr;
+    }
+    
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    if (!render || !render->engine_) {
+        return nullptr;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(render->engineMutex_);
+        render->engine_->SetFoldMode(header.foldMode);
+        render->engine_->SetPaperType(header.paperType);
+        render->engine_->SetPaperColor(header.paperColor);
+        render->engine_->SetActions(actions);
+        render->RequestFrame(FRAME_SURFACE_ALL);
+    }
+    
+    // 返回纸张参数，供 ArkTS 同步界面状态
+    napi_value result;
+    napi_value value;
+    napi_create_object(env, &result);
+    napi_create_int32(env, static_cast<int32_t>(header.foldMode), &value);
+    napi_set_named_property(env, result, "foldMode", value);
+    napi_create_int32(env, static_cast<int32_t>(header.paperType), &value);
+    napi_set_named_property(env, result, "paperType", value);
+    napi_create_uint32(env, header.paperColor, &value);
+    napi_set_named_property(env, result, "paperColor", value);
+    return result;
+}
+
 napi_value PaperCutRender::SetZoom(napi_env env, napi_callback_info info)
 {
     size_t argc = 1;
@@ -599,7 +1366,9 @@ napi_value PaperCutRender::SetZoom(napi_env env, napi_callback_info info)
     double zoom;
     napi_get_value_double(env, args[0], &zoom);
     
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
     render->engine_->SetZoom(static_cast<float>(zoom));
+    render->RequestFrame(FRAME_SURFACE_EDITOR);
     return nullptr;
 }
 
@@ -623,7 +1392,38 @@ napi_value PaperCutRender::SetPan(napi_env env, napi_callback_info info)
     napi_get_value_double(env, args[0], &x);
     napi_get_value_double(env, args[1], &y);
     
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
     render->engine_->SetPan(static_cast<float>(x), static_cast<float>(y));
+    render->RequestFrame(FRAME_SURFACE_EDITOR);
+    return nullptr;
+}
+
+napi_value PaperCutRender::SetInputEnabled(napi_env env, napi_callback_info info)
+{
+    size_t argc = 1;
+    napi_value args[1];
+    napi_get_cb_info(env, info, &argc, args, nullptr, nullptr);
+    
+    if (argc < 1) {
+        LOGE("SetInputEnabled: insufficient arguments");
+        return nullptr;
+    }
+    
+    PaperCutRender *render = GetRenderFromArgs(env, info);
+    if (!render || !render->engine_) {
+        return nullptr;
+    }
+    
+    bool enabled = true;
+    napi_get_value_bool(env, args[0], &enabled);
+    
+    std::lock_guard<std::mutex> lock(render->engineMutex_);
+    render->inputEnabled_ = enabled;
+    // 禁用时（捏合/平移开始）放弃未完成的笔画
+    if (!enabled && render->engine_->IsDrawing()) {
+        render->engine_->CancelDrawing();
+        render->RequestFrame(FRAME_SURFACE_ALL);
+    }
     return nullptr;
 }
 
@@ -10,7 +10,9 @@
 #include <native_window/external_window.h>
 #include <string>
 #include <memory>
+#include <mutex>
 #include "paper_cut_engine.h"
+#include "utils/frame_scheduler.h"
 #include "napi/native_api.h"
 
 class PaperCutRender {
@@ -25,18 +27,32 @@ public:
     static napi_value InitializeEngine(napi_env env, napi_callback_info info);
     static napi_value StartDrawing(napi_env env, napi_callback_info info);
     static napi_value AddPoint(napi_env env, napi_callback_info info);
+    static napi_value AddPoints(napi_env env, napi_callback_info info);
     static napi_value FinishDrawing(napi_env env, napi_callback_info info);
     static napi_value SetToolMode(napi_env env, napi_callback_info info);
     static napi_value SetFoldMode(napi_env env, napi_callback_info info);
+    static napi_value SetPreviewUnfoldMode(napi_env env, napi_callback_info info);
     static napi_value SetPaperType(napi_env env, napi_callback_info info);
     static napi_value SetPaperColor(napi_env env, napi_callback_info info);
+    static napi_value SetBackgroundColor(napi_env env, napi_callback_info info);
     static napi_value Undo(napi_env env, napi_callback_info info);
     static napi_value Redo(napi_env env, napi_callback_info info);
+    static napi_value SeekHistory(napi_env env, napi_callback_info info);
+    static napi_value GetHistoryLength(napi_env env, napi_callback_info info);
+    static napi_value GetHistoryIndex(napi_env env, napi_callback_info info);
+    static napi_value GetPaperMetrics(napi_env env, napi_callback_info info);
+    static napi_value ExportSvg(napi_env env, napi_callback_info info);
+    static napi_value ExportPng(napi_env env, napi_callback_info info);
     static napi_value Clear(napi_env env, napi_callback_info info);
     static napi_value GetActions(napi_env env, napi_callback_info info);
     static napi_value SetActions(napi_env env, napi_callback_info info);
+    static napi_value GetActionsBinary(napi_env env, napi_callback_info info);
+    static napi_value SetActionsBinary(napi_env env, napi_callback_info info);
+    static napi_value GetWorkBinary(napi_env env, napi_callback_info info);
+    static napi_value SetWorkBinary(napi_env env, napi_callback_info info);
     static napi_value SetZoom(napi_env env, napi_callback_info info);
     static napi_value SetPan(napi_env env, napi_callback_info info);
+    static napi_value SetInputEnabled(napi_env env, napi_callback_info info);
     static napi_value SetPreviewWindow(napi_env env, napi_callback_info info);
     
     // 导出NAPI接口
@@ -47,9 +63,23 @@ public:
     void SetNativeWindow(OHNativeWindow *nativeWindow);
     void SetPreviewWindow(OHNativeWindow *nativeWindow);
     
+    // 渲染线程：请求在下一个 vsync 重绘指定表面（FrameSurface 位掩码）
+    void RequestFrame(uint32_t surfaces);
+    
+    // Native 输入：XComponent 触摸/鼠标事件直接驱动引擎（屏幕坐标 -> ScreenToModel）
+    void SetViewportSize(uint64_t width, uint64_t height);
+    void OnTouchEvent(const OH_NativeXComponent_TouchEvent &event,
+                      const OH_NativeXComponent_HistoricalPoint *history, int32_t historySize);
+    void OnMouseEvent(const OH_NativeXComponent_MouseEvent &event);
+    
     // 获取实例
     static PaperCutRender *GetInstance(std::string &id);
     static void Release(std::string &id);
+    static std::string GetEditorIdForPreview(const std::string &previewId);
+    // 读取二进制参数：接受 ArrayBuffer，也接受 Uint8Array/Int8Array 视图
+    static bool GetBinaryArg(napi_env env, napi_value value, void **data, size_t *size);
+    // 解析 ArkTS 的 Action[]（getActions/setActions 的对象格式）
+    static bool ParseActionArray(napi_env env, napi_value array, std::vector<Action> *out);
     
     std::string id_;
     
@@ -60,6 +90,15 @@ private:
     OHNativeWindow *nativeWindow_ = nullptr;
     OHNativeWindow *previewWindow_ = nullptr;
     OH_NativeXComponent_Callback renderCallback_;
+    OH_NativeXComponent_MouseEvent_Callback mouseCallback_;
+    bool inputEnabled_ = true;  // ArkTS 手势（捏合/平移）期间关闭绘制输入
+    
+    // 引擎不是线程安全的：NAPI（JS 线程）与渲染线程都必须持有该锁访问 engine_
+    std::mutex engineMutex_;
+    std::unique_ptr<FrameScheduler> scheduler_;
+    
+    void EnsureScheduler();
+    void PresentFrame(uint32_t surfaces);
     
     // 从NAPI参数获取实例
     static PaperCutRender *GetRenderFromArgs(napi_env env, napi_callback_info info);
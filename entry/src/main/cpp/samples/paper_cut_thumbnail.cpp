@@ -0,0 +1,68 @@
+//
+// Created on 2026/10/17.
+// 作品缩略图实现
+//
+
+#include "paper_cut_thumbnail.h"
+#include "paper_cut_engine.h"
+#include "paper_cut_work_codec.h"
+#include "utils/png_writer.h"
+#include "utils/raster_backend_cpu.h"
+#include <cstdio>
+
+namespace {
+// 渲染效果变化（展开算法、缩略图样式）时递增，使旧缓存自然失效
+constexpr uint32_t RENDER_VERSION = 2;
+
+inline void HashBytes(uint64_t& hash, const uint8_t* data, size_t size)
+{
+    // FNV-1a 64
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001B3ULL;
+    }
+}
+} // namespace
+
+namespace PaperCutThumbnail {
+
+std::string CacheKey(const uint8_t* workData, size_t size, int pixelSize)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    const uint32_t params[2] = {RENDER_VERSION, static_cast<uint32_t>(pixelSize)};
+    HashBytes(hash, reinterpret_cast<const uint8_t*>(params), sizeof(params));
+    HashBytes(hash, workData, size);
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+    return key;
+}
+
+bool RenderPng(const uint8_t* workData, size_t size, int pixelSize, std::vector<uint8_t>* png)
+{
+    if (!png || pixelSize <= 0 || pixelSize > MAX_SIZE) {
+        return false;
+    }
+    WorkHeader header;
+    std::vector<Action> actions;
+    if (!WorkCodec::Decode(workData, size, &header, &actions)) {
+        return false;
+    }
+
+    // 与编辑器相同的数据层与预览展开路径，只是没有窗口；CPU 后端不依赖设备图形库，任意线程可用
+    PaperCutEngine engine(std::make_unique<CpuRasterBackend>());
+    if (!engine.InitializeHeadless(0, 0)) {
+        return false;
+    }
+    engine.SetFoldMode(header.foldMode);
+    engine.SetPaperType(header.paperType);
+    engine.SetPaperColor(header.paperColor);
+    engine.SetActions(actions);
+
+    std::vector<uint32_t> pixels;
+    if (!engine.RenderPreviewToPixels(pixelSize, pixelSize, &pixels)) {
+        return false;
+    }
+    return PngWriter::EncodeRgbaPremul(pixels.data(), pixelSize, pixelSize, pixelSize, png);
+}
+
+} // namespace PaperCutThumbnail
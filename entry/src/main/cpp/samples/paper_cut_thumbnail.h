@@ -0,0 +1,27 @@
+//
+// Created on 2026/10/17.
+// 作品缩略图：无窗口引擎渲染展开预览 -> PNG
+//
+// 缓存按内容寻址：键为作品数据（WorkCodec 格式，已包含动作与纸张属性）与尺寸的哈希，
+// 同一内容只渲染一次，内容变化自然得到新文件。
+//
+
+#ifndef PAPERCUTTING_PAPER_CUT_THUMBNAIL_H
+#define PAPERCUTTING_PAPER_CUT_THUMBNAIL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace PaperCutThumbnail {
+constexpr int DEFAULT_SIZE = 256;
+constexpr int MAX_SIZE = 1024;
+
+// 16 位十六进制缓存键
+std::string CacheKey(const uint8_t* workData, size_t size, int pixelSize);
+// 解码作品数据并渲染 pixelSize x pixelSize 的透明底 PNG；可在任意线程调用
+bool RenderPng(const uint8_t* workData, size_t size, int pixelSize, std::vector<uint8_t>* png);
+} // namespace PaperCutThumbnail
+
+#endif // PAPERCUTTING_PAPER_CUT_THUMBNAIL_H
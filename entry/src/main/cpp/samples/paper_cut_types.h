@@ -0,0 +1,105 @@
+//
+// Created on 2026/10/17.
+// 剪纸基础数据类型（点、工具/折叠/纸张枚举、动作）
+//
+// 不依赖 native_drawing，序列化/存储等纯 C++ 模块可以只包含本头文件。
+//
+
+#ifndef PAPERCUTTING_PAPER_CUT_TYPES_H
+#define PAPERCUTTING_PAPER_CUT_TYPES_H
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// 点结构
+struct Point {
+    float x;
+    float y;
+    
+    Point() : x(0), y(0) {}
+    Point(float x, float y) : x(x), y(y) {}
+};
+
+// 模型坐标定点精度：1/16 像素。输入点在进入命令历史前对齐到该网格，
+// 作品存储格式按同一网格量化，保存/加载无损。
+constexpr int MODEL_POINT_SUBPIXEL = 16;
+
+inline int32_t QuantizeModelCoord(float v)
+{
+    const float scaled = std::round(v * MODEL_POINT_SUBPIXEL);
+    // NaN 归零，超出 int32 的异常坐标截断（模型坐标正常在 0~2048 附近）
+    if (std::isnan(scaled)) {
+        return 0;
+    }
+    if (scaled <= -2.0e9f || scaled >= 2.0e9f) {
+        return scaled < 0 ? -2000000000 : 2000000000;
+    }
+    return static_cast<int32_t>(scaled);
+}
+
+inline float DequantizeModelCoord(int32_t q)
+{
+    return static_cast<float>(q) / MODEL_POINT_SUBPIXEL;
+}
+
+inline Point SnapToModelGrid(const Point& p)
+{
+    return Point(DequantizeModelCoord(QuantizeModelCoord(p.x)), DequantizeModelCoord(QuantizeModelCoord(p.y)));
+}
+
+// 工具类型
+enum class ToolMode {
+    SCISSORS = 0,      // 剪刀（裁剪）
+    BEZIER = 1,        // 贝塞尔曲线
+    DRAFT_PEN = 2,     // 铅笔
+    DRAFT_ERASER = 3   // 橡皮
+};
+
+// 折叠模式
+enum class FoldMode {
+    ZERO = 0,  // 不折叠（全纸）
+    ONE = 1,
+    TWO = 2,
+    THREE = 3,
+    FOUR = 4,
+    FIVE = 5,
+    SIX = 6,
+    SEVEN = 7,
+    EIGHT = 8
+};
+
+// 纸张类型
+enum class PaperType {
+    CIRCLE = 0,   // 圆形
+    SQUARE = 1    // 方形
+};
+
+// 预览展开方式。默认 CANVAS_STAMP：tile 只按像素重绘，撤销/加载的首帧代价与剪刀路径数量无关。
+// 另外两种由 setPreviewUnfoldMode 显式选择：稳定帧更快，但 POLAR_LUT 首次要构建查找表，
+// GEOMETRY 在撤销/加载后要从最后一次清空起重新合并剪刀路径（300 条时是盖印的 3~7 倍，见 unfold_bench）
+enum class PreviewUnfoldMode {
+    CANVAS_STAMP = 0,  // 画布变换：扇形 tile 旋转/镜像盖印 2N 次
+    POLAR_LUT = 1,     // 像素查找表：每个输出像素直接从 tile 取样
+    GEOMETRY = 2       // 几何展开：剩余纸张轮廓裁剪到扇形后复制 2N 份，一次光栅化
+};
+
+// 动作类型
+enum class ActionType {
+    CUT = 0,      // 裁剪
+    STROKE = 1    // 笔触
+};
+
+// 动作结构（兼容旧代码）
+struct Action {
+    std::string id;
+    ActionType type;
+    ToolMode tool;
+    std::vector<Point> points;
+    int64_t timestamp;
+    
+    Action() : type(ActionType::CUT), tool(ToolMode::SCISSORS), timestamp(0) {}
+};
+
+#endif // PAPERCUTTING_PAPER_CUT_TYPES_H
@@ -0,0 +1,267 @@
+//
+// Created on 2026/10/17.
+// 剪纸预览的对称展开实现
+//
+
+#include "paper_cut_unfold.h"
+#include <algorithm>
+#include <cmath>
+#include "utils/job_system.h"
+
+namespace {
+constexpr float TWO_PI = 6.283185307179586f;
+constexpr float START_ANGLE = -1.5707963267948966f;  // 与 PaperCutEngine 一致：扇形从 -π/2 开始
+constexpr int ROWS_PER_JOB = 32;  // 行之间没有依赖，按块分给任务系统
+
+// 两个预乘像素按 f/256 线性插值（两通道一组，避免逐字节运算）
+inline uint32_t Lerp(uint32_t a, uint32_t b, uint32_t f)
+{
+    const uint32_t inv = 256 - f;
+    uint32_t rb = (((a & 0x00FF00FFu) * inv + (b & 0x00FF00FFu) * f) >> 8) & 0x00FF00FFu;
+    uint32_t ag = (((a >> 8) & 0x00FF00FFu) * inv + ((b >> 8) & 0x00FF00FFu) * f) & 0xFF00FF00u;
+    return rb | ag;
+}
+} // namespace
+
+void PolarUnfoldLut::Build(const UnfoldGeometry& geometry)
+{
+    geometry_ = geometry;
+    built_ = false;
+    const int width = geometry.outWidth;
+    const int height = geometry.outHeight;
+    if (width <= 0 || height <= 0 || geometry.tileWidth < 2 || geometry.tileHeight < 2 ||
+        geometry.tileWidth >= INVALID || geometry.tileHeight >= INVALID) {
+        entries_.clear();
+        return;
+    }
+    entries_.resize(static_cast<size_t>(width) * static_cast<size_t>(height));
+
+    const bool isFullPaper = (geometry.foldCount <= 0);
+    const int totalSegments = isFullPaper ? 1 : geometry.foldCount * 2;
+    const float sectorAngle = TWO_PI / totalSegments;
+    // 双线性采样需要右/下邻点，左上角坐标限制在 [0, size - 2]
+    const float maxX = static_cast<float>(geometry.tileWidth - 2);
+    const float maxY = static_cast<float>(geometry.tileHeight - 2);
+
+    JobSystem::Get().ParallelFor(height, ROWS_PER_JOB, [&](int rowBegin, int rowEnd) {
+        for (int y = rowBegin; y < rowEnd; y++) {
+            Entry* row = entries_.data() + static_cast<size_t>(y) * width;
+            const float dy = static_cast<float>(y) + 0.5f - geometry.centerY;
+            for (int x = 0; x < width; x++) {
+                const float dx = static_cast<float>(x) + 0.5f - geometry.centerX;
+                float srcX = dx;
+                float srcY = dy;
+                if (!isFullPaper) {
+                    // 输出角度 -> 段号 + 段内角度；奇数段镜像：φ = start + sector - local
+                    float rel = std::atan2(dy, dx) - START_ANGLE;
+                    rel -= std::floor(rel / TWO_PI) * TWO_PI;
+                    int segment = std::min(static_cast<int>(rel / sectorAngle), totalSegments - 1);
+                    float local = rel - segment * sectorAngle;
+                    if (segment & 1) {
+                        local = sectorAngle - local;
+                    }
+                    const float radius = std::sqrt(dx * dx + dy * dy);
+                    const float phi = START_ANGLE + local;
+                    srcX = radius * std::cos(phi);
+                    srcY = radius * std::sin(phi);
+                }
+                // 像素中心对齐：tile 像素 (tx,ty) 的中心位于 (tileLeft + tx + 0.5, tileTop + ty + 0.5)
+                const float tx = srcX - static_cast<float>(geometry.tileLeft) - 0.5f;
+                const float ty = srcY - static_cast<float>(geometry.tileTop) - 0.5f;
+                if (tx < -0.5f || ty < -0.5f || tx > maxX + 1.5f || ty > maxY + 1.5f) {
+                    row[x] = Entry{INVALID, 0, 0, 0};
+                    continue;
+                }
+                const float cx = std::min(std::max(tx, 0.0f), maxX);
+                const float cy = std::min(std::max(ty, 0.0f), maxY);
+                const int ix = std::min(static_cast<int>(cx), geometry.tileWidth - 2);
+                const int iy = std::min(static_cast<int>(cy), geometry.tileHeight - 2);
+                // 小数部分按 [0,1] 截断后量化为 /256（tile 边缘外的半个像素按边缘取值）
+                float fx = std::min(std::max(tx - ix, 0.0f), 1.0f);
+                float fy = std::min(std::max(ty - iy, 0.0f), 1.0f);
+                row[x] = Entry{static_cast<uint16_t>(ix), static_cast<uint16_t>(iy),
+                               static_cast<uint8_t>(std::min(255.0f, fx * 256.0f)),
+                               static_cast<uint8_t>(std::min(255.0f, fy * 256.0f))};
+            }
+        }
+    });
+    built_ = true;
+}
+
+void PolarUnfoldLut::Gather(const uint32_t* tile, size_t tileStride, uint32_t* out, size_t outStride) const
+{
+    if (!built_ || !tile || !out) return;
+    const int width = geometry_.outWidth;
+    const int height = geometry_.outHeight;
+
+    JobSystem::Get().ParallelFor(height, ROWS_PER_JOB, [&](int rowBegin, int rowEnd) {
+        for (int y = rowBegin; y < rowEnd; y++) {
+            const Entry* row = entries_.data() + static_cast<size_t>(y) * width;
+            uint32_t* dst = out + static_cast<size_t>(y) * outStride;
+            for (int x = 0; x < width; x++) {
+                const Entry& e = row[x];
+                if (e.x == INVALID) {
+                    dst[x] = 0;
+                    continue;
+                }
+                const uint32_t* p0 = tile + static_cast<size_t>(e.y) * tileStride + e.x;
+                const uint32_t* p1 = p0 + tileStride;
+                uint32_t top = Lerp(p0[0], p0[1], e.fx);
+                uint32_t bottom = Lerp(p1[0], p1[1], e.fx);
+                dst[x] = Lerp(top, bottom, e.fy);
+            }
+        }
+    });
+}
+
+void SymmetryExpander::Configure(int foldCount, const RasterMatrix& toDevice)
+{
+    segments_.clear();
+    clip_ = foldCount > 0;
+    if (!clip_) {
+        segments_.push_back({toDevice, false});
+        return;
+    }
+    const int totalSegments = foldCount * 2;
+    const float sweep = TWO_PI / totalSegments;
+    // 起始边方向 u、结束边方向 v：扇形内 cross(u, p) >= 0 且 cross(p, v) >= 0
+    const float endAngle = START_ANGLE + sweep;
+    startNormalX_ = -std::sin(START_ANGLE);
+    startNormalY_ = std::cos(START_ANGLE);
+    endNormalX_ = std::sin(endAngle);
+    endNormalY_ = -std::cos(endAngle);
+    segments_.reserve(totalSegments);
+    for (int i = 0; i < totalSegments; i++) {
+        // 偶数段旋转 i * sweep；奇数段沿角度为 boundary 的直线镜像：R(2 * boundary) * diag(1, -1)
+        const bool mirrored = (i % 2) != 0;
+        const float angle = mirrored ? 2.0f * (START_ANGLE + ((i + 1) / 2) * sweep) : i * sweep;
+        const float c = std::cos(angle);
+        const float s = std::sin(angle);
+        RasterMatrix segment;
+        segment.a = c;
+        segment.b = s;
+        segment.c = mirrored ? s : -s;
+        segment.d = mirrored ? -c : c;
+        segments_.push_back({toDevice.Concat(segment), mirrored});
+    }
+}
+
+void SymmetryExpander::Expand(const RasterPoint* points, size_t count, std::vector<RasterPath::Contour>* out)
+{
+    if (!points || !out || count < 3 || segments_.empty()) {
+        return;
+    }
+    Emit(ClipToWedge(points, count), out);
+}
+
+void SymmetryExpander::Expand(const std::vector<RasterPath::Contour>& contours,
+                              std::vector<RasterPath::Contour>* out)
+{
+    for (const auto& contour : contours) {
+        Expand(contour.points.data(), contour.points.size(), out);
+    }
+}
+
+void SymmetryExpander::Replicate(const std::vector<RasterPath::Contour>& contours,
+                                 std::vector<RasterPath::Contour>* out)
+{
+    if (!out || segments_.empty()) {
+        return;
+    }
+    for (const auto& contour : contours) {
+        const size_t count = contour.points.size();
+        if (count < 3) {
+            continue;
+        }
+        xs_.resize(count);
+        ys_.resize(count);
+        for (size_t k = 0; k < count; k++) {
+            xs_[k] = contour.points[k].x;
+            ys_[k] = contour.points[k].y;
+        }
+        Emit(count, out);
+    }
+}
+
+size_t SymmetryExpander::ClipToWedge(const RasterPoint* points, size_t count)
+{
+    xs_.resize(count);
+    ys_.resize(count);
+    for (size_t k = 0; k < count; k++) {
+        xs_[k] = points[k].x;
+        ys_[k] = points[k].y;
+    }
+    if (!clip_) {
+        return count;
+    }
+    // 凸区域逐个半平面裁剪（Sutherland–Hodgman）。沿边界产生的退化边面积为零，不影响覆盖率
+    ClipHalfPlane(startNormalX_, startNormalY_, xs_, ys_, &tmpX_, &tmpY_);
+    ClipHalfPlane(endNormalX_, endNormalY_, tmpX_, tmpY_, &xs_, &ys_);
+    return xs_.size() >= 3 ? xs_.size() : 0;
+}
+
+void SymmetryExpander::ClipHalfPlane(float nx, float ny, const std::vector<float>& xs, const std::vector<float>& ys,
+                                     std::vector<float>* outX, std::vector<float>* outY)
+{
+    outX->clear();
+    outY->clear();
+    const size_t count = xs.size();
+    if (count == 0) {
+        return;
+    }
+    float px = xs[count - 1];
+    float py = ys[count - 1];
+    float pd = nx * px + ny * py;
+    for (size_t k = 0; k < count; k++) {
+        const float qx = xs[k];
+        const float qy = ys[k];
+        const float qd = nx * qx + ny * qy;
+        if ((pd >= 0.0f) != (qd >= 0.0f)) {
+            // 交点在边界直线上
+            const float t = pd / (pd - qd);
+            outX->push_back(px + (qx - px) * t);
+            outY->push_back(py + (qy - py) * t);
+        }
+        if (qd >= 0.0f) {
+            outX->push_back(qx);
+            outY->push_back(qy);
+        }
+        px = qx;
+        py = qy;
+        pd = qd;
+    }
+}
+
+void SymmetryExpander::Emit(size_t count, std::vector<RasterPath::Contour>* out) const
+{
+    if (count < 3) {
+        return;
+    }
+    const float* xs = xs_.data();
+    const float* ys = ys_.data();
+    for (const Segment& segment : segments_) {
+        out->emplace_back();
+        RasterPath::Contour& contour = out->back();
+        contour.closed = true;
+        contour.points.resize(count);
+        RasterPoint* dst = contour.points.data();
+        const float a = segment.matrix.a;
+        const float b = segment.matrix.b;
+        const float c = segment.matrix.c;
+        const float d = segment.matrix.d;
+        const float tx = segment.matrix.tx;
+        const float ty = segment.matrix.ty;
+        // 每段一个仿射，坐标分量连续存放，循环只有乘加（编译器向量化）；镜像段倒序写出保持方向
+        if (segment.mirrored) {
+            for (size_t k = 0; k < count; k++) {
+                dst[count - 1 - k].x = a * xs[k] + c * ys[k] + tx;
+                dst[count - 1 - k].y = b * xs[k] + d * ys[k] + ty;
+            }
+        } else {
+            for (size_t k = 0; k < count; k++) {
+                dst[k].x = a * xs[k] + c * ys[k] + tx;
+                dst[k].y = b * xs[k] + d * ys[k] + ty;
+            }
+        }
+    }
+}
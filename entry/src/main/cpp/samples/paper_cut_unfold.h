@@ -0,0 +1,105 @@
+//
+// Created on 2026/10/17.
+// 剪纸预览的对称展开：像素空间的极坐标查找表（LUT）与几何空间的多边形展开
+//
+// 纯 C++ 实现，不依赖 native_drawing，可以在 Linux 上单独编译做基准测试。
+//
+
+#ifndef PAPERCUTTING_PAPER_CUT_UNFOLD_H
+#define PAPERCUTTING_PAPER_CUT_UNFOLD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "utils/raster_backend.h"
+
+// 展开几何：输出图与扇形 tile 共用“中心原点”的像素坐标系
+struct UnfoldGeometry {
+    int foldCount = 0;      // 折数 N（0 表示不折叠，整张纸即一个 tile）；展开后共 2N 段
+    int outWidth = 0;       // 输出图尺寸
+    int outHeight = 0;
+    float centerX = 0.0f;   // 中心原点在输出图中的像素位置
+    float centerY = 0.0f;
+    int tileLeft = 0;       // tile 左上角在中心原点坐标系中的位置
+    int tileTop = 0;
+    int tileWidth = 0;
+    int tileHeight = 0;
+
+    bool operator==(const UnfoldGeometry& other) const
+    {
+        return foldCount == other.foldCount && outWidth == other.outWidth && outHeight == other.outHeight &&
+               centerX == other.centerX && centerY == other.centerY && tileLeft == other.tileLeft &&
+               tileTop == other.tileTop && tileWidth == other.tileWidth && tileHeight == other.tileHeight;
+    }
+    bool operator!=(const UnfoldGeometry& other) const { return !(*this == other); }
+};
+
+// 输出像素 -> tile 像素的映射表。
+// 每个输出像素记录 tile 中双线性采样的左上角索引和小数权重，
+// 奇数段的镜像已折叠进表里，因此展开只是一遍与像素数成正比的 gather，
+// 与折数、命令历史长度都无关。
+class PolarUnfoldLut {
+public:
+    // 几何不变时直接复用已有的表
+    bool Matches(const UnfoldGeometry& geometry) const { return built_ && geometry_ == geometry; }
+    void Build(const UnfoldGeometry& geometry);
+
+    // tile / out 均为 32 位预乘像素，stride 以像素为单位；tile 外的输出像素写 0（透明）
+    void Gather(const uint32_t* tile, size_t tileStride, uint32_t* out, size_t outStride) const;
+
+    const UnfoldGeometry& GetGeometry() const { return geometry_; }
+
+private:
+    struct Entry {
+        uint16_t x;     // tile 中双线性采样的左上角坐标，x == INVALID 表示落在 tile 外
+        uint16_t y;
+        uint8_t fx;     // 水平/垂直方向的小数权重（/256）
+        uint8_t fy;
+    };
+    static constexpr uint16_t INVALID = 0xFFFF;
+
+    UnfoldGeometry geometry_;
+    std::vector<Entry> entries_;
+    bool built_ = false;
+};
+
+// 几何空间的对称展开：多边形先与第一个扇形求交（扇形角不超过 π，即两条过原点的半平面，
+// 解析裁剪），再用 2N 个仿射变换批量复制到所有段（偶数段旋转、奇数段沿扇形边界镜像，
+// 与 RenderPreviewCanvas 一致）。镜像段反转顶点顺序，所有副本方向一致，
+// 相邻段沿接缝的面积精确相加，整个展开结果按非零规则一次光栅化即可，不需要画布裁剪状态。
+class SymmetryExpander {
+public:
+    // foldCount 为 0 时不折叠：不裁剪，只有一个变换。toDevice 为模型坐标到输出坐标的变换，合并进每段
+    void Configure(int foldCount, const RasterMatrix& toDevice);
+    int GetSegmentCount() const { return static_cast<int>(segments_.size()); }
+
+    // 与第一个扇形求交后展开到所有段，结果追加到 out（轮廓按原方向，镜像段已反转）
+    void Expand(const RasterPoint* points, size_t count, std::vector<RasterPath::Contour>* out);
+    void Expand(const std::vector<RasterPath::Contour>& contours, std::vector<RasterPath::Contour>* out);
+    // 只复制不裁剪：调用方已保证轮廓落在第一个扇形内
+    void Replicate(const std::vector<RasterPath::Contour>& contours, std::vector<RasterPath::Contour>* out);
+
+private:
+    struct Segment {
+        RasterMatrix matrix;
+        bool mirrored;
+    };
+    // 裁剪结果放在 xs_ / ys_（SoA），返回顶点数
+    size_t ClipToWedge(const RasterPoint* points, size_t count);
+    static void ClipHalfPlane(float nx, float ny, const std::vector<float>& xs, const std::vector<float>& ys,
+                              std::vector<float>* outX, std::vector<float>* outY);
+    void Emit(size_t count, std::vector<RasterPath::Contour>* out) const;
+
+    std::vector<Segment> segments_;
+    bool clip_ = false;
+    float startNormalX_ = 0.0f;  // 两条边界的内法线：n · p >= 0 在扇形内
+    float startNormalY_ = 0.0f;
+    float endNormalX_ = 0.0f;
+    float endNormalY_ = 0.0f;
+    std::vector<float> xs_;
+    std::vector<float> ys_;
+    std::vector<float> tmpX_;
+    std::vector<float> tmpY_;
+};
+
+#endif // PAPERCUTTING_PAPER_CUT_UNFOLD_H
@@ -0,0 +1,189 @@
+//
+// Created on 2026/10/17.
+// 作品紧凑存储格式实现
+//
+
+#include "paper_cut_work_codec.h"
+#include <utility>
+
+namespace {
+constexpr size_t HEADER_SIZE = 12;
+constexpr uint8_t MAX_FOLD = static_cast<uint8_t>(FoldMode::EIGHT);
+constexpr uint8_t MAX_PAPER = static_cast<uint8_t>(PaperType::SQUARE);
+constexpr uint8_t MAX_TOOL = static_cast<uint8_t>(ToolMode::DRAFT_ERASER);
+constexpr uint8_t MAX_TYPE = static_cast<uint8_t>(ActionType::STROKE);
+
+inline uint32_t ZigZag(int32_t v)
+{
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline int32_t UnZigZag(uint32_t v)
+{
+    return static_cast<int32_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+inline void PutVarint(std::vector<uint8_t>& out, uint64_t v)
+{
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+inline void PutU32(std::vector<uint8_t>& out, uint32_t v)
+{
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    }
+}
+
+// 顺序读取器：任何越界读取都会置 ok=false，调用方最后统一检查
+struct Reader {
+    const uint8_t* cursor;
+    const uint8_t* end;
+    bool ok = true;
+
+    uint8_t U8()
+    {
+        if (cursor >= end) {
+            ok = false;
+            return 0;
+        }
+        return *cursor++;
+    }
+
+    uint32_t U32()
+    {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) {
+            v |= static_cast<uint32_t>(U8()) << (8 * i);
+        }
+        return v;
+    }
+
+    uint64_t Varint()
+    {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uint8_t b = U8();
+            v |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80) || !ok) {
+                return v;
+            }
+        }
+        ok = false;
+        return 0;
+    }
+};
+} // namespace
+
+namespace WorkCodec {
+
+bool Encode(const WorkHeader& header, const std::vector<Action>& actions, std::vector<uint8_t>* out)
+{
+    if (!out) {
+        return false;
+    }
+    size_t pointCount = 0;
+    for (const auto& action : actions) {
+        pointCount += action.points.size();
+    }
+
+    std::vector<uint8_t> buf;
+    // 典型差分 2~4 字节/点，预留避免反复扩容
+    buf.reserve(HEADER_SIZE + actions.size() * 4 + pointCount * 4 + 16);
+    PutU32(buf, MAGIC);
+    buf.push_back(VERSION);
+    buf.push_back(static_cast<uint8_t>(header.foldMode));
+    buf.push_back(static_cast<uint8_t>(header.paperType));
+    buf.push_back(0);
+    PutU32(buf, header.paperColor);
+    PutVarint(buf, actions.size());
+    PutVarint(buf, pointCount);
+
+    int32_t lastX = 0;
+    int32_t lastY = 0;
+    for (const auto& action : actions) {
+        buf.push_back(static_cast<uint8_t>((static_cast<uint8_t>(action.type) << 4) |
+                                           static_cast<uint8_t>(action.tool)));
+        PutVarint(buf, action.points.size());
+        for (const auto& point : action.points) {
+            const int32_t x = QuantizeModelCoord(point.x);
+            const int32_t y = QuantizeModelCoord(point.y);
+            // 以 uint32 做差，溢出时按补码回绕，解码端同样回绕即可还原
+            PutVarint(buf, ZigZag(static_cast<int32_t>(static_cast<uint32_t>(x) - static_cast<uint32_t>(lastX))));
+            PutVarint(buf, ZigZag(static_cast<int32_t>(static_cast<uint32_t>(y) - static_cast<uint32_t>(lastY))));
+            lastX = x;
+            lastY = y;
+        }
+    }
+    *out = std::move(buf);
+    return true;
+}
+
+bool Decode(const uint8_t* data, size_t size, WorkHeader* header, std::vector<Action>* actions)
+{
+    if (!data || !header || !actions || size < HEADER_SIZE) {
+        return false;
+    }
+    Reader reader{data, data + size};
+    const uint32_t magic = reader.U32();
+    const uint8_t version = reader.U8();
+    const uint8_t fold = reader.U8();
+    const uint8_t paper = reader.U8();
+    reader.U8();
+    const uint32_t color = reader.U32();
+    if (magic != MAGIC || version == 0 || version > VERSION || fold > MAX_FOLD || paper > MAX_PAPER) {
+        return false;
+    }
+
+    const uint64_t actionCount = reader.Varint();
+    const uint64_t pointCount = reader.Varint();
+    // 每个动作至少 2 字节、每个点至少 2 字节，据此拒绝伪造的超大计数
+    const uint64_t remaining = static_cast<uint64_t>(reader.end - reader.cursor);
+    if (!reader.ok || actionCount > remaining / 2 || pointCount > remaining / 2) {
+        return false;
+    }
+
+    std::vector<Action> result(static_cast<size_t>(actionCount));
+    uint64_t pointsLeft = pointCount;
+    int32_t lastX = 0;
+    int32_t lastY = 0;
+    for (auto& action : result) {
+        const uint8_t kind = reader.U8();
+        const uint64_t n = reader.Varint();
+        const uint8_t type = kind >> 4;
+        const uint8_t tool = kind & 0x0F;
+        if (!reader.ok || type > MAX_TYPE || tool > MAX_TOOL || n > pointsLeft) {
+            return false;
+        }
+        pointsLeft -= n;
+        action.type = static_cast<ActionType>(type);
+        action.tool = static_cast<ToolMode>(tool);
+        action.points.resize(static_cast<size_t>(n));
+        for (auto& point : action.points) {
+            lastX = static_cast<int32_t>(static_cast<uint32_t>(lastX) +
+                                         static_cast<uint32_t>(UnZigZag(static_cast<uint32_t>(reader.Varint()))));
+            lastY = static_cast<int32_t>(static_cast<uint32_t>(lastY) +
+                                         static_cast<uint32_t>(UnZigZag(static_cast<uint32_t>(reader.Varint()))));
+            point.x = DequantizeModelCoord(lastX);
+            point.y = DequantizeModelCoord(lastY);
+        }
+        if (!reader.ok) {
+            return false;
+        }
+    }
+    if (pointsLeft != 0 || reader.cursor != reader.end) {
+        return false;
+    }
+
+    header->foldMode = static_cast<FoldMode>(fold);
+    header->paperType = static_cast<PaperType>(paper);
+    header->paperColor = color;
+    *actions = std::move(result);
+    return true;
+}
+
+} // namespace WorkCodec
@@ -0,0 +1,39 @@
+//
+// Created on 2026/10/17.
+// 作品紧凑存储格式（折叠/纸张/颜色 + 量化差分编码的动作列表）
+//
+// 纯 C++ 实现，不依赖 NAPI / native_drawing。
+//
+
+#ifndef PAPERCUTTING_PAPER_CUT_WORK_CODEC_H
+#define PAPERCUTTING_PAPER_CUT_WORK_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "paper_cut_types.h"
+
+// 作品头：恢复编辑状态所需的纸张参数
+struct WorkHeader {
+    FoldMode foldMode = FoldMode::ZERO;
+    PaperType paperType = PaperType::CIRCLE;
+    uint32_t paperColor = 0xFFFF0000;
+};
+
+// 布局：
+//   magic "PCWK" u32 | version u8 | foldMode u8 | paperType u8 | reserved u8 | paperColor u32   （小端）
+//   actionCount varint | pointCount varint
+//   每个动作：(type << 4 | tool) u8 | pointCount varint | 每点 zigzag varint dx, dy
+// 坐标按 MODEL_POINT_SUBPIXEL 定点化；差分跨动作连续（首点相对上一动作末点），
+// 相邻采样点间距约 10px，绝大多数差分落在 1~2 字节内。
+// 动作 id / timestamp 不落盘：SetActions 重建命令时会重新生成。
+namespace WorkCodec {
+constexpr uint32_t MAGIC = 0x4B574350;  // "PCWK"
+constexpr uint8_t VERSION = 1;
+
+bool Encode(const WorkHeader& header, const std::vector<Action>& actions, std::vector<uint8_t>* out);
+// 数据截断、版本不支持或枚举越界时返回 false，且不修改输出
+bool Decode(const uint8_t* data, size_t size, WorkHeader* header, std::vector<Action>* actions);
+} // namespace WorkCodec
+
+#endif // PAPERCUTTING_PAPER_CUT_WORK_CODEC_H
@@ -34,7 +34,6 @@
 #include <native_drawing/drawing_mask_filter.h>
 #include <native_drawing/drawing_matrix.h>
 #include <map>
-#include <sys/mman.h>
 #include "common/log_common.h"
 #include "sample_graphics.h"
 #include "utils/adaptation_util.h"
@@ -210,40 +209,27 @@ void SampleGraphics::SetHeight(uint64_t height) { height_ = height; }
 
 void SampleGraphics::SetNativeWindow(OHNativeWindow *nativeWindow) { nativeWindow_ = nativeWindow; }
 
-void SampleGraphics::Prepare()
+bool SampleGraphics::Prepare(OH_Drawing_AlphaFormat alphaFormat)
 {
     if (nativeWindow_ == nullptr) {
         SAMPLE_LOGE("nativeWindow_ is nullptr");
-        return;
+        return false;
     }
     // 这里的nativeWindow是从上一步骤中的回调函数中获得的
-    // 通过 OH_NativeWindow_NativeWindowRequestBuffer 获取 OHNativeWindowBuffer 实例
-    int ret = OH_NativeWindow_NativeWindowRequestBuffer(nativeWindow_, &buffer_, &fenceFd_);
-    SAMPLE_LOGI("request buffer ret = %{public}d", ret);
-    // 通过 OH_NativeWindow_GetBufferHandleFromNative 获取 buffer 的 handle
-    bufferHandle_ = OH_NativeWindow_GetBufferHandleFromNative(buffer_);
-    // 使用系统mmap接口拿到bufferHandle的内存虚拟地址
-    mappedAddr_ = static_cast<uint32_t *>(
-        mmap(bufferHandle_->virAddr, bufferHandle_->size, PROT_READ | PROT_WRITE, MAP_SHARED, bufferHandle_->fd, 0));
-    if (mappedAddr_ == MAP_FAILED) {
-        SAMPLE_LOGE("mmap failed");
-    }
+    // NativeWindowFrame 内部完成 RequestBuffer、等待 fence、mmap，并把画布直接绑定到 buffer 内存
+    frame_ = std::make_unique<NativeWindowFrame>(nativeWindow_);
+    if (!frame_->Begin(alphaFormat)) {
+        SAMPLE_LOGE("begin native window frame failed");
+        frame_.reset();
+        return false;
+    }
+    return true;
 }
 
 void SampleGraphics::Create()
 {
-    uint32_t width = static_cast<uint32_t>(bufferHandle_->stride / 4);
-    // 创建一个bitmap对象
-    cScreenBitmap_ = OH_Drawing_BitmapCreate();
-    // 定义bitmap的像素格式
-    OH_Drawing_BitmapFormat cFormat{COLOR_FORMAT_RGBA_8888, ALPHA_FORMAT_OPAQUE};
-    // 构造对应格式的bitmap
-    OH_Drawing_BitmapBuild(cScreenBitmap_, width, height_, &cFormat);
-
-    // 创建一个canvas对象
-    cScreenCanvas_ = OH_Drawing_CanvasCreate();
-    // 将画布与bitmap绑定，画布画的内容会输出到绑定的bitmap内存中
-    OH_Drawing_CanvasBind(cScreenCanvas_, cScreenBitmap_);
+    // 屏幕画布即 buffer 画布，绘制内容直接写入 NativeWindow buffer
+    cScreenCanvas_ = frame_->GetCanvas();
     // 使用白色清除画布内容
     OH_Drawing_CanvasClear(cScreenCanvas_, OH_Drawing_ColorSetArgb(rgbaMax_, rgbaMax_, rgbaMax_, rgbaMax_));
 }
@@ -266,28 +252,16 @@ void SampleGraphics::CreateByCPU()
     // 将背景设置为白色
     OH_Drawing_CanvasClear(cCPUCanvas_, OH_Drawing_ColorSetArgb(rgbaMax_, rgbaMax_, rgbaMax_, rgbaMax_));
     
-    // 创建一个bitmap对象
-    cScreenBitmap_ = OH_Drawing_BitmapCreate();
-    // 构造对应格式的bitmap
-    OH_Drawing_BitmapBuild(cScreenBitmap_, width_, height_, &cFormat);
-    // 创建一个canvas对象
-    cScreenCanvas_ = OH_Drawing_CanvasCreate();
-    // 将Canvas与bitmap绑定，Canvas绘制的内容会输出到绑定的bitmap内存中
-    OH_Drawing_CanvasBind(cScreenCanvas_, cScreenBitmap_);
+    // 屏幕画布直接使用 buffer 画布
+    cScreenCanvas_ = frame_->GetCanvas();
+    OH_Drawing_CanvasClear(cScreenCanvas_, OH_Drawing_ColorSetArgb(rgbaMax_, rgbaMax_, rgbaMax_, rgbaMax_));
 }
 
 void SampleGraphics::CreateByGPU()
 {
-    // 创建一个bitmap对象
-    cScreenBitmap_ = OH_Drawing_BitmapCreate();
-    // 定义bitmap的像素格式
-    OH_Drawing_BitmapFormat cFormat{COLOR_FORMAT_RGBA_8888, ALPHA_FORMAT_OPAQUE};
-    // 构造对应格式的bitmap
-    OH_Drawing_BitmapBuild(cScreenBitmap_, width_, height_, &cFormat);
-    // 创建一个canvas对象
-    cScreenCanvas_ = OH_Drawing_CanvasCreate();
-    // 将画布与bitmap绑定，画布画的内容会输出到绑定的bitmap内存中
-    OH_Drawing_CanvasBind(cScreenCanvas_, cScreenBitmap_);
+    // 屏幕画布直接使用 buffer 画布
+    cScreenCanvas_ = frame_->GetCanvas();
+    OH_Drawing_CanvasClear(cScreenCanvas_, OH_Drawing_ColorSetArgb(rgbaMax_, rgbaMax_, rgbaMax_, rgbaMax_));
     
     // 设置宽高（按需设定）
     int32_t cWidth = 800;
@@ -309,33 +283,14 @@ void SampleGraphics::CreateByGPU()
 
 void SampleGraphics::DisPlay()
 {
-    // 画完后获取像素地址，地址指向的内存包含画布画的像素数据
-    void *bitmapAddr = OH_Drawing_BitmapGetPixels(cScreenBitmap_);
-    uint32_t *value = static_cast<uint32_t *>(bitmapAddr);
-
-    uint32_t *pixel = static_cast<uint32_t *>(mappedAddr_); // 使用mmap获取到的地址来访问内存
-    if (pixel == nullptr) {
-        SAMPLE_LOGE("pixel is null");
-        return;
-    }
-    if (value == nullptr) {
-        SAMPLE_LOGE("value is null");
+    if (frame_ == nullptr) {
+        SAMPLE_LOGE("frame is null");
         return;
     }
-    for (uint32_t x = 0; x < width_; x++) {
-        for (uint32_t y = 0; y < height_; y++) {
-            *pixel++ = *value++;
-        }
-    }
-    // 设置刷新区域，如果Region中的Rect为nullptr,或者rectNumber为0，则认为OHNativeWindowBuffer全部有内容更改。
-    Region region{nullptr, 0};
-    // 通过OH_NativeWindow_NativeWindowFlushBuffer 提交给消费者使用，例如：显示在屏幕上。
-    OH_NativeWindow_NativeWindowFlushBuffer(nativeWindow_, buffer_, fenceFd_, region);
-    // 内存使用完记得去掉内存映射
-    int result = munmap(mappedAddr_, bufferHandle_->size);
-    if (result == -1) {
-        SAMPLE_LOGE("munmap failed!");
-    }
+    // 画布已直接绑定 buffer 内存，无需再逐像素拷贝；提交给消费者使用，例如：显示在屏幕上。
+    cScreenCanvas_ = nullptr;
+    frame_->Flush();
+    frame_.reset();
 }
 
 void SampleGraphics::DisPlayCPU()
@@ -381,7 +336,12 @@ void SampleGraphics::InitDrawFunction(std::string id)
 void SampleGraphics::DoRender(SampleGraphics *render, char* canvasType, char* shapeType)
 {
     SAMPLE_LOGI("DoRender");
-    render->Prepare();
+    // CPU 离屏位图带透明度，贴到屏幕时需要 PREMUL；其余直接绘制到不透明屏幕
+    OH_Drawing_AlphaFormat alphaFormat =
+        (strcmp(canvasType, "CanvasGetByCPU") == 0) ? ALPHA_FORMAT_PREMUL : ALPHA_FORMAT_OPAQUE;
+    if (!render->Prepare(alphaFormat)) {
+        return;
+    }
     // 不同画布
     if (strcmp(canvasType, "CanvasGet") == 0) {
             SAMPLE_LOGI("CanvasGet");
@@ -526,34 +486,29 @@ napi_value SampleGraphics::DrawImage(napi_env env, napi_callback_info info)
 
 SampleGraphics::~SampleGraphics()
 {
-    // 销毁canvas对象
-    OH_Drawing_CanvasDestroy(cScreenCanvas_);
+    // 屏幕画布归 frame_ 所有，未提交的 buffer 会在 frame_ 析构时归还
     cScreenCanvas_ = nullptr;
+    frame_.reset();
+    // 销毁canvas对象
     OH_Drawing_CanvasDestroy(cCPUCanvas_);
     cCPUCanvas_ = nullptr;
     // 销毁bitmap对象
-    OH_Drawing_BitmapDestroy(cScreenBitmap_);
-    cScreenBitmap_ = nullptr;
     OH_Drawing_BitmapDestroy(cOffScreenBitmap_);
     cOffScreenBitmap_ = nullptr;
     
-    buffer_ = nullptr;
-    bufferHandle_ = nullptr;
     nativeWindow_ = nullptr;
-    mappedAddr_ = nullptr;
     DeInitializeEglContext();
 }
 
 void SampleGraphics::Destroy()
 {
-    // 销毁canvas对象
-    OH_Drawing_CanvasDestroy(cScreenCanvas_);
+    // 屏幕画布归 frame_ 所有，未提交的 buffer 会在 frame_ 析构时归还
     cScreenCanvas_ = nullptr;
+    frame_.reset();
+    // 销毁canvas对象
     OH_Drawing_CanvasDestroy(cCPUCanvas_);
     cCPUCanvas_ = nullptr;
     // 销毁bitmap对象
-    OH_Drawing_BitmapDestroy(cScreenBitmap_);
-    cScreenBitmap_ = nullptr;
     OH_Drawing_BitmapDestroy(cOffScreenBitmap_);
     cOffScreenBitmap_ = nullptr;
     DeInitializeEglContext();
@@ -24,6 +24,7 @@
 #include <native_drawing/drawing_brush.h>
 #include <native_drawing/drawing_path.h>
 #include <cstdint>
+#include <memory>
 #include <unordered_map>
 #include <string>
 #include <EGL/egl.h>
@@ -31,6 +32,7 @@
 #include <GLES3/gl3.h>
 #include "napi/native_api.h"
 #include <multimedia/image_framework/image_pixel_map_mdk.h>
+#include "utils/native_window_frame.h"
 
 
 class SampleGraphics {
@@ -71,7 +73,7 @@ public:
     void DrawRegion(OH_Drawing_Canvas *canvas);
     
     // 创建画布及绘图结果显示
-    void Prepare();
+    bool Prepare(OH_Drawing_AlphaFormat alphaFormat);
     void Create();
     void CreateByCPU();
     void CreateByGPU();
@@ -126,7 +128,7 @@ private:
     EGLContext EGLContext_ = EGL_NO_CONTEXT;
     EGLSurface EGLSurface_ = nullptr;
     
-    OH_Drawing_Bitmap *cScreenBitmap_ = nullptr;
+    // 屏幕画布直接绑定到 NativeWindow buffer，由 frame_ 持有
     OH_Drawing_Canvas *cScreenCanvas_ = nullptr;
     OH_Drawing_Bitmap *cOffScreenBitmap_ = nullptr;
     OH_Drawing_Canvas *cCPUCanvas_ = nullptr;
@@ -134,10 +136,7 @@ private:
     NativePixelMap *nativePixelMap_ = nullptr;
     
     OHNativeWindow *nativeWindow_ = nullptr;
-    uint32_t *mappedAddr_ = nullptr;
-    BufferHandle *bufferHandle_ = nullptr;
-    struct NativeWindowBuffer *buffer_ = nullptr;
-    int fenceFd_ = 0;
+    std::unique_ptr<NativeWindowFrame> frame_;
     
     const uint16_t rgbaMin_ = 0x00;
     const uint16_t rgbaMax_ = 0xFF;
@@ -0,0 +1,228 @@
+//
+// Created on 2026/10/17.
+// 动作二进制格式：编码/解码/再编码逐字节一致，截断与损坏的输入全部拒绝且不修改输出
+//
+
+#include <random>
+#include "samples/paper_cut_action_codec.h"
+#include "test_common.h"
+
+namespace {
+constexpr size_t HEADER_SIZE = 20;
+constexpr size_t ACTION_ENTRY_SIZE = 16;
+
+std::vector<Action> RandomActions(std::mt19937& rng, int count)
+{
+    std::uniform_real_distribution<float> coord(-1100.0f, 1100.0f);
+    std::vector<Action> actions;
+    for (int i = 0; i < count; i++) {
+        Action action;
+        action.tool = static_cast<ToolMode>(rng() % 4);
+        action.type = action.tool == ToolMode::SCISSORS || action.tool == ToolMode::BEZIER ? ActionType::CUT
+                                                                                          : ActionType::STROKE;
+        // id 长度 0~12，含多字节 UTF-8，使 id 块需要补齐
+        const int idLength = static_cast<int>(rng() % 5);
+        for (int k = 0; k < idLength; k++) {
+            action.id += k % 2 == 0 ? "a" : "剪";
+        }
+        action.timestamp = static_cast<int64_t>(rng()) << 20 | rng() % 1000;
+        const int pointCount = static_cast<int>(rng() % 60);
+        for (int k = 0; k < pointCount; k++) {
+            action.points.emplace_back(coord(rng), coord(rng));
+        }
+        actions.push_back(std::move(action));
+    }
+    return actions;
+}
+
+bool SameActions(const std::vector<Action>& a, const std::vector<Action>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].id != b[i].id || a[i].type != b[i].type || a[i].tool != b[i].tool ||
+            a[i].timestamp != b[i].timestamp || a[i].points.size() != b[i].points.size()) {
+            return false;
+        }
+        for (size_t j = 0; j < a[i].points.size(); j++) {
+            if (a[i].points[j].x != b[i].points[j].x || a[i].points[j].y != b[i].points[j].y) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void Patch(std::vector<uint8_t>* bytes, size_t offset, T value)
+{
+    std::memcpy(bytes->data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T Read(const std::vector<uint8_t>& bytes, size_t offset)
+{
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+// 解码失败的输入：返回 false，且 out 保持调用前的内容
+bool RejectsUntouched(const std::vector<uint8_t>& bytes)
+{
+    Action sentinel;
+    sentinel.id = "sentinel";
+    sentinel.points.emplace_back(1.0f, 2.0f);
+    std::vector<Action> out(1, sentinel);
+    const bool decoded = ActionBinaryCodec::Decode(bytes.data(), bytes.size(), &out);
+    return !decoded && SameActions(out, std::vector<Action>(1, sentinel));
+}
+
+void TestRoundTrip()
+{
+    std::mt19937 rng(5);
+    const std::vector<Action> actions = RandomActions(rng, 50);
+    std::vector<uint8_t> bytes;
+    CHECK(ActionBinaryCodec::Encode(actions, &bytes));
+    CHECK(bytes.size() == ActionBinaryCodec::EncodedSize(actions));
+    CHECK(bytes.size() % 4 == 0);
+
+    std::vector<Action> decoded;
+    CHECK(ActionBinaryCodec::Decode(bytes.data(), bytes.size(), &decoded));
+    CHECK(SameActions(decoded, actions));
+    std::vector<uint8_t> again;
+    CHECK(ActionBinaryCodec::Encode(decoded, &again));
+    CHECK(again == bytes);
+
+    // 空列表只有头部
+    std::vector<uint8_t> empty;
+    CHECK(ActionBinaryCodec::Encode({}, &empty));
+    CHECK(empty.size() == HEADER_SIZE);
+    decoded = actions;
+    CHECK(ActionBinaryCodec::Decode(empty.data(), empty.size(), &decoded));
+    CHECK(decoded.empty());
+
+    // 调用方内存大小不符时拒绝编码
+    std::vector<uint8_t> buffer(bytes.size() + 4);
+    CHECK(!ActionBinaryCodec::Encode(actions, buffer.data(), buffer.size()));
+    CHECK(!ActionBinaryCodec::Encode(actions, nullptr, bytes.size()));
+}
+
+void TestTruncation()
+{
+    std::mt19937 rng(6);
+    const std::vector<Action> actions = RandomActions(rng, 12);
+    std::vector<uint8_t> bytes;
+    CHECK(ActionBinaryCodec::Encode(actions, &bytes));
+    for (size_t size = 0; size < bytes.size(); size++) {
+        CHECK(RejectsUntouched(std::vector<uint8_t>(bytes.begin(), bytes.begin() + size)));
+    }
+    // 尾部多余字节同样拒绝
+    std::vector<uint8_t> longer = bytes;
+    longer.push_back(0);
+    CHECK(RejectsUntouched(longer));
+
+    std::vector<Action> out;
+    CHECK(!ActionBinaryCodec::Decode(nullptr, bytes.size(), &out));
+    CHECK(!ActionBinaryCodec::Decode(bytes.data(), bytes.size(), nullptr));
+}
+
+void TestCorruptHeader()
+{
+    std::mt19937 rng(7);
+    std::vector<Action> actions = RandomActions(rng, 8);
+    actions[0].points.emplace_back(3.0f, 4.0f);  // 至少一个动作带点
+    actions[1].id = "id";
+    std::vector<uint8_t> bytes;
+    CHECK(ActionBinaryCodec::Encode(actions, &bytes));
+
+    auto corrupt = [&bytes](auto mutate) {
+        std::vector<uint8_t> copy = bytes;
+        mutate(&copy);
+        return RejectsUntouched(copy);
+    };
+    CHECK(corrupt([](std::vector<uint8_t>* b) { (*b)[0] ^= 0x01; }));                          // magic
+    CHECK(corrupt([](std::vector<uint8_t>* b) { Patch<uint16_t>(b, 4, 0); }));                 // version 0
+    CHECK(corrupt([](std::vector<uint8_t>* b) {                                                // 未来版本
+        Patch<uint16_t>(b, 4, ActionBinaryCodec::VERSION + 1);
+    }));
+    CHECK(corrupt([](std::vector<uint8_t>* b) { Patch<uint16_t>(b, 6, HEADER_SIZE - 4); }));   // 头部过短
+    CHECK(corrupt([](std::vector<uint8_t>* b) { Patch<uint16_t>(b, 6, 0xFFFF); }));            // 头部超出数据
+    // 各计数 ±1 或取极值：总长度对不上
+    for (size_t offset : {8u, 12u, 16u}) {
+        const uint32_t count = Read<uint32_t>(bytes, offset);
+        CHECK(corrupt([offset, count](std::vector<uint8_t>* b) { Patch<uint32_t>(b, offset, count + 1); }));
+        CHECK(corrupt([offset, count](std::vector<uint8_t>* b) { Patch<uint32_t>(b, offset, count - 1); }));
+        CHECK(corrupt([offset](std::vector<uint8_t>* b) { Patch<uint32_t>(b, offset, UINT32_MAX); }));
+    }
+}
+
+void TestCorruptEntries()
+{
+    std::mt19937 rng(8);
+    std::vector<Action> actions = RandomActions(rng, 6);
+    for (auto& action : actions) {
+        action.id = "ab";
+        action.points.assign(3, Point(1.0f, 1.0f));
+    }
+    std::vector<uint8_t> bytes;
+    CHECK(ActionBinaryCodec::Encode(actions, &bytes));
+
+    for (size_t i = 0; i < actions.size(); i++) {
+        const size_t entry = HEADER_SIZE + i * ACTION_ENTRY_SIZE;
+        std::vector<uint8_t> copy = bytes;
+        copy[entry] = static_cast<uint8_t>(ActionType::STROKE) + 1;  // type 越界
+        CHECK(RejectsUntouched(copy));
+        copy = bytes;
+        copy[entry + 1] = static_cast<uint8_t>(ToolMode::DRAFT_ERASER) + 1;  // tool 越界
+        CHECK(RejectsUntouched(copy));
+        copy = bytes;
+        copy[entry + 1] = 0xFF;
+        CHECK(RejectsUntouched(copy));
+        // 单项计数与头部总数不一致（总长度不变）
+        copy = bytes;
+        Patch<uint16_t>(&copy, entry + 2, 3);
+        CHECK(RejectsUntouched(copy));
+        copy = bytes;
+        Patch<uint32_t>(&copy, entry + 4, 4);
+        CHECK(RejectsUntouched(copy));
+        copy = bytes;
+        Patch<uint32_t>(&copy, entry + 4, UINT32_MAX);
+        CHECK(RejectsUntouched(copy));
+    }
+    // 计数在动作间挪动但总和不变：合法，按新划分解码
+    std::vector<uint8_t> moved = bytes;
+    Patch<uint32_t>(&moved, HEADER_SIZE + 4, 2);
+    Patch<uint32_t>(&moved, HEADER_SIZE + ACTION_ENTRY_SIZE + 4, 4);
+    std::vector<Action> out;
+    CHECK(ActionBinaryCodec::Decode(moved.data(), moved.size(), &out));
+    CHECK(out.size() == actions.size() && out[0].points.size() == 2 && out[1].points.size() == 4);
+}
+
+// 较长的头部（未来版本追加的字段）按 headerSize 跳过
+void TestHeaderExtension()
+{
+    std::mt19937 rng(9);
+    const std::vector<Action> actions = RandomActions(rng, 5);
+    std::vector<uint8_t> bytes;
+    CHECK(ActionBinaryCodec::Encode(actions, &bytes));
+    std::vector<uint8_t> extended(bytes.begin(), bytes.begin() + HEADER_SIZE);
+    extended.insert(extended.end(), 8, 0xAB);
+    extended.insert(extended.end(), bytes.begin() + HEADER_SIZE, bytes.end());
+    Patch<uint16_t>(&extended, 6, HEADER_SIZE + 8);
+    std::vector<Action> out;
+    CHECK(ActionBinaryCodec::Decode(extended.data(), extended.size(), &out));
+    CHECK(SameActions(out, actions));
+}
+} // namespace
+
+int main()
+{
+    TestRoundTrip();
+    TestTruncation();
+    TestCorruptHeader();
+    TestCorruptEntries();
+    TestHeaderExtension();
+    return TestResult("action_codec_test");
+}
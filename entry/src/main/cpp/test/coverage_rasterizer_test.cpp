@@ -0,0 +1,289 @@
+//
+// Created on 2026/10/17.
+// 解析覆盖率光栅化：逐像素与精确的有向面积及 16x16 超采样比较
+//
+// 精确参照：每个轮廓按像素格做 Sutherland-Hodgman 裁剪，有向面积之和即该像素内环绕数的积分，
+// 再按填充规则折算，光栅化结果必须在 ±1/255 以内。超采样是点采样，直边穿过像素时本身有
+// 至多约 1/16 的离散误差；像素内环绕数超过 1 或正负混合（重叠轮廓的边缘、自交点）时，
+// 累积面积与点采样的定义不同，这些像素只和精确参照比较。
+//
+
+#include <random>
+#include "test_common.h"
+#include "utils/coverage_rasterizer.h"
+
+namespace {
+constexpr int SIZE = 96;
+constexpr int SUPERSAMPLE = 16;
+// 超采样自身的离散误差上限（实测最大约 0.043）
+constexpr double SAMPLING_ERROR = 1.0 / SUPERSAMPLE + 1.0 / 255.0;
+
+using Polygon = std::vector<std::vector<RasterPoint>>;
+
+struct Vec {
+    double x;
+    double y;
+};
+
+// 多边形（可凹、可自交）裁剪到凸窗口的一条边：保留 inside(p) 为真的一侧
+template <typename Inside, typename Cross>
+std::vector<Vec> ClipEdge(const std::vector<Vec>& input, Inside inside, Cross cross)
+{
+    std::vector<Vec> output;
+    for (size_t i = 0; i < input.size(); i++) {
+        const Vec& a = input[i];
+        const Vec& b = input[(i + 1) % input.size()];
+        const bool inA = inside(a);
+        const bool inB = inside(b);
+        if (inA) {
+            output.push_back(a);
+        }
+        if (inA != inB) {
+            output.push_back(cross(a, b));
+        }
+    }
+    return output;
+}
+
+// 轮廓与像素格 [x, x+1) x [y, y+1) 交集的有向面积（double 精度）
+double ClippedSignedArea(const std::vector<RasterPoint>& contour, int px, int py)
+{
+    std::vector<Vec> poly;
+    for (const RasterPoint& p : contour) {
+        poly.push_back({p.x, p.y});
+    }
+    auto atX = [](double bound) {
+        return [bound](const Vec& a, const Vec& b) {
+            return Vec{bound, a.y + (b.y - a.y) * (bound - a.x) / (b.x - a.x)};
+        };
+    };
+    auto atY = [](double bound) {
+        return [bound](const Vec& a, const Vec& b) {
+            return Vec{a.x + (b.x - a.x) * (bound - a.y) / (b.y - a.y), bound};
+        };
+    };
+    const double left = px;
+    const double right = px + 1.0;
+    const double top = py;
+    const double bottom = py + 1.0;
+    poly = ClipEdge(poly, [left](const Vec& p) { return p.x >= left; }, atX(left));
+    poly = ClipEdge(poly, [right](const Vec& p) { return p.x <= right; }, atX(right));
+    poly = ClipEdge(poly, [top](const Vec& p) { return p.y >= top; }, atY(top));
+    poly = ClipEdge(poly, [bottom](const Vec& p) { return p.y <= bottom; }, atY(bottom));
+    double area = 0.0;
+    for (size_t i = 0; i < poly.size(); i++) {
+        const Vec& a = poly[i];
+        const Vec& b = poly[(i + 1) % poly.size()];
+        area += a.x * b.y - b.x * a.y;
+    }
+    return area * 0.5;
+}
+
+double ApplyRule(double winding, RasterFillRule rule)
+{
+    double value = std::fabs(winding);
+    if (rule == RasterFillRule::EVEN_ODD) {
+        value = std::fmod(value, 2.0);
+        return value > 1.0 ? 2.0 - value : value;
+    }
+    return std::min(value, 1.0);
+}
+
+// 点 (x, y) 处的环绕数（向下为正的半开区间规则）
+int Winding(const Polygon& polygon, double x, double y)
+{
+    int winding = 0;
+    for (const auto& contour : polygon) {
+        for (size_t i = 0; i < contour.size(); i++) {
+            const RasterPoint& a = contour[i];
+            const RasterPoint& b = contour[(i + 1) % contour.size()];
+            if ((a.y <= y) == (b.y <= y)) {
+                continue;
+            }
+            const double t = (y - a.y) / (b.y - a.y);
+            if (a.x + t * (b.x - a.x) > x) {
+                winding += b.y > a.y ? 1 : -1;
+            }
+        }
+    }
+    return winding;
+}
+
+// 16x16 点采样覆盖率。comparable：像素内采样到的环绕数只有 0 和同一个 ±1，此时有向面积按规则折算
+// 恰为几何覆盖面积；环绕数 |w| > 1 或正负混合（重叠轮廓的边缘、自交点）时累积面积与点采样定义不同
+double Supersample(const Polygon& polygon, int px, int py, RasterFillRule rule, bool* comparable)
+{
+    int inside = 0;
+    bool positive = false;
+    bool negative = false;
+    bool multiple = false;
+    for (int sy = 0; sy < SUPERSAMPLE; sy++) {
+        for (int sx = 0; sx < SUPERSAMPLE; sx++) {
+            const int w = Winding(polygon, px + (sx + 0.5) / SUPERSAMPLE, py + (sy + 0.5) / SUPERSAMPLE);
+            inside += (rule == RasterFillRule::EVEN_ODD ? (w % 2 != 0) : (w != 0)) ? 1 : 0;
+            positive = positive || w > 0;
+            negative = negative || w < 0;
+            multiple = multiple || w > 1 || w < -1;
+        }
+    }
+    *comparable = !multiple && !(positive && negative);
+    return static_cast<double>(inside) / (SUPERSAMPLE * SUPERSAMPLE);
+}
+
+struct Clip {
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+
+void Compare(const char* name, const Polygon& polygon, RasterFillRule rule, const Clip& clip = {0, 0, SIZE, SIZE})
+{
+    std::vector<uint8_t> coverage(SIZE * SIZE, 0);
+    std::vector<uint8_t> written(SIZE * SIZE, 0);
+    CoverageRasterizer rasterizer;
+    rasterizer.Begin(clip.left, clip.top, clip.right, clip.bottom);
+    for (const auto& contour : polygon) {
+        rasterizer.AddContour(contour.data(), contour.size());
+    }
+    bool inBounds = true;
+    rasterizer.Fill(rule, [&](int y, int x0, int x1, const uint8_t* values) {
+        inBounds = inBounds && y >= clip.top && y < clip.bottom && x0 >= clip.left && x1 <= clip.right;
+        for (int x = std::max(x0, 0); x < std::min(x1, SIZE); x++) {
+            coverage[y * SIZE + x] = values[x - x0];
+            written[y * SIZE + x] = 1;
+        }
+    });
+    CHECK(inBounds);
+
+    int exactErrors = 0;
+    double maxExact = 0.0;
+    double sumSampled = 0.0;
+    double maxSampled = 0.0;
+    int pixels = 0;
+    for (int y = clip.top; y < clip.bottom; y++) {
+        for (int x = clip.left; x < clip.right; x++) {
+            double winding = 0.0;
+            for (const auto& contour : polygon) {
+                winding += ClippedSignedArea(contour, x, y);
+            }
+            // 轮廓方向：正向（顺时针，y 向下）为正面积，环绕数的符号不影响两种规则
+            const double exact = ApplyRule(winding, rule);
+            const double actual = coverage[y * SIZE + x] / 255.0;
+            const double exactDiff = std::fabs(actual - exact);
+            maxExact = std::max(maxExact, exactDiff);
+            exactErrors += exactDiff > 1.0 / 255.0 + 1e-6 ? 1 : 0;
+
+            bool comparable = false;
+            const double sampledDiff = std::fabs(actual - Supersample(polygon, x, y, rule, &comparable));
+            if (comparable) {
+                sumSampled += sampledDiff;
+                maxSampled = std::max(maxSampled, sampledDiff);
+                pixels++;
+            }
+        }
+    }
+    // 裁剪矩形之外没有任何输出
+    for (int y = 0; y < SIZE; y++) {
+        for (int x = 0; x < SIZE; x++) {
+            if (x < clip.left || x >= clip.right || y < clip.top || y >= clip.bottom) {
+                CHECK(!written[y * SIZE + x]);
+            }
+        }
+    }
+    const double meanSampled = pixels > 0 ? sumSampled / pixels : 0.0;
+    if (exactErrors != 0 || meanSampled > 1.0 / 255.0 || maxSampled > SAMPLING_ERROR) {
+        std::fprintf(stderr, "%s (%s): %d pixel(s) off exact by > 1/255 (max %.4f), supersample mean %.5f max %.4f\n",
+                     name, rule == RasterFillRule::EVEN_ODD ? "even-odd" : "non-zero", exactErrors, maxExact,
+                     meanSampled, maxSampled);
+    }
+    CHECK(exactErrors == 0);
+    // 16x16 超采样：可比像素的平均差在 1/255 以内，单个像素不超过超采样自身的离散误差
+    CHECK(meanSampled <= 1.0 / 255.0);
+    CHECK(maxSampled <= SAMPLING_ERROR);
+}
+
+void CompareBothRules(const char* name, const Polygon& polygon, const Clip& clip = {0, 0, SIZE, SIZE})
+{
+    Compare(name, polygon, RasterFillRule::NON_ZERO, clip);
+    Compare(name, polygon, RasterFillRule::EVEN_ODD, clip);
+}
+
+void TestThinSlivers()
+{
+    // 细长三角形：最宽处 0.3 像素
+    CompareBothRules("sliver triangle", {{{4.2f, 10.1f}, {90.7f, 10.4f}, {4.2f, 10.2f}}});
+    // 0.05 像素宽的斜条
+    CompareBothRules("diagonal hairline", {{{5.0f, 5.0f}, {90.0f, 80.0f}, {90.05f, 80.0f}, {5.05f, 5.0f}}});
+    // 宽度小于一个像素、跨越像素边界的竖条
+    CompareBothRules("vertical sliver", {{{30.9f, 3.3f}, {31.2f, 3.3f}, {31.2f, 92.6f}, {30.9f, 92.6f}}});
+    // 落在同一像素内的小三角形
+    CompareBothRules("sub-pixel triangle", {{{40.1f, 40.1f}, {40.8f, 40.3f}, {40.4f, 40.9f}}});
+}
+
+void TestNearlyAxisParallel()
+{
+    // 斜率约 1/300 的上下边、约 1/400 的左右边
+    CompareBothRules("near-horizontal quad", {{{5.3f, 20.1f}, {90.7f, 20.4f}, {90.2f, 60.9f}, {5.1f, 60.6f}}});
+    // 一条 y 只变化 0.01 的长边
+    CompareBothRules("almost flat wedge", {{{2.0f, 50.0f}, {94.0f, 50.01f}, {48.0f, 70.5f}}});
+    // 恰好落在像素边界上的轴对齐边
+    CompareBothRules("pixel-aligned rect", {{{10.0f, 10.0f}, {50.0f, 10.0f}, {50.0f, 30.0f}, {10.0f, 30.0f}}});
+    CompareBothRules("half-pixel rect", {{{10.5f, 10.5f}, {50.5f, 10.5f}, {50.5f, 30.5f}, {10.5f, 30.5f}}});
+}
+
+void TestSelfIntersecting()
+{
+    // 五角星：非零规则中心填满，奇偶规则中心为空
+    Polygon star(1);
+    for (int i = 0; i < 5; i++) {
+        const double angle = -M_PI / 2 + i * 4 * M_PI / 5;
+        star[0].push_back({static_cast<float>(48 + 40 * std::cos(angle)), static_cast<float>(48 + 40 * std::sin(angle))});
+    }
+    CompareBothRules("pentagram", star);
+    // 8 字形（两半方向相反）
+    CompareBothRules("bow tie", {{{10.3f, 10.7f}, {80.1f, 70.2f}, {80.4f, 12.9f}, {10.6f, 72.5f}}});
+    // 同一正方形绕两圈 + 反向的内层正方形
+    CompareBothRules("double wound", {{{10.2f, 10.2f}, {80.7f, 10.2f}, {80.7f, 80.7f}, {10.2f, 80.7f}},
+                                      {{10.2f, 10.2f}, {80.7f, 10.2f}, {80.7f, 80.7f}, {10.2f, 80.7f}},
+                                      {{30.5f, 30.5f}, {30.5f, 60.5f}, {60.5f, 60.5f}, {60.5f, 30.5f}}});
+}
+
+void TestClippedAtBorder()
+{
+    // 四边都越出画布的多边形
+    const Polygon big = {{{-30.5f, 20.3f}, {40.2f, -25.7f}, {130.6f, 30.1f}, {60.4f, 140.8f}, {-10.9f, 110.2f}}};
+    CompareBothRules("clipped to canvas", big);
+    // 裁剪矩形不从 0 开始
+    CompareBothRules("clipped to inner rect", big, {17, 9, SIZE - 5, SIZE - 13});
+    // 完全在裁剪矩形左侧的部分只贡献到边界列
+    CompareBothRules("left of clip",
+                     {{{-40.0f, 20.25f}, {30.3f, 20.25f}, {30.3f, 60.75f}, {-40.0f, 60.75f}}}, {12, 0, SIZE, SIZE});
+}
+
+void TestRandomPolygons()
+{
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> coord(-8.0f, SIZE + 8.0f);
+    for (int round = 0; round < 12; round++) {
+        Polygon polygon(1 + rng() % 2);
+        for (auto& contour : polygon) {
+            const int count = 3 + static_cast<int>(rng() % 8);
+            for (int i = 0; i < count; i++) {
+                contour.push_back({coord(rng), coord(rng)});
+            }
+        }
+        CompareBothRules("random", polygon);
+    }
+}
+} // namespace
+
+int main()
+{
+    TestThinSlivers();
+    TestNearlyAxisParallel();
+    TestSelfIntersecting();
+    TestClippedAtBorder();
+    TestRandomPolygons();
+    return TestResult("coverage_rasterizer_test");
+}
@@ -0,0 +1,252 @@
+//
+// Created on 2026/10/17.
+// 无窗口引擎（CpuRasterBackend）：历史操作与整段重放一致、动作往返、橡皮实时合成与提交一致、显示列表重放与直接绘制一致、预览与缩略图输出
+//
+
+#include <random>
+#include "samples/paper_cut_thumbnail.h"
+#include "samples/paper_cut_work_codec.h"
+#include "test_common.h"
+
+namespace {
+bool SameActions(const std::vector<Action>& a, const std::vector<Action>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].tool != b[i].tool || a[i].type != b[i].type || a[i].points.size() != b[i].points.size()) {
+            return false;
+        }
+        for (size_t j = 0; j < a[i].points.size(); j++) {
+            if (a[i].points[j].x != b[i].points[j].x || a[i].points[j].y != b[i].points[j].y) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 撤销/重做/新命令/清空/定位的随机序列，每隔几步与“同一动作列表整段重放”的结果逐字节比较
+void TestHistoryMatchesReplay()
+{
+    std::mt19937 rng(11);
+    auto engine = TestData::MakeEngine();
+    auto reference = TestData::MakeEngine();
+    CHECK(engine && reference);
+    if (!engine || !reference) {
+        return;
+    }
+    std::vector<Action> actions;
+    for (int i = 0; i < 120; i++) {
+        actions.push_back(TestData::RandomAction(rng));
+    }
+    engine->SetActions(actions);
+    CHECK(engine->GetHistoryLength() == actions.size());
+    CHECK(SameActions(engine->GetActions(), actions));
+
+    for (int step = 0; step < 120; step++) {
+        const int op = static_cast<int>(rng() % 10);
+        if (op < 4) {
+            for (int k = 1 + static_cast<int>(rng() % 6); k > 0; k--) {
+                engine->Undo();
+            }
+        } else if (op < 6) {
+            for (int k = 1 + static_cast<int>(rng() % 4); k > 0; k--) {
+                engine->Redo();
+            }
+        } else if (op < 9) {
+            engine->AddAction(TestData::RandomAction(rng));
+        } else if (step % 20 == 9) {
+            engine->Clear();
+        } else {
+            engine->SeekHistory(rng() % (engine->GetHistoryLength() + 1));
+        }
+        if (step % 10 == 0) {
+            reference->SetActions(engine->GetActions());
+            CHECK(TestData::SameLayers(*engine, *reference));
+        }
+    }
+    // 清空之后再撤销回清空之前
+    engine->Clear();
+    engine->AddAction(TestData::RandomAction(rng));
+    engine->Undo();
+    engine->Undo();
+    reference->SetActions(engine->GetActions());
+    CHECK(TestData::SameLayers(*engine, *reference));
+}
+
+// 纸张中心被剪掉、角落在纸外：预览 alpha 应分别为 0 / 0，纸上其余位置不透明
+void TestPreviewPixels()
+{
+    auto engine = TestData::MakeEngine();
+    CHECK(engine != nullptr);
+    if (!engine) {
+        return;
+    }
+    std::vector<Point> hole;
+    for (int i = 0; i < 32; i++) {
+        const float t = i * 6.2831853f / 32;
+        hole.push_back(SnapToModelGrid(Point(200.0f * std::cos(t), 200.0f * std::sin(t))));
+    }
+    engine->SetFoldMode(FoldMode::ZERO);
+    engine->AddAction(TestData::MakeAction(ToolMode::SCISSORS, hole));
+
+    const int size = 256;
+    std::vector<uint32_t> pixels;
+    CHECK(engine->RenderPreviewToPixels(size, size, &pixels));
+    CHECK(pixels.size() == static_cast<size_t>(size) * size);
+    if (pixels.size() != static_cast<size_t>(size) * size) {
+        return;
+    }
+    auto alpha = [&pixels, size](int x, int y) { return pixels[static_cast<size_t>(y) * size + x] >> 24; };
+    CHECK(alpha(size / 2, size / 2) == 0);
+    CHECK(alpha(0, 0) == 0);
+    CHECK(alpha(size / 2, size / 2 + size * 3 / 10) == 0xFF);
+}
+
+// 橡皮拖动中的主画布与抬笔提交后一致：只擦除草稿层，已剪出的镂空不会被纸色填上
+void TestLiveEraserMatchesCommit()
+{
+    auto engine = TestData::MakeEngine();
+    CpuRasterBackend backend;
+    const int size = 512;
+    std::unique_ptr<RasterBitmap> target = backend.CreateBitmap(size, size, RasterFormat::RGBA8888);
+    std::unique_ptr<RasterCanvas> canvas = target ? backend.CreateCanvas(target.get()) : nullptr;
+    CHECK(engine && canvas);
+    if (!engine || !canvas) {
+        return;
+    }
+    std::vector<Point> hole;
+    for (int i = 0; i < 32; i++) {
+        const float t = i * 6.2831853f / 32;
+        hole.push_back(SnapToModelGrid(Point(200.0f * std::cos(t), 200.0f * std::sin(t))));
+    }
+    engine->SetFoldMode(FoldMode::ZERO);
+    engine->AddAction(TestData::MakeAction(ToolMode::SCISSORS, hole));
+    // 草稿线穿过镂空，橡皮沿同一条线擦过纸面与镂空
+    const std::vector<Point> line = {Point(-400, 0), Point(-100, 20), Point(100, -20), Point(400, 0)};
+    engine->AddAction(TestData::MakeAction(ToolMode::DRAFT_PEN, line));
+
+    engine->SetToolMode(ToolMode::DRAFT_ERASER);
+    engine->StartDrawing(line[0].x, line[0].y);
+    for (size_t i = 1; i < line.size(); i++) {
+        engine->AddPoint(line[i].x, line[i].y);
+    }
+    engine->RenderTo(canvas.get());
+    const size_t bytes = static_cast<size_t>(size) * size * 4;
+    const std::vector<uint8_t> live(static_cast<const uint8_t*>(target->GetPixels()),
+                                    static_cast<const uint8_t*>(target->GetPixels()) + bytes);
+    engine->FinishDrawing();
+    engine->RenderTo(canvas.get());
+    const uint8_t* committed = static_cast<const uint8_t*>(target->GetPixels());
+    // 实时路径按裁剪覆盖率扣除，提交后按 A8 清除量化：只允许舍入差
+    int maxDiff = 0;
+    for (size_t i = 0; i < bytes; i++) {
+        maxDiff = std::max(maxDiff, std::abs(live[i] - committed[i]));
+    }
+    if (maxDiff > 2) {
+        std::fprintf(stderr, "live eraser differs from committed result by %d\n", maxDiff);
+    }
+    CHECK(maxDiff <= 2);
+}
+
+// 同一组命令：按不均匀行条带重放显示列表（光栅器与暂存区跨命令、跨条带复用）与逐条 Apply 到画布逐字节一致
+void TestDisplayListMatchesApply()
+{
+    const int size = TestData::CANVAS_SIZE;
+    CpuRasterBackend backend;
+    std::unique_ptr<RasterBitmap> applied = backend.CreateBitmap(size, size, RasterFormat::A8);
+    std::unique_ptr<RasterBitmap> replayed = backend.CreateBitmap(size, size, RasterFormat::A8);
+    std::unique_ptr<RasterCanvas> canvas = backend.CreateCanvas(applied.get());
+    CHECK(applied && replayed && canvas);
+    if (!applied || !replayed || !canvas) {
+        return;
+    }
+    // 半覆盖的初始内容：叠加与清除都会改变像素
+    canvas->Clear(0x80000000);
+    std::memcpy(replayed->GetPixels(), applied->GetPixels(), static_cast<size_t>(size) * size);
+
+    std::mt19937 rng(25);
+    std::vector<std::unique_ptr<ICommand>> commands;
+    for (int i = 0; i < 60; i++) {
+        const Action action = TestData::RandomAction(rng);
+        if (action.tool == ToolMode::SCISSORS) {
+            commands.push_back(std::make_unique<CutCommand>(action.points));
+        } else if (action.tool == ToolMode::DRAFT_PEN) {
+            commands.push_back(std::make_unique<PencilCommand>(action.points));
+        } else {
+            commands.push_back(std::make_unique<EraserCommand>(action.points));
+        }
+    }
+
+    canvas->Save();
+    canvas->Translate(size * 0.5f, size * 0.5f);
+    for (const auto& command : commands) {
+        command->Apply(canvas.get());
+    }
+    canvas->Restore();
+
+    RasterMatrix matrix;
+    matrix.tx = size * 0.5f;
+    matrix.ty = size * 0.5f;
+    uint8_t* pixels = static_cast<uint8_t*>(replayed->GetPixels());
+    const DisplayList::MaskSet masks = {&pixels, 1, size, size};
+    CoverageRasterizer rasterizer;
+    std::vector<RasterPoint> scratch;
+    for (int top = 0; top < size;) {
+        const int bottom = std::min(size, top + 1 + static_cast<int>(rng() % 300));
+        const RasterIRect band = {0, top, size, bottom};
+        for (const auto& command : commands) {
+            const DisplayList* list = command->Compile();
+            CHECK(list != nullptr);
+            if (list) {
+                list->Rasterize(matrix, band, masks, &rasterizer, &scratch);
+            }
+        }
+        top = bottom;
+    }
+    CHECK(TestData::SameMask(applied.get(), replayed.get()));
+
+    // 重放确实改变了内容（不是两边都没画）
+    size_t changed = 0;
+    for (size_t i = 0; i < static_cast<size_t>(size) * size; i++) {
+        changed += pixels[i] != 0x80 ? 1 : 0;
+    }
+    CHECK(changed > 10000);
+}
+
+void TestThumbnail()
+{
+    std::mt19937 rng(5);
+    WorkHeader header;
+    header.foldMode = FoldMode::SIX;
+    std::vector<Action> actions;
+    for (int i = 0; i < 20; i++) {
+        actions.push_back(TestData::RandomCut(rng));
+    }
+    std::vector<uint8_t> work;
+    CHECK(WorkCodec::Encode(header, actions, &work));
+
+    std::vector<uint8_t> png;
+    CHECK(PaperCutThumbnail::RenderPng(work.data(), work.size(), 128, &png));
+    CHECK(png.size() > 8 && std::memcmp(png.data(), "\x89PNG\r\n\x1a\n", 8) == 0);
+    CHECK(!PaperCutThumbnail::RenderPng(work.data(), work.size() / 2, 128, &png));
+    CHECK(!PaperCutThumbnail::RenderPng(work.data(), work.size(), PaperCutThumbnail::MAX_SIZE + 1, &png));
+
+    const std::string key = PaperCutThumbnail::CacheKey(work.data(), work.size(), 128);
+    CHECK(key.size() == 16);
+    CHECK(key == PaperCutThumbnail::CacheKey(work.data(), work.size(), 128));
+    CHECK(key != PaperCutThumbnail::CacheKey(work.data(), work.size(), 256));
+}
+} // namespace
+
+int main()
+{
+    TestHistoryMatchesReplay();
+    TestPreviewPixels();
+    TestLiveEraserMatchesCommit();
+    TestDisplayListMatchesApply();
+    TestThumbnail();
+    return TestResult("engine_test");
+}
@@ -0,0 +1,99 @@
+//
+// Created on 2026/10/17.
+// 剪刀路径填充基准：2048x2048 A8 mask 上的抗锯齿 destination-out 填充（CpuRasterCanvas::DrawPath）
+//
+// 波浪闭合曲线（剪刀路径式）与随机自交多边形，100 / 10k / 100k 顶点。只使用画布接口，
+// 同一文件也可以对照旧版本的 CPU 后端编译。覆盖率总和与多边形面积相互校验。
+//
+
+#include <cstdlib>
+#include <cstring>
+#include "test_common.h"
+
+namespace {
+constexpr int SIZE = 2048;
+
+std::vector<RasterPoint> MakePolygon(int count, bool selfIntersecting, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<RasterPoint> points;
+    points.reserve(count);
+    for (int i = 0; i < count; i++) {
+        if (selfIntersecting) {
+            points.push_back({100.0f + unit(rng) * 1848.0f, 100.0f + unit(rng) * 1848.0f});
+            continue;
+        }
+        const float t = 6.2831853f * i / count;
+        const float r = 700.0f + 250.0f * std::sin(7.0f * t) + 40.0f * unit(rng);
+        points.push_back({1024.0f + r * std::cos(t), 1024.0f + r * std::sin(t)});
+    }
+    return points;
+}
+
+double ShoelaceArea(const std::vector<RasterPoint>& points)
+{
+    double area = 0;
+    for (size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
+        area += static_cast<double>(points[j].x) * points[i].y - static_cast<double>(points[i].x) * points[j].y;
+    }
+    return std::fabs(area) * 0.5;
+}
+
+// 返回单次填充耗时（毫秒），mask 中被清除的覆盖率总和写入 cleared（像素为单位）
+double Fill(const RasterPath& path, bool antiAlias, int repeats, double* cleared)
+{
+    CpuRasterBitmap mask(SIZE, SIZE, RasterFormat::A8);
+    CpuRasterCanvas canvas(&mask);
+    RasterPaint paint;
+    paint.color = 0xFFFFFFFF;
+    paint.antiAlias = antiAlias;
+    paint.blend = RasterBlend::CLEAR;
+    double total = 0;
+    for (int i = 0; i < repeats; i++) {
+        std::memset(mask.GetPixels(), 0xFF, static_cast<size_t>(SIZE) * SIZE);
+        const double start = NowMs();
+        canvas.DrawPath(path, paint);
+        total += NowMs() - start;
+    }
+    const uint8_t* pixels = static_cast<const uint8_t*>(mask.GetPixels());
+    double sum = 0;
+    for (size_t i = 0; i < static_cast<size_t>(SIZE) * SIZE; i++) {
+        sum += 255 - pixels[i];
+    }
+    *cleared = sum / 255.0;
+    return total / repeats;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    // 随机自交多边形的边交叉数为 O(n^2)，10 万顶点要十几秒，默认不跑
+    const bool all = argc > 1 && std::strcmp(argv[1], "--all") == 0;
+    std::mt19937 rng(7);
+    std::printf("2048x2048 A8 destination-out fill\n");
+    for (bool selfIntersecting : {false, true}) {
+        for (int count : {100, 10000, 100000}) {
+            if (selfIntersecting && count > 10000 && !all) {
+                continue;
+            }
+            const std::vector<RasterPoint> points = MakePolygon(count, selfIntersecting, rng);
+            RasterPath path;
+            path.AddPolyline(points.data(), points.size(), true);
+            const int repeats = selfIntersecting && count >= 10000 ? 1 : 5;
+            double clearedAa = 0;
+            double clearedBw = 0;
+            const double aa = Fill(path, true, repeats, &clearedAa);
+            const double bw = Fill(path, false, repeats, &clearedBw);
+            std::printf("%-6s n=%6d  aa %9.2f ms  bw %9.2f ms", selfIntersecting ? "random" : "wavy", count, aa, bw);
+            if (!selfIntersecting) {
+                // 简单多边形：覆盖率总和就是面积
+                const double area = ShoelaceArea(points);
+                std::printf("  area error aa %.4f%% bw %.4f%%", 100.0 * std::fabs(clearedAa - area) / area,
+                            100.0 * std::fabs(clearedBw - area) / area);
+                CHECK(std::fabs(clearedAa - area) < area * 1e-3);
+            }
+            std::printf("\n");
+        }
+    }
+    return TestFailureCount() > 0 ? TestResult("fill_bench") : 0;
+}
@@ -0,0 +1,171 @@
+//
+// Created on 2026/10/17.
+// 帧调度器：ManualVsyncSource 驱动，验证请求合并、每个 vsync 最多上屏一次、上屏期间的请求顺延到下一帧、迟到的 vsync 跳过
+//
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "test_common.h"
+#include "utils/frame_scheduler.h"
+
+namespace {
+constexpr auto PRESENT_TIMEOUT = std::chrono::seconds(2);
+// 断言“没有上屏”时给渲染线程的时间
+constexpr auto QUIET_PERIOD = std::chrono::milliseconds(30);
+constexpr int64_t MS = 1000000;
+
+int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Frame {
+    uint32_t surfaces;
+    int64_t timestampNs;
+    std::thread::id thread;
+};
+
+class Recorder {
+public:
+    void Present(uint32_t surfaces, int64_t timestampNs)
+    {
+        std::function<void()> hook;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            frames_.push_back({surfaces, timestampNs, std::this_thread::get_id()});
+            hook = std::move(onNextPresent_);
+            onNextPresent_ = nullptr;
+        }
+        if (hook) {
+            hook();
+        }
+        cond_.notify_all();
+    }
+
+    // 等到至少 count 帧（超时返回 false）
+    bool WaitFor(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, PRESENT_TIMEOUT, [this, count] { return frames_.size() >= count; });
+    }
+
+    size_t Count()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_.size();
+    }
+
+    Frame Last()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_.empty() ? Frame{0, 0, std::thread::id()} : frames_.back();
+    }
+
+    // 下一帧上屏时在渲染线程上执行
+    void OnNextPresent(std::function<void()> hook)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        onNextPresent_ = std::move(hook);
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<Frame> frames_;
+    std::function<void()> onNextPresent_;
+};
+} // namespace
+
+int main()
+{
+    auto source = std::make_unique<ManualVsyncSource>();
+    ManualVsyncSource* vsync = source.get();
+    Recorder recorder;
+    FrameScheduler scheduler(std::move(source),
+                             [&recorder](uint32_t surfaces, int64_t timestampNs) { recorder.Present(surfaces, timestampNs); });
+    CHECK(scheduler.Start());
+    CHECK(scheduler.IsRunning());
+
+    // 没有请求时 vsync 不触发上屏；只有请求没有 vsync 也不上屏
+    vsync->Tick(1);
+    scheduler.RequestFrame(FRAME_SURFACE_EDITOR);
+    std::this_thread::sleep_for(QUIET_PERIOD);
+    CHECK(recorder.Count() == 0);
+
+    // 多次请求合并为一帧，时间戳来自触发它的 vsync，在渲染线程上执行
+    for (int i = 0; i < 100; i++) {
+        scheduler.RequestFrame(FRAME_SURFACE_EDITOR);
+    }
+    vsync->Tick(2);
+    CHECK(recorder.WaitFor(1));
+    std::this_thread::sleep_for(QUIET_PERIOD);
+    CHECK(recorder.Count() == 1);
+    CHECK(recorder.Last().surfaces == FRAME_SURFACE_EDITOR);
+    CHECK(recorder.Last().timestampNs == 2);
+    CHECK(recorder.Last().thread != std::this_thread::get_id());
+
+    // 空闲 vsync 不产生帧
+    vsync->Tick(3);
+    std::this_thread::sleep_for(QUIET_PERIOD);
+    CHECK(recorder.Count() == 1);
+
+    // 不同表面的请求合并为同一帧
+    scheduler.RequestFrame(FRAME_SURFACE_EDITOR);
+    scheduler.RequestFrame(FRAME_SURFACE_PREVIEW);
+    vsync->Tick(4);
+    CHECK(recorder.WaitFor(2));
+    CHECK(recorder.Last().surfaces == FRAME_SURFACE_ALL);
+
+    // 上屏期间的新请求留到下一个 vsync
+    recorder.OnNextPresent([&scheduler] { scheduler.RequestFrame(FRAME_SURFACE_PREVIEW); });
+    scheduler.RequestFrame(FRAME_SURFACE_EDITOR);
+    vsync->Tick(5);
+    CHECK(recorder.WaitFor(3));
+    std::this_thread::sleep_for(QUIET_PERIOD);
+    CHECK(recorder.Count() == 3);
+    vsync->Tick(6);
+    CHECK(recorder.WaitFor(4));
+    CHECK(recorder.Last().surfaces == FRAME_SURFACE_PREVIEW);
+    CHECK(recorder.Last().timestampNs == 6);
+
+    // 停止后 vsync 回调被注销，不再上屏（计数在 present 返回后才累加，停止后读取才确定）
+    scheduler.Stop();
+    CHECK(!scheduler.IsRunning());
+    CHECK(scheduler.GetPresentedFrameCount() == 4);
+    scheduler.RequestFrame(FRAME_SURFACE_ALL);
+    vsync->Tick(7);
+    std::this_thread::sleep_for(QUIET_PERIOD);
+    CHECK(recorder.Count() == 4);
+
+    // 可以重新启动，停止前积累的请求在下一个 vsync 上屏
+    CHECK(scheduler.Start());
+    vsync->Tick(8);
+    CHECK(recorder.WaitFor(5));
+    CHECK(recorder.Last().surfaces == FRAME_SURFACE_ALL);
+
+    // 预期上屏时间已过的 vsync 跳过，脏标记保留；紧接着的 vsync 即使同样迟到也上屏（不连续跳过）
+    scheduler.RequestFrame(FRAME_SURFACE_EDITOR);
+    vsync->Tick(9, NowNs() - MS);
+    std::this_thread::sleep_for(QUIET_PERIOD);
+    CHECK(recorder.Count() == 5);
+    CHECK(scheduler.GetSkippedFrameCount() == 1);
+    vsync->Tick(10, NowNs() - MS);
+    CHECK(recorder.WaitFor(6));
+    CHECK(recorder.Last().surfaces == FRAME_SURFACE_EDITOR);
+    CHECK(recorder.Last().timestampNs == 10);
+
+    // 未到期、未知（0）、迟到过久（时钟来源不一致）的预期时间都不跳帧
+    const int64_t targets[] = {NowNs() + 16 * MS, 0, NowNs() - 10000 * MS};
+    for (int i = 0; i < 3; i++) {
+        scheduler.RequestFrame(FRAME_SURFACE_PREVIEW);
+        vsync->Tick(11 + i, targets[i]);
+        CHECK(recorder.WaitFor(7 + i));
+        CHECK(recorder.Last().timestampNs == 11 + i);
+    }
+    CHECK(scheduler.GetSkippedFrameCount() == 1);
+    scheduler.Stop();
+    return TestResult("frame_scheduler_test");
+}
@@ -0,0 +1,92 @@
+//
+// Created on 2026/10/17.
+// 模型网格对齐：手绘（含首点）与贝塞尔输入生成的命令，历史定位结果与保存后重新加载逐字节一致
+//
+
+#include "samples/paper_cut_work_codec.h"
+#include "test_common.h"
+
+namespace {
+// 故意不在 1/16 px 网格上的坐标
+constexpr float OFFSET = 0.0371f;
+
+void DrawFreehand(PaperCutEngine* engine, ToolMode tool, float cx, float cy)
+{
+    engine->SetToolMode(tool);
+    engine->StartDrawing(cx + OFFSET, cy - OFFSET);
+    for (int i = 1; i <= 24; i++) {
+        const float t = i * 6.2831853f / 24;
+        engine->AddPoint(cx + 90.0f * std::sin(t) + OFFSET * i, cy + 60.0f * (1.0f - std::cos(t)) + OFFSET);
+    }
+    engine->FinishDrawing();
+}
+
+void DrawBezier(PaperCutEngine* engine, float cx, float cy)
+{
+    engine->AddBezierPoint(cx + OFFSET, cy + OFFSET);
+    engine->AddBezierPoint(cx + 150.3f, cy + 20.7f);
+    engine->AddBezierPoint(cx + 120.1f, cy + 140.9f);
+    engine->AddBezierPoint(cx - 10.0f, cy + 100.0f);
+    engine->UpdateBezierPoint(3, cx - 30.0f + OFFSET, cy + 110.0f - OFFSET);
+    engine->CloseBezier();
+}
+
+bool OnGrid(const std::vector<Action>& actions)
+{
+    for (const Action& action : actions) {
+        for (const Point& p : action.points) {
+            const Point snapped = SnapToModelGrid(p);
+            if (snapped.x != p.x || snapped.y != p.y) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<Action> Reload(const std::vector<Action>& actions)
+{
+    WorkHeader header;
+    std::vector<uint8_t> data;
+    std::vector<Action> decoded;
+    if (!WorkCodec::Encode(header, actions, &data) || !WorkCodec::Decode(data.data(), data.size(), &header, &decoded)) {
+        return {};
+    }
+    return decoded;
+}
+} // namespace
+
+int main()
+{
+    auto engine = TestData::MakeEngine();
+    auto reference = TestData::MakeEngine();
+    CHECK(engine && reference);
+    if (!engine || !reference) {
+        return TestResult("grid_snap_test");
+    }
+    engine->SetFoldMode(FoldMode::ZERO);
+    DrawFreehand(engine.get(), ToolMode::SCISSORS, -400.0f, -300.0f);
+    DrawBezier(engine.get(), 200.0f, -350.0f);
+    DrawFreehand(engine.get(), ToolMode::DRAFT_PEN, -300.0f, 250.0f);
+    DrawBezier(engine.get(), -100.0f, 100.0f);
+    DrawFreehand(engine.get(), ToolMode::DRAFT_ERASER, -280.0f, 260.0f);
+    DrawFreehand(engine.get(), ToolMode::SCISSORS, 300.0f, 300.0f);
+
+    const std::vector<Action> actions = engine->GetActions();
+    CHECK(actions.size() == 6);
+    CHECK(OnGrid(actions));
+
+    // 保存格式往返：重新加载的图层与交互生成的图层一致
+    const std::vector<Action> reloaded = Reload(actions);
+    CHECK(reloaded.size() == actions.size());
+    reference->SetActions(reloaded);
+    CHECK(TestData::SameLayers(*engine, *reference));
+
+    // 历史定位（检查点/脏区重建）与同一前缀的整段重放一致
+    for (size_t index : {size_t(0), size_t(3), size_t(1), actions.size(), size_t(4)}) {
+        engine->SeekHistory(index);
+        reference->SetActions(std::vector<Action>(reloaded.begin(), reloaded.begin() + index));
+        CHECK(TestData::SameLayers(*engine, *reference));
+    }
+    return TestResult("grid_snap_test");
+}
@@ -0,0 +1,131 @@
+//
+// Created on 2026/10/17.
+// 历史检查点策略：超出预算时淘汰、保留数量与字节数不超过预算，定位到已淘汰的位置仍与整段重放逐字节一致
+//
+
+#include <algorithm>
+#include <random>
+#include "test_common.h"
+
+namespace {
+// 与 PaperCutEngine 的检查点常量一致：每 32 条命令（或估算代价 4096）一个，
+// 2048² 下每个检查点两张 A8 共 8MB，96MB 预算最多 12 个
+constexpr size_t COMMAND_INTERVAL = 32;
+constexpr size_t MEMORY_BUDGET = 96 * 1024 * 1024;
+constexpr size_t MAX_CHECKPOINTS = 12;
+constexpr size_t COMMANDS = 800;
+
+bool WithinBudget(const PaperCutEngine& engine)
+{
+    const std::vector<size_t> counts = engine.GetCheckpointCounts();
+    const size_t bytesPerCheckpoint = static_cast<size_t>(TestData::CANVAS_SIZE) * TestData::CANVAS_SIZE * 2;
+    return counts.size() <= MAX_CHECKPOINTS && engine.GetCheckpointBytes() <= MEMORY_BUDGET &&
+           engine.GetCheckpointBytes() == counts.size() * bytesPerCheckpoint &&
+           std::is_sorted(counts.begin(), counts.end());
+}
+
+bool MatchesReplay(PaperCutEngine& engine, PaperCutEngine& reference, const std::vector<Action>& actions,
+                   size_t index)
+{
+    engine.SeekHistory(index);
+    reference.SetActions(std::vector<Action>(actions.begin(), actions.begin() + index));
+    return engine.GetHistoryIndex() == index && TestData::SameLayers(engine, reference);
+}
+
+void TestEvictionAndBudget()
+{
+    auto engine = TestData::MakeEngine();
+    auto reference = TestData::MakeEngine();
+    CHECK(engine && reference);
+    if (!engine || !reference) {
+        return;
+    }
+    std::mt19937 rng(3);
+    std::vector<Action> actions;
+    size_t peak = 0;
+    bool budget = true;
+    for (size_t i = 0; i < COMMANDS; i++) {
+        actions.push_back(TestData::RandomAction(rng));
+        engine->AddAction(actions.back());
+        peak = std::max(peak, engine->GetCheckpointCounts().size());
+        budget = budget && WithinBudget(*engine);
+    }
+    CHECK(budget);
+    // 800 条命令能打出远多于 12 个检查点，淘汰后保留满预算
+    CHECK(peak == MAX_CHECKPOINTS);
+    const std::vector<size_t> retained = engine->GetCheckpointCounts();
+    CHECK(retained.size() == MAX_CHECKPOINTS);
+    // 淘汰按“合并后区间最短”进行，剩余检查点大致均匀：相邻间隔不超过平均间隔的 3 倍
+    size_t previous = 0;
+    for (size_t count : retained) {
+        CHECK(count - previous <= 3 * COMMANDS / MAX_CHECKPOINTS);
+        previous = count;
+    }
+
+    // 按命令数间隔、现在不在保留列表中的位置：32、96、160 等曾打过快照后被淘汰，其余预算满后不再打快照
+    std::vector<size_t> evicted;
+    for (size_t count = COMMAND_INTERVAL; count < COMMANDS; count += COMMAND_INTERVAL) {
+        if (!std::binary_search(retained.begin(), retained.end(), count)) {
+            evicted.push_back(count);
+        }
+    }
+    CHECK(evicted.size() >= 8);
+    // 向后、向前交替定位到已淘汰的位置、保留的检查点与任意位置
+    std::vector<size_t> targets;
+    for (size_t i = 0; i < evicted.size(); i += 3) {
+        targets.push_back(evicted[i]);
+    }
+    targets.push_back(retained.front());
+    targets.push_back(retained.back());
+    targets.push_back(0);
+    targets.push_back(COMMANDS - 1);
+    targets.push_back(477);
+    std::shuffle(targets.begin(), targets.end(), rng);
+    targets.push_back(COMMANDS);
+    for (size_t index : targets) {
+        if (!MatchesReplay(*engine, *reference, actions, index)) {
+            std::fprintf(stderr, "seek to %zu differs from full replay\n", index);
+            CHECK(false);
+        }
+        CHECK(WithinBudget(*engine));
+    }
+
+    // 撤销到中途后推入新命令：之后的检查点作废，预算仍成立
+    engine->SeekHistory(300);
+    actions.resize(300);
+    for (int i = 0; i < 100; i++) {
+        actions.push_back(TestData::RandomAction(rng));
+        engine->AddAction(actions.back());
+    }
+    CHECK(WithinBudget(*engine));
+    const std::vector<size_t> after = engine->GetCheckpointCounts();
+    CHECK(!after.empty() && after.back() <= actions.size());
+    CHECK(MatchesReplay(*engine, *reference, actions, 350));
+    CHECK(MatchesReplay(*engine, *reference, actions, actions.size()));
+}
+
+// 小画布：检查点更小，预算内可以全部保留，不发生淘汰
+void TestSmallCanvasKeepsAll()
+{
+    auto engine = TestData::MakeEngine(512);
+    CHECK(engine != nullptr);
+    if (!engine) {
+        return;
+    }
+    std::mt19937 rng(4);
+    for (size_t i = 0; i < 400; i++) {
+        Action action = TestData::RandomCut(rng, 200.0f);
+        engine->AddAction(action);
+    }
+    const std::vector<size_t> counts = engine->GetCheckpointCounts();
+    CHECK(counts.size() >= 400 / COMMAND_INTERVAL);
+    CHECK(engine->GetCheckpointBytes() == counts.size() * 512 * 512 * 2);
+}
+} // namespace
+
+int main()
+{
+    TestEvictionAndBudget();
+    TestSmallCanvasKeepsAll();
+    return TestResult("history_checkpoint_test");
+}
@@ -0,0 +1,104 @@
+//
+// Created on 2026/10/17.
+// 任务系统扩展性基准：固定总工作量，在不同线程数下统计 ParallelFor / TaskGroup / 历史重放的耗时
+//
+// 不带参数运行时按 1, 2, 4, ... 个线程依次以子进程重跑自身（PAPERCUT_JOB_THREADS 指定线程数），
+// 线程池在进程内只创建一次，所以每个线程数需要单独的进程。
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "test_common.h"
+#include "utils/job_system.h"
+
+namespace {
+constexpr int ITEMS = 4096;
+
+void RunChild()
+{
+    JobSystem& jobs = JobSystem::Get();
+    std::vector<double> out(ITEMS);
+    auto work = [&out](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            double sum = 0;
+            for (int k = 0; k < 20000; k++) {
+                sum += std::sqrt(i + k * 0.5);
+            }
+            out[i] = sum;
+        }
+    };
+    std::printf("threads %d\n", jobs.GetConcurrency());
+
+    double start = NowMs();
+    work(0, ITEMS);
+    std::printf("  serial loop            %8.1f ms\n", NowMs() - start);
+    for (int grain : {1, 64, 512}) {
+        start = NowMs();
+        jobs.ParallelFor(ITEMS, grain, work);
+        std::printf("  parallel-for grain %-4d %8.1f ms\n", grain, NowMs() - start);
+    }
+    // 嵌套：任务内再 ParallelFor
+    start = NowMs();
+    {
+        TaskGroup group;
+        const int chunk = ITEMS / 16;
+        for (int i = 0; i < 16; i++) {
+            group.Run([&jobs, &work, i, chunk] {
+                jobs.ParallelFor(chunk, 8, [&work, i, chunk](int b, int e) { work(i * chunk + b, i * chunk + e); });
+            });
+        }
+    }
+    std::printf("  nested parallel-for    %8.1f ms\n", NowMs() - start);
+
+    // 调度开销
+    start = NowMs();
+    for (int i = 0; i < 1000; i++) {
+        jobs.ParallelFor(64, 1, [](int, int) {});
+    }
+    std::printf("  empty parallel-for     %8.2f us/call\n", (NowMs() - start));
+    start = NowMs();
+    {
+        TaskGroup group;
+        for (int i = 0; i < 100000; i++) {
+            group.Run([] {});
+        }
+    }
+    std::printf("  100k empty tasks       %8.1f ms\n", NowMs() - start);
+
+    // 引擎：500 条命令的整段重放（行条带并行）
+    std::mt19937 rng(3);
+    std::vector<Action> actions;
+    for (int i = 0; i < 500; i++) {
+        actions.push_back(TestData::RandomAction(rng));
+    }
+    auto engine = TestData::MakeEngine();
+    if (engine) {
+        start = NowMs();
+        engine->SetActions(actions);
+        std::printf("  replay 500 commands    %8.1f ms\n", NowMs() - start);
+    }
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (std::getenv("PAPERCUT_JOB_THREADS")) {
+        RunChild();
+        return 0;
+    }
+    const int maxThreads = argc > 1 ? std::atoi(argv[1])
+                                    : static_cast<int>(std::max(4u, std::thread::hardware_concurrency()));
+    std::printf("hardware threads %u\n", std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        std::fflush(stdout);
+        const std::string command = "PAPERCUT_JOB_THREADS=" + std::to_string(threads) + " \"" + argv[0] + "\"";
+        if (std::system(command.c_str()) != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,118 @@
+//
+// Created on 2026/10/17.
+// 作品库：在普通临时目录上保存/列出/读取/删除，重新打开后索引完整，缩略图引用随作品释放
+//
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include "samples/paper_cut_library.h"
+#include "test_common.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+WorkMeta MakeMeta(const std::string& id)
+{
+    WorkMeta meta;
+    meta.id = id;
+    meta.date = 1760000000123;
+    meta.foldMode = 6;
+    meta.paperType = "CIRCLE";
+    meta.paperColor = "#C4161C";
+    return meta;
+}
+
+void TestSaveReopenRemove(const std::string& root)
+{
+    const std::vector<uint8_t> first(1000, 7);
+    const std::vector<uint8_t> second(5, 9);
+    {
+        WorkLibrary library;
+        CHECK(library.Open(root + "/"));
+        CHECK(library.List().empty());
+
+        WorkMeta meta = MakeMeta("work_1");
+        meta.title = "a\tb\nc\\d";  // 索引是制表符分隔，字段内需要转义
+        CHECK(library.Save(meta, first.data(), first.size()));
+        WorkMeta other = MakeMeta("work_2");
+        CHECK(library.Save(other, second.data(), second.size()));
+        CHECK(library.SetPreviewImage("work_2", "file:///external/work_2.png"));
+
+        // 非法 id 不会落到 works/ 之外
+        CHECK(!library.Save(WorkMeta(), second.data(), second.size()));
+        CHECK(!library.Save(MakeMeta("../escape"), second.data(), second.size()));
+        CHECK(!library.Save(MakeMeta(".hidden"), second.data(), second.size()));
+        CHECK(!fs::exists(fs::path(root).parent_path() / "escape.pcw"));
+
+        // 同 id 覆盖：数据与索引项都更新，列表顺序不变
+        meta.foldMode = 8;
+        CHECK(library.Save(meta, second.data(), second.size()));
+    }
+    // 中断写入留下的临时文件在打开时清理
+    std::ofstream(root + "/works/junk.pcw.tmp") << "x";
+
+    WorkLibrary library;
+    CHECK(library.Open(root));
+    const std::vector<WorkMeta> list = library.List();
+    CHECK(list.size() == 2);
+    if (list.size() == 2) {
+        CHECK(list[0].id == "work_1" && list[0].title == "a\tb\nc\\d" && list[0].foldMode == 8);
+        CHECK(list[0].date == 1760000000123 && list[0].paperType == "CIRCLE" && list[0].paperColor == "#C4161C");
+        CHECK(list[1].id == "work_2" && list[1].previewImage == "file:///external/work_2.png");
+    }
+    CHECK(!fs::exists(root + "/works/junk.pcw.tmp"));
+
+    std::vector<uint8_t> data;
+    CHECK(library.Load("work_1", &data) && data == second);
+    CHECK(library.Contains("work_2"));
+    CHECK(library.Remove("work_1"));
+    CHECK(!library.Contains("work_1"));
+    CHECK(!library.Load("work_1", &data));
+    CHECK(!fs::exists(root + "/works/work_1.pcw"));
+    CHECK(library.List().size() == 1);
+}
+
+// 缩略图按内容共享：只有不再被任何作品引用时才删除文件，外部引用不受影响
+void TestThumbnailReferences(const std::string& root)
+{
+    WorkLibrary library;
+    CHECK(library.Open(root));
+    const std::vector<uint8_t> data(10, 1);
+    const std::vector<uint8_t> png(100, 2);
+    CHECK(library.Save(MakeMeta("a"), data.data(), data.size()));
+    CHECK(library.Save(MakeMeta("b"), data.data(), data.size()));
+
+    CHECK(!library.HasThumbnail("k1"));
+    CHECK(library.WriteThumbnail("k1", png.data(), png.size()) && library.HasThumbnail("k1"));
+    const std::string shared = library.ThumbnailUri("k1");
+    CHECK(shared == "file://" + root + "/thumbs/k1.png");
+    CHECK(library.SetPreviewImage("a", shared) && library.SetPreviewImage("b", shared));
+
+    CHECK(library.WriteThumbnail("k2", png.data(), png.size()));
+    CHECK(library.SetPreviewImage("a", library.ThumbnailUri("k2")));
+    CHECK(library.HasThumbnail("k1"));  // b 仍在使用
+
+    // 重新保存（不带缩略图）释放旧引用
+    CHECK(library.Save(MakeMeta("a"), data.data(), data.size()));
+    CHECK(!library.HasThumbnail("k2"));
+    CHECK(library.Remove("b"));
+    CHECK(!library.HasThumbnail("k1"));
+    CHECK(library.SetPreviewImage("a", "file:///external/x.png"));
+}
+} // namespace
+
+int main()
+{
+    char pattern[] = "/tmp/papercut_library_XXXXXX";
+    const char* dir = mkdtemp(pattern);
+    CHECK(dir != nullptr);
+    if (!dir) {
+        return TestResult("library_test");
+    }
+    TestSaveReopenRemove(std::string(dir) + "/root");
+    TestThumbnailReferences(std::string(dir) + "/thumbs");
+    std::error_code error;
+    fs::remove_all(dir, error);
+    return TestResult("library_test");
+}
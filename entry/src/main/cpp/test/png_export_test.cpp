@@ -0,0 +1,189 @@
+//
+// Created on 2026/10/17.
+// 分块 PNG 导出（无窗口）：解码写出的文件（CRC、inflate、反滤波），与整幅一次光栅化逐像素比较
+//
+
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include <zlib.h>
+#include "test_common.h"
+#include "utils/coverage_rasterizer.h"
+
+namespace {
+constexpr uint32_t PAPER_COLOR = 0xFFD02030;
+
+uint32_t ReadBigEndian(const uint8_t* p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+int Paeth(int a, int b, int c)
+{
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    return (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+}
+
+// 只支持导出使用的格式：8 位 RGBA、非隔行
+bool DecodePng(const std::string& path, int* width, int* height, std::vector<uint8_t>* rgba)
+{
+    std::vector<uint8_t> file;
+    FILE* stream = std::fopen(path.c_str(), "rb");
+    if (!stream) {
+        return false;
+    }
+    uint8_t buffer[1 << 16];
+    size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), stream)) > 0) {
+        file.insert(file.end(), buffer, buffer + read);
+    }
+    std::fclose(stream);
+    if (file.size() < 8 || std::memcmp(file.data(), "\x89PNG\r\n\x1a\n", 8) != 0) {
+        return false;
+    }
+    std::vector<uint8_t> compressed;
+    bool ended = false;
+    for (size_t pos = 8; pos + 12 <= file.size();) {
+        const uint32_t length = ReadBigEndian(&file[pos]);
+        if (pos + 12 + length > file.size()) {
+            return false;
+        }
+        const uint8_t* type = &file[pos + 4];
+        if (crc32(0, type, 4 + length) != ReadBigEndian(type + 4 + length)) {
+            return false;
+        }
+        if (std::memcmp(type, "IHDR", 4) == 0) {
+            *width = static_cast<int>(ReadBigEndian(type + 4));
+            *height = static_cast<int>(ReadBigEndian(type + 8));
+            if (type[12] != 8 || type[13] != 6 || type[16] != 0) {
+                return false;
+            }
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            compressed.insert(compressed.end(), type + 4, type + 4 + length);
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            ended = true;
+        }
+        pos += 12 + length;
+    }
+    if (!ended || *width <= 0 || *height <= 0) {
+        return false;
+    }
+    const size_t rowBytes = static_cast<size_t>(*width) * 4;
+    std::vector<uint8_t> raw((rowBytes + 1) * *height);
+    uLongf rawSize = raw.size();
+    if (uncompress(raw.data(), &rawSize, compressed.data(), compressed.size()) != Z_OK || rawSize != raw.size()) {
+        return false;
+    }
+    rgba->assign(rowBytes * *height, 0);
+    for (int y = 0; y < *height; y++) {
+        const uint8_t filter = raw[y * (rowBytes + 1)];
+        const uint8_t* src = &raw[y * (rowBytes + 1) + 1];
+        uint8_t* row = &(*rgba)[y * rowBytes];
+        const uint8_t* prev = y > 0 ? row - rowBytes : nullptr;
+        for (size_t i = 0; i < rowBytes; i++) {
+            const int a = i >= 4 ? row[i - 4] : 0;
+            const int b = prev ? prev[i] : 0;
+            const int c = (prev && i >= 4) ? prev[i - 4] : 0;
+            int predictor = 0;
+            switch (filter) {
+                case 0: predictor = 0; break;
+                case 1: predictor = a; break;
+                case 2: predictor = b; break;
+                case 3: predictor = (a + b) / 2; break;
+                case 4: predictor = Paeth(a, b, c); break;
+                default: return false;
+            }
+            row[i] = static_cast<uint8_t>(src[i] + predictor);
+        }
+    }
+    return true;
+}
+
+// 尺寸不是 tile 的整数倍、非正方形：分块/分段压缩的结果应与整幅光栅化一致
+void CheckExport(PaperCutEngine* engine, int width, int height, const std::string& path)
+{
+    const int fd = open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    const double start = NowMs();
+    CHECK(fd >= 0 && engine->ExportPng(fd, width, height));
+    const double elapsed = NowMs() - start;
+    close(fd);
+
+    int decodedWidth = 0;
+    int decodedHeight = 0;
+    std::vector<uint8_t> rgba;
+    CHECK(DecodePng(path, &decodedWidth, &decodedHeight, &rgba));
+    CHECK(decodedWidth == width && decodedHeight == height);
+    if (decodedWidth != width || decodedHeight != height) {
+        return;
+    }
+
+    TiledPngExport::Image reference;
+    CHECK(engine->PrepareExportPng(width, height, &reference));
+    std::vector<uint8_t> coverage(static_cast<size_t>(width) * height, 0);
+    CoverageRasterizer rasterizer;
+    rasterizer.Begin(0, 0, width, height);
+    rasterizer.AddContours(reference.contours);
+    rasterizer.Fill(RasterFillRule::NON_ZERO, [&coverage, width](int y, int x0, int x1, const uint8_t* c) {
+        std::memcpy(&coverage[static_cast<size_t>(y) * width + x0], c, x1 - x0);
+    });
+
+    // 非预乘输出：有覆盖的像素颜色就是纸张颜色，透明像素颜色为 0；alpha 允许 ±1（预乘往返取整）
+    size_t mismatches = 0;
+    for (size_t i = 0; i < coverage.size(); i++) {
+        const uint8_t* px = &rgba[i * 4];
+        const bool colorOk = px[3] ? (px[0] == 0xD0 && px[1] == 0x20 && px[2] == 0x30) : !(px[0] | px[1] | px[2]);
+        mismatches += (std::abs(px[3] - coverage[i]) > 1 || !colorOk);
+    }
+    std::printf("%dx%d: %.1f ms, %zu pixels differ from single-pass raster\n", width, height, elapsed, mismatches);
+    CHECK(mismatches == 0);
+}
+} // namespace
+
+int main()
+{
+    auto engine = TestData::MakeEngine();
+    CHECK(engine != nullptr);
+    if (!engine) {
+        return TestResult("png_export_test");
+    }
+    engine->SetPaperType(PaperType::SQUARE);
+    engine->SetFoldMode(FoldMode::EIGHT);
+    engine->SetPaperColor(PAPER_COLOR);
+    std::mt19937 rng(11);
+    for (int i = 0; i < 200; i++) {
+        engine->AddAction(TestData::RandomCut(rng));
+    }
+
+    char pattern[] = "/tmp/papercut_png_XXXXXX";
+    const int fd = mkstemp(pattern);
+    CHECK(fd >= 0);
+    if (fd < 0) {
+        return TestResult("png_export_test");
+    }
+    close(fd);
+    for (const auto& size : {std::make_pair(1999, 1301), std::make_pair(700, 2100), std::make_pair(64, 64),
+                             std::make_pair(1, 1)}) {
+        CheckExport(engine.get(), size.first, size.second, pattern);
+    }
+    unlink(pattern);
+
+    // 写入失败、无效描述符、超出尺寸上限
+    const int full = open("/dev/full", O_WRONLY);
+    if (full >= 0) {
+        CHECK(!engine->ExportPng(full, 512, 512));
+        close(full);
+    }
+    CHECK(!engine->ExportPng(-1, 512, 512));
+    TiledPngExport::Image image;
+    CHECK(!engine->PrepareExportPng(TiledPngExport::MAX_SIZE + 1, 16, &image));
+    CHECK(!engine->PrepareExportPng(16, INT32_MAX, &image));
+    // 尺寸在快照轮廓之前拒绝
+    CHECK(image.contours.empty() && image.width == 0);
+    CHECK(!PaperCutEngine::IsValidExportSize(INT32_MAX, INT32_MAX));
+    CHECK(PaperCutEngine::IsValidExportSize(0, TiledPngExport::MAX_SIZE));
+    return TestResult("png_export_test");
+}
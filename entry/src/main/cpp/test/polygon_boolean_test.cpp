@@ -0,0 +1,161 @@
+//
+// Created on 2026/10/17.
+// 多边形布尔运算：已知差集的精确面积/周长，以及剩余纸张面积与裁剪 mask 覆盖率之和一致
+//
+
+#include <algorithm>
+#include <random>
+#include "samples/paper_cut_geometry.h"
+#include "test_common.h"
+#include "utils/polygon_boolean.h"
+
+namespace {
+using Contours = std::vector<RasterPath::Contour>;
+
+RasterPath::Contour Rect(float left, float top, float right, float bottom)
+{
+    RasterPath::Contour contour;
+    contour.points = {{left, top}, {right, top}, {right, bottom}, {left, bottom}};
+    contour.closed = true;
+    return contour;
+}
+
+RasterPath::Contour Reversed(RasterPath::Contour contour)
+{
+    std::reverse(contour.points.begin(), contour.points.end());
+    return contour;
+}
+
+Contours Compute(const Contours& subject, const Contours& clip, BooleanOp op)
+{
+    Contours out;
+    PolygonBoolean::Compute(subject, RasterFillRule::NON_ZERO, clip, RasterFillRule::NON_ZERO, op, &out);
+    return out;
+}
+
+bool Near(double a, double b)
+{
+    return std::fabs(a - b) <= 1e-6 * std::max(1.0, std::fabs(b));
+}
+
+// 结果面积、周长、轮廓数与孔数（有向面积为负的轮廓）
+void ExpectResult(const Contours& result, double area, double perimeter, size_t contours, size_t holes)
+{
+    CHECK(Near(PolygonBoolean::Area(result), area));
+    CHECK(Near(PolygonBoolean::Perimeter(result), perimeter));
+    CHECK(result.size() == contours);
+    size_t negative = 0;
+    for (const auto& contour : result) {
+        CHECK(contour.closed);
+        negative += PolygonBoolean::Area({contour}) < 0 ? 1 : 0;
+    }
+    CHECK(negative == holes);
+}
+
+void TestKnownDifferences()
+{
+    const Contours square = {Rect(0, 0, 100, 100)};
+    // 部分重叠：L 形，周长与原正方形相同
+    ExpectResult(Compute(square, {Rect(50, 50, 150, 150)}, BooleanOp::DIFFERENCE), 7500, 400, 1, 0);
+    // 完全在内部：外轮廓 + 一个孔
+    ExpectResult(Compute(square, {Rect(25, 25, 75, 75)}, BooleanOp::DIFFERENCE), 7500, 600, 2, 1);
+    // 反向的减数按非零规则结果相同
+    ExpectResult(Compute(square, {Reversed(Rect(25, 25, 75, 75))}, BooleanOp::DIFFERENCE), 7500, 600, 2, 1);
+    // 不相交：原样保留
+    ExpectResult(Compute(square, {Rect(200, 200, 300, 300)}, BooleanOp::DIFFERENCE), 10000, 400, 1, 0);
+    // 只共享一条边：不减少面积，也不留下零宽的边
+    ExpectResult(Compute(square, {Rect(100, 0, 200, 100)}, BooleanOp::DIFFERENCE), 10000, 400, 1, 0);
+    // 只共享一个角点
+    ExpectResult(Compute(square, {Rect(100, 100, 200, 200)}, BooleanOp::DIFFERENCE), 10000, 400, 1, 0);
+    // 共线重叠的边：减去下半部分
+    ExpectResult(Compute(square, {Rect(0, 50, 100, 100)}, BooleanOp::DIFFERENCE), 5000, 300, 1, 0);
+    // 与底边部分共线的缺口
+    ExpectResult(Compute(square, {Rect(20, 0, 60, 40)}, BooleanOp::DIFFERENCE), 8400, 480, 1, 0);
+    // 贯穿：分成两块
+    ExpectResult(Compute(square, {Rect(40, -10, 60, 110)}, BooleanOp::DIFFERENCE), 8000, 560, 2, 0);
+    // 减去自身 / 被完全覆盖：空
+    CHECK(Compute(square, square, BooleanOp::DIFFERENCE).empty());
+    CHECK(Compute(square, {Rect(-1, -1, 101, 101)}, BooleanOp::DIFFERENCE).empty());
+    // 斜边：减去半个正方形
+    RasterPath::Contour triangle;
+    triangle.points = {{0, 0}, {100, 0}, {0, 100}};
+    triangle.closed = true;
+    ExpectResult(Compute(square, {triangle}, BooleanOp::DIFFERENCE), 5000, 200 + 100 * std::sqrt(2.0), 1, 0);
+
+    // 其余运算在同一对正方形上的面积
+    const Contours other = {Rect(50, 50, 150, 150)};
+    ExpectResult(Compute(square, other, BooleanOp::UNION), 17500, 600, 1, 0);
+    ExpectResult(Compute(square, other, BooleanOp::INTERSECTION), 2500, 200, 1, 0);
+    CHECK(Near(PolygonBoolean::Area(Compute(square, other, BooleanOp::XOR)), 15000));
+}
+
+// 减数的多个轮廓相互重叠（非零规则下按并集处理）
+void TestOverlappingClip()
+{
+    const Contours square = {Rect(0, 0, 100, 100)};
+    const Contours clip = {Rect(10, 10, 60, 60), Rect(40, 40, 90, 90)};
+    ExpectResult(Compute(square, clip, BooleanOp::DIFFERENCE), 10000 - 2500 - 2500 + 400, 400 + 320, 2, 1);
+}
+
+// 裁剪 mask 在纸张范围内的覆盖率之和 ≈ 剩余纸张面积（mask 不含纸张形状，只统计方形纸张内的像素）
+double MaskArea(const RasterBitmap* mask, int left, int top, int right, int bottom)
+{
+    const uint8_t* pixels = static_cast<const uint8_t*>(mask->GetPixels());
+    uint64_t sum = 0;
+    for (int y = top; y < bottom; y++) {
+        for (int x = left; x < right; x++) {
+            sum += pixels[static_cast<size_t>(y) * mask->GetWidth() + x];
+        }
+    }
+    return sum / 255.0;
+}
+
+void TestAreaMatchesMask()
+{
+    // 2000 的画布：方形纸张半径 800，边界落在整像素上
+    constexpr int SIZE = 2000;
+    auto engine = TestData::MakeEngine(SIZE);
+    CHECK(engine != nullptr);
+    if (!engine) {
+        return;
+    }
+    engine->SetPaperType(PaperType::SQUARE);
+    const int paperLeft = SIZE / 2 - 800;
+    const int paperRight = SIZE / 2 + 800;
+    CHECK(Near(engine->GetPaperGeometry().GetArea(), 1600.0 * 1600.0));
+
+    std::mt19937 rng(19);
+    for (int i = 0; i < 40; i++) {
+        // 部分剪刀路径越出纸张边界
+        engine->AddAction(TestData::RandomCut(rng, 900.0f));
+        if (i % 5 == 4) {
+            PaperGeometry& geometry = engine->GetPaperGeometry();
+            const double area = geometry.GetArea();
+            const double maskArea = MaskArea(engine->GetCutMask(), paperLeft, paperLeft, paperRight, paperRight);
+            // 抗锯齿边缘每像素的 1/255 量化误差与边界长度成正比（实测差 < 2）
+            CHECK(std::fabs(area - maskArea) <= 0.001 * geometry.GetPerimeter() + 1.0);
+            CHECK(area < 1600.0 * 1600.0);
+        }
+    }
+    // 撤销一半后几何按剩余历史重建
+    for (int i = 0; i < 20; i++) {
+        engine->Undo();
+    }
+    PaperGeometry& geometry = engine->GetPaperGeometry();
+    CHECK(geometry.GetCutCount() == 20);
+    const double maskArea = MaskArea(engine->GetCutMask(), paperLeft, paperLeft, paperRight, paperRight);
+    CHECK(std::fabs(geometry.GetArea() - maskArea) <= 0.001 * geometry.GetPerimeter() + 1.0);
+
+    engine->Clear();
+    CHECK(Near(engine->GetPaperGeometry().GetArea(), 1600.0 * 1600.0));
+    CHECK(Near(engine->GetPaperGeometry().GetPerimeter(), 6400.0));
+}
+} // namespace
+
+int main()
+{
+    TestKnownDifferences();
+    TestOverlappingClip();
+    TestAreaMatchesMask();
+    return TestResult("polygon_boolean_test");
+}
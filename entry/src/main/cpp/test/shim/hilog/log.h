@@ -0,0 +1,21 @@
+//
+// Created on 2026/10/17.
+// 主机构建用的 hilog 替身：只提供引擎源码用到的宏与 OH_LOG_Print，日志直接丢弃
+//
+// 设备构建链接真正的 libhilog_ndk，不会看到这个目录。
+//
+
+#ifndef PAPERCUTTING_TEST_SHIM_HILOG_LOG_H
+#define PAPERCUTTING_TEST_SHIM_HILOG_LOG_H
+
+#ifndef LOG_DOMAIN
+#define LOG_DOMAIN 0
+#endif
+
+enum LogType { LOG_APP = 0 };
+enum LogLevel { LOG_DEBUG = 3, LOG_INFO = 4, LOG_WARN = 5, LOG_ERROR = 6, LOG_FATAL = 7 };
+
+// 格式串含 hilog 专有的 %{public} 修饰，不能转给 printf
+inline int OH_LOG_Print(LogType, LogLevel, unsigned int, const char*, const char*, ...) { return 0; }
+
+#endif // PAPERCUTTING_TEST_SHIM_HILOG_LOG_H
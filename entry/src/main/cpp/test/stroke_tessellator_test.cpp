@@ -0,0 +1,214 @@
+//
+// Created on 2026/10/17.
+// 描边展开：急转弯/折返处中心线附近没有空洞、网格不越出线宽，增量追加与一次展开逐顶点一致
+//
+
+#include <random>
+#include "test_common.h"
+#include "utils/coverage_rasterizer.h"
+#include "utils/stroke_tessellator.h"
+
+namespace {
+constexpr int GRID = 256;
+
+// 平滑中心线（与 StrokeTessellator / CreateSmoothStrokePath 相同的中点二次曲线），按细步长采样
+std::vector<RasterPoint> SampleCenterline(const std::vector<RasterPoint>& inputs)
+{
+    std::vector<RasterPoint> samples;
+    if (inputs.empty()) {
+        return samples;
+    }
+    auto line = [&samples](RasterPoint a, RasterPoint b) {
+        for (int k = 0; k <= 64; k++) {
+            const float t = k / 64.0f;
+            samples.push_back({a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t});
+        }
+    };
+    RasterPoint start = inputs[0];
+    samples.push_back(start);
+    for (size_t i = 1; i + 1 < inputs.size(); i++) {
+        const RasterPoint c = inputs[i];
+        const RasterPoint e = {(c.x + inputs[i + 1].x) * 0.5f, (c.y + inputs[i + 1].y) * 0.5f};
+        for (int k = 1; k <= 256; k++) {
+            const float t = k / 256.0f;
+            const float u = 1.0f - t;
+            samples.push_back({u * u * start.x + 2 * u * t * c.x + t * t * e.x,
+                               u * u * start.y + 2 * u * t * c.y + t * t * e.y});
+        }
+        start = e;
+    }
+    line(start, inputs.back());
+    return samples;
+}
+
+std::vector<uint8_t> Rasterize(StrokeTessellator& stroke)
+{
+    std::vector<uint8_t> coverage(GRID * GRID, 0);
+    CoverageRasterizer rasterizer;
+    rasterizer.Begin(0, 0, GRID, GRID);
+    const std::vector<RasterPoint>& vertices = stroke.GetVertices();
+    for (const StrokeTessellator::Piece& piece : stroke.GetPieces()) {
+        rasterizer.AddContour(vertices.data() + piece.first, piece.count);
+    }
+    rasterizer.Fill(RasterFillRule::NON_ZERO, [&coverage](int y, int x0, int x1, const uint8_t* values) {
+        std::memcpy(coverage.data() + static_cast<size_t>(y) * GRID + x0, values, x1 - x0);
+    });
+    return coverage;
+}
+
+// 对每个中心线采样点：半径 halfWidth - 1 内的像素必须全覆盖（无空洞），
+// 所有中心线采样点 halfWidth + 1.5 以外的像素必须无覆盖（不越界）
+void CheckCoverage(const std::vector<RasterPoint>& inputs, float width)
+{
+    StrokeTessellator stroke(width);
+    stroke.Append(inputs.data(), inputs.size());
+    const std::vector<uint8_t> coverage = Rasterize(stroke);
+    const std::vector<RasterPoint> center = SampleCenterline(inputs);
+
+    const float half = width * 0.5f;
+    std::vector<uint8_t> inner(GRID * GRID, 0);
+    std::vector<uint8_t> allowed(GRID * GRID, 0);
+    for (const RasterPoint& c : center) {
+        const int reach = static_cast<int>(std::ceil(half + 2.0f));
+        for (int y = static_cast<int>(c.y) - reach; y <= static_cast<int>(c.y) + reach; y++) {
+            for (int x = static_cast<int>(c.x) - reach; x <= static_cast<int>(c.x) + reach; x++) {
+                if (x < 0 || y < 0 || x >= GRID || y >= GRID) {
+                    continue;
+                }
+                // 像素中心到中心线采样点的距离；像素任意点到中心的距离不超过 √2 / 2
+                const float d = std::hypot(x + 0.5f - c.x, y + 0.5f - c.y);
+                if (d + 0.71f <= half - 0.25f) {
+                    inner[y * GRID + x] = 1;
+                }
+                if (d - 0.71f <= half + 0.5f) {
+                    allowed[y * GRID + x] = 1;
+                }
+            }
+        }
+    }
+    int holes = 0;
+    int outside = 0;
+    for (size_t i = 0; i < coverage.size(); i++) {
+        holes += inner[i] && coverage[i] < 255 ? 1 : 0;
+        outside += !allowed[i] && coverage[i] > 0 ? 1 : 0;
+    }
+    if (holes != 0 || outside != 0) {
+        std::fprintf(stderr, "width %.1f, %zu inputs: %d hole pixel(s), %d pixel(s) outside\n", width,
+                     inputs.size(), holes, outside);
+    }
+    CHECK(holes == 0);
+    CHECK(outside == 0);
+}
+
+void TestSharpTurns()
+{
+    const float widths[] = {3.0f, 8.0f, 20.0f};
+    for (float width : widths) {
+        // 锐角折返（中点曲线在顶点附近急转）
+        CheckCoverage({{20, 60}, {200, 60}, {30, 70}, {210, 120}}, width);
+        // 完全折返：同一直线来回
+        CheckCoverage({{30, 128}, {220, 128}, {40, 128}, {180, 128}}, width);
+        // 锯齿：每段都是急转弯，线段长短不一（部分顶点无法斜接）
+        CheckCoverage({{20, 200}, {40, 40}, {50, 210}, {62, 50}, {66, 200}, {90, 48}, {92, 52}, {130, 220},
+                       {131, 30}, {230, 128}},
+                      width);
+        // 直角与重合点
+        CheckCoverage({{40, 40}, {200, 40}, {200, 40}, {200, 200}, {40, 200}, {40, 60}}, width);
+        // 只有两点 / 一点
+        CheckCoverage({{60, 60}, {190, 170}}, width);
+        CheckCoverage({{128, 128}}, width);
+    }
+    // 随机急转折线
+    std::mt19937 rng(18);
+    std::uniform_real_distribution<float> coord(30.0f, 226.0f);
+    for (int round = 0; round < 40; round++) {
+        std::vector<RasterPoint> inputs;
+        const int count = 3 + static_cast<int>(rng() % 12);
+        for (int i = 0; i < count; i++) {
+            inputs.push_back({coord(rng), coord(rng)});
+        }
+        CheckCoverage(inputs, round % 2 == 0 ? 3.0f : 8.0f);
+    }
+}
+
+bool SameMesh(StrokeTessellator& a, StrokeTessellator& b)
+{
+    const std::vector<StrokeTessellator::Piece>& pa = a.GetPieces();
+    const std::vector<StrokeTessellator::Piece>& pb = b.GetPieces();
+    const std::vector<RasterPoint>& va = a.GetVertices();
+    const std::vector<RasterPoint>& vb = b.GetVertices();
+    if (pa.size() != pb.size() || va.size() != vb.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < pa.size(); i++) {
+        if (pa[i].first != pb[i].first || pa[i].count != pb[i].count) {
+            return false;
+        }
+    }
+    // 逐位比较：增量路径必须走与一次展开完全相同的浮点运算
+    return std::memcmp(va.data(), vb.data(), va.size() * sizeof(RasterPoint)) == 0;
+}
+
+// 逐点 / 随机分批追加，每次追加后都取一次网格（触发尾部重建），最终与一次展开完全一致；
+// 每一步的中间结果也与同一前缀的一次展开一致
+void TestIncrementalMatchesOneShot()
+{
+    std::mt19937 rng(81);
+    std::uniform_real_distribution<float> coord(0.0f, 500.0f);
+    std::uniform_real_distribution<float> step(-40.0f, 40.0f);
+    for (int round = 0; round < 60; round++) {
+        const float width = round % 3 == 0 ? 3.0f : (round % 3 == 1 ? 8.0f : 25.0f);
+        std::vector<RasterPoint> inputs;
+        RasterPoint p = {coord(rng), coord(rng)};
+        const int count = 2 + static_cast<int>(rng() % 120);
+        for (int i = 0; i < count; i++) {
+            // 平滑段、急转弯、重合点、非有限点混合
+            const int kind = static_cast<int>(rng() % 10);
+            if (kind == 0 && !inputs.empty()) {
+                inputs.push_back(inputs.back());
+                continue;
+            }
+            if (kind == 1) {
+                inputs.push_back({NAN, 1.0f});
+                continue;
+            }
+            p = kind == 2 ? RasterPoint{coord(rng), coord(rng)} : RasterPoint{p.x + step(rng), p.y + step(rng)};
+            inputs.push_back(p);
+        }
+
+        StrokeTessellator incremental(width);
+        size_t appended = 0;
+        bool prefixesMatch = true;
+        while (appended < inputs.size()) {
+            const size_t batch = std::min(inputs.size() - appended, static_cast<size_t>(1 + rng() % 4));
+            if (batch == 1) {
+                incremental.Append(inputs[appended]);
+            } else {
+                incremental.Append(inputs.data() + appended, batch);
+            }
+            appended += batch;
+            incremental.GetPieces();
+            StrokeTessellator prefix(width);
+            prefix.Append(inputs.data(), appended);
+            prefixesMatch = prefixesMatch && SameMesh(incremental, prefix);
+        }
+        CHECK(prefixesMatch);
+        StrokeTessellator oneShot(width);
+        oneShot.Append(inputs.data(), inputs.size());
+        CHECK(SameMesh(incremental, oneShot));
+
+        // Reset 后复用同一对象与新建对象一致
+        incremental.Reset(width);
+        CHECK(incremental.GetInputCount() == 0 && incremental.GetPieces().empty());
+        incremental.Append(inputs.data(), inputs.size());
+        CHECK(SameMesh(incremental, oneShot));
+    }
+}
+} // namespace
+
+int main()
+{
+    TestSharpTurns();
+    TestIncrementalMatchesOneShot();
+    return TestResult("stroke_tessellator_test");
+}
@@ -0,0 +1,216 @@
+//
+// Created on 2026/10/17.
+// SVG 导出：解析输出的路径并光栅化，与同一作品从数据层 mask 展开的预览逐像素比较
+//
+// 预览（盖印展开）来自栅格 mask，SVG 来自矢量几何，两条路径互相独立。折数不能整除 90° 时
+// 盖印要对旋转后的 tile 重采样，接缝与剪口边缘会有少量像素差，阈值按此留余量。
+//
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+#include "test_common.h"
+#include "utils/coverage_rasterizer.h"
+
+namespace {
+constexpr int SIZE = 1024;
+
+struct SvgDocument {
+    float viewX = 0;
+    float viewY = 0;
+    float viewWidth = 0;
+    float viewHeight = 0;
+    int width = 0;
+    int height = 0;
+    std::string fill;
+    std::vector<RasterPath::Contour> contours;
+};
+
+std::string Attribute(const std::string& text, const std::string& name)
+{
+    const std::string key = " " + name + "=\"";
+    const size_t begin = text.find(key);
+    if (begin == std::string::npos) {
+        return "";
+    }
+    const size_t end = text.find('"', begin + key.size());
+    return text.substr(begin + key.size(), end - begin - key.size());
+}
+
+// SvgWriter 输出的路径子集：m 开始子路径（相对上一子路径起点），其后为相对 lineto 坐标对，z 闭合
+bool ParsePath(const std::string& d, std::vector<RasterPath::Contour>* contours)
+{
+    const char* p = d.c_str();
+    double startX = 0;
+    double startY = 0;
+    double x = 0;
+    double y = 0;
+    while (*p) {
+        if (*p == ' ') {
+            p++;
+        } else if (*p == 'z') {
+            x = startX;
+            y = startY;
+            p++;
+        } else {
+            const bool move = (*p == 'm');
+            p += move ? 1 : 0;
+            char* end = nullptr;
+            const double dx = std::strtod(p, &end);
+            if (end == p) {
+                return false;
+            }
+            p = end;
+            const double dy = std::strtod(p, &end);
+            if (end == p) {
+                return false;
+            }
+            p = end;
+            x += dx;
+            y += dy;
+            if (move) {
+                startX = x;
+                startY = y;
+                contours->emplace_back();
+                contours->back().closed = true;
+            } else if (contours->empty()) {
+                return false;
+            }
+            contours->back().points.push_back({static_cast<float>(x), static_cast<float>(y)});
+        }
+    }
+    return true;
+}
+
+bool ReadSvg(const std::string& path, SvgDocument* doc)
+{
+    std::string text;
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    char buffer[1 << 16];
+    size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, read);
+    }
+    std::fclose(file);
+    if (text.size() < 7 || text.compare(text.size() - 7, 7, "</svg>\n") != 0) {
+        return false;
+    }
+    const size_t svg = text.find("<svg");
+    const size_t pathTag = text.find("<path");
+    if (svg == std::string::npos || pathTag == std::string::npos) {
+        return false;
+    }
+    const std::string header = text.substr(svg, text.find('>', svg) - svg);
+    const std::string element = text.substr(pathTag, text.find("/>", pathTag) - pathTag);
+    if (std::sscanf(Attribute(header, "viewBox").c_str(), "%f %f %f %f", &doc->viewX, &doc->viewY, &doc->viewWidth,
+                    &doc->viewHeight) != 4) {
+        return false;
+    }
+    doc->width = std::atoi(Attribute(header, "width").c_str());
+    doc->height = std::atoi(Attribute(header, "height").c_str());
+    doc->fill = Attribute(element, "fill");
+    return Attribute(element, "fill-rule") == "nonzero" && ParsePath(Attribute(element, "d"), &doc->contours);
+}
+
+void CheckDesign(PaperType paperType, FoldMode foldMode, const std::vector<Action>& actions, const std::string& path)
+{
+    auto engine = TestData::MakeEngine();
+    CHECK(engine != nullptr);
+    if (!engine) {
+        return;
+    }
+    engine->SetPaperType(paperType);
+    engine->SetFoldMode(foldMode);
+    engine->SetPaperColor(0xFFC4161C);
+    engine->SetActions(actions);
+
+    const int fd = open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    CHECK(fd >= 0 && engine->ExportSvg(fd, SIZE, SIZE));
+    close(fd);
+    SvgDocument doc;
+    CHECK(ReadSvg(path, &doc));
+    CHECK(doc.width == SIZE && doc.height == SIZE && doc.fill == "#c4161c");
+    CHECK(!doc.contours.empty() && doc.viewWidth > 0);
+    if (doc.contours.empty() || doc.viewWidth <= 0) {
+        return;
+    }
+
+    // 预览的取景：模型 2048 缩放到 SIZE、以纸张中心为原点
+    const float scale = static_cast<float>(SIZE) / TestData::CANVAS_SIZE;
+    for (auto& contour : doc.contours) {
+        for (RasterPoint& p : contour.points) {
+            p.x = p.x * scale + SIZE * 0.5f;
+            p.y = p.y * scale + SIZE * 0.5f;
+        }
+    }
+    std::vector<uint8_t> vector(static_cast<size_t>(SIZE) * SIZE, 0);
+    CoverageRasterizer rasterizer;
+    rasterizer.Begin(0, 0, SIZE, SIZE);
+    rasterizer.AddContours(doc.contours);
+    rasterizer.Fill(RasterFillRule::NON_ZERO, [&vector](int y, int x0, int x1, const uint8_t* coverage) {
+        std::memcpy(&vector[static_cast<size_t>(y) * SIZE + x0], coverage, x1 - x0);
+    });
+
+    std::vector<uint32_t> preview;
+    CHECK(engine->RenderPreviewToPixels(SIZE, SIZE, &preview));
+    if (preview.size() != vector.size()) {
+        return;
+    }
+    double sum = 0;
+    size_t opaque = 0;
+    size_t far = 0;
+    for (size_t i = 0; i < vector.size(); i++) {
+        const int diff = std::abs(static_cast<int>(preview[i] >> 24) - vector[i]);
+        sum += diff;
+        opaque += vector[i] == 255;
+        far += diff > 128;
+    }
+    const double mean = sum / vector.size();
+    std::printf("paper %d fold %d: %zu contours, mean |da| %.3f, %zu pixels off by more than half\n",
+                static_cast<int>(paperType), static_cast<int>(foldMode), doc.contours.size(), mean, far);
+    CHECK(opaque > vector.size() / 10);
+    // 扇形边界落在 90° 倍数上时盖印不重采样，两种光栅化只差边缘抗锯齿
+    const int fold = static_cast<int>(foldMode);
+    if (fold == 0 || fold == 1 || fold == 2 || fold == 4) {
+        CHECK(mean < 0.2);
+        CHECK(far == 0);
+    } else {
+        CHECK(mean < 2.0);
+        CHECK(far < vector.size() / 1000);
+    }
+}
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(7);
+    std::vector<Action> actions;
+    for (int i = 0; i < 150; i++) {
+        actions.push_back(TestData::RandomCut(rng));
+    }
+    char pattern[] = "/tmp/papercut_svg_XXXXXX";
+    const int fd = mkstemp(pattern);
+    CHECK(fd >= 0);
+    if (fd < 0) {
+        return TestResult("svg_export_test");
+    }
+    close(fd);
+    for (PaperType paperType : {PaperType::CIRCLE, PaperType::SQUARE}) {
+        for (FoldMode foldMode : {FoldMode::ZERO, FoldMode::TWO, FoldMode::FIVE, FoldMode::EIGHT}) {
+            CheckDesign(paperType, foldMode, actions, pattern);
+        }
+    }
+    unlink(pattern);
+
+    // 写入失败（目录 / 无效描述符）返回 false
+    auto engine = TestData::MakeEngine(256);
+    const int directory = open("/tmp", O_RDONLY);
+    CHECK(engine && !engine->ExportSvg(directory, 0, 0));
+    CHECK(engine && !engine->ExportSvg(-1, 0, 0));
+    close(directory);
+    return TestResult("svg_export_test");
+}
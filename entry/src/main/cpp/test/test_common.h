@@ -0,0 +1,121 @@
+//
+// Created on 2026/10/17.
+// 主机测试公共工具：失败计数的 CHECK（不依赖 assert，Release 下同样生效）与引擎测试数据
+//
+
+#ifndef PAPERCUTTING_TEST_COMMON_H
+#define PAPERCUTTING_TEST_COMMON_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+#include "samples/paper_cut_engine.h"
+#include "utils/raster_backend_cpu.h"
+
+inline int& TestFailureCount()
+{
+    static int count = 0;
+    return count;
+}
+
+#define CHECK(cond)                                                                     \
+    do {                                                                                \
+        if (!(cond)) {                                                                  \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            TestFailureCount()++;                                                       \
+        }                                                                               \
+    } while (0)
+
+// main 的返回值：有失败时为 1，ctest 据此判定
+inline int TestResult(const char* name)
+{
+    if (TestFailureCount() > 0) {
+        std::printf("%s: %d check(s) failed\n", name, TestFailureCount());
+        return 1;
+    }
+    std::printf("%s: ok\n", name);
+    return 0;
+}
+
+// 基准计时（毫秒）
+inline double NowMs()
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+namespace TestData {
+constexpr int CANVAS_SIZE = 2048;
+
+inline std::unique_ptr<PaperCutEngine> MakeEngine(int size = CANVAS_SIZE)
+{
+    auto engine = std::make_unique<PaperCutEngine>(std::make_unique<CpuRasterBackend>());
+    return engine->InitializeHeadless(size, size) ? std::move(engine) : nullptr;
+}
+
+inline Action MakeAction(ToolMode tool, std::vector<Point> points)
+{
+    Action action;
+    action.tool = tool;
+    action.type = tool == ToolMode::SCISSORS || tool == ToolMode::BEZIER ? ActionType::CUT : ActionType::STROKE;
+    action.points = std::move(points);
+    return action;
+}
+
+// 不规则闭合剪刀路径（模型坐标，圆心在纸张中心），点已对齐到模型网格
+inline Action RandomCut(std::mt19937& rng, float extent = 900.0f)
+{
+    std::uniform_real_distribution<float> center(-extent, extent);
+    std::uniform_real_distribution<float> radius(10.0f, 120.0f);
+    std::uniform_real_distribution<float> jitter(0.4f, 1.0f);
+    const float cx = center(rng);
+    const float cy = center(rng);
+    const float r = radius(rng);
+    const int count = 8 + static_cast<int>(rng() % 40);
+    std::vector<Point> points;
+    for (int i = 0; i < count; i++) {
+        const float t = i * 6.2831853f / count;
+        const float rr = r * jitter(rng);
+        points.push_back(SnapToModelGrid(Point(cx + rr * std::cos(t), cy + rr * std::sin(t))));
+    }
+    return MakeAction(ToolMode::SCISSORS, std::move(points));
+}
+
+// 剪刀 / 铅笔 / 橡皮随机混合
+inline Action RandomAction(std::mt19937& rng)
+{
+    const int kind = static_cast<int>(rng() % 3);
+    if (kind == 0) {
+        return RandomCut(rng, 750.0f);
+    }
+    std::uniform_real_distribution<float> center(-750.0f, 750.0f);
+    const float cx = center(rng);
+    const float cy = center(rng);
+    const int count = 10 + static_cast<int>(rng() % 80);
+    std::vector<Point> points;
+    for (int i = 0; i < count; i++) {
+        points.push_back(SnapToModelGrid(Point(cx + i * 2.0f - count, cy + 20.0f * std::sin(i * 0.3f))));
+    }
+    return MakeAction(kind == 1 ? ToolMode::DRAFT_PEN : ToolMode::DRAFT_ERASER, std::move(points));
+}
+
+inline bool SameMask(const RasterBitmap* a, const RasterBitmap* b)
+{
+    if (!a || !b || a->GetWidth() != b->GetWidth() || a->GetHeight() != b->GetHeight()) {
+        return false;
+    }
+    const size_t size = static_cast<size_t>(a->GetWidth()) * a->GetHeight();
+    return std::memcmp(a->GetPixels(), b->GetPixels(), size) == 0;
+}
+
+// 裁剪与草稿两个数据层逐字节相同
+inline bool SameLayers(const PaperCutEngine& a, const PaperCutEngine& b)
+{
+    return SameMask(a.GetCutMask(), b.GetCutMask()) && SameMask(a.GetDraftMask(), b.GetDraftMask());
+}
+} // namespace TestData
+
+#endif // PAPERCUTTING_TEST_COMMON_H
@@ -0,0 +1,104 @@
+//
+// Created on 2026/10/17.
+// 预览展开基准：扇形 tile 盖印 2N 次（CANVAS_STAMP）、极坐标查找表（POLAR_LUT）与几何展开（GEOMETRY），
+// 同一引擎、同一 CPU 后端
+//
+// 输出首帧（含 tile / 查找表构建）、稳定帧、新增一条剪刀路径后与撤销一步后的首帧耗时，
+// 以及与盖印结果的平均通道差作为对照。
+//
+
+#include <cstdlib>
+#include "test_common.h"
+
+namespace {
+struct Mode {
+    PreviewUnfoldMode mode;
+    const char* name;
+};
+const Mode MODES[] = {
+    {PreviewUnfoldMode::CANVAS_STAMP, "stamp"},
+    {PreviewUnfoldMode::POLAR_LUT, "lut"},
+    {PreviewUnfoldMode::GEOMETRY, "geometry"},
+};
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int size = argc > 1 ? std::atoi(argv[1]) : 1024;
+    const int frames = 10;
+    std::mt19937 rng(7);
+    std::vector<Action> actions;
+    for (int i = 0; i < 300; i++) {
+        actions.push_back(TestData::RandomCut(rng));
+    }
+
+    std::printf("preview %dx%d, %zu cuts, %d warm frames\n", size, size, actions.size(), frames);
+    for (FoldMode fold : {FoldMode::ZERO, FoldMode::TWO, FoldMode::FOUR, FoldMode::EIGHT}) {
+        std::vector<uint32_t> first;
+        for (const Mode& mode : MODES) {
+            auto engine = TestData::MakeEngine();
+            if (!engine) {
+                return 1;
+            }
+            engine->SetFoldMode(fold);
+            engine->SetActions(actions);
+            engine->SetPreviewUnfoldMode(mode.mode);
+
+            CpuRasterBitmap bitmap(size, size, RasterFormat::RGBA8888);
+            CpuRasterCanvas canvas(&bitmap);
+            double start = NowMs();
+            canvas.Clear(0);
+            engine->RenderPreviewTo(&canvas);
+            const double cold = NowMs() - start;
+            start = NowMs();
+            for (int i = 0; i < frames; i++) {
+                canvas.Clear(0);
+                engine->RenderPreviewTo(&canvas);
+            }
+            const double warm = (NowMs() - start) / frames;
+
+            const uint32_t* pixels = static_cast<const uint32_t*>(bitmap.GetPixels());
+            double diff = 0;
+            if (first.empty()) {
+                first.assign(pixels, pixels + static_cast<size_t>(size) * size);
+            } else {
+                for (size_t i = 0; i < first.size(); i++) {
+                    for (int shift = 0; shift < 24; shift += 8) {
+                        diff += std::abs(static_cast<int>((pixels[i] >> shift) & 0xFF) -
+                                         static_cast<int>((first[i] >> shift) & 0xFF));
+                    }
+                }
+                diff /= first.size() * 3;
+            }
+            // 再提交一条剪刀路径后的首帧：编辑时每次抬笔都要付出的重建代价（tile 重绘 / 几何增量合并后重新展开）
+            std::mt19937 cutRng(11);  // 各模式追加相同的剪刀路径
+            double afterCut = 0;
+            for (int i = 0; i < frames; i++) {
+                engine->AddAction(TestData::RandomCut(cutRng));
+                start = NowMs();
+                canvas.Clear(0);
+                engine->RenderPreviewTo(&canvas);
+                afterCut += NowMs() - start;
+            }
+            afterCut /= frames;
+            // 撤销后的首帧：几何展开要从最后一次清空起重新合并剪刀路径，tile 只按像素重绘
+            double afterUndo = 0;
+            for (int i = 0; i < frames; i++) {
+                engine->Undo();
+                start = NowMs();
+                canvas.Clear(0);
+                engine->RenderPreviewTo(&canvas);
+                afterUndo += NowMs() - start;
+            }
+            afterUndo /= frames;
+
+            std::printf("fold %d %-8s first %7.2f ms  frame %7.2f ms  after cut %7.2f ms  after undo %7.2f ms",
+                        static_cast<int>(fold), mode.name, cold, warm, afterCut, afterUndo);
+            if (&mode != &MODES[0]) {
+                std::printf("  mean |dRGB| vs %s %.3f", MODES[0].name, diff);
+            }
+            std::printf("\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,172 @@
+//
+// Created on 2026/10/17.
+// 均匀网格空间索引：跨多格、落在格子边界、空/退化矩形、截断后查询，以及与逐条暴力检查的随机比较
+//
+
+#include <random>
+#include "test_common.h"
+#include "utils/uniform_grid.h"
+
+namespace {
+using Ids = std::vector<uint32_t>;
+
+Ids Query(const UniformGrid& grid, const RasterIRect& rect, size_t begin = 0, size_t end = SIZE_MAX)
+{
+    Ids out = {12345};  // Query 覆盖原内容
+    grid.Query(rect, begin, end, &out);
+    return out;
+}
+
+// 参照：逐条检查编号范围与相交（Intersects 本身不排除空矩形，网格中空矩形只占编号）
+Ids BruteForce(const std::vector<RasterIRect>& rects, const RasterIRect& rect, size_t begin, size_t end)
+{
+    Ids out;
+    if (rect.IsEmpty()) {
+        return out;
+    }
+    for (size_t id = begin; id < std::min(end, rects.size()); id++) {
+        if (!rects[id].IsEmpty() && rects[id].Intersects(rect)) {
+            out.push_back(static_cast<uint32_t>(id));
+        }
+    }
+    return out;
+}
+
+void TestSpanningManyCells()
+{
+    UniformGrid grid;
+    grid.Reset(1024, 1024, 64);
+    grid.Append({10, 10, 1000, 1000});  // 0：覆盖 16x16 个格子
+    grid.Append({500, 500, 520, 520});  // 1：单个格子
+    CHECK(Query(grid, {0, 0, 1024, 1024}) == Ids({0, 1}));  // 多格条目只返回一次
+    CHECK(Query(grid, {990, 990, 995, 995}) == Ids({0}));
+    CHECK(Query(grid, {505, 505, 506, 506}) == Ids({0, 1}));
+    CHECK(Query(grid, {0, 0, 10, 10}).empty());  // 同一格子、包围盒不相交
+    CHECK(Query(grid, {0, 0, 1024, 1024}, 1) == Ids({1}));
+    CHECK(Query(grid, {0, 0, 1024, 1024}, 0, 1) == Ids({0}));
+    CHECK(Query(grid, {0, 0, 1024, 1024}, 1, 1).empty());
+}
+
+void TestCellBoundaries()
+{
+    UniformGrid grid;
+    grid.Reset(256, 256, 64);
+    grid.Append({0, 0, 64, 64});      // 0：恰好一个格子（右/下开区间，不进入下一格）
+    grid.Append({64, 64, 128, 128});  // 1：下一个格子
+    grid.Append({63, 63, 65, 65});    // 2：跨四个格子的 2x2
+    CHECK(Query(grid, {64, 0, 65, 63}).empty());     // 0 的右边界是开区间
+    CHECK(Query(grid, {64, 0, 65, 64}) == Ids({2}));
+    CHECK(Query(grid, {63, 63, 64, 64}) == Ids({0, 2}));
+    CHECK(Query(grid, {64, 64, 65, 65}) == Ids({1, 2}));
+    CHECK(Query(grid, {127, 127, 128, 128}) == Ids({1}));
+    CHECK(Query(grid, {128, 128, 256, 256}).empty());
+    // 超出网格的部分压到边缘格子：远处的矩形仍能被远处的查询找到
+    grid.Append({-500, 300, -400, 400});  // 3
+    grid.Append({250, 250, 5000, 5000});  // 4
+    CHECK(Query(grid, {-450, 350, -440, 360}) == Ids({3}));
+    CHECK(Query(grid, {0, 200, 10, 256}).empty());
+    CHECK(Query(grid, {4000, 4000, 4001, 4001}) == Ids({4}));
+    CHECK(Query(grid, {255, 255, 256, 256}) == Ids({4}));
+}
+
+void TestEmptyAndDegenerate()
+{
+    UniformGrid grid;
+    grid.Reset(256, 256, 32);
+    grid.Append({});                  // 0：空矩形，只占编号
+    grid.Append({40, 40, 40, 90});    // 1：宽度为 0
+    grid.Append({90, 40, 50, 60});    // 2：左右颠倒
+    grid.Append({10, 10, 20, 20});    // 3
+    CHECK(grid.GetCount() == 4);
+    CHECK(Query(grid, {0, 0, 256, 256}) == Ids({3}));
+    // 空查询矩形不返回任何条目
+    CHECK(Query(grid, {15, 15, 15, 15}).empty());
+    CHECK(Query(grid, {20, 10, 10, 20}).empty());
+    // 截断掉空条目所在的编号也正常
+    grid.Truncate(1);
+    CHECK(grid.GetCount() == 1);
+    CHECK(Query(grid, {0, 0, 256, 256}).empty());
+
+    // 未 Reset 的网格与零尺寸网格
+    UniformGrid none;
+    none.Append({0, 0, 10, 10});
+    CHECK(Query(none, {0, 0, 10, 10}).empty());
+    UniformGrid zero;
+    zero.Reset(0, 0, 16);
+    zero.Append({0, 0, 10, 10});
+    CHECK(Query(zero, {0, 0, 10, 10}) == Ids({0}));
+}
+
+void TestTruncateThenQuery()
+{
+    UniformGrid grid;
+    grid.Reset(512, 512, 64);
+    for (int i = 0; i < 10; i++) {
+        grid.Append({i * 40, i * 40, i * 40 + 100, i * 40 + 100});
+    }
+    CHECK(Query(grid, {0, 0, 512, 512}).size() == 10);
+    grid.Truncate(4);
+    CHECK(grid.GetCount() == 4);
+    CHECK(Query(grid, {0, 0, 512, 512}) == Ids({0, 1, 2, 3}));
+    CHECK(Query(grid, {300, 300, 512, 512}).empty());
+    // 截断后追加的条目重新使用被删除的编号
+    grid.Append({300, 300, 310, 310});
+    CHECK(Query(grid, {300, 300, 512, 512}) == Ids({4}));
+    CHECK(Query(grid, {0, 0, 512, 512}) == Ids({0, 1, 2, 3, 4}));
+    // 截断到更大的数量不做任何事
+    grid.Truncate(100);
+    CHECK(grid.GetCount() == 5);
+    grid.Truncate(0);
+    CHECK(Query(grid, {0, 0, 512, 512}).empty());
+}
+
+// 随机追加 / 截断 / 查询，与暴力检查逐次比较；格子从 1 像素到大于整个网格
+void TestRandomAgainstBruteForce()
+{
+    std::mt19937 rng(24);
+    for (int cellSize : {1, 7, 64, 128, 5000}) {
+        UniformGrid grid;
+        grid.Reset(700, 500, cellSize);
+        std::vector<RasterIRect> rects;
+        auto randomRect = [&rng]() {
+            std::uniform_int_distribution<int> pos(-100, 800);
+            std::uniform_int_distribution<int> extent(-5, 300);
+            const int left = pos(rng);
+            const int top = pos(rng);
+            return RasterIRect{left, top, left + extent(rng), top + extent(rng)};
+        };
+        bool match = true;
+        for (int step = 0; step < 400; step++) {
+            const int op = static_cast<int>(rng() % 10);
+            if (op < 6) {
+                rects.push_back(randomRect());
+                grid.Append(rects.back());
+            } else if (op == 6) {
+                const size_t count = rects.empty() ? 0 : rng() % (rects.size() + 1);
+                rects.resize(count);
+                grid.Truncate(count);
+            } else {
+                const RasterIRect rect = randomRect();
+                const size_t begin = rects.empty() ? 0 : rng() % rects.size();
+                const size_t end = begin + rng() % (rects.size() + 2);
+                match = match && Query(grid, rect, begin, end) == BruteForce(rects, rect, begin, end);
+            }
+            match = match && grid.GetCount() == rects.size();
+        }
+        if (!match) {
+            std::fprintf(stderr, "cell size %d: grid query differs from brute force\n", cellSize);
+        }
+        CHECK(match);
+    }
+}
+} // namespace
+
+int main()
+{
+    TestSpanningManyCells();
+    TestCellBoundaries();
+    TestEmptyAndDegenerate();
+    TestTruncateThenQuery();
+    TestRandomAgainstBruteForce();
+    return TestResult("uniform_grid_test");
+}
@@ -0,0 +1,176 @@
+//
+// Created on 2026/10/17.
+// 作品格式基准：WorkCodec 与旧版 JSON 文本（JSON.stringify 等价输出 + 只认该格式的最小解析器）
+//
+// 输出字节数与编解码吞吐（百万点/秒），并验证二进制往返逐点一致、再编码字节相同。
+//
+
+#include <charconv>
+#include <cstdlib>
+#include <string>
+#include "samples/paper_cut_work_codec.h"
+#include "test_common.h"
+
+namespace {
+void AppendNumber(std::string* out, double value)
+{
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out->append(buffer, result.ptr);
+}
+
+std::string ToJson(const std::vector<Action>& actions)
+{
+    std::string out = "[";
+    for (size_t i = 0; i < actions.size(); i++) {
+        const Action& action = actions[i];
+        out += i ? ",{\"id\":\"" : "{\"id\":\"";
+        out += action.id + "\",\"type\":" + std::to_string(static_cast<int>(action.type)) +
+               ",\"tool\":" + std::to_string(static_cast<int>(action.tool)) + ",\"points\":[";
+        for (size_t j = 0; j < action.points.size(); j++) {
+            out += j ? ",{\"x\":" : "{\"x\":";
+            AppendNumber(&out, action.points[j].x);
+            out += ",\"y\":";
+            AppendNumber(&out, action.points[j].y);
+            out += '}';
+        }
+        out += "],\"timestamp\":" + std::to_string(action.timestamp) + "}";
+    }
+    return out + "]";
+}
+
+// 不做通用 JSON 校验，只作为文本格式解码耗时的下限
+std::vector<Action> FromJson(const std::string& json)
+{
+    std::vector<Action> out;
+    const char* p = json.c_str();
+    char* end = nullptr;
+    while ((p = std::strstr(p, "{\"id\":\"")) != nullptr) {
+        Action action;
+        p += 7;
+        const char* quote = std::strchr(p, '"');
+        action.id.assign(p, quote);
+        p = std::strstr(quote, "\"type\":") + 7;
+        action.type = static_cast<ActionType>(std::strtol(p, &end, 10));
+        p = std::strstr(end, "\"tool\":") + 7;
+        action.tool = static_cast<ToolMode>(std::strtol(p, &end, 10));
+        p = std::strstr(end, "\"points\":[") + 10;
+        while (*p == '{') {
+            const float x = std::strtof(p + 5, &end);
+            const float y = std::strtof(end + 5, &end);
+            action.points.emplace_back(x, y);
+            p = end + 1;
+            if (*p == ',') {
+                p++;
+            }
+        }
+        p = std::strstr(p, "\"timestamp\":") + 12;
+        action.timestamp = std::strtoll(p, &end, 10);
+        p = end;
+        out.push_back(std::move(action));
+    }
+    return out;
+}
+
+// 约 10px 间距的手绘路径，剪刀与铅笔混合
+std::vector<Action> MakeActions(size_t* pointCount)
+{
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<Action> actions;
+    *pointCount = 0;
+    const int64_t timestamp = 1760000000000;
+    for (int i = 0; i < 300; i++) {
+        float x = 1024.0f + unit(rng) * 900.0f;
+        float y = 1024.0f - unit(rng) * 900.0f;
+        float angle = unit(rng) * 6.28f;
+        std::vector<Point> points;
+        for (int j = 20 + static_cast<int>(unit(rng) * 120); j > 0; j--) {
+            angle += (unit(rng) - 0.5f) * 0.6f;
+            x += 10.5f * std::cos(angle);
+            y += 10.5f * std::sin(angle);
+            points.push_back(SnapToModelGrid(Point(x, y)));
+        }
+        *pointCount += points.size();
+        Action action = TestData::MakeAction(i % 5 == 0 ? ToolMode::DRAFT_PEN : ToolMode::SCISSORS, std::move(points));
+        action.timestamp = timestamp + i * 37;
+        action.id = std::to_string(action.timestamp);
+        actions.push_back(std::move(action));
+    }
+    return actions;
+}
+
+bool SamePoints(const std::vector<Action>& a, const std::vector<Action>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].tool != b[i].tool || a[i].type != b[i].type || a[i].points.size() != b[i].points.size()) {
+            return false;
+        }
+        for (size_t j = 0; j < a[i].points.size(); j++) {
+            if (a[i].points[j].x != b[i].points[j].x || a[i].points[j].y != b[i].points[j].y) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int rounds = argc > 1 ? std::atoi(argv[1]) : 200;
+    size_t pointCount = 0;
+    const std::vector<Action> actions = MakeActions(&pointCount);
+    WorkHeader header;
+    header.foldMode = FoldMode::SIX;
+    header.paperColor = 0xFFC62828;
+
+    std::vector<uint8_t> binary;
+    WorkHeader decodedHeader;
+    std::vector<Action> decoded;
+    std::vector<uint8_t> reencoded;
+    CHECK(WorkCodec::Encode(header, actions, &binary));
+    CHECK(WorkCodec::Decode(binary.data(), binary.size(), &decodedHeader, &decoded));
+    CHECK(SamePoints(actions, decoded));
+    CHECK(WorkCodec::Encode(decodedHeader, decoded, &reencoded) && reencoded == binary);
+    const std::string json = ToJson(actions);
+    CHECK(SamePoints(actions, FromJson(json)));
+    if (TestFailureCount() > 0) {
+        return TestResult("work_codec_bench");
+    }
+
+    auto throughput = [pointCount, rounds](double ms) { return pointCount * rounds / (ms * 1000.0); };
+    double start = NowMs();
+    for (int i = 0; i < rounds; i++) {
+        std::vector<uint8_t> out;
+        WorkCodec::Encode(header, actions, &out);
+    }
+    const double binaryEncode = NowMs() - start;
+    start = NowMs();
+    for (int i = 0; i < rounds; i++) {
+        std::vector<Action> out;
+        WorkCodec::Decode(binary.data(), binary.size(), &decodedHeader, &out);
+    }
+    const double binaryDecode = NowMs() - start;
+    start = NowMs();
+    for (int i = 0; i < rounds; i++) {
+        ToJson(actions);
+    }
+    const double jsonEncode = NowMs() - start;
+    start = NowMs();
+    for (int i = 0; i < rounds; i++) {
+        FromJson(json);
+    }
+    const double jsonDecode = NowMs() - start;
+
+    std::printf("%zu actions, %zu points, %d rounds\n", actions.size(), pointCount, rounds);
+    std::printf("binary: %8zu bytes (%5.2f B/pt)  encode %6.1f Mpt/s  decode %6.1f Mpt/s\n", binary.size(),
+                static_cast<double>(binary.size()) / pointCount, throughput(binaryEncode), throughput(binaryDecode));
+    std::printf("json:   %8zu bytes (%5.2f B/pt)  encode %6.1f Mpt/s  decode %6.1f Mpt/s\n", json.size(),
+                static_cast<double>(json.size()) / pointCount, throughput(jsonEncode), throughput(jsonDecode));
+    std::printf("binary is %.1fx smaller\n", static_cast<double>(json.size()) / binary.size());
+    return 0;
+}
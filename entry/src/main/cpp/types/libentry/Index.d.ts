@@ -14,3 +14,24 @@
  */
 
 export const add: (a: number, b: number) => number;
+
+// 作品库（每个作品一个文件 + 索引）
+export interface WorkMeta {
+  id?: string;
+  title?: string;
+  paperType?: string;
+  paperColor?: string;
+  date?: number;
+  foldMode?: number;
+  previewImage?: string;
+}
+
+export const libraryOpen: (dir: string) => boolean;
+export const libraryList: () => WorkMeta[];
+export const librarySave: (meta: WorkMeta, data: ArrayBuffer | Uint8Array) => boolean;
+export const libraryLoad: (id: string) => ArrayBuffer | undefined;
+export const libraryRemove: (id: string) => boolean;
+export const libraryImport: (meta: WorkMeta, actions: object[]) => boolean;
+export const librarySetPreviewImage: (id: string, previewImage: string) => boolean;
+// 工作线程渲染展开缩略图（PNG，按内容哈希缓存）并写入索引，返回 file:// 引用
+export const libraryRenderThumbnail: (id: string, size?: number) => Promise<string>;
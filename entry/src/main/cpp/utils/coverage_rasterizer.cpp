@@ -0,0 +1,210 @@
+//
+// Created on 2026/10/17.
+// 解析覆盖率光栅化实现
+//
+
+#include "coverage_rasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+inline uint8_t ToCoverage(float accumulated, RasterFillRule rule)
+{
+    float value = std::fabs(accumulated);
+    if (rule == RasterFillRule::EVEN_ODD) {
+        value = std::fmod(value, 2.0f);
+        if (value > 1.0f) {
+            value = 2.0f - value;
+        }
+    } else {
+        value = std::min(value, 1.0f);
+    }
+    return static_cast<uint8_t>(value * 255.0f + 0.5f);
+}
+} // namespace
+
+void CoverageRasterizer::Begin(int clipLeft, int clipTop, int clipRight, int clipBottom)
+{
+    cells_.clear();
+    clipLeft_ = clipLeft;
+    clipTop_ = clipTop;
+    clipBottom_ = std::max(clipTop, clipBottom);
+    width_ = std::max(0, clipRight - clipLeft);
+}
+
+void CoverageRasterizer::AddContour(const RasterPoint* points, size_t count)
+{
+    if (!points || count < 2 || width_ == 0) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const RasterPoint& a = points[i];
+        const RasterPoint& b = points[(i + 1) % count];
+        AddLine(a.x - clipLeft_, a.y, b.x - clipLeft_, b.y);
+    }
+}
+
+void CoverageRasterizer::AddContours(const std::vector<RasterPath::Contour>& contours)
+{
+    for (const auto& contour : contours) {
+        AddContour(contour.points.data(), contour.points.size());
+    }
+}
+
+void CoverageRasterizer::AddLine(float x0, float y0, float x1, float y1)
+{
+    if (y0 == y1 || !std::isfinite(x0) || !std::isfinite(y0) || !std::isfinite(x1) || !std::isfinite(y1)) {
+        return;
+    }
+    float dir = 1.0f;
+    if (y0 > y1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+        dir = -1.0f;
+    }
+    // 上下裁剪不改动端点，只在 AccumulateLine 中限制行范围：每行的 x 都由原始端点直接求出，
+    // 覆盖率与裁剪矩形无关，同一多边形按行条带分别光栅化的结果与整体光栅化逐字节一致
+    if (y1 <= static_cast<float>(clipTop_) || y0 >= static_cast<float>(clipBottom_)) {
+        return;
+    }
+    const float dxdy = (x1 - x0) / (y1 - y0);
+    // 在左右裁剪边界处切分：边界外的部分压到边界上成为竖直边，
+    // 左侧的面积由此计入边界列，右侧整体落在裁剪区外
+    const float right = static_cast<float>(width_);
+    float splits[2];
+    int splitCount = 0;
+    for (float bound : {0.0f, right}) {
+        if ((x0 - bound) * (x1 - bound) < 0.0f) {
+            splits[splitCount++] = y0 + (bound - x0) / dxdy;
+        }
+    }
+    if (splitCount == 2 && splits[0] > splits[1]) {
+        std::swap(splits[0], splits[1]);
+    }
+    float ya = y0;
+    float xa = x0;
+    for (int i = 0; i <= splitCount; i++) {
+        const float yb = (i < splitCount) ? std::min(std::max(splits[i], ya), y1) : y1;
+        const float xb = (i < splitCount) ? x0 + (yb - y0) * dxdy : x1;
+        if (yb > ya) {
+            AccumulateLine(std::min(std::max(xa, 0.0f), right), ya, std::min(std::max(xb, 0.0f), right), yb, dir);
+        }
+        ya = yb;
+        xa = xb;
+    }
+}
+
+void CoverageRasterizer::AccumulateLine(float x0, float y0, float x1, float y1, float dir)
+{
+    // y0 < y1，x 已限制在 [0, width_]。每行把线段右侧的有向面积分摊到它经过的格子，
+    // 增量之和为 dy * dir，前缀和到线段右侧即为该行的完整覆盖
+    const float dxdy = (x1 - x0) / (y1 - y0);
+    // 舍入误差不能把 x 带出端点范围，否则贴着裁剪边界的边会落到 -1 列或 width_ 列
+    const float xMin = std::min(x0, x1);
+    const float xMax = std::max(x0, x1);
+    auto xAt = [&](float y) { return std::min(std::max(x0 + (y - y0) * dxdy, xMin), xMax); };
+    // 先限制到裁剪范围再取整，远离画布的端点不会溢出 int
+    const int rowBegin = static_cast<int>(std::floor(std::max(y0, static_cast<float>(clipTop_))));
+    const int rowEnd = static_cast<int>(std::ceil(std::min(y1, static_cast<float>(clipBottom_))));
+    float x = xAt(std::max(static_cast<float>(rowBegin), y0));
+    for (int y = rowBegin; y < rowEnd; y++) {
+        const float yNext = std::min(static_cast<float>(y + 1), y1);
+        const float dy = yNext - std::max(static_cast<float>(y), y0);
+        const float xNext = xAt(yNext);
+        const float d = dy * dir;
+        const float xa = std::min(x, xNext);
+        const float xb = std::max(x, xNext);
+        const float xaFloor = std::floor(xa);
+        const int xai = static_cast<int>(xaFloor);
+        const float xbCeil = std::ceil(xb);
+        const int xbi = static_cast<int>(xbCeil);
+        if (xbi <= xai + 1) {
+            // 线段在本行只经过一个像素列：按中点把面积分给该列与右侧一列
+            const float xm = 0.5f * (x + xNext) - xaFloor;
+            AddCell(y, xai, d - d * xm);
+            AddCell(y, xai + 1, d * xm);
+        } else {
+            // 跨多列：两端是三角形面积，中间每列增加相同的面积斜率
+            const float s = 1.0f / (xb - xa);
+            const float xaFrac = xa - xaFloor;
+            const float a0 = 0.5f * s * (1.0f - xaFrac) * (1.0f - xaFrac);
+            const float xbFrac = xb - xbCeil + 1.0f;
+            const float am = 0.5f * s * xbFrac * xbFrac;
+            AddCell(y, xai, d * a0);
+            if (xbi == xai + 2) {
+                AddCell(y, xai + 1, d * (1.0f - a0 - am));
+            } else {
+                const float a1 = s * (1.5f - xaFrac);
+                AddCell(y, xai + 1, d * (a1 - a0));
+                for (int xi = xai + 2; xi < xbi - 1; xi++) {
+                    AddCell(y, xi, d * s);
+                }
+                const float a2 = a1 + (xbi - xai - 3) * s;
+                AddCell(y, xbi - 1, d * (1.0f - a2 - am));
+            }
+            AddCell(y, xbi, d * am);
+        }
+        x = xNext;
+    }
+}
+
+void CoverageRasterizer::Fill(RasterFillRule rule, const SpanSink& sink)
+{
+    if (cells_.empty()) {
+        return;
+    }
+    // 按行计数排序（行数固定为裁剪高度），行内再按 x 排序
+    const int rows = clipBottom_ - clipTop_;
+    rowStart_.assign(static_cast<size_t>(rows) + 1, 0);
+    for (const Cell& cell : cells_) {
+        rowStart_[cell.y - clipTop_ + 1]++;
+    }
+    for (int r = 0; r < rows; r++) {
+        rowStart_[r + 1] += rowStart_[r];
+    }
+    sorted_.resize(cells_.size());
+    for (const Cell& cell : cells_) {
+        sorted_[rowStart_[cell.y - clipTop_]++] = cell;
+    }
+    // 分桶后 rowStart_[r] 指向第 r 行的末尾，即第 r + 1 行的开头
+    if (coverage_.size() < static_cast<size_t>(width_)) {
+        coverage_.resize(width_);
+    }
+
+    uint32_t begin = 0;
+    for (int r = 0; r < rows; r++) {
+        const uint32_t end = rowStart_[r];
+        if (begin == end) {
+            continue;
+        }
+        Cell* rowCells = sorted_.data() + begin;
+        const uint32_t count = end - begin;
+        std::sort(rowCells, rowCells + count, [](const Cell& lhs, const Cell& rhs) { return lhs.x < rhs.x; });
+        const int x0 = rowCells[0].x;
+        int x1 = std::min(width_, rowCells[count - 1].x + 1);
+        uint8_t* out = coverage_.data();
+        float accumulated = 0.0f;
+        int x = x0;
+        for (uint32_t i = 0; i < count;) {
+            const int cx = rowCells[i].x;
+            if (cx > x) {
+                // 两个格子之间覆盖率不变
+                std::memset(out + (x - x0), ToCoverage(accumulated, rule), cx - x);
+            }
+            for (; i < count && rowCells[i].x == cx; i++) {
+                accumulated += rowCells[i].delta;
+            }
+            out[cx - x0] = ToCoverage(accumulated, rule);
+            x = cx + 1;
+        }
+        // 多边形越过右裁剪边界时，右侧的边不产生格子，剩余覆盖一直延续到边界
+        const uint8_t tail = ToCoverage(accumulated, rule);
+        if (tail != 0 && x < width_) {
+            std::memset(out + (x - x0), tail, width_ - x);
+            x1 = width_;
+        }
+        sink(clipTop_ + r, clipLeft_ + x0, clipLeft_ + x1, coverage_.data());
+        begin = end;
+    }
+}
@@ -0,0 +1,66 @@
+//
+// Created on 2026/10/17.
+// 解析覆盖率光栅化：按有向面积累积（signed-area accumulation）计算每个像素被多边形覆盖的精确面积
+//
+// 每条线段在它经过的像素格（cell）里累加有向面积增量，只记录被边经过的格子（稀疏扫描线）；
+// 逐行按 x 排序后做前缀和即为覆盖率，两个格子之间的覆盖率恒定，整段直接填充。
+// 与 ScanlineFiller 接口一致，抗锯齿边缘是精确面积而不是子采样近似。
+//
+
+#ifndef PAPERCUTTING_COVERAGE_RASTERIZER_H
+#define PAPERCUTTING_COVERAGE_RASTERIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "raster_backend.h"
+
+class CoverageRasterizer {
+public:
+    // coverage[i] 为像素 (x0 + i, y) 的覆盖率 0..255，只在回调期间有效
+    using SpanSink = std::function<void(int y, int x0, int x1, const uint8_t* coverage)>;
+
+    // 开始一个新多边形：清空格子并设置裁剪矩形（设备像素，右/下为开区间）
+    void Begin(int clipLeft, int clipTop, int clipRight, int clipBottom);
+    // 追加轮廓（设备坐标，总是隐式闭合），线段立即累积到格子中
+    void AddContour(const RasterPoint* points, size_t count);
+    void AddContours(const std::vector<RasterPath::Contour>& contours);
+    // 逐行输出覆盖率（只输出有边经过的行）。非零规则取 min(|w|, 1)，奇偶规则按 |w| 折返
+    void Fill(RasterFillRule rule, const SpanSink& sink);
+
+    size_t GetCellCount() const { return cells_.size(); }
+
+private:
+    struct Cell {
+        int y;
+        int x;  // 相对 clipLeft
+        float delta;
+    };
+
+    void AddLine(float x0, float y0, float x1, float y1);
+    void AccumulateLine(float x0, float y0, float x1, float y1, float dir);
+    void AddCell(int y, int x, float delta)
+    {
+        if (x >= width_ || delta == 0.0f) {
+            return;
+        }
+        // 折线上相邻的短线段经常落在同一格子，直接合并
+        if (!cells_.empty() && cells_.back().y == y && cells_.back().x == x) {
+            cells_.back().delta += delta;
+            return;
+        }
+        cells_.push_back({y, x, delta});
+    }
+
+    std::vector<Cell> cells_;
+    std::vector<Cell> sorted_;      // 按行分桶后的格子
+    std::vector<uint32_t> rowStart_;
+    std::vector<uint8_t> coverage_;
+    int clipLeft_ = 0;
+    int clipTop_ = 0;
+    int clipBottom_ = 0;
+    int width_ = 0;
+};
+
+#endif // PAPERCUTTING_COVERAGE_RASTERIZER_H
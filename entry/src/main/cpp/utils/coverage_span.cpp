@@ -0,0 +1,238 @@
+//
+// Created on 2026/10/17.
+// 8 位覆盖率跨度运算实现
+//
+// 实现按编译目标在编译期选择：设备（arm64）总是有 NEON；x86 默认 SSE2，
+// 以 -mavx2 编译时混合运算改用 AVX2。尾部不足一个向量的像素走标量路径。
+//
+
+#include "coverage_span.h"
+#include <algorithm>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define COVERAGE_SPAN_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define COVERAGE_SPAN_SSE2 1
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define COVERAGE_SPAN_AVX2 1
+#endif
+#endif
+
+namespace {
+// x / 255 四舍五入，对 0..255*255 精确
+inline uint32_t Div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+#if defined(COVERAGE_SPAN_NEON)
+inline uint8x8_t Div255Narrow(uint16x8_t x)
+{
+    // (x + ((x + 128) >> 8) + 128) >> 8
+    return vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8);
+}
+
+inline uint8x16_t MulDiv255(uint8x16_t a, uint8x16_t b)
+{
+    const uint8x8_t lo = Div255Narrow(vmull_u8(vget_low_u8(a), vget_low_u8(b)));
+    const uint8x8_t hi = Div255Narrow(vmull_u8(vget_high_u8(a), vget_high_u8(b)));
+    return vcombine_u8(lo, hi);
+}
+#endif
+
+#if defined(COVERAGE_SPAN_SSE2)
+inline __m128i Div255Epi16(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+inline __m128i MulDiv255(__m128i a, __m128i b)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i lo = Div255Epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)));
+    const __m128i hi = Div255Epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)));
+    return _mm_packus_epi16(lo, hi);
+}
+
+// 4 个 int32 的块内前缀和，再加上前一块的进位
+inline __m128i PrefixSum4(__m128i x, __m128i carry)
+{
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+    return _mm_add_epi32(x, carry);
+}
+#endif
+
+#if defined(COVERAGE_SPAN_AVX2)
+inline __m256i Div255Epi16(__m256i x)
+{
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+// 32 个字节相乘；packus 按 128 位 lane 交错，permute 恢复顺序
+inline __m256i MulDiv255(__m256i a, __m256i b)
+{
+    const __m256i lo = Div255Epi16(_mm256_mullo_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(a)),
+                                                      _mm256_cvtepu8_epi16(_mm256_castsi256_si128(b))));
+    const __m256i hi = Div255Epi16(_mm256_mullo_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(a, 1)),
+                                                      _mm256_cvtepu8_epi16(_mm256_extracti128_si256(b, 1))));
+    return _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+}
+#endif
+} // namespace
+
+namespace CoverageSpan {
+const char* GetIsaName()
+{
+#if defined(COVERAGE_SPAN_NEON)
+    return "neon";
+#elif defined(COVERAGE_SPAN_AVX2)
+    return "avx2";
+#elif defined(COVERAGE_SPAN_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void AccumulateDeltas(int32_t* delta, uint8_t* out, size_t count)
+{
+    size_t i = 0;
+    int32_t running = 0;
+#if defined(COVERAGE_SPAN_NEON)
+    const int32x4_t zero = vdupq_n_s32(0);
+    int32x4_t carry = zero;
+    for (; i + 16 <= count; i += 16) {
+        int32x4_t sums[4];
+        for (int k = 0; k < 4; k++) {
+            int32x4_t x = vld1q_s32(delta + i + k * 4);
+            x = vaddq_s32(x, vextq_s32(zero, x, 3));
+            x = vaddq_s32(x, vextq_s32(zero, x, 2));
+            x = vaddq_s32(x, carry);
+            carry = vdupq_n_s32(vgetq_lane_s32(x, 3));
+            sums[k] = x;
+            vst1q_s32(delta + i + k * 4, zero);
+        }
+        const int16x8_t lo = vcombine_s16(vqmovn_s32(sums[0]), vqmovn_s32(sums[1]));
+        const int16x8_t hi = vcombine_s16(vqmovn_s32(sums[2]), vqmovn_s32(sums[3]));
+        vst1q_u8(out + i, vcombine_u8(vqmovun_s16(lo), vqmovun_s16(hi)));
+    }
+    running = vgetq_lane_s32(carry, 0);
+#elif defined(COVERAGE_SPAN_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i carry = zero;
+    for (; i + 16 <= count; i += 16) {
+        __m128i sums[4];
+        for (int k = 0; k < 4; k++) {
+            __m128i* p = reinterpret_cast<__m128i*>(delta + i + k * 4);
+            sums[k] = PrefixSum4(_mm_loadu_si128(p), carry);
+            carry = _mm_shuffle_epi32(sums[k], 0xFF);
+            _mm_storeu_si128(p, zero);
+        }
+        // packs 饱和到 int16，packus 再饱和到 0..255
+        const __m128i lo = _mm_packs_epi32(sums[0], sums[1]);
+        const __m128i hi = _mm_packs_epi32(sums[2], sums[3]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+    }
+    running = _mm_cvtsi128_si32(carry);
+#endif
+    for (; i < count; i++) {
+        running += delta[i];
+        delta[i] = 0;
+        out[i] = static_cast<uint8_t>(std::min(255, std::max(0, running)));
+    }
+}
+
+void MultiplyA8(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t count)
+{
+    size_t i = 0;
+#if defined(COVERAGE_SPAN_NEON)
+    for (; i + 16 <= count; i += 16) {
+        vst1q_u8(dst + i, MulDiv255(vld1q_u8(a + i), vld1q_u8(b + i)));
+    }
+#elif defined(COVERAGE_SPAN_AVX2)
+    for (; i + 32 <= count; i += 32) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), MulDiv255(va, vb));
+    }
+#elif defined(COVERAGE_SPAN_SSE2)
+    for (; i + 16 <= count; i += 16) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), MulDiv255(va, vb));
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = static_cast<uint8_t>(Div255(a[i] * b[i]));
+    }
+}
+
+void ClearA8(uint8_t* dst, const uint8_t* coverage, size_t count)
+{
+    size_t i = 0;
+#if defined(COVERAGE_SPAN_NEON)
+    for (; i + 16 <= count; i += 16) {
+        vst1q_u8(dst + i, MulDiv255(vld1q_u8(dst + i), vmvnq_u8(vld1q_u8(coverage + i))));
+    }
+#elif defined(COVERAGE_SPAN_AVX2)
+    const __m256i ones = _mm256_set1_epi8(static_cast<char>(0xFF));
+    for (; i + 32 <= count; i += 32) {
+        __m256i* d = reinterpret_cast<__m256i*>(dst + i);
+        const __m256i inv =
+            _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(coverage + i)), ones);
+        _mm256_storeu_si256(d, MulDiv255(_mm256_loadu_si256(d), inv));
+    }
+#elif defined(COVERAGE_SPAN_SSE2)
+    const __m128i ones = _mm_set1_epi8(static_cast<char>(0xFF));
+    for (; i + 16 <= count; i += 16) {
+        __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+        const __m128i inv = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(coverage + i)), ones);
+        _mm_storeu_si128(d, MulDiv255(_mm_loadu_si128(d), inv));
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = static_cast<uint8_t>(Div255(dst[i] * (255u - coverage[i])));
+    }
+}
+
+void SrcOverA8(uint8_t* dst, const uint8_t* coverage, uint8_t alpha, size_t count)
+{
+    size_t i = 0;
+#if defined(COVERAGE_SPAN_NEON)
+    const uint8x16_t va = vdupq_n_u8(alpha);
+    for (; i + 16 <= count; i += 16) {
+        const uint8x16_t s = MulDiv255(vld1q_u8(coverage + i), va);
+        vst1q_u8(dst + i, vqaddq_u8(s, MulDiv255(vld1q_u8(dst + i), vmvnq_u8(s))));
+    }
+#elif defined(COVERAGE_SPAN_AVX2)
+    const __m256i va = _mm256_set1_epi8(static_cast<char>(alpha));
+    const __m256i ones = _mm256_set1_epi8(static_cast<char>(0xFF));
+    for (; i + 32 <= count; i += 32) {
+        __m256i* d = reinterpret_cast<__m256i*>(dst + i);
+        const __m256i s = MulDiv255(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(coverage + i)), va);
+        const __m256i keep = MulDiv255(_mm256_loadu_si256(d), _mm256_xor_si256(s, ones));
+        _mm256_storeu_si256(d, _mm256_adds_epu8(s, keep));
+    }
+#elif defined(COVERAGE_SPAN_SSE2)
+    const __m128i va = _mm_set1_epi8(static_cast<char>(alpha));
+    const __m128i ones = _mm_set1_epi8(static_cast<char>(0xFF));
+    for (; i + 16 <= count; i += 16) {
+        __m128i* d = reinterpret_cast<__m128i*>(dst + i);
+        const __m128i s = MulDiv255(_mm_loadu_si128(reinterpret_cast<const __m128i*>(coverage + i)), va);
+        const __m128i keep = MulDiv255(_mm_loadu_si128(d), _mm_xor_si128(s, ones));
+        _mm_storeu_si128(d, _mm_adds_epu8(s, keep));
+    }
+#endif
+    for (; i < count; i++) {
+        const uint32_t s = Div255(coverage[i] * static_cast<uint32_t>(alpha));
+        dst[i] = static_cast<uint8_t>(std::min(255u, s + Div255(dst[i] * (255u - s))));
+    }
+}
+} // namespace CoverageSpan
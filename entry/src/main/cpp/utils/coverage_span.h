@@ -0,0 +1,31 @@
+//
+// Created on 2026/10/17.
+// 8 位覆盖率跨度运算：扫描线累积与 A8 混合（NEON / SSE2 / AVX2 向量化，其他平台为标量实现）
+//
+// 所有乘法都按 x * y / 255 精确取整（div255），各实现结果逐字节一致。
+//
+
+#ifndef PAPERCUTTING_COVERAGE_SPAN_H
+#define PAPERCUTTING_COVERAGE_SPAN_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CoverageSpan {
+// 当前编译使用的实现名称（"neon" / "avx2" / "sse2" / "scalar"），用于日志与基准
+const char* GetIsaName();
+
+// 对差分数组做前缀和并饱和到 0..255 写入 out，同时把 delta[0, count) 清零以便下一行复用
+void AccumulateDeltas(int32_t* delta, uint8_t* out, size_t count);
+
+// dst[i] = a[i] * b[i] / 255（裁剪 mask 与覆盖率相乘）；dst 可以与 a 相同
+void MultiplyA8(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t count);
+
+// destination-out：dst[i] = dst[i] * (255 - coverage[i]) / 255
+void ClearA8(uint8_t* dst, const uint8_t* coverage, size_t count);
+
+// source-over：s = coverage[i] * alpha / 255，dst[i] = s + dst[i] * (255 - s) / 255
+void SrcOverA8(uint8_t* dst, const uint8_t* coverage, uint8_t alpha, size_t count);
+} // namespace CoverageSpan
+
+#endif // PAPERCUTTING_COVERAGE_SPAN_H
@@ -0,0 +1,120 @@
+//
+// Created on 2026/10/17.
+// 保留模式显示列表实现
+//
+
+#include "display_list.h"
+#include <algorithm>
+#include "coverage_span.h"
+
+namespace {
+// Fill 回调只捕获一个引用，std::function 不需要为它分配内存
+struct SpanWriter {
+    const DisplayList::MaskSet& masks;
+    const RasterIRect& region;
+    RasterBlend blend;
+
+    void Write(int y, int x0, int x1, const uint8_t* coverage) const
+    {
+        // 光栅化左右不裁剪（整行宽度），列范围在写入时限制：覆盖率与 region 无关，
+        // 脏矩形重建与整张重放逐字节一致
+        const int left = std::max(x0, region.left);
+        const int right = std::min(x1, region.right);
+        if (left >= right) {
+            return;
+        }
+        coverage += left - x0;
+        const size_t offset = static_cast<size_t>(y) * masks.width + left;
+        for (size_t i = 0; i < masks.count; i++) {
+            if (blend == RasterBlend::CLEAR) {
+                CoverageSpan::ClearA8(masks.pixels[i] + offset, coverage, right - left);
+            } else {
+                CoverageSpan::SrcOverA8(masks.pixels[i] + offset, coverage, 0xFF, right - left);
+            }
+        }
+    }
+};
+} // namespace
+
+void DisplayList::Reset(RasterBlend blend, RasterFillRule rule)
+{
+    points_.clear();
+    contours_.clear();
+    path_.Reset();
+    blend_ = blend;
+    rule_ = rule;
+}
+
+void DisplayList::Reserve(size_t pointCount, size_t contourCount)
+{
+    points_.reserve(pointCount);
+    contours_.reserve(contourCount);
+}
+
+void DisplayList::AddContour(const RasterPoint* points, size_t count)
+{
+    if (!points || count < 2) {
+        return;
+    }
+    contours_.push_back({static_cast<uint32_t>(points_.size()), static_cast<uint32_t>(count)});
+    points_.insert(points_.end(), points, points + count);
+}
+
+RasterPoint* DisplayList::AddContour(size_t count)
+{
+    if (count < 2) {
+        return nullptr;
+    }
+    const size_t first = points_.size();
+    contours_.push_back({static_cast<uint32_t>(first), static_cast<uint32_t>(count)});
+    points_.resize(first + count);
+    return points_.data() + first;
+}
+
+void DisplayList::Shrink()
+{
+    points_.shrink_to_fit();
+    contours_.shrink_to_fit();
+}
+
+void DisplayList::Rasterize(const RasterMatrix& matrix, const RasterIRect& region, const MaskSet& masks,
+                            CoverageRasterizer* rasterizer, std::vector<RasterPoint>* scratch) const
+{
+    if (contours_.empty() || masks.count == 0 || region.IsEmpty()) {
+        return;
+    }
+    if (scratch->size() < points_.size()) {
+        scratch->resize(points_.size());
+    }
+    RasterPoint* mapped = scratch->data();
+    for (size_t i = 0; i < points_.size(); i++) {
+        mapped[i] = matrix.Map(points_[i].x, points_[i].y);
+    }
+    rasterizer->Begin(0, std::max(0, region.top), masks.width, std::min(masks.height, region.bottom));
+    for (const Contour& contour : contours_) {
+        rasterizer->AddContour(mapped + contour.first, contour.count);
+    }
+    const SpanWriter writer = {masks, region, blend_};
+    rasterizer->Fill(rule_, [&writer](int y, int x0, int x1, const uint8_t* coverage) {
+        writer.Write(y, x0, x1, coverage);
+    });
+}
+
+void DisplayList::Draw(RasterCanvas* canvas)
+{
+    if (!canvas || contours_.empty()) {
+        return;
+    }
+    if (path_.IsEmpty()) {
+        for (const Contour& contour : contours_) {
+            path_.AddPolyline(points_.data() + contour.first, contour.count, true);
+        }
+        path_.SetFillRule(rule_);
+    }
+    // A8 图层只取覆盖率，颜色无关
+    RasterPaint paint;
+    paint.color = 0xFFFFFFFF;
+    paint.antiAlias = true;
+    paint.blend = blend_;
+    canvas->DrawPath(path_, paint);
+}
@@ -0,0 +1,64 @@
+//
+// Created on 2026/10/17.
+// 保留模式显示列表：命令编译一次得到的已展平几何（模型坐标的闭合轮廓）+ 绘制状态，与后端无关
+//
+// 重放时顶点做一次仿射变换写入调用方的暂存区，直接送入覆盖率光栅化并按混合方式写入 A8 mask，
+// 不再构建路径；暂存区与光栅器由调用方跨命令复用，长历史重放不会按点或按命令分配内存。
+// 没有可直接访问像素的 A8 mask 时（画布回退），使用同样只构建一次的 RasterPath。
+//
+
+#ifndef PAPERCUTTING_DISPLAY_LIST_H
+#define PAPERCUTTING_DISPLAY_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "coverage_rasterizer.h"
+#include "raster_backend.h"
+
+class DisplayList {
+public:
+    // points 中的一段 [first, first + count)，总是闭合
+    struct Contour {
+        uint32_t first;
+        uint32_t count;
+    };
+    // 一组同尺寸、行紧密排列的 A8 mask
+    struct MaskSet {
+        uint8_t* const* pixels;
+        size_t count;
+        int width;
+        int height;
+    };
+
+    // 清空并设置绘制状态：SRC_OVER 按覆盖率叠加，CLEAR 按覆盖率清除（destination-out）
+    void Reset(RasterBlend blend, RasterFillRule rule);
+    // 预留总顶点数/轮廓数，编译时一次分配到位
+    void Reserve(size_t pointCount, size_t contourCount);
+    void AddContour(const RasterPoint* points, size_t count);
+    // 追加 count 个顶点的轮廓，返回待调用方写入的顶点；count < 2 时不追加，返回 nullptr
+    RasterPoint* AddContour(size_t count);
+    // 释放多余容量（编译完成后调用，列表在命令生命周期内常驻）
+    void Shrink();
+
+    bool IsEmpty() const { return contours_.empty(); }
+    RasterBlend GetBlend() const { return blend_; }
+    const std::vector<RasterPoint>& GetPoints() const { return points_; }
+    const std::vector<Contour>& GetContours() const { return contours_; }
+
+    // 按 matrix（模型 -> mask 像素）变换后光栅化，只写 region 内的像素。可在多个线程上以不同 region 并发调用，
+    // rasterizer / scratch 为调用线程私有，容量只增不减
+    void Rasterize(const RasterMatrix& matrix, const RasterIRect& region, const MaskSet& masks,
+                   CoverageRasterizer* rasterizer, std::vector<RasterPoint>* scratch) const;
+    // 画布回退：当前变换下用抗锯齿填充绘制（路径在首次调用时构建）
+    void Draw(RasterCanvas* canvas);
+
+private:
+    std::vector<RasterPoint> points_;
+    std::vector<Contour> contours_;
+    RasterBlend blend_ = RasterBlend::SRC_OVER;
+    RasterFillRule rule_ = RasterFillRule::NON_ZERO;
+    RasterPath path_;
+};
+
+#endif // PAPERCUTTING_DISPLAY_LIST_H
@@ -0,0 +1,68 @@
+//
+// Created on 2026/10/17.
+// 基于 OH_DisplaySoloist 的 vsync 来源实现
+//
+
+#include "display_soloist_vsync.h"
+#include <hilog/log.h>
+#include <utility>
+
+#define LOGE(...) ((void)OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, "DisplaySoloistVsync", __VA_ARGS__))
+
+namespace {
+// 跟随屏幕刷新率，剪纸编辑不需要高于 120Hz
+constexpr int32_t MIN_FRAME_RATE = 30;
+constexpr int32_t MAX_FRAME_RATE = 120;
+constexpr int32_t EXPECTED_FRAME_RATE = 120;
+}
+
+DisplaySoloistVsyncSource::~DisplaySoloistVsyncSource()
+{
+    Stop();
+}
+
+bool DisplaySoloistVsyncSource::Start(Callback onVsync)
+{
+    if (soloist_) {
+        LOGE("DisplaySoloist already started");
+        return false;
+    }
+    // 独占线程：vsync 回调不占用 UI/JS 线程
+    soloist_ = OH_DisplaySoloist_Create(true);
+    if (!soloist_) {
+        LOGE("Failed to create DisplaySoloist");
+        return false;
+    }
+    callback_ = std::move(onVsync);
+
+    DisplaySoloist_ExpectedRateRange range{MIN_FRAME_RATE, MAX_FRAME_RATE, EXPECTED_FRAME_RATE};
+    OH_DisplaySoloist_SetExpectedFrameRateRange(soloist_, &range);
+    int32_t ret = OH_DisplaySoloist_Start(soloist_, OnFrame, this);
+    if (ret != 0) {
+        LOGE("Failed to start DisplaySoloist, ret=%{public}d", ret);
+        OH_DisplaySoloist_Destroy(soloist_);
+        soloist_ = nullptr;
+        callback_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void DisplaySoloistVsyncSource::Stop()
+{
+    if (!soloist_) {
+        return;
+    }
+    OH_DisplaySoloist_Stop(soloist_);
+    OH_DisplaySoloist_Destroy(soloist_);
+    soloist_ = nullptr;
+    callback_ = nullptr;
+}
+
+void DisplaySoloistVsyncSource::OnFrame(long long timestamp, long long targetTimestamp, void* data)
+{
+    auto* self = static_cast<DisplaySoloistVsyncSource*>(data);
+    if (self && self->callback_) {
+        self->callback_(static_cast<int64_t>(timestamp), static_cast<int64_t>(targetTimestamp));
+    }
+}
@@ -0,0 +1,27 @@
+//
+// Created on 2026/10/17.
+// 基于 OH_DisplaySoloist 的 vsync 来源
+//
+
+#ifndef PAPERCUTTING_DISPLAY_SOLOIST_VSYNC_H
+#define PAPERCUTTING_DISPLAY_SOLOIST_VSYNC_H
+
+#include <native_display_soloist/native_display_soloist.h>
+#include "frame_scheduler.h"
+
+class DisplaySoloistVsyncSource : public VsyncSource {
+public:
+    DisplaySoloistVsyncSource() = default;
+    ~DisplaySoloistVsyncSource() override;
+
+    bool Start(Callback onVsync) override;
+    void Stop() override;
+
+private:
+    static void OnFrame(long long timestamp, long long targetTimestamp, void* data);
+
+    OH_DisplaySoloist* soloist_ = nullptr;
+    Callback callback_;
+};
+
+#endif // PAPERCUTTING_DISPLAY_SOLOIST_VSYNC_H
@@ -0,0 +1,172 @@
+//
+// Created on 2026/10/17.
+// 帧调度器实现
+//
+
+#include "frame_scheduler.h"
+#include <chrono>
+#include <utility>
+
+namespace {
+// 迟到超过这个时间说明时间戳与本地时钟不是同一来源，不据此跳帧
+constexpr int64_t MAX_LATENESS_NS = 1000000000;
+}
+
+bool ManualVsyncSource::Start(Callback onVsync)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    callback_ = std::move(onVsync);
+    return true;
+}
+
+void ManualVsyncSource::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    callback_ = nullptr;
+}
+
+void ManualVsyncSource::Tick(int64_t timestampNs, int64_t targetTimestampNs)
+{
+    Callback callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callback = callback_;
+    }
+    if (callback) {
+        callback(timestampNs, targetTimestampNs);
+    }
+}
+
+FrameScheduler::FrameScheduler(std::unique_ptr<VsyncSource> source, PresentCallback present)
+    : source_(std::move(source)), present_(std::move(present))
+{
+}
+
+FrameScheduler::~FrameScheduler()
+{
+    Stop();
+}
+
+bool FrameScheduler::Start()
+{
+    if (!source_ || !present_) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            return true;
+        }
+        running_ = true;
+        stopRequested_ = false;
+        vsyncPending_ = false;
+        lastSkipped_ = false;
+    }
+    thread_ = std::thread(&FrameScheduler::ThreadMain, this);
+    if (!source_->Start(
+            [this](int64_t timestampNs, int64_t targetTimestampNs) { OnVsync(timestampNs, targetTimestampNs); })) {
+        Stop();
+        return false;
+    }
+    return true;
+}
+
+void FrameScheduler::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        stopRequested_ = true;
+    }
+    // 先停 vsync，保证回调不会在 join 之后再访问 this
+    if (source_) {
+        source_->Stop();
+    }
+    cond_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = false;
+}
+
+bool FrameScheduler::IsRunning() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_ && !stopRequested_;
+}
+
+void FrameScheduler::RequestFrame(uint32_t surfaces)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    dirtySurfaces_ |= surfaces;
+}
+
+uint64_t FrameScheduler::GetPresentedFrameCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return presentedFrames_;
+}
+
+uint64_t FrameScheduler::GetSkippedFrameCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return skippedFrames_;
+}
+
+void FrameScheduler::OnVsync(int64_t timestampNs, int64_t targetTimestampNs)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 没有脏表面时 vsync 直接丢弃，渲染线程保持休眠
+        if (dirtySurfaces_ == FRAME_SURFACE_NONE) {
+            return;
+        }
+        vsyncPending_ = true;
+        vsyncTimestamp_ = timestampNs;
+        vsyncTarget_ = targetTimestampNs;
+    }
+    cond_.notify_one();
+}
+
+bool FrameScheduler::IsStale(int64_t targetTimestampNs) const
+{
+    if (targetTimestampNs <= 0) {
+        return false;
+    }
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    const int64_t lateness = now - targetTimestampNs;
+    return lateness > 0 && lateness < MAX_LATENESS_NS;
+}
+
+void FrameScheduler::ThreadMain()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cond_.wait(lock, [this] { return stopRequested_ || (vsyncPending_ && dirtySurfaces_ != FRAME_SURFACE_NONE); });
+        if (stopRequested_) {
+            break;
+        }
+        // 赶不上预期上屏时间的 vsync：脏标记留给下一个 vsync
+        if (!lastSkipped_ && IsStale(vsyncTarget_)) {
+            vsyncPending_ = false;
+            lastSkipped_ = true;
+            skippedFrames_++;
+            continue;
+        }
+        lastSkipped_ = false;
+        // 一次取走全部脏标记：上屏期间的新请求会留到下一个 vsync
+        const uint32_t surfaces = dirtySurfaces_;
+        const int64_t timestampNs = vsyncTimestamp_;
+        dirtySurfaces_ = FRAME_SURFACE_NONE;
+        vsyncPending_ = false;
+
+        lock.unlock();
+        present_(surfaces, timestampNs);
+        lock.lock();
+        presentedFrames_++;
+    }
+}
@@ -0,0 +1,93 @@
+//
+// Created on 2026/10/17.
+// 帧调度器：独立渲染线程 + vsync 驱动，合并多次重绘请求
+//
+// 纯 C++ 实现（只依赖标准库），vsync 来源可替换，便于在 Linux 上用假时钟驱动测试。
+//
+
+#ifndef PAPERCUTTING_FRAME_SCHEDULER_H
+#define PAPERCUTTING_FRAME_SCHEDULER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// 需要重绘的上屏表面（位掩码）
+enum FrameSurface : uint32_t {
+    FRAME_SURFACE_NONE = 0,
+    FRAME_SURFACE_EDITOR = 1u << 0,
+    FRAME_SURFACE_PREVIEW = 1u << 1,
+    FRAME_SURFACE_ALL = FRAME_SURFACE_EDITOR | FRAME_SURFACE_PREVIEW
+};
+
+// vsync 来源接口：Start 之后在任意线程周期性调用 onVsync(时间戳 ns, 本帧预期上屏时间 ns)，Stop 返回后不再回调。
+// 两个时间戳与 std::chrono::steady_clock 同为 CLOCK_MONOTONIC；预期上屏时间未知时为 0
+class VsyncSource {
+public:
+    using Callback = std::function<void(int64_t timestampNs, int64_t targetTimestampNs)>;
+    virtual ~VsyncSource() = default;
+    virtual bool Start(Callback onVsync) = 0;
+    virtual void Stop() = 0;
+};
+
+// 手动驱动的 vsync 来源：由调用方 Tick()，用于测试或没有显示同步能力的宿主
+class ManualVsyncSource : public VsyncSource {
+public:
+    bool Start(Callback onVsync) override;
+    void Stop() override;
+    void Tick(int64_t timestampNs, int64_t targetTimestampNs = 0);
+
+private:
+    std::mutex mutex_;
+    Callback callback_;
+};
+
+// 渲染请求只累积脏标记；每个 vsync 渲染线程最多为每个表面上屏一次。
+// present 回调在渲染线程上执行，参数为本帧需要上屏的表面集合。
+// 渲染线程取到 vsync 时若已过了它的预期上屏时间（上一帧渲染超时），这一帧赶不上，
+// 跳过它、保留脏标记等下一个 vsync，避免在两次 vsync 之间上屏造成排队延迟；不连续跳过，保证持续超时时仍有帧输出。
+class FrameScheduler {
+public:
+    using PresentCallback = std::function<void(uint32_t surfaces, int64_t timestampNs)>;
+
+    FrameScheduler(std::unique_ptr<VsyncSource> source, PresentCallback present);
+    ~FrameScheduler();
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    bool Start();
+    void Stop();
+    bool IsRunning() const;
+
+    // 任意线程调用：标记表面需要重绘，实际上屏在下一个 vsync
+    void RequestFrame(uint32_t surfaces);
+    uint64_t GetPresentedFrameCount() const;
+    uint64_t GetSkippedFrameCount() const;
+
+private:
+    void OnVsync(int64_t timestampNs, int64_t targetTimestampNs);
+    bool IsStale(int64_t targetTimestampNs) const;
+    void ThreadMain();
+
+    std::unique_ptr<VsyncSource> source_;
+    PresentCallback present_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread thread_;
+    uint32_t dirtySurfaces_ = FRAME_SURFACE_NONE;
+    bool vsyncPending_ = false;
+    int64_t vsyncTimestamp_ = 0;
+    int64_t vsyncTarget_ = 0;
+    bool lastSkipped_ = false;
+    bool running_ = false;
+    bool stopRequested_ = false;
+    uint64_t presentedFrames_ = 0;
+    uint64_t skippedFrames_ = 0;
+};
+
+#endif // PAPERCUTTING_FRAME_SCHEDULER_H
@@ -0,0 +1,288 @@
+//
+// Created on 2026/10/17.
+// 模块级任务系统实现
+//
+
+#include "job_system.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+constexpr int MAX_CPUS = 64;
+constexpr auto HELP_WAIT = std::chrono::microseconds(200);  // Wait 找不到可执行任务时的最长休眠
+
+// 当前线程在池中的序号；非池内线程为 -1
+thread_local int t_workerIndex = -1;
+
+long ReadMaxFrequency(int cpu)
+{
+    char path[96];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpu);
+    FILE* file = std::fopen(path, "r");
+    if (!file) {
+        return -1;
+    }
+    long frequency = -1;
+    if (std::fscanf(file, "%ld", &frequency) != 1) {
+        frequency = -1;
+    }
+    std::fclose(file);
+    return frequency;
+}
+
+// 大核数：最高频率高于最低档簇的核（中核 + 大核 + 超大核）；同构或读不到频率时为全部核
+int CountBigCores()
+{
+    const int cpuCount = std::max(1, std::min(MAX_CPUS, static_cast<int>(std::thread::hardware_concurrency())));
+    std::vector<long> frequencies;
+    for (int cpu = 0; cpu < cpuCount; cpu++) {
+        const long frequency = ReadMaxFrequency(cpu);
+        if (frequency <= 0) {
+            return cpuCount;
+        }
+        frequencies.push_back(frequency);
+    }
+    const long lowest = *std::min_element(frequencies.begin(), frequencies.end());
+    const int big = static_cast<int>(
+        std::count_if(frequencies.begin(), frequencies.end(), [lowest](long f) { return f > lowest; }));
+    return big > 0 ? big : cpuCount;
+}
+
+// 可同时执行任务的线程数（含调用线程）。环境变量 PAPERCUT_JOB_THREADS 覆盖大核检测，
+// 主机基准用它在同一台机器上测量不同线程数下的扩展性
+int ThreadCount()
+{
+    const char* value = std::getenv("PAPERCUT_JOB_THREADS");
+    const int count = value ? std::atoi(value) : 0;
+    return count > 0 ? std::min(count, MAX_CPUS) : CountBigCores();
+}
+} // namespace
+
+JobSystem& JobSystem::Get()
+{
+    static JobSystem instance(ThreadCount() - 1);
+    instance.Start();
+    return instance;
+}
+
+void JobSystem::Acquire()
+{
+    JobSystem& system = Get();
+    std::lock_guard<std::mutex> lock(system.lifecycleMutex_);
+    system.refCount_++;
+}
+
+void JobSystem::Release()
+{
+    JobSystem& system = Get();
+    {
+        std::lock_guard<std::mutex> lock(system.lifecycleMutex_);
+        if (system.refCount_ == 0 || --system.refCount_ > 0) {
+            return;
+        }
+    }
+    system.Shutdown();
+}
+
+JobSystem::JobSystem(int workerCount)
+{
+    for (int i = 0; i < std::max(0, workerCount); i++) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Start()
+{
+    std::lock_guard<std::mutex> lock(lifecycleMutex_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    stopping_ = false;
+    for (size_t i = 0; i < workers_.size(); i++) {
+        workers_[i]->thread = std::thread(&JobSystem::WorkerLoop, this, static_cast<int>(i));
+    }
+}
+
+void JobSystem::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(lifecycleMutex_);
+    if (!running_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> sleepLock(sleepMutex_);
+        stopping_ = true;
+    }
+    sleepCv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+    // 队列中剩余的任务由各自 TaskGroup 的 Wait 在调用线程上执行完
+    running_ = false;
+}
+
+void JobSystem::WorkerLoop(int index)
+{
+    t_workerIndex = index;
+    while (true) {
+        Task task;
+        if (TryPop(&task)) {
+            Execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        sleepCv_.wait(lock, [this]() { return stopping_.load() || queuedCount_.load() > 0; });
+        if (stopping_) {
+            break;
+        }
+    }
+    t_workerIndex = -1;
+}
+
+void JobSystem::Submit(Task task)
+{
+    const int index = t_workerIndex;
+    if (index >= 0 && index < static_cast<int>(workers_.size())) {
+        std::lock_guard<std::mutex> lock(workers_[index]->mutex);
+        workers_[index]->tasks.push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> lock(injectMutex_);
+        injected_.push_back(std::move(task));
+    }
+    {
+        // 与 WorkerLoop 的等待条件在同一把锁下更新，避免丢失唤醒
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        queuedCount_++;
+    }
+    sleepCv_.notify_one();
+}
+
+bool JobSystem::TryPop(Task* task)
+{
+    if (queuedCount_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    const int self = t_workerIndex;
+    const int count = static_cast<int>(workers_.size());
+    if (self >= 0 && self < count) {
+        Worker& worker = *workers_[self];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (!worker.tasks.empty()) {
+            *task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            queuedCount_--;
+            return true;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(injectMutex_);
+        if (!injected_.empty()) {
+            *task = std::move(injected_.front());
+            injected_.pop_front();
+            queuedCount_--;
+            return true;
+        }
+    }
+    // 从相邻线程开始轮询窃取，分散竞争
+    for (int k = 1; k <= count; k++) {
+        const int victim = ((self < 0 ? 0 : self) + k) % count;
+        if (victim == self) {
+            continue;
+        }
+        Worker& worker = *workers_[victim];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (!worker.tasks.empty()) {
+            *task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+            queuedCount_--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::Execute(Task& task)
+{
+    TaskGroup* group = task.group;
+    if (!group->IsCancelled()) {
+        task.fn();
+    }
+    task.fn = nullptr;
+    group->Finish();
+}
+
+bool JobSystem::ParallelFor(int count, int grain, const RangeFn& fn, const TaskGroup* cancel)
+{
+    auto cancelled = [cancel]() { return cancel && cancel->IsCancelled(); };
+    if (count <= 0) {
+        return !cancelled();
+    }
+    grain = std::max(1, grain);
+    const int chunks = (count + grain - 1) / grain;
+    // 每个任务循环领取块（原子计数），任务数不超过线程数；块的负载不均由领取顺序自然平衡
+    std::atomic<int> next(0);
+    auto body = [&]() {
+        for (int chunk = next++; chunk < chunks && !cancelled(); chunk = next++) {
+            fn(chunk * grain, std::min(count, (chunk + 1) * grain));
+        }
+    };
+    TaskGroup group;
+    const int helpers = std::min(chunks, GetConcurrency()) - 1;
+    for (int i = 0; i < helpers; i++) {
+        group.Run(body);
+    }
+    body();
+    group.Wait();
+    return !cancelled();
+}
+
+TaskGroup::TaskGroup() : system_(JobSystem::Get()) {}
+
+TaskGroup::~TaskGroup()
+{
+    Wait();
+}
+
+void TaskGroup::Run(std::function<void()> fn)
+{
+    pending_++;
+    JobSystem::Task task;
+    task.fn = std::move(fn);
+    task.group = this;
+    system_.Submit(std::move(task));
+}
+
+void TaskGroup::Wait()
+{
+    while (pending_.load(std::memory_order_acquire) > 0) {
+        // 等待期间执行任意可执行的任务（包括其他组的），池中没有空闲线程时也能前进
+        JobSystem::Task task;
+        if (system_.TryPop(&task)) {
+            system_.Execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait_for(lock, HELP_WAIT, [this]() { return pending_.load() == 0; });
+    }
+    // 最后一个 Finish 可能刚递减完计数、还持有锁：等它释放后调用方才能析构本组
+    std::lock_guard<std::mutex> lock(mutex_);
+}
+
+void TaskGroup::Finish()
+{
+    // 在锁内递减并通知：Wait 返回后 TaskGroup 可能立即析构，通知必须在释放锁之前完成
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_ == 0) {
+        done_.notify_all();
+    }
+}
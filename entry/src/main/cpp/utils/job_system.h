@@ -0,0 +1,110 @@
+//
+// Created on 2026/10/17.
+// 模块级任务系统：工作窃取线程池 + 任务组（等待时参与执行、可取消）+ 按区间并行的 ParallelFor
+//
+// 每个工作线程有自己的双端队列：本线程提交的任务压入队尾、从队尾取（LIFO，缓存友好），
+// 空闲线程从其他队列的队首窃取（FIFO，先偷大块）；非池内线程（NAPI 主线程、async work 线程）
+// 提交的任务进入共享注入队列。TaskGroup::Wait 在等待期间自己执行队列里的任务，
+// 因此嵌套并行（任务里再 ParallelFor）不会占满线程而死锁，池中没有线程时也能全部在调用线程完成。
+//
+// 线程数按大核数确定（cpufreq 最高频率不是最低档的核，读不到时取全部核），调用线程也参与计算，
+// 后台线程数 = 大核数 - 1（环境变量 PAPERCUT_JOB_THREADS 可指定总线程数，供基准测量扩展性）。
+// 模块加载时 Acquire、环境销毁时 Release，引用归零即停止并回收线程。
+//
+
+#ifndef PAPERCUTTING_JOB_SYSTEM_H
+#define PAPERCUTTING_JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class TaskGroup;
+
+class JobSystem {
+public:
+    using RangeFn = std::function<void(int begin, int end)>;
+
+    // 进程内唯一实例；首次使用时启动线程（Linux 测试无需 Acquire）
+    static JobSystem& Get();
+    // 模块生命周期：每个 napi_env 初始化时 Acquire，env 销毁时 Release，计数归零时停止线程
+    static void Acquire();
+    static void Release();
+
+    // 可同时执行任务的线程数（后台线程 + 调用线程）
+    int GetConcurrency() const { return static_cast<int>(workers_.size()) + 1; }
+
+    // [0, count) 按 grain 切块并行执行 fn(begin, end)，返回前所有块都已完成（内部单独等待，
+    // 可在任何任务中调用）；cancel 不为空且被取消后不再开始新的块，返回 false
+    bool ParallelFor(int count, int grain, const RangeFn& fn, const TaskGroup* cancel = nullptr);
+
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+private:
+    friend class TaskGroup;
+
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup* group = nullptr;
+    };
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    explicit JobSystem(int workerCount);
+    void Start();
+    void Shutdown();
+    void WorkerLoop(int index);
+    void Submit(Task task);
+    // 取一个任务：本线程队列尾 -> 注入队列 -> 其他线程队列首（窃取）
+    bool TryPop(Task* task);
+    void Execute(Task& task);
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex injectMutex_;
+    std::deque<Task> injected_;
+    std::atomic<int> queuedCount_ {0};  // 所有队列中尚未取走的任务数，用于休眠判断
+
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCv_;
+    std::mutex lifecycleMutex_;
+    bool running_ = false;
+    std::atomic<bool> stopping_ {false};
+    int refCount_ = 0;
+};
+
+// 一组相关任务：Run 提交，Wait 等待全部完成（期间调用线程参与执行）。析构时自动 Wait
+class TaskGroup {
+public:
+    TaskGroup();
+    ~TaskGroup();
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void Run(std::function<void()> fn);
+    void Wait();
+    // 取消后尚未开始的任务直接跳过；已开始的任务可通过 IsCancelled 提前结束
+    void Cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+    bool IsCancelled() const { return cancelled_.load(std::memory_order_relaxed); }
+
+private:
+    friend class JobSystem;
+    void Finish();
+
+    JobSystem& system_;
+    std::atomic<int> pending_ {0};
+    std::atomic<bool> cancelled_ {false};
+    std::mutex mutex_;
+    std::condition_variable done_;
+};
+
+#endif // PAPERCUTTING_JOB_SYSTEM_H
@@ -0,0 +1,160 @@
+//
+// Created on 2026/10/17.
+// NativeWindow 上屏帧实现
+//
+
+#include "native_window_frame.h"
+#include <hilog/log.h>
+#include <cerrno>
+#include <poll.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define LOGE(...) ((void)OH_LOG_Print(LOG_APP, LOG_ERROR, LOG_DOMAIN, "NativeWindowFrame", __VA_ARGS__))
+
+namespace {
+constexpr int FENCE_TIMEOUT_MS = 3000;
+constexpr uint32_t BYTES_PER_PIXEL = 4;
+}
+
+NativeWindowFrame::NativeWindowFrame(OHNativeWindow* window)
+    : window_(window),
+      buffer_(nullptr),
+      handle_(nullptr),
+      fenceFd_(-1),
+      mappedAddr_(MAP_FAILED),
+      pixels_(nullptr),
+      width_(0),
+      height_(0),
+      stride_(0),
+      bitmap_(nullptr),
+      canvas_(nullptr)
+{
+}
+
+NativeWindowFrame::~NativeWindowFrame()
+{
+    if (canvas_) {
+        OH_Drawing_CanvasDestroy(canvas_);
+        canvas_ = nullptr;
+    }
+    if (bitmap_) {
+        OH_Drawing_BitmapDestroy(bitmap_);
+        bitmap_ = nullptr;
+    }
+    Unmap();
+    if (fenceFd_ >= 0) {
+        close(fenceFd_);
+        fenceFd_ = -1;
+    }
+    // 未提交的 buffer 必须归还，否则 BufferQueue 会逐渐耗尽
+    if (buffer_ && window_) {
+        OH_NativeWindow_NativeWindowAbortBuffer(window_, buffer_);
+        buffer_ = nullptr;
+    }
+}
+
+bool NativeWindowFrame::Begin(OH_Drawing_AlphaFormat alphaFormat)
+{
+    if (!window_) {
+        LOGE("NativeWindow is null");
+        return false;
+    }
+    if (buffer_) {
+        LOGE("Frame already begun");
+        return false;
+    }
+
+    int ret = OH_NativeWindow_NativeWindowRequestBuffer(window_, &buffer_, &fenceFd_);
+    if (ret != 0 || !buffer_) {
+        LOGE("Failed to request buffer, ret=%{public}d", ret);
+        buffer_ = nullptr;
+        fenceFd_ = -1;
+        return false;
+    }
+
+    handle_ = OH_NativeWindow_GetBufferHandleFromNative(buffer_);
+    if (!handle_) {
+        LOGE("Failed to get buffer handle");
+        return false;  // 析构时 Abort
+    }
+
+    // 上一帧的消费者可能仍在读这块 buffer，直接写入前必须等 release fence
+    WaitReleaseFence();
+
+    mappedAddr_ = mmap(handle_->virAddr, handle_->size, PROT_READ | PROT_WRITE, MAP_SHARED, handle_->fd, 0);
+    if (mappedAddr_ == MAP_FAILED) {
+        LOGE("mmap failed, errno=%{public}d", errno);
+        return false;
+    }
+
+    pixels_ = static_cast<uint32_t*>(mappedAddr_);
+    width_ = static_cast<uint32_t>(handle_->width);
+    height_ = static_cast<uint32_t>(handle_->height);
+    stride_ = static_cast<uint32_t>(handle_->stride) / BYTES_PER_PIXEL;
+
+    // bitmap 不分配内存，直接包装映射地址；rowBytes 使用 buffer 的真实 stride
+    OH_Drawing_Image_Info imageInfo{static_cast<int32_t>(width_), static_cast<int32_t>(height_),
+                                    COLOR_FORMAT_RGBA_8888, alphaFormat};
+    bitmap_ = OH_Drawing_BitmapCreateFromPixels(&imageInfo, mappedAddr_, static_cast<uint32_t>(handle_->stride));
+    if (!bitmap_) {
+        LOGE("Failed to wrap buffer memory as bitmap");
+        return false;
+    }
+
+    canvas_ = OH_Drawing_CanvasCreate();
+    OH_Drawing_CanvasBind(canvas_, bitmap_);
+    return true;
+}
+
+void NativeWindowFrame::Flush()
+{
+    if (!buffer_ || !window_) {
+        return;
+    }
+
+    // 先销毁 canvas/bitmap，确保所有绘制都已落到映射内存
+    if (canvas_) {
+        OH_Drawing_CanvasDestroy(canvas_);
+        canvas_ = nullptr;
+    }
+    if (bitmap_) {
+        OH_Drawing_BitmapDestroy(bitmap_);
+        bitmap_ = nullptr;
+    }
+
+    // CPU 写入已同步完成，不需要 acquire fence
+    Region region{nullptr, 0};
+    OH_NativeWindow_NativeWindowFlushBuffer(window_, buffer_, -1, region);
+    buffer_ = nullptr;
+
+    Unmap();
+}
+
+void NativeWindowFrame::WaitReleaseFence()
+{
+    if (fenceFd_ < 0) {
+        return;
+    }
+    struct pollfd pfd = {fenceFd_, POLLIN, 0};
+    int ret;
+    do {
+        ret = poll(&pfd, 1, FENCE_TIMEOUT_MS);
+    } while (ret == -1 && (errno == EINTR || errno == EAGAIN));
+    if (ret == 0) {
+        LOGE("Wait release fence timeout");
+    }
+    close(fenceFd_);
+    fenceFd_ = -1;
+}
+
+void NativeWindowFrame::Unmap()
+{
+    if (mappedAddr_ != MAP_FAILED && handle_) {
+        if (munmap(mappedAddr_, handle_->size) == -1) {
+            LOGE("munmap failed, errno=%{public}d", errno);
+        }
+    }
+    mappedAddr_ = MAP_FAILED;
+    pixels_ = nullptr;
+}
@@ -0,0 +1,54 @@
+//
+// Created on 2026/10/17.
+// NativeWindow 上屏帧：画布直接绑定到 mmap 后的 buffer 内存（零拷贝上屏）
+//
+
+#ifndef PAPERCUTTING_NATIVE_WINDOW_FRAME_H
+#define PAPERCUTTING_NATIVE_WINDOW_FRAME_H
+
+#include <native_drawing/drawing_bitmap.h>
+#include <native_drawing/drawing_canvas.h>
+#include <native_window/external_window.h>
+#include <cstdint>
+
+// 一帧的完整生命周期：
+// - Begin()：请求 buffer、等待 release fence、mmap，并把 canvas 按 buffer 的真实 stride 直接绑定到映射内存
+// - 绘制：直接画到 GetCanvas()（或通过 GetPixels() 按 stride 写像素）
+// - Flush()：提交 buffer 并解除映射
+// 未 Flush 就析构时会把 buffer 归还给 NativeWindow（Abort），避免 buffer 泄漏。
+class NativeWindowFrame {
+public:
+    explicit NativeWindowFrame(OHNativeWindow* window);
+    ~NativeWindowFrame();
+
+    NativeWindowFrame(const NativeWindowFrame&) = delete;
+    NativeWindowFrame& operator=(const NativeWindowFrame&) = delete;
+
+    bool Begin(OH_Drawing_AlphaFormat alphaFormat = ALPHA_FORMAT_PREMUL);
+    void Flush();
+
+    OH_Drawing_Canvas* GetCanvas() const { return canvas_; }
+    uint32_t* GetPixels() const { return pixels_; }
+    uint32_t GetWidth() const { return width_; }
+    uint32_t GetHeight() const { return height_; }
+    // 每行像素数（buffer stride / 4），可能大于 GetWidth()
+    uint32_t GetStride() const { return stride_; }
+
+private:
+    void WaitReleaseFence();
+    void Unmap();
+
+    OHNativeWindow* window_;
+    OHNativeWindowBuffer* buffer_;
+    BufferHandle* handle_;
+    int fenceFd_;
+    void* mappedAddr_;
+    uint32_t* pixels_;
+    uint32_t width_;
+    uint32_t height_;
+    uint32_t stride_;
+    OH_Drawing_Bitmap* bitmap_;
+    OH_Drawing_Canvas* canvas_;
+};
+
+#endif // PAPERCUTTING_NATIVE_WINDOW_FRAME_H
@@ -0,0 +1,331 @@
+//
+// Created on 2026/10/17.
+// PNG 编码实现
+//
+
+#include "png_writer.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <utility>
+#include <zlib.h>
+
+namespace {
+using PngWriter::BYTES_PER_PIXEL;
+constexpr int FILTER_COUNT = 5;  // None, Sub, Up, Average, Paeth
+constexpr size_t IDAT_CHUNK_SIZE = 256 * 1024;  // 单个 IDAT 块的最大长度
+const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+void PutU32BE(std::vector<uint8_t>& out, uint32_t v)
+{
+    out.push_back(static_cast<uint8_t>(v >> 24));
+    out.push_back(static_cast<uint8_t>(v >> 16));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+void PutChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size)
+{
+    PutU32BE(out, static_cast<uint32_t>(size));
+    const size_t typeAt = out.size();
+    out.insert(out.end(), type, type + 4);
+    if (size > 0) {
+        out.insert(out.end(), data, data + size);
+    }
+    // CRC 覆盖 type + data
+    const uLong crc = crc32(0L, out.data() + typeAt, static_cast<uInt>(4 + size));
+    PutU32BE(out, static_cast<uint32_t>(crc));
+}
+
+// 预乘 -> 非预乘（PNG 规定为直通 alpha）
+void UnpremultiplyRow(const uint32_t* src, int width, uint8_t* dst)
+{
+    for (int x = 0; x < width; x++) {
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(src + x);
+        const uint32_t a = p[3];
+        uint8_t* d = dst + x * BYTES_PER_PIXEL;
+        if (a == 0) {
+            d[0] = d[1] = d[2] = d[3] = 0;
+        } else if (a == 255) {
+            std::memcpy(d, p, BYTES_PER_PIXEL);
+        } else {
+            for (int c = 0; c < 3; c++) {
+                const uint32_t v = (p[c] * 255u + a / 2) / a;
+                d[c] = static_cast<uint8_t>(v > 255 ? 255 : v);
+            }
+            d[3] = static_cast<uint8_t>(a);
+        }
+    }
+}
+
+size_t FilterCost(const uint8_t* row, size_t rowBytes)
+{
+    size_t sum = 0;
+    for (size_t i = 0; i < rowBytes; i++) {
+        sum += static_cast<size_t>(std::abs(static_cast<int8_t>(row[i])));
+    }
+    return sum;
+}
+
+// 每种滤波器单独一个循环（不在逐字节循环里分支），编译器可以向量化 Sub/Up/Average；返回代价
+size_t ApplyFilter(int filter, const uint8_t* cur, const uint8_t* prev, size_t rowBytes, uint8_t* out)
+{
+    const size_t head = std::min(rowBytes, static_cast<size_t>(BYTES_PER_PIXEL));
+    switch (filter) {
+        case 1:
+            std::memcpy(out, cur, head);
+            for (size_t i = head; i < rowBytes; i++) {
+                out[i] = static_cast<uint8_t>(cur[i] - cur[i - BYTES_PER_PIXEL]);
+            }
+            break;
+        case 2:
+            if (!prev) {
+                std::memcpy(out, cur, rowBytes);
+                break;
+            }
+            for (size_t i = 0; i < rowBytes; i++) {
+                out[i] = static_cast<uint8_t>(cur[i] - prev[i]);
+            }
+            break;
+        case 3:
+            if (!prev) {
+                std::memcpy(out, cur, head);
+                for (size_t i = head; i < rowBytes; i++) {
+                    out[i] = static_cast<uint8_t>(cur[i] - (cur[i - BYTES_PER_PIXEL] >> 1));
+                }
+                break;
+            }
+            for (size_t i = 0; i < head; i++) {
+                out[i] = static_cast<uint8_t>(cur[i] - (prev[i] >> 1));
+            }
+            for (size_t i = head; i < rowBytes; i++) {
+                out[i] = static_cast<uint8_t>(cur[i] - ((cur[i - BYTES_PER_PIXEL] + prev[i]) >> 1));
+            }
+            break;
+        case 4:
+            // 没有上一行时 Paeth 退化为 Sub
+            if (!prev) {
+                return ApplyFilter(1, cur, prev, rowBytes, out);
+            }
+            for (size_t i = 0; i < head; i++) {
+                out[i] = static_cast<uint8_t>(cur[i] - prev[i]);
+            }
+            // 无分支形式（按 pa / pb / pc 比较结果选择），可向量化
+            for (size_t i = head; i < rowBytes; i++) {
+                const int a = cur[i - BYTES_PER_PIXEL];
+                const int b = prev[i];
+                const int c = prev[i - BYTES_PER_PIXEL];
+                const int pa = std::abs(b - c);
+                const int pb = std::abs(a - c);
+                const int pc = std::abs(a + b - c - c);
+                const int bc = (pb <= pc) ? b : c;
+                out[i] = static_cast<uint8_t>(cur[i] - ((pa <= pb && pa <= pc) ? a : bc));
+            }
+            break;
+        default:
+            std::memcpy(out, cur, rowBytes);
+            break;
+    }
+    return FilterCost(out, rowBytes);
+}
+
+void MakeHeader(int width, int height, uint8_t* ihdr)
+{
+    ihdr[0] = static_cast<uint8_t>(width >> 24);
+    ihdr[1] = static_cast<uint8_t>(width >> 16);
+    ihdr[2] = static_cast<uint8_t>(width >> 8);
+    ihdr[3] = static_cast<uint8_t>(width);
+    ihdr[4] = static_cast<uint8_t>(height >> 24);
+    ihdr[5] = static_cast<uint8_t>(height >> 16);
+    ihdr[6] = static_cast<uint8_t>(height >> 8);
+    ihdr[7] = static_cast<uint8_t>(height);
+    ihdr[8] = 8;   // bit depth
+    ihdr[9] = 6;   // color type: RGBA
+    ihdr[10] = 0;  // compression
+    ihdr[11] = 0;  // filter method
+    ihdr[12] = 0;  // no interlace
+}
+} // namespace
+
+namespace PngWriter {
+
+void FilterRow(const uint8_t* row, const uint8_t* prevRow, size_t rowBytes, uint8_t* scratch, uint8_t* out)
+{
+    // 代价为 0 时后面的滤波器不可能更好（同代价取先出现的），大片透明/纯色行只需一两次滤波
+    size_t bestCost = SIZE_MAX;
+    for (int filter = 0; filter < FILTER_COUNT && bestCost > 0; filter++) {
+        const size_t cost = ApplyFilter(filter, row, prevRow, rowBytes, scratch);
+        if (cost < bestCost) {
+            bestCost = cost;
+            out[0] = static_cast<uint8_t>(filter);
+            std::memcpy(out + 1, scratch, rowBytes);
+        }
+    }
+}
+
+bool EncodeRgbaPremul(const uint32_t* pixels, int width, int height, size_t stride, std::vector<uint8_t>* out)
+{
+    if (!pixels || !out || width <= 0 || height <= 0 || stride < static_cast<size_t>(width)) {
+        return false;
+    }
+    const size_t rowBytes = static_cast<size_t>(width) * BYTES_PER_PIXEL;
+
+    // 滤波后的原始数据流：每行 1 字节滤波类型 + 行数据
+    std::vector<uint8_t> raw((rowBytes + 1) * height);
+    std::vector<uint8_t> prevRow(rowBytes);
+    std::vector<uint8_t> curRow(rowBytes);
+    std::vector<uint8_t> candidate(rowBytes);
+    for (int y = 0; y < height; y++) {
+        UnpremultiplyRow(pixels + static_cast<size_t>(y) * stride, width, curRow.data());
+        const uint8_t* prev = y > 0 ? prevRow.data() : nullptr;
+        FilterRow(curRow.data(), prev, rowBytes, candidate.data(), raw.data() + static_cast<size_t>(y) * (rowBytes + 1));
+        curRow.swap(prevRow);
+    }
+
+    uLongf compressedSize = compressBound(static_cast<uLong>(raw.size()));
+    std::vector<uint8_t> compressed(compressedSize);
+    if (compress2(compressed.data(), &compressedSize, raw.data(), static_cast<uLong>(raw.size()),
+                  Z_DEFAULT_COMPRESSION) != Z_OK) {
+        return false;
+    }
+
+    std::vector<uint8_t> png(SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+    png.reserve(sizeof(SIGNATURE) + 25 + compressedSize + 12 + 12);
+
+    uint8_t ihdr[13];
+    MakeHeader(width, height, ihdr);
+    PutChunk(png, "IHDR", ihdr, sizeof(ihdr));
+    PutChunk(png, "IDAT", compressed.data(), compressedSize);
+    PutChunk(png, "IEND", nullptr, 0);
+    *out = std::move(png);
+    return true;
+}
+
+bool DeflateRows(const uint8_t* data, int rows, int width, bool last, DeflatedRows* out)
+{
+    if (!data || !out || rows <= 0 || width <= 0) {
+        return false;
+    }
+    const size_t size = (static_cast<size_t>(width) * BYTES_PER_PIXEL + 1) * rows;
+    if (size > UINT32_MAX / 2) {
+        return false;  // 段大小由调用方控制，远小于 zlib 的 32 位计数
+    }
+    z_stream stream {};
+    // 负的 windowBits：raw deflate，zlib 头与 adler32 由 StreamEncoder 统一写出
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    // deflateBound 不含同步刷新追加的空存储块，多留一些余量
+    out->data.resize(deflateBound(&stream, static_cast<uLong>(size)) + 16);
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = out->data.data();
+    stream.avail_out = static_cast<uInt>(out->data.size());
+    const int status = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool ok = (last ? status == Z_STREAM_END : status == Z_OK) && stream.avail_in == 0;
+    out->data.resize(out->data.size() - stream.avail_out);
+    deflateEnd(&stream);
+    out->adler = static_cast<uint32_t>(adler32(1L, data, static_cast<uInt>(size)));
+    out->rawSize = size;
+    out->rows = rows;
+    out->last = last;
+    return ok;
+}
+
+StreamEncoder::StreamEncoder(int fd) : fd_(fd) {}
+
+bool StreamEncoder::Begin(int width, int height)
+{
+    if (fd_ < 0 || width <= 0 || height <= 0 || width_ != 0 ||
+        static_cast<size_t>(width) > (SIZE_MAX / BYTES_PER_PIXEL) - 1) {
+        return false;
+    }
+    width_ = width;
+    height_ = height;
+
+    uint8_t ihdr[13];
+    MakeHeader(width, height, ihdr);
+    // zlib 头单独一个 IDAT：deflate、32K 窗口、默认压缩级别
+    static const uint8_t ZLIB_HEADER[2] = {0x78, 0x9C};
+    ok_ = WriteAll(SIGNATURE, sizeof(SIGNATURE)) && WriteChunk("IHDR", ihdr, sizeof(ihdr)) &&
+          WriteChunk("IDAT", ZLIB_HEADER, sizeof(ZLIB_HEADER));
+    return ok_;
+}
+
+bool StreamEncoder::WriteFilteredRows(const uint8_t* data, int rows)
+{
+    DeflatedRows deflated;
+    if (!ok_ || rows <= 0 || rows > height_ - rowsWritten_ ||
+        !DeflateRows(data, rows, width_, rowsWritten_ + rows == height_, &deflated)) {
+        ok_ = false;
+        return false;
+    }
+    return WriteDeflatedRows(deflated);
+}
+
+bool StreamEncoder::WriteDeflatedRows(const DeflatedRows& rows)
+{
+    if (!ok_ || rows.rows <= 0 || rows.rows > height_ - rowsWritten_ ||
+        rows.rawSize != (static_cast<size_t>(width_) * BYTES_PER_PIXEL + 1) * rows.rows ||
+        rows.last != (rowsWritten_ + rows.rows == height_)) {
+        ok_ = false;
+        return false;
+    }
+    rowsWritten_ += rows.rows;
+    adler_ = static_cast<uint32_t>(adler32_combine(adler_, rows.adler, static_cast<z_off_t>(rows.rawSize)));
+    // 大段拆成多个 IDAT，单个块不超过 IDAT_CHUNK_SIZE
+    for (size_t offset = 0; offset < rows.data.size() && ok_; offset += IDAT_CHUNK_SIZE) {
+        WriteChunk("IDAT", rows.data.data() + offset, std::min(IDAT_CHUNK_SIZE, rows.data.size() - offset));
+    }
+    return ok_;
+}
+
+bool StreamEncoder::Finish()
+{
+    if (!ok_ || rowsWritten_ != height_) {
+        return false;
+    }
+    const uint8_t trailer[4] = {static_cast<uint8_t>(adler_ >> 24), static_cast<uint8_t>(adler_ >> 16),
+                                static_cast<uint8_t>(adler_ >> 8), static_cast<uint8_t>(adler_)};
+    return WriteChunk("IDAT", trailer, sizeof(trailer)) && WriteChunk("IEND", nullptr, 0);
+}
+
+bool StreamEncoder::WriteChunk(const char* type, const uint8_t* data, size_t size)
+{
+    uint8_t head[8];
+    const uint32_t length = static_cast<uint32_t>(size);
+    head[0] = static_cast<uint8_t>(length >> 24);
+    head[1] = static_cast<uint8_t>(length >> 16);
+    head[2] = static_cast<uint8_t>(length >> 8);
+    head[3] = static_cast<uint8_t>(length);
+    std::memcpy(head + 4, type, 4);
+    // CRC 覆盖 type + data
+    uLong crc = crc32(0L, head + 4, 4);
+    if (size > 0) {
+        crc = crc32(crc, data, static_cast<uInt>(size));
+    }
+    const uint8_t tail[4] = {static_cast<uint8_t>(crc >> 24), static_cast<uint8_t>(crc >> 16),
+                             static_cast<uint8_t>(crc >> 8), static_cast<uint8_t>(crc)};
+    ok_ = WriteAll(head, sizeof(head)) && (size == 0 || WriteAll(data, size)) && WriteAll(tail, sizeof(tail));
+    return ok_;
+}
+
+bool StreamEncoder::WriteAll(const uint8_t* data, size_t size)
+{
+    while (size > 0) {
+        const ssize_t n = write(fd_, data, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace PngWriter
@@ -0,0 +1,66 @@
+//
+// Created on 2026/10/17.
+// PNG 编码（RGBA8，zlib 压缩）
+//
+// 纯 C++ + zlib，Linux 上可单独编译测试。
+// 小图一次性编码到内存；大图用 StreamEncoder 逐段写入文件描述符（每段一个 IDAT），
+// 内存只与调用方持有的行块有关，与图像高度无关。
+//
+
+#ifndef PAPERCUTTING_PNG_WRITER_H
+#define PAPERCUTTING_PNG_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PngWriter {
+constexpr int BYTES_PER_PIXEL = 4;
+
+// 单行滤波：row / prevRow 为非预乘 RGBA（prevRow 为 nullptr 表示首行），scratch 至少 rowBytes 字节；
+// out 写入 1 字节滤波类型 + rowBytes 字节数据（按最小绝对差和选择滤波器）。行之间互不依赖，可并行
+void FilterRow(const uint8_t* row, const uint8_t* prevRow, size_t rowBytes, uint8_t* scratch, uint8_t* out);
+
+// pixels 为 RGBA_8888 预乘像素（内存顺序 R,G,B,A），stride 以像素为单位；
+// 输出非预乘 RGBA 的 PNG。每行按最小绝对差和选择滤波器。
+bool EncodeRgbaPremul(const uint32_t* pixels, int width, int height, size_t stride, std::vector<uint8_t>* out);
+
+// 一段已滤波的行独立压缩为 raw deflate（不带 zlib 头尾，段尾同步刷新到字节边界），
+// 各段互不依赖、可在不同线程并行压缩，按顺序拼接后仍是一条合法的 deflate 流（同 pigz）
+struct DeflatedRows {
+    std::vector<uint8_t> data;
+    uint32_t adler = 1;  // 本段未压缩数据的 adler32
+    size_t rawSize = 0;
+    int rows = 0;
+    bool last = false;  // 整幅图像的最后一段（以 BFINAL 块结束）
+};
+// data 为 rows 行 FilterRow 的输出（每行 1 + width * 4 字节）
+bool DeflateRows(const uint8_t* data, int rows, int width, bool last, DeflatedRows* out);
+
+// 流式编码：Begin -> 按顺序写入共 height 行 -> Finish；fd 由调用方打开和关闭
+class StreamEncoder {
+public:
+    explicit StreamEncoder(int fd);
+
+    bool Begin(int width, int height);
+    // 在调用线程压缩并写出（最后一段自动结束 deflate 流）
+    bool WriteFilteredRows(const uint8_t* data, int rows);
+    // 写出 DeflateRows 的结果；段的 last 标记必须与是否写满 height 行一致
+    bool WriteDeflatedRows(const DeflatedRows& rows);
+    // 写出 adler32 和 IEND；行数不足或任意一次写入失败都返回 false
+    bool Finish();
+
+private:
+    bool WriteChunk(const char* type, const uint8_t* data, size_t size);
+    bool WriteAll(const uint8_t* data, size_t size);
+
+    int fd_;
+    int width_ = 0;
+    int height_ = 0;
+    int rowsWritten_ = 0;
+    uint32_t adler_ = 1;  // 整条 zlib 流的 adler32，由各段合并
+    bool ok_ = false;
+};
+} // namespace PngWriter
+
+#endif // PAPERCUTTING_PNG_WRITER_H
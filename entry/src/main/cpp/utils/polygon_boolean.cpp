@@ -0,0 +1,540 @@
+//
+// Created on 2026/10/17.
+// 多边形布尔运算实现
+//
+
+#include "polygon_boolean.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+constexpr double FIXED_SCALE = 256.0;   // 量化网格：1/256 像素
+constexpr double MAX_COORD = 65536.0;   // 量化后不超过 2^24，叉积在 int64 内不溢出
+constexpr int MAX_SPLIT_PASSES = 8;     // 交点取整引入的新交叉通常 1~2 轮即消失
+constexpr size_t EDGES_PER_BAND = 4;
+constexpr size_t MAX_BANDS = 4096;
+
+struct IPoint {
+    int64_t x;
+    int64_t y;
+};
+
+inline bool operator==(IPoint a, IPoint b)
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+inline bool operator!=(IPoint a, IPoint b)
+{
+    return !(a == b);
+}
+
+inline bool operator<(IPoint a, IPoint b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// (a - o) × (b - o)
+inline int64_t Cross(IPoint o, IPoint a, IPoint b)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+inline int Sign(int64_t v)
+{
+    return (v > 0) - (v < 0);
+}
+
+// 无向子边：a < b（字典序，a.x <= b.x），wind 为 a -> b 方向上各集合（0 = subject，1 = clip）的环绕数增量
+struct Edge {
+    IPoint a;
+    IPoint b;
+    int32_t wind[2];
+};
+
+// 结果边界上的有向边，内部在 (to - from) 的正叉积一侧
+struct Link {
+    IPoint from;
+    IPoint to;
+};
+
+struct SplitPoint {
+    uint32_t edge;
+    int64_t order;  // 沿边方向的投影，用于排序
+    IPoint p;
+};
+
+void PushEdge(IPoint from, IPoint to, const int32_t wind[2], std::vector<Edge>* edges)
+{
+    if (from == to) {
+        return;
+    }
+    if (to < from) {
+        edges->push_back({to, from, {-wind[0], -wind[1]}});
+    } else {
+        edges->push_back({from, to, {wind[0], wind[1]}});
+    }
+}
+
+void AddContours(const std::vector<RasterPath::Contour>& contours, int set, std::vector<Edge>* edges)
+{
+    int32_t wind[2] = {0, 0};
+    wind[set] = 1;
+    std::vector<IPoint> ring;
+    for (const auto& contour : contours) {
+        ring.clear();
+        for (const RasterPoint& p : contour.points) {
+            if (!std::isfinite(p.x) || !std::isfinite(p.y) || std::fabs(p.x) > MAX_COORD ||
+                std::fabs(p.y) > MAX_COORD) {
+                continue;
+            }
+            ring.push_back({std::llround(p.x * FIXED_SCALE), std::llround(p.y * FIXED_SCALE)});
+        }
+        for (size_t i = 0; i < ring.size(); i++) {
+            PushEdge(ring[i], ring[(i + 1) % ring.size()], wind, edges);
+        }
+    }
+}
+
+// p 与 e 共线时判断 p 是否严格位于 e 内部（共线点的字典序即沿线顺序）
+inline bool StrictlyInside(const Edge& e, IPoint p)
+{
+    return e.a < p && p < e.b;
+}
+
+void AddSplit(const std::vector<Edge>& edges, uint32_t index, IPoint p, std::vector<SplitPoint>* splits)
+{
+    const Edge& e = edges[index];
+    const int64_t order = (p.x - e.a.x) * (e.b.x - e.a.x) + (p.y - e.a.y) * (e.b.y - e.a.y);
+    splits->push_back({index, order, p});
+}
+
+void IntersectPair(const std::vector<Edge>& edges, uint32_t i, uint32_t j, std::vector<SplitPoint>* splits)
+{
+    const Edge& e = edges[i];
+    const Edge& f = edges[j];
+    if (std::max(e.a.y, e.b.y) < std::min(f.a.y, f.b.y) || std::max(f.a.y, f.b.y) < std::min(e.a.y, e.b.y)) {
+        return;
+    }
+    const int o1 = Sign(Cross(e.a, e.b, f.a));
+    const int o2 = Sign(Cross(e.a, e.b, f.b));
+    const int o3 = Sign(Cross(f.a, f.b, e.a));
+    const int o4 = Sign(Cross(f.a, f.b, e.b));
+    // 端点落在另一条边内部（含共线重叠）：在该端点处切分
+    if (o1 == 0 && StrictlyInside(e, f.a)) {
+        AddSplit(edges, i, f.a, splits);
+    }
+    if (o2 == 0 && StrictlyInside(e, f.b)) {
+        AddSplit(edges, i, f.b, splits);
+    }
+    if (o3 == 0 && StrictlyInside(f, e.a)) {
+        AddSplit(edges, j, e.a, splits);
+    }
+    if (o4 == 0 && StrictlyInside(f, e.b)) {
+        AddSplit(edges, j, e.b, splits);
+    }
+    if (o1 * o2 >= 0 || o3 * o4 >= 0) {
+        return;
+    }
+    // 真交叉：交点取整到网格（两侧叉积异号保证分母非零）
+    const double rx = static_cast<double>(e.b.x - e.a.x);
+    const double ry = static_cast<double>(e.b.y - e.a.y);
+    const double sx = static_cast<double>(f.b.x - f.a.x);
+    const double sy = static_cast<double>(f.b.y - f.a.y);
+    const double qx = static_cast<double>(f.a.x - e.a.x);
+    const double qy = static_cast<double>(f.a.y - e.a.y);
+    const double t = (qx * sy - qy * sx) / (rx * sy - ry * sx);
+    const IPoint p = {e.a.x + std::llround(t * rx), e.a.y + std::llround(t * ry)};
+    if (p != e.a && p != e.b) {
+        AddSplit(edges, i, p, splits);
+    }
+    if (p != f.a && p != f.b) {
+        AddSplit(edges, j, p, splits);
+    }
+}
+
+// 一轮 x 方向扫描求交并切分；没有任何切分时返回 false
+bool SplitPass(std::vector<Edge>* edges)
+{
+    std::sort(edges->begin(), edges->end(), [](const Edge& lhs, const Edge& rhs) { return lhs.a.x < rhs.a.x; });
+    std::vector<SplitPoint> splits;
+    std::vector<uint32_t> active;
+    for (uint32_t i = 0; i < edges->size(); i++) {
+        const int64_t x = (*edges)[i].a.x;
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [&](uint32_t j) { return (*edges)[j].b.x < x; }),
+                     active.end());
+        for (uint32_t j : active) {
+            IntersectPair(*edges, j, i, &splits);
+        }
+        active.push_back(i);
+    }
+    if (splits.empty()) {
+        return false;
+    }
+    std::sort(splits.begin(), splits.end(), [](const SplitPoint& lhs, const SplitPoint& rhs) {
+        return lhs.edge < rhs.edge || (lhs.edge == rhs.edge && lhs.order < rhs.order);
+    });
+    std::vector<Edge> result;
+    result.reserve(edges->size() + splits.size());
+    size_t s = 0;
+    for (uint32_t i = 0; i < edges->size(); i++) {
+        const Edge& e = (*edges)[i];
+        IPoint from = e.a;
+        for (; s < splits.size() && splits[s].edge == i; s++) {
+            if (splits[s].p != from) {
+                PushEdge(from, splits[s].p, e.wind, &result);
+                from = splits[s].p;
+            }
+        }
+        PushEdge(from, e.b, e.wind, &result);
+    }
+    edges->swap(result);
+    return true;
+}
+
+// 重合子边合并为一条，方向增量相加；增量全为零的边（正反抵消）不是任何区域的边界
+void MergeEdges(std::vector<Edge>* edges)
+{
+    std::sort(edges->begin(), edges->end(), [](const Edge& lhs, const Edge& rhs) {
+        return lhs.a < rhs.a || (lhs.a == rhs.a && lhs.b < rhs.b);
+    });
+    size_t out = 0;
+    for (size_t i = 0; i < edges->size();) {
+        Edge merged = (*edges)[i];
+        size_t j = i + 1;
+        for (; j < edges->size() && (*edges)[j].a == merged.a && (*edges)[j].b == merged.b; j++) {
+            merged.wind[0] += (*edges)[j].wind[0];
+            merged.wind[1] += (*edges)[j].wind[1];
+        }
+        if (merged.wind[0] != 0 || merged.wind[1] != 0) {
+            (*edges)[out++] = merged;
+        }
+        i = j;
+    }
+    edges->resize(out);
+}
+
+// 按一个坐标轴分段的边索引：每条边登记到其坐标范围覆盖的所有段
+class BandIndex {
+public:
+    template <typename RangeFn>
+    void Build(const std::vector<uint32_t>& ids, RangeFn range)
+    {
+        start_.clear();
+        items_.clear();
+        if (ids.empty()) {
+            return;
+        }
+        int64_t lo = INT64_MAX;
+        int64_t hi = INT64_MIN;
+        for (uint32_t id : ids) {
+            int64_t a = 0;
+            int64_t b = 0;
+            range(id, &a, &b);
+            lo = std::min(lo, a);
+            hi = std::max(hi, b);
+        }
+        const size_t bands = std::max<size_t>(1, std::min(MAX_BANDS, ids.size() / EDGES_PER_BAND));
+        origin_ = lo;
+        width_ = std::max<int64_t>(1, (hi - lo) / static_cast<int64_t>(bands) + 1);
+        start_.assign(bands + 1, 0);
+        for (uint32_t id : ids) {
+            int64_t a = 0;
+            int64_t b = 0;
+            range(id, &a, &b);
+            for (size_t band = Band(a); band <= Band(b); band++) {
+                start_[band + 1]++;
+            }
+        }
+        for (size_t band = 0; band < bands; band++) {
+            start_[band + 1] += start_[band];
+        }
+        items_.resize(start_[bands]);
+        std::vector<uint32_t> cursor(start_.begin(), start_.end() - 1);
+        for (uint32_t id : ids) {
+            int64_t a = 0;
+            int64_t b = 0;
+            range(id, &a, &b);
+            for (size_t band = Band(a); band <= Band(b); band++) {
+                items_[cursor[band]++] = id;
+            }
+        }
+    }
+
+    // 坐标 v 所在段内登记的边（覆盖 v 的边一定在其中）
+    template <typename Visit>
+    void Query(int64_t v, Visit visit) const
+    {
+        if (start_.empty()) {
+            return;
+        }
+        const size_t band = Band(v);
+        for (uint32_t k = start_[band]; k < start_[band + 1]; k++) {
+            visit(items_[k]);
+        }
+    }
+
+private:
+    size_t Band(int64_t v) const
+    {
+        const int64_t band = (v - origin_) / width_;
+        return static_cast<size_t>(std::max<int64_t>(0, std::min<int64_t>(band, start_.size() - 2)));
+    }
+
+    int64_t origin_ = 0;
+    int64_t width_ = 1;
+    std::vector<uint32_t> start_;
+    std::vector<uint32_t> items_;
+};
+
+inline bool IsInside(int32_t winding, RasterFillRule rule)
+{
+    return rule == RasterFillRule::EVEN_ODD ? (winding & 1) != 0 : winding != 0;
+}
+
+inline bool Combine(bool inSubject, bool inClip, BooleanOp op)
+{
+    switch (op) {
+        case BooleanOp::UNION:
+            return inSubject || inClip;
+        case BooleanOp::INTERSECTION:
+            return inSubject && inClip;
+        case BooleanOp::DIFFERENCE:
+            return inSubject && !inClip;
+        case BooleanOp::XOR:
+            return inSubject != inClip;
+    }
+    return false;
+}
+
+// 求每条子边两侧的环绕数，保留两侧结果不同的边并定向（内部在正叉积一侧）
+void ClassifyEdges(const std::vector<Edge>& edges, const RasterFillRule rules[2], BooleanOp op,
+                   std::vector<Link>* links)
+{
+    std::vector<uint32_t> sloped;    // a.x < b.x：向 -y 发射竖直射线
+    std::vector<uint32_t> vertical;  // a.x == b.x：向 -x 发射水平射线
+    std::vector<uint32_t> crossing;  // a.y != b.y：可能与水平射线相交
+    for (uint32_t i = 0; i < edges.size(); i++) {
+        (edges[i].a.x < edges[i].b.x ? sloped : vertical).push_back(i);
+        if (edges[i].a.y != edges[i].b.y) {
+            crossing.push_back(i);
+        }
+    }
+    BandIndex xBands;
+    xBands.Build(sloped, [&](uint32_t id, int64_t* lo, int64_t* hi) {
+        *lo = edges[id].a.x;
+        *hi = edges[id].b.x;
+    });
+    BandIndex yBands;
+    if (!vertical.empty()) {
+        yBands.Build(crossing, [&](uint32_t id, int64_t* lo, int64_t* hi) {
+            *lo = std::min(edges[id].a.y, edges[id].b.y);
+            *hi = std::max(edges[id].a.y, edges[id].b.y);
+        });
+    }
+
+    // positive / negative 为 a -> b 正叉积一侧与另一侧的环绕数；结果内部在哪侧就按哪个方向输出
+    auto emit = [&](const Edge& e, const int32_t positive[2], const int32_t negative[2]) {
+        const bool inPositive = Combine(IsInside(positive[0], rules[0]), IsInside(positive[1], rules[1]), op);
+        const bool inNegative = Combine(IsInside(negative[0], rules[0]), IsInside(negative[1], rules[1]), op);
+        if (inPositive != inNegative) {
+            links->push_back(inPositive ? Link{e.a, e.b} : Link{e.b, e.a});
+        }
+    };
+
+    // 中点用两倍坐标表示，保持整数精确
+    for (uint32_t id : sloped) {
+        const Edge& e = edges[id];
+        const int64_t mx2 = e.a.x + e.b.x;
+        const int64_t my2 = e.a.y + e.b.y;
+        int32_t above[2] = {0, 0};
+        xBands.Query(mx2 >> 1, [&](uint32_t k) {
+            const Edge& f = edges[k];
+            if (k == id || mx2 < 2 * f.a.x || mx2 >= 2 * f.b.x) {
+                return;
+            }
+            // f 在中点上方（y 更小）时被射线穿过；f 沿 +x，贡献 +wind
+            const int64_t cross = (f.b.x - f.a.x) * (my2 - 2 * f.a.y) - (f.b.y - f.a.y) * (mx2 - 2 * f.a.x);
+            if (cross > 0) {
+                above[0] += f.wind[0];
+                above[1] += f.wind[1];
+            }
+        });
+        const int32_t below[2] = {above[0] + e.wind[0], above[1] + e.wind[1]};
+        // a.x < b.x 时 +y（下方）为正叉积一侧
+        emit(e, below, above);
+    }
+    for (uint32_t id : vertical) {
+        const Edge& e = edges[id];
+        const int64_t mx2 = e.a.x + e.b.x;
+        const int64_t my2 = e.a.y + e.b.y;
+        int32_t left[2] = {0, 0};
+        yBands.Query(my2 >> 1, [&](uint32_t k) {
+            const Edge& f = edges[k];
+            const bool upward = f.a.y < f.b.y;  // 沿 +y
+            const IPoint p = upward ? f.a : f.b;
+            const IPoint q = upward ? f.b : f.a;
+            if (k == id || my2 < 2 * p.y || my2 >= 2 * q.y) {
+                return;
+            }
+            // f 在中点左侧时被射线穿过；与竖直射线同一环绕方向约定，沿 +y 贡献 -wind
+            const int64_t cross = (q.x - p.x) * (my2 - 2 * p.y) - (q.y - p.y) * (mx2 - 2 * p.x);
+            if (cross < 0) {
+                const int32_t sign = upward ? -1 : 1;
+                left[0] += sign * f.wind[0];
+                left[1] += sign * f.wind[1];
+            }
+        });
+        // e 沿 +y，从左侧跨到右侧贡献 -wind；此时 -x（左侧）为正叉积一侧
+        const int32_t right[2] = {left[0] - e.wind[0], left[1] - e.wind[1]};
+        emit(e, left, right);
+    }
+}
+
+// 去掉共线顶点（含零面积折返）
+void Simplify(std::vector<IPoint>* ring)
+{
+    std::vector<IPoint> out;
+    out.reserve(ring->size());
+    for (const IPoint& p : *ring) {
+        while (out.size() >= 2 && Cross(out[out.size() - 2], out.back(), p) == 0) {
+            out.pop_back();
+        }
+        out.push_back(p);
+    }
+    size_t head = 0;
+    bool changed = true;
+    while (changed && out.size() - head >= 3) {
+        changed = false;
+        if (Cross(out[out.size() - 2], out.back(), out[head]) == 0) {
+            out.pop_back();
+            changed = true;
+        } else if (Cross(out.back(), out[head], out[head + 1]) == 0) {
+            head++;
+            changed = true;
+        }
+    }
+    ring->assign(out.begin() + head, out.end());
+}
+
+// 有向边首尾相接成环：同一顶点有多条出边时选向内部转得最急的一条，使相切的区域分成独立轮廓
+void LinkContours(std::vector<Link>* links, std::vector<RasterPath::Contour>* out)
+{
+    std::sort(links->begin(), links->end(), [](const Link& lhs, const Link& rhs) { return lhs.from < rhs.from; });
+    std::vector<bool> used(links->size(), false);
+    std::vector<IPoint> ring;
+    for (size_t first = 0; first < links->size(); first++) {
+        if (used[first]) {
+            continue;
+        }
+        ring.clear();
+        const IPoint start = (*links)[first].from;
+        ring.push_back(start);
+        size_t current = first;
+        bool closed = false;
+        while (true) {
+            used[current] = true;
+            const Link& in = (*links)[current];
+            if (in.to == start) {
+                closed = true;
+                break;
+            }
+            ring.push_back(in.to);
+            auto range = std::equal_range(links->begin(), links->end(), Link{in.to, in.to},
+                                          [](const Link& lhs, const Link& rhs) { return lhs.from < rhs.from; });
+            const double dx = static_cast<double>(in.to.x - in.from.x);
+            const double dy = static_cast<double>(in.to.y - in.from.y);
+            size_t best = links->size();
+            double bestTurn = -INFINITY;
+            for (auto it = range.first; it != range.second; ++it) {
+                const size_t k = static_cast<size_t>(it - links->begin());
+                if (used[k]) {
+                    continue;
+                }
+                const double ox = static_cast<double>(it->to.x - it->from.x);
+                const double oy = static_cast<double>(it->to.y - it->from.y);
+                const double turn = std::atan2(dx * oy - dy * ox, dx * ox + dy * oy);
+                if (turn > bestTurn) {
+                    bestTurn = turn;
+                    best = k;
+                }
+            }
+            if (best == links->size()) {
+                break;  // 输入坐标超出范围等异常情况下边界不闭合，丢弃该段
+            }
+            current = best;
+        }
+        if (!closed) {
+            continue;
+        }
+        Simplify(&ring);
+        if (ring.size() < 3) {
+            continue;
+        }
+        RasterPath::Contour contour;
+        contour.closed = true;
+        contour.points.reserve(ring.size());
+        for (const IPoint& p : ring) {
+            contour.points.push_back({static_cast<float>(p.x / FIXED_SCALE), static_cast<float>(p.y / FIXED_SCALE)});
+        }
+        out->push_back(std::move(contour));
+    }
+}
+} // namespace
+
+namespace PolygonBoolean {
+void Compute(const std::vector<RasterPath::Contour>& subject, RasterFillRule subjectRule,
+             const std::vector<RasterPath::Contour>& clip, RasterFillRule clipRule, BooleanOp op,
+             std::vector<RasterPath::Contour>* out)
+{
+    if (!out) {
+        return;
+    }
+    out->clear();
+    std::vector<Edge> edges;
+    AddContours(subject, 0, &edges);
+    AddContours(clip, 1, &edges);
+    int pass = 0;
+    while (pass++ < MAX_SPLIT_PASSES && SplitPass(&edges)) {
+        // 交点取整后可能与其他边产生新的交叉，切分到不再变化为止
+    }
+    MergeEdges(&edges);
+    const RasterFillRule rules[2] = {subjectRule, clipRule};
+    std::vector<Link> links;
+    ClassifyEdges(edges, rules, op, &links);
+    LinkContours(&links, out);
+}
+
+double Area(const std::vector<RasterPath::Contour>& contours)
+{
+    double area = 0.0;
+    for (const auto& contour : contours) {
+        const size_t count = contour.points.size();
+        for (size_t i = 0; i < count; i++) {
+            const RasterPoint& a = contour.points[i];
+            const RasterPoint& b = contour.points[(i + 1) % count];
+            area += static_cast<double>(a.x) * b.y - static_cast<double>(b.x) * a.y;
+        }
+    }
+    return area * 0.5;
+}
+
+double Perimeter(const std::vector<RasterPath::Contour>& contours)
+{
+    double length = 0.0;
+    for (const auto& contour : contours) {
+        const size_t count = contour.points.size();
+        if (count < 2) {
+            continue;
+        }
+        for (size_t i = 0; i < count; i++) {
+            const RasterPoint& a = contour.points[i];
+            const RasterPoint& b = contour.points[(i + 1) % count];
+            length += std::hypot(static_cast<double>(b.x) - a.x, static_cast<double>(b.y) - a.y);
+        }
+    }
+    return length;
+}
+} // namespace PolygonBoolean
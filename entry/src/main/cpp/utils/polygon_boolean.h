@@ -0,0 +1,38 @@
+//
+// Created on 2026/10/17.
+// 多边形布尔运算：两组轮廓（各自按填充规则解释）求并 / 交 / 差 / 异或，输出不自交的闭合轮廓
+//
+// 坐标量化到 1/256 像素的整数网格，所有拓扑判断（方向、共线、点是否在线段上）都是精确整数运算：
+// ① 求出所有线段交点（含端点接触、共线重叠），在交点处切分；交点取整后可能产生新的交叉，反复切分直到稳定；
+// ② 合并重合的子边，按集合累加方向增量；
+// ③ 从每条子边中点发出射线（半开区间计数）求两侧的环绕数，两侧结果不同的子边即为结果边界；
+// ④ 结果边界按“内部在左（正向）”连接成轮廓：外轮廓有向面积为正，孔为负，共线点合并。
+//
+
+#ifndef PAPERCUTTING_POLYGON_BOOLEAN_H
+#define PAPERCUTTING_POLYGON_BOOLEAN_H
+
+#include <vector>
+#include "raster_backend.h"
+
+enum class BooleanOp {
+    UNION = 0,
+    INTERSECTION = 1,
+    DIFFERENCE = 2,  // subject - clip
+    XOR = 3
+};
+
+namespace PolygonBoolean {
+// 轮廓总是视为闭合（contour.closed 被忽略）；输出轮廓 closed = true，外轮廓为正向、孔为反向，
+// 结果按非零或奇偶规则填充都相同。坐标需有限且绝对值不超过 65536，否则该点被丢弃
+void Compute(const std::vector<RasterPath::Contour>& subject, RasterFillRule subjectRule,
+             const std::vector<RasterPath::Contour>& clip, RasterFillRule clipRule, BooleanOp op,
+             std::vector<RasterPath::Contour>* out);
+
+// 有向面积之和（a.x * b.y - b.x * a.y 的一半；Compute 的输出即为实际面积）
+double Area(const std::vector<RasterPath::Contour>& contours);
+// 所有轮廓（闭合）的边长之和
+double Perimeter(const std::vector<RasterPath::Contour>& contours);
+} // namespace PolygonBoolean
+
+#endif // PAPERCUTTING_POLYGON_BOOLEAN_H
@@ -0,0 +1,222 @@
+//
+// Created on 2026/10/17.
+// 渲染后端公共部分：变换矩阵与路径展平
+//
+
+#include "raster_backend.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float PI_F = 3.14159265358979f;
+constexpr int MAX_CURVE_SEGMENTS = 4096;
+} // namespace
+
+RasterMatrix RasterMatrix::Concat(const RasterMatrix& other) const
+{
+    RasterMatrix m;
+    m.a = a * other.a + c * other.b;
+    m.b = b * other.a + d * other.b;
+    m.c = a * other.c + c * other.d;
+    m.d = b * other.c + d * other.d;
+    m.tx = a * other.tx + c * other.ty + tx;
+    m.ty = b * other.tx + d * other.ty + ty;
+    return m;
+}
+
+bool RasterMatrix::Invert(RasterMatrix* out) const
+{
+    const float det = a * d - b * c;
+    if (!out || std::fabs(det) < 1e-12f) {
+        return false;
+    }
+    const float inv = 1.0f / det;
+    out->a = d * inv;
+    out->b = -b * inv;
+    out->c = -c * inv;
+    out->d = a * inv;
+    out->tx = -(out->a * tx + out->c * ty);
+    out->ty = -(out->b * tx + out->d * ty);
+    return true;
+}
+
+float RasterMatrix::MaxScale() const
+{
+    return std::max(std::hypot(a, b), std::hypot(c, d));
+}
+
+void RasterPath::EnsureContour()
+{
+    // 与 native_drawing 一致：Close 之后直接 LineTo 会从上一个 MoveTo 点开始新轮廓
+    if (!contourOpen_) {
+        verbs_.push_back(Verb::MOVE);
+        points_.push_back(lastMove_);
+        contourOpen_ = true;
+    }
+}
+
+void RasterPath::MoveTo(float x, float y)
+{
+    verbs_.push_back(Verb::MOVE);
+    points_.push_back({x, y});
+    lastMove_ = {x, y};
+    contourOpen_ = true;
+}
+
+void RasterPath::LineTo(float x, float y)
+{
+    EnsureContour();
+    verbs_.push_back(Verb::LINE);
+    points_.push_back({x, y});
+}
+
+void RasterPath::QuadTo(float cx, float cy, float x, float y)
+{
+    EnsureContour();
+    verbs_.push_back(Verb::QUAD);
+    points_.push_back({cx, cy});
+    points_.push_back({x, y});
+}
+
+void RasterPath::Close()
+{
+    if (contourOpen_) {
+        verbs_.push_back(Verb::CLOSE);
+        contourOpen_ = false;
+    }
+}
+
+void RasterPath::AddRect(float left, float top, float right, float bottom)
+{
+    MoveTo(left, top);
+    LineTo(right, top);
+    LineTo(right, bottom);
+    LineTo(left, bottom);
+    Close();
+}
+
+void RasterPath::AddCircle(float cx, float cy, float radius)
+{
+    AddArc(cx - radius, cy - radius, cx + radius, cy + radius, 0.0f, 360.0f);
+    Close();
+}
+
+void RasterPath::AddArc(float left, float top, float right, float bottom, float startDeg, float sweepDeg)
+{
+    const float cx = (left + right) * 0.5f;
+    const float cy = (top + bottom) * 0.5f;
+    const float rx = (right - left) * 0.5f;
+    const float ry = (bottom - top) * 0.5f;
+    verbs_.push_back(Verb::ARC);
+    points_.push_back({cx, cy});
+    points_.push_back({rx, ry});
+    points_.push_back({startDeg, sweepDeg});
+    const float start = startDeg * PI_F / 180.0f;
+    lastMove_ = {cx + std::cos(start) * rx, cy + std::sin(start) * ry};
+    contourOpen_ = true;
+}
+
+void RasterPath::AddPolyline(const RasterPoint* points, size_t count, bool close)
+{
+    if (!points || count == 0) {
+        return;
+    }
+    MoveTo(points[0].x, points[0].y);
+    for (size_t i = 1; i < count; i++) {
+        LineTo(points[i].x, points[i].y);
+    }
+    if (close) {
+        Close();
+    }
+}
+
+void RasterPath::Reset()
+{
+    verbs_.clear();
+    points_.clear();
+    lastMove_ = {0.0f, 0.0f};
+    contourOpen_ = false;
+    fillRule_ = RasterFillRule::NON_ZERO;
+}
+
+void RasterPath::Flatten(const RasterMatrix& matrix, float tolerance, std::vector<Contour>* out) const
+{
+    if (!out) {
+        return;
+    }
+    tolerance = std::max(tolerance, 0.01f);
+    const float scale = matrix.MaxScale();
+    Contour current;
+    RasterPoint last = {0.0f, 0.0f};  // 模型坐标下的当前点
+    auto flush = [&]() {
+        if (!current.points.empty()) {
+            out->push_back(std::move(current));
+        }
+        current = Contour();
+    };
+
+    size_t p = 0;
+    for (Verb verb : verbs_) {
+        switch (verb) {
+            case Verb::MOVE:
+                flush();
+                last = points_[p++];
+                current.points.push_back(matrix.Map(last.x, last.y));
+                break;
+            case Verb::LINE:
+                last = points_[p++];
+                current.points.push_back(matrix.Map(last.x, last.y));
+                break;
+            case Verb::QUAD: {
+                const RasterPoint c = points_[p++];
+                const RasterPoint e = points_[p++];
+                // 二次曲线 n 段均匀细分的最大弦高为 |p0 - 2c + p2| / (4n²)
+                const float ddx = last.x - 2.0f * c.x + e.x;
+                const float ddy = last.y - 2.0f * c.y + e.y;
+                const float dd = std::hypot(ddx, ddy) * scale;
+                int n = static_cast<int>(std::ceil(std::sqrt(dd / (4.0f * tolerance))));
+                n = std::max(1, std::min(n, MAX_CURVE_SEGMENTS));
+                for (int i = 1; i <= n; i++) {
+                    const float t = static_cast<float>(i) / n;
+                    const float u = 1.0f - t;
+                    const float x = u * u * last.x + 2.0f * u * t * c.x + t * t * e.x;
+                    const float y = u * u * last.y + 2.0f * u * t * c.y + t * t * e.y;
+                    current.points.push_back(matrix.Map(x, y));
+                }
+                last = e;
+                break;
+            }
+            case Verb::ARC: {
+                const RasterPoint center = points_[p++];
+                const RasterPoint radii = points_[p++];
+                const RasterPoint angles = points_[p++];
+                flush();
+                const bool full = std::fabs(angles.y) >= 360.0f;
+                const float start = angles.x * PI_F / 180.0f;
+                const float sweep = (full ? (angles.y > 0 ? 360.0f : -360.0f) : angles.y) * PI_F / 180.0f;
+                // 弦高误差 r(1 - cos(θ/2)) <= tolerance
+                const float r = std::max(std::fabs(radii.x), std::fabs(radii.y)) * scale;
+                float step = (r > tolerance) ? 2.0f * std::acos(1.0f - tolerance / r) : PI_F * 0.5f;
+                step = std::max(step, 1e-4f);
+                int n = static_cast<int>(std::ceil(std::fabs(sweep) / step));
+                n = std::max(full ? 8 : 1, std::min(n, MAX_CURVE_SEGMENTS));
+                const int count = full ? n : n + 1;  // 整圆不重复终点
+                for (int i = 0; i < count; i++) {
+                    const float angle = start + sweep * static_cast<float>(i) / n;
+                    last = {center.x + std::cos(angle) * radii.x, center.y + std::sin(angle) * radii.y};
+                    current.points.push_back(matrix.Map(last.x, last.y));
+                }
+                if (full) {
+                    current.closed = true;
+                    last = {center.x + std::cos(start) * radii.x, center.y + std::sin(start) * radii.y};
+                }
+                break;
+            }
+            case Verb::CLOSE:
+                current.closed = true;
+                flush();
+                break;
+        }
+    }
+    flush();
+}
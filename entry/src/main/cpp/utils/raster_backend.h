@@ -0,0 +1,220 @@
+//
+// Created on 2026/10/17.
+// 渲染后端接口：引擎与命令只依赖这里的路径/画笔/画布抽象
+//
+// 纯 C++ 实现（只依赖标准库）。设备上由 native_drawing 后端实现，
+// Linux 测试/基准使用 CPU 后端直接渲染到内存。
+//
+
+#ifndef PAPERCUTTING_RASTER_BACKEND_H
+#define PAPERCUTTING_RASTER_BACKEND_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 像素格式：A8 为覆盖率 mask；RGBA8888 为预乘 alpha，内存顺序 R,G,B,A
+enum class RasterFormat {
+    A8 = 0,
+    RGBA8888 = 1
+};
+
+enum class RasterBlend {
+    SRC_OVER = 0,
+    CLEAR = 1  // 按覆盖率清除目标（destination-out 语义）
+};
+
+enum class RasterClipOp {
+    INTERSECT = 0,
+    DIFFERENCE = 1
+};
+
+// 填充规则（与 native_drawing 的 WINDING / EVEN_ODD 对应）
+enum class RasterFillRule {
+    NON_ZERO = 0,
+    EVEN_ODD = 1
+};
+
+enum class RasterPaintStyle {
+    FILL = 0,
+    STROKE = 1
+};
+
+enum class RasterLineCap {
+    BUTT = 0,
+    ROUND = 1,
+    SQUARE = 2
+};
+
+enum class RasterLineJoin {
+    MITER = 0,
+    ROUND = 1,
+    BEVEL = 2
+};
+
+// 默认值与 native_drawing 的画刷/画笔一致（不抗锯齿、BUTT 端点、MITER 连接）
+struct RasterPaint {
+    RasterPaintStyle style = RasterPaintStyle::FILL;
+    uint32_t color = 0xFF000000;  // ARGB（非预乘）
+    RasterBlend blend = RasterBlend::SRC_OVER;
+    bool antiAlias = false;
+    float strokeWidth = 0.0f;
+    RasterLineCap cap = RasterLineCap::BUTT;
+    RasterLineJoin join = RasterLineJoin::MITER;
+};
+
+struct RasterPoint {
+    float x;
+    float y;
+};
+
+// 整数像素矩形，右/下为开区间
+struct RasterIRect {
+    int left = 0;
+    int top = 0;
+    int right = 0;
+    int bottom = 0;
+
+    bool IsEmpty() const { return left >= right || top >= bottom; }
+    bool Intersects(const RasterIRect& other) const
+    {
+        return left < other.right && other.left < right && top < other.bottom && other.top < bottom;
+    }
+    // 空矩形不参与合并
+    void Union(const RasterIRect& other)
+    {
+        if (other.IsEmpty()) {
+            return;
+        }
+        if (IsEmpty()) {
+            *this = other;
+            return;
+        }
+        left = std::min(left, other.left);
+        top = std::min(top, other.top);
+        right = std::max(right, other.right);
+        bottom = std::max(bottom, other.bottom);
+    }
+    void Intersect(const RasterIRect& other)
+    {
+        left = std::max(left, other.left);
+        top = std::max(top, other.top);
+        right = std::min(right, other.right);
+        bottom = std::min(bottom, other.bottom);
+    }
+};
+
+// 仿射变换：x' = a*x + c*y + tx，y' = b*x + d*y + ty
+struct RasterMatrix {
+    float a = 1.0f;
+    float b = 0.0f;
+    float c = 0.0f;
+    float d = 1.0f;
+    float tx = 0.0f;
+    float ty = 0.0f;
+
+    RasterPoint Map(float x, float y) const { return {a * x + c * y + tx, b * x + d * y + ty}; }
+    // this * other（先应用 other）
+    RasterMatrix Concat(const RasterMatrix& other) const;
+    bool Invert(RasterMatrix* out) const;
+    // 各向同性近似缩放（用于曲线展平精度与描边宽度）
+    float MaxScale() const;
+};
+
+// 与后端无关的路径：只记录动词与参数，由各后端在绘制时转换/展平
+class RasterPath {
+public:
+    enum class Verb : uint8_t {
+        MOVE = 0,
+        LINE = 1,
+        QUAD = 2,
+        ARC = 3,   // 3 个参数点：圆心、半径(rx, ry)、(起始角, 扫过角)，角度为度
+        CLOSE = 4
+    };
+
+    // 展平后的一条轮廓（设备坐标）
+    struct Contour {
+        std::vector<RasterPoint> points;
+        bool closed = false;
+    };
+
+    void MoveTo(float x, float y);
+    void LineTo(float x, float y);
+    void QuadTo(float cx, float cy, float x, float y);
+    void Close();
+    void AddRect(float left, float top, float right, float bottom);
+    void AddCircle(float cx, float cy, float radius);
+    // 与 native_drawing 一致：圆弧总是开始一条新轮廓（扫过 360 度时为完整椭圆）
+    void AddArc(float left, float top, float right, float bottom, float startDeg, float sweepDeg);
+    // 折线：MoveTo 第一个点，其余 LineTo
+    void AddPolyline(const RasterPoint* points, size_t count, bool close);
+
+    void Reset();
+    bool IsEmpty() const { return verbs_.empty(); }
+    void SetFillRule(RasterFillRule rule) { fillRule_ = rule; }
+    RasterFillRule GetFillRule() const { return fillRule_; }
+    const std::vector<Verb>& Verbs() const { return verbs_; }
+    const std::vector<RasterPoint>& Points() const { return points_; }
+
+    // 按 matrix 变换并展平为折线，tolerance 为设备像素下的最大弦高误差
+    void Flatten(const RasterMatrix& matrix, float tolerance, std::vector<Contour>* out) const;
+
+private:
+    void EnsureContour();
+
+    std::vector<Verb> verbs_;
+    std::vector<RasterPoint> points_;
+    RasterPoint lastMove_ = {0.0f, 0.0f};
+    bool contourOpen_ = false;
+    RasterFillRule fillRule_ = RasterFillRule::NON_ZERO;
+};
+
+class RasterBitmap {
+public:
+    virtual ~RasterBitmap() = default;
+    virtual int GetWidth() const = 0;
+    virtual int GetHeight() const = 0;
+    virtual RasterFormat GetFormat() const = 0;
+    // 像素按行紧密排列（A8 每像素 1 字节，RGBA8888 每像素 4 字节）
+    virtual void* GetPixels() = 0;
+    const void* GetPixels() const { return const_cast<RasterBitmap*>(this)->GetPixels(); }
+};
+
+// 画布状态（变换 + 裁剪）由 Save/Restore 成对管理
+class RasterCanvas {
+public:
+    virtual ~RasterCanvas() = default;
+    virtual int GetWidth() const = 0;
+    virtual int GetHeight() const = 0;
+
+    virtual void Save() = 0;
+    virtual void Restore() = 0;
+    virtual void Translate(float dx, float dy) = 0;
+    virtual void Scale(float sx, float sy) = 0;
+    virtual void Rotate(float degrees) = 0;  // 绕当前原点
+    virtual void ClipPath(const RasterPath& path, RasterClipOp op, bool antiAlias) = 0;
+
+    // 用 color 覆盖当前裁剪区域（不混合）
+    virtual void Clear(uint32_t color) = 0;
+    virtual void DrawPath(const RasterPath& path, const RasterPaint& paint) = 0;
+    virtual void DrawRect(float left, float top, float right, float bottom, const RasterPaint& paint) = 0;
+    // A8 位图按 paint.color 着色；RGBA 位图只取 paint 的不透明度。paint 为空时按不透明白色/原色处理
+    virtual void DrawBitmap(const RasterBitmap& bitmap, float left, float top, const RasterPaint* paint) = 0;
+    // 把位图的 src 区域缩放到 dst 区域；linear 为 true 时双线性采样
+    virtual void DrawBitmapRect(const RasterBitmap& bitmap, const float src[4], const float dst[4],
+                                const RasterPaint* paint, bool linear) = 0;
+};
+
+// 位图与画布的工厂：同一后端创建的位图只能交给同一后端的画布使用
+class RasterBackend {
+public:
+    virtual ~RasterBackend() = default;
+    virtual const char* GetName() const = 0;
+    virtual std::unique_ptr<RasterBitmap> CreateBitmap(int width, int height, RasterFormat format) = 0;
+    // 画布绑定到位图（不持有），位图必须比画布活得久
+    virtual std::unique_ptr<RasterCanvas> CreateCanvas(RasterBitmap* bitmap) = 0;
+};
+
+#endif // PAPERCUTTING_RASTER_BACKEND_H
@@ -0,0 +1,548 @@
+//
+// Created on 2026/10/17.
+// CPU 渲染后端实现
+//
+
+#include "raster_backend_cpu.h"
+#include "coverage_span.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace {
+constexpr float PI_F = 3.14159265358979f;
+constexpr float CURVE_TOLERANCE = 0.25f;  // 曲线展平的最大弦高（设备像素）
+constexpr float MITER_LIMIT = 4.0f;        // 与 native_drawing 默认值一致
+
+inline uint8_t ToByte(float value)
+{
+    return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, value)) + 0.5f);
+}
+
+// 所有描边片段统一为正向（顺时针面积为正），非零环绕填充后即为它们的并集
+void AppendPolygon(std::vector<RasterPath::Contour>* out, std::vector<RasterPoint> points)
+{
+    float area = 0.0f;
+    for (size_t i = 0; i < points.size(); i++) {
+        const RasterPoint& a = points[i];
+        const RasterPoint& b = points[(i + 1) % points.size()];
+        area += a.x * b.y - b.x * a.y;
+    }
+    if (area < 0.0f) {
+        std::reverse(points.begin(), points.end());
+    }
+    RasterPath::Contour contour;
+    contour.points = std::move(points);
+    contour.closed = true;
+    out->push_back(std::move(contour));
+}
+
+void AppendDisc(std::vector<RasterPath::Contour>* out, RasterPoint center, float radius)
+{
+    const float step = (radius > CURVE_TOLERANCE) ? 2.0f * std::acos(1.0f - CURVE_TOLERANCE / radius) : PI_F * 0.5f;
+    const int n = std::max(8, static_cast<int>(std::ceil(2.0f * PI_F / step)));
+    std::vector<RasterPoint> points(n);
+    for (int i = 0; i < n; i++) {
+        const float angle = 2.0f * PI_F * i / n;
+        points[i] = {center.x + std::cos(angle) * radius, center.y + std::sin(angle) * radius};
+    }
+    AppendPolygon(out, std::move(points));
+}
+
+// 描边展开为“线段矩形 + 连接 + 端点”多边形集合（设备坐标）
+void StrokeContours(const std::vector<RasterPath::Contour>& contours, float width, RasterLineCap cap,
+                    RasterLineJoin join, std::vector<RasterPath::Contour>* out)
+{
+    const float hw = width * 0.5f;
+    for (const auto& contour : contours) {
+        std::vector<RasterPoint> pts;
+        pts.reserve(contour.points.size());
+        for (const RasterPoint& p : contour.points) {
+            if (pts.empty() || std::fabs(p.x - pts.back().x) > 1e-4f || std::fabs(p.y - pts.back().y) > 1e-4f) {
+                pts.push_back(p);
+            }
+        }
+        if (contour.closed && pts.size() > 1 && std::fabs(pts.front().x - pts.back().x) <= 1e-4f &&
+            std::fabs(pts.front().y - pts.back().y) <= 1e-4f) {
+            pts.pop_back();
+        }
+        const size_t n = pts.size();
+        if (n == 0) {
+            continue;
+        }
+        if (n == 1) {
+            if (cap == RasterLineCap::ROUND) {
+                AppendDisc(out, pts[0], hw);
+            } else if (cap == RasterLineCap::SQUARE) {
+                const RasterPoint p = pts[0];
+                AppendPolygon(out, {{p.x - hw, p.y - hw}, {p.x + hw, p.y - hw}, {p.x + hw, p.y + hw},
+                                    {p.x - hw, p.y + hw}});
+            }
+            continue;
+        }
+        const bool closed = contour.closed && n > 2;
+        const size_t segments = closed ? n : n - 1;
+        auto direction = [&](size_t i) {
+            const RasterPoint& a = pts[i % n];
+            const RasterPoint& b = pts[(i + 1) % n];
+            const float len = std::hypot(b.x - a.x, b.y - a.y);
+            return RasterPoint{(b.x - a.x) / len, (b.y - a.y) / len};
+        };
+        for (size_t i = 0; i < segments; i++) {
+            RasterPoint a = pts[i];
+            RasterPoint b = pts[(i + 1) % n];
+            const RasterPoint d = direction(i);
+            if (!closed && cap == RasterLineCap::SQUARE) {
+                if (i == 0) {
+                    a = {a.x - d.x * hw, a.y - d.y * hw};
+                }
+                if (i + 1 == segments) {
+                    b = {b.x + d.x * hw, b.y + d.y * hw};
+                }
+            }
+            const RasterPoint nrm = {-d.y * hw, d.x * hw};
+            AppendPolygon(out, {{a.x + nrm.x, a.y + nrm.y}, {b.x + nrm.x, b.y + nrm.y}, {b.x - nrm.x, b.y - nrm.y},
+                                {a.x - nrm.x, a.y - nrm.y}});
+        }
+        const size_t firstJoin = closed ? 0 : 1;
+        const size_t lastJoin = closed ? n : n - 1;
+        for (size_t i = firstJoin; i < lastJoin; i++) {
+            const RasterPoint v = pts[i];
+            const RasterPoint d0 = direction(i + n - 1);
+            const RasterPoint d1 = direction(i);
+            const float cross = d0.x * d1.y - d0.y * d1.x;
+            const float dot = d0.x * d1.x + d0.y * d1.y;
+            if (std::fabs(cross) < 1e-6f && dot > 0.0f) {
+                continue;  // 共线，无需连接
+            }
+            if (join == RasterLineJoin::ROUND) {
+                AppendDisc(out, v, hw);
+                continue;
+            }
+            // 外侧在转向的反方向
+            const float side = (cross > 0.0f) ? -1.0f : 1.0f;
+            const RasterPoint n0 = {-d0.y * side, d0.x * side};
+            const RasterPoint n1 = {-d1.y * side, d1.x * side};
+            const RasterPoint p0 = {v.x + n0.x * hw, v.y + n0.y * hw};
+            const RasterPoint p1 = {v.x + n1.x * hw, v.y + n1.y * hw};
+            const float mx = n0.x + n1.x;
+            const float my = n0.y + n1.y;
+            const float mlen = std::hypot(mx, my);
+            const float cosHalf = (mlen > 1e-6f) ? (mx * n0.x + my * n0.y) / mlen : 0.0f;
+            if (join == RasterLineJoin::MITER && cosHalf > 1.0f / MITER_LIMIT) {
+                const float reach = hw / cosHalf;
+                AppendPolygon(out, {v, p0, {v.x + mx / mlen * reach, v.y + my / mlen * reach}, p1});
+            } else {
+                AppendPolygon(out, {v, p0, p1});
+            }
+        }
+        if (!closed && cap == RasterLineCap::ROUND) {
+            AppendDisc(out, pts.front(), hw);
+            AppendDisc(out, pts.back(), hw);
+        }
+    }
+}
+
+struct Rgba {
+    float r;
+    float g;
+    float b;
+    float a;  // 预乘，0..255
+};
+
+inline Rgba PremulColor(uint32_t color, float opacity)
+{
+    const float a = ((color >> 24) & 0xFF) * opacity / 255.0f;
+    return {((color >> 16) & 0xFF) * a, ((color >> 8) & 0xFF) * a, (color & 0xFF) * a, 255.0f * a};
+}
+} // namespace
+
+CpuRasterBitmap::CpuRasterBitmap(int width, int height, RasterFormat format)
+    : width_(width), height_(height), format_(format),
+      pixels_(static_cast<size_t>(width) * static_cast<size_t>(height) * (format == RasterFormat::A8 ? 1 : 4), 0)
+{
+}
+
+CpuRasterCanvas::CpuRasterCanvas(CpuRasterBitmap* target) : target_(target)
+{
+    state_.clipRight = target_->GetWidth();
+    state_.clipBottom = target_->GetHeight();
+}
+
+void CpuRasterCanvas::Save()
+{
+    stack_.push_back(state_);
+}
+
+void CpuRasterCanvas::Restore()
+{
+    if (!stack_.empty()) {
+        state_ = std::move(stack_.back());
+        stack_.pop_back();
+    }
+}
+
+void CpuRasterCanvas::Translate(float dx, float dy)
+{
+    RasterMatrix m;
+    m.tx = dx;
+    m.ty = dy;
+    state_.matrix = state_.matrix.Concat(m);
+}
+
+void CpuRasterCanvas::Scale(float sx, float sy)
+{
+    RasterMatrix m;
+    m.a = sx;
+    m.d = sy;
+    state_.matrix = state_.matrix.Concat(m);
+}
+
+void CpuRasterCanvas::Rotate(float degrees)
+{
+    const float rad = degrees * PI_F / 180.0f;
+    RasterMatrix m;
+    m.a = std::cos(rad);
+    m.b = std::sin(rad);
+    m.c = -m.b;
+    m.d = m.a;
+    state_.matrix = state_.matrix.Concat(m);
+}
+
+void CpuRasterCanvas::ClipPath(const RasterPath& path, RasterClipOp op, bool antiAlias)
+{
+    const int width = GetWidth();
+    const int height = GetHeight();
+    std::vector<RasterPath::Contour> contours;
+    path.Flatten(state_.matrix, CURVE_TOLERANCE, &contours);
+
+    auto mask = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(width) * height, 0);
+    const std::vector<uint8_t>* previous = state_.clipMask.get();
+    if (op == RasterClipOp::INTERSECT) {
+        int left = INT_MAX;
+        int top = INT_MAX;
+        int right = INT_MIN;
+        int bottom = INT_MIN;
+        Rasterize(contours, path.GetFillRule(), antiAlias, [&](int y, int x0, int x1, const uint8_t* coverage) {
+            uint8_t* row = mask->data() + static_cast<size_t>(y) * width;
+            if (previous) {
+                CoverageSpan::MultiplyA8(row + x0, coverage, previous->data() + static_cast<size_t>(y) * width + x0,
+                                         x1 - x0);
+            } else {
+                std::memcpy(row + x0, coverage, x1 - x0);
+            }
+            left = std::min(left, x0);
+            right = std::max(right, x1);
+            top = std::min(top, y);
+            bottom = std::max(bottom, y + 1);
+        });
+        if (left >= right) {
+            left = right = top = bottom = 0;
+        }
+        state_.clipLeft = left;
+        state_.clipTop = top;
+        state_.clipRight = right;
+        state_.clipBottom = bottom;
+    } else {
+        for (int y = state_.clipTop; y < state_.clipBottom; y++) {
+            uint8_t* row = mask->data() + static_cast<size_t>(y) * width;
+            if (previous) {
+                std::memcpy(row + state_.clipLeft, previous->data() + static_cast<size_t>(y) * width + state_.clipLeft,
+                            state_.clipRight - state_.clipLeft);
+            } else {
+                std::memset(row + state_.clipLeft, 0xFF, state_.clipRight - state_.clipLeft);
+            }
+        }
+        Rasterize(contours, path.GetFillRule(), antiAlias, [&](int y, int x0, int x1, const uint8_t* coverage) {
+            CoverageSpan::ClearA8(mask->data() + static_cast<size_t>(y) * width + x0, coverage, x1 - x0);
+        });
+    }
+    state_.clipMask = std::move(mask);
+}
+
+void CpuRasterCanvas::Clear(uint32_t color)
+{
+    const int width = GetWidth();
+    const bool a8 = target_->GetFormat() == RasterFormat::A8;
+    const Rgba c = PremulColor(color, 1.0f);
+    const uint8_t value[4] = {ToByte(c.r), ToByte(c.g), ToByte(c.b), ToByte(c.a)};
+    uint8_t* pixels = static_cast<uint8_t*>(target_->GetPixels());
+    const uint8_t* mask = state_.clipMask ? state_.clipMask->data() : nullptr;
+    for (int y = state_.clipTop; y < state_.clipBottom; y++) {
+        const size_t rowStart = static_cast<size_t>(y) * width;
+        if (a8 && !mask) {
+            std::memset(pixels + rowStart + state_.clipLeft, value[3], state_.clipRight - state_.clipLeft);
+            continue;
+        }
+        for (int x = state_.clipLeft; x < state_.clipRight; x++) {
+            const float cov = mask ? mask[rowStart + x] / 255.0f : 1.0f;
+            if (a8) {
+                uint8_t& d = pixels[rowStart + x];
+                d = ToByte(d + (value[3] - d) * cov);
+                continue;
+            }
+            uint8_t* d = pixels + (rowStart + x) * 4;
+            for (int k = 0; k < 4; k++) {
+                d[k] = mask ? ToByte(d[k] + (value[k] - d[k]) * cov) : value[k];
+            }
+        }
+    }
+}
+
+void CpuRasterCanvas::BlendRow(int y, int x0, int x1, const uint8_t* coverage, const RasterPaint& paint)
+{
+    const int width = GetWidth();
+    const size_t rowStart = static_cast<size_t>(y) * width;
+    const size_t count = static_cast<size_t>(x1 - x0);
+    if (state_.clipMask) {
+        // 覆盖率先乘裁剪 mask
+        if (rowScratch_.size() < count) {
+            rowScratch_.resize(count);
+        }
+        CoverageSpan::MultiplyA8(rowScratch_.data(), coverage, state_.clipMask->data() + rowStart + x0, count);
+        coverage = rowScratch_.data();
+    }
+    const bool clear = paint.blend == RasterBlend::CLEAR;
+    uint8_t* pixels = static_cast<uint8_t*>(target_->GetPixels());
+    if (target_->GetFormat() == RasterFormat::A8) {
+        uint8_t* dst = pixels + rowStart + x0;
+        if (clear) {
+            CoverageSpan::ClearA8(dst, coverage, count);
+        } else {
+            CoverageSpan::SrcOverA8(dst, coverage, static_cast<uint8_t>(paint.color >> 24), count);
+        }
+        return;
+    }
+    const Rgba src = PremulColor(paint.color, 1.0f);
+    const float srcAlpha = src.a / 255.0f;
+    uint8_t* dst = pixels + (rowStart + x0) * 4;
+    for (size_t i = 0; i < count; i++) {
+        if (coverage[i] == 0) {
+            continue;
+        }
+        const float c = coverage[i] / 255.0f;
+        uint8_t* d = dst + i * 4;
+        if (clear) {
+            for (int k = 0; k < 4; k++) {
+                d[k] = ToByte(d[k] * (1.0f - c));
+            }
+        } else {
+            const float keep = 1.0f - srcAlpha * c;
+            d[0] = ToByte(src.r * c + d[0] * keep);
+            d[1] = ToByte(src.g * c + d[1] * keep);
+            d[2] = ToByte(src.b * c + d[2] * keep);
+            d[3] = ToByte(src.a * c + d[3] * keep);
+        }
+    }
+}
+
+void CpuRasterCanvas::FillContours(const std::vector<RasterPath::Contour>& contours, RasterFillRule rule,
+                                   const RasterPaint& paint)
+{
+    if (state_.clipLeft >= state_.clipRight || state_.clipTop >= state_.clipBottom) {
+        return;
+    }
+    Rasterize(contours, rule, paint.antiAlias, [&](int y, int x0, int x1, const uint8_t* coverage) {
+        BlendRow(y, x0, x1, coverage, paint);
+    });
+}
+
+void CpuRasterCanvas::Rasterize(const std::vector<RasterPath::Contour>& contours, RasterFillRule rule,
+                                bool antiAlias, const ScanlineFiller::SpanSink& sink)
+{
+    // 抗锯齿用解析面积覆盖率（边缘精确）；不抗锯齿按像素中心采样
+    if (antiAlias) {
+        rasterizer_.Begin(state_.clipLeft, state_.clipTop, state_.clipRight, state_.clipBottom);
+        rasterizer_.AddContours(contours);
+        rasterizer_.Fill(rule, sink);
+        return;
+    }
+    filler_.Begin(state_.clipLeft, state_.clipTop, state_.clipRight, state_.clipBottom);
+    filler_.AddContours(contours);
+    filler_.Fill(rule, false, sink);
+}
+
+void CpuRasterCanvas::DrawPath(const RasterPath& path, const RasterPaint& paint)
+{
+    std::vector<RasterPath::Contour> contours;
+    path.Flatten(state_.matrix, CURVE_TOLERANCE, &contours);
+    if (paint.style == RasterPaintStyle::STROKE) {
+        // 在设备坐标中展开描边（宽度按变换的最大缩放换算）；宽度 0 为 1 像素细线
+        const float width = paint.strokeWidth > 0.0f ? paint.strokeWidth * state_.matrix.MaxScale() : 1.0f;
+        std::vector<RasterPath::Contour> outline;
+        StrokeContours(contours, width, paint.cap, paint.join, &outline);
+        FillContours(outline, RasterFillRule::NON_ZERO, paint);  // 描边片段都是正向，非零规则即并集
+        return;
+    }
+    FillContours(contours, path.GetFillRule(), paint);
+}
+
+void CpuRasterCanvas::DrawRect(float left, float top, float right, float bottom, const RasterPaint& paint)
+{
+    RasterPath path;
+    path.AddRect(left, top, right, bottom);
+    DrawPath(path, paint);
+}
+
+void CpuRasterCanvas::DrawBitmap(const RasterBitmap& bitmap, float left, float top, const RasterPaint* paint)
+{
+    RasterMatrix offset;
+    offset.tx = left;
+    offset.ty = top;
+    const float src[4] = {0.0f, 0.0f, static_cast<float>(bitmap.GetWidth()), static_cast<float>(bitmap.GetHeight())};
+    DrawBitmapMatrix(bitmap, state_.matrix.Concat(offset), src, paint, false);
+}
+
+void CpuRasterCanvas::DrawBitmapRect(const RasterBitmap& bitmap, const float src[4], const float dst[4],
+                                     const RasterPaint* paint, bool linear)
+{
+    const float srcW = src[2] - src[0];
+    const float srcH = src[3] - src[1];
+    if (srcW <= 0.0f || srcH <= 0.0f) {
+        return;
+    }
+    // 位图坐标 -> dst：translate(dst) * scale(dst/src) * translate(-src)
+    RasterMatrix map;
+    map.a = (dst[2] - dst[0]) / srcW;
+    map.d = (dst[3] - dst[1]) / srcH;
+    map.tx = dst[0] - src[0] * map.a;
+    map.ty = dst[1] - src[1] * map.d;
+    DrawBitmapMatrix(bitmap, state_.matrix.Concat(map), src, paint, linear);
+}
+
+void CpuRasterCanvas::DrawBitmapMatrix(const RasterBitmap& bitmap, const RasterMatrix& matrix, const float src[4],
+                                       const RasterPaint* paint, bool linear)
+{
+    RasterMatrix inverse;
+    if (!matrix.Invert(&inverse)) {
+        return;
+    }
+    // src 区域四角映射到设备坐标求包围盒
+    float minX = INFINITY;
+    float minY = INFINITY;
+    float maxX = -INFINITY;
+    float maxY = -INFINITY;
+    const float cornersX[4] = {src[0], src[2], src[2], src[0]};
+    const float cornersY[4] = {src[1], src[1], src[3], src[3]};
+    for (int i = 0; i < 4; i++) {
+        const RasterPoint p = matrix.Map(cornersX[i], cornersY[i]);
+        minX = std::min(minX, p.x);
+        maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y);
+        maxY = std::max(maxY, p.y);
+    }
+    const int x0 = std::max(state_.clipLeft, static_cast<int>(std::floor(minX)));
+    const int x1 = std::min(state_.clipRight, static_cast<int>(std::ceil(maxX)));
+    const int y0 = std::max(state_.clipTop, static_cast<int>(std::floor(minY)));
+    const int y1 = std::min(state_.clipBottom, static_cast<int>(std::ceil(maxY)));
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+
+    const auto& source = static_cast<const CpuRasterBitmap&>(bitmap);
+    const uint8_t* srcPixels = static_cast<const uint8_t*>(source.GetPixels());
+    const int srcWidth = source.GetWidth();
+    const bool srcA8 = source.GetFormat() == RasterFormat::A8;
+    // 采样范围限制在 src 区域内（与 strict 约束一致，避免采到相邻像素）
+    const int sx0 = std::max(0, static_cast<int>(std::floor(src[0])));
+    const int sy0 = std::max(0, static_cast<int>(std::floor(src[1])));
+    const int sx1 = std::min(srcWidth, static_cast<int>(std::ceil(src[2]))) - 1;
+    const int sy1 = std::min(source.GetHeight(), static_cast<int>(std::ceil(src[3]))) - 1;
+    if (sx0 > sx1 || sy0 > sy1) {
+        return;
+    }
+    // A8 位图按画笔颜色着色（默认黑色）；RGBA 位图只取画笔不透明度
+    const uint32_t paintColor = paint ? paint->color : 0xFF000000;
+    const Rgba tint = PremulColor(paintColor, 1.0f);
+    const float opacity = ((paintColor >> 24) & 0xFF) / 255.0f;
+
+    auto fetch = [&](int ix, int iy, float out[4]) {
+        ix = std::min(std::max(ix, sx0), sx1);
+        iy = std::min(std::max(iy, sy0), sy1);
+        const size_t index = static_cast<size_t>(iy) * srcWidth + ix;
+        if (srcA8) {
+            const float a = srcPixels[index] / 255.0f;
+            out[0] = tint.r * a;
+            out[1] = tint.g * a;
+            out[2] = tint.b * a;
+            out[3] = tint.a * a;
+        } else {
+            const uint8_t* p = srcPixels + index * 4;
+            for (int k = 0; k < 4; k++) {
+                out[k] = p[k] * opacity;
+            }
+        }
+    };
+
+    const int width = GetWidth();
+    const bool dstA8 = target_->GetFormat() == RasterFormat::A8;
+    uint8_t* pixels = static_cast<uint8_t*>(target_->GetPixels());
+    for (int y = y0; y < y1; y++) {
+        const size_t rowStart = static_cast<size_t>(y) * width;
+        const uint8_t* mask = state_.clipMask ? state_.clipMask->data() + rowStart : nullptr;
+        const float cy = y + 0.5f;
+        float u = inverse.a * (x0 + 0.5f) + inverse.c * cy + inverse.tx;
+        float v = inverse.b * (x0 + 0.5f) + inverse.d * cy + inverse.ty;
+        for (int x = x0; x < x1; x++, u += inverse.a, v += inverse.b) {
+            if (u < src[0] || u >= src[2] || v < src[1] || v >= src[3]) {
+                continue;
+            }
+            const float c = mask ? mask[x] / 255.0f : 1.0f;
+            if (c <= 0.0f) {
+                continue;
+            }
+            float s[4];
+            if (linear) {
+                const float fx = u - 0.5f;
+                const float fy = v - 0.5f;
+                const int ix = static_cast<int>(std::floor(fx));
+                const int iy = static_cast<int>(std::floor(fy));
+                const float tx = fx - ix;
+                const float ty = fy - iy;
+                float p00[4];
+                float p10[4];
+                float p01[4];
+                float p11[4];
+                fetch(ix, iy, p00);
+                fetch(ix + 1, iy, p10);
+                fetch(ix, iy + 1, p01);
+                fetch(ix + 1, iy + 1, p11);
+                for (int k = 0; k < 4; k++) {
+                    const float top = p00[k] + (p10[k] - p00[k]) * tx;
+                    const float bottom = p01[k] + (p11[k] - p01[k]) * tx;
+                    s[k] = top + (bottom - top) * ty;
+                }
+            } else {
+                fetch(static_cast<int>(std::floor(u)), static_cast<int>(std::floor(v)), s);
+            }
+            const float keep = 1.0f - s[3] / 255.0f * c;
+            if (dstA8) {
+                uint8_t& d = pixels[rowStart + x];
+                d = ToByte(s[3] * c + d * keep);
+                continue;
+            }
+            uint8_t* d = pixels + (rowStart + x) * 4;
+            for (int k = 0; k < 4; k++) {
+                d[k] = ToByte(s[k] * c + d[k] * keep);
+            }
+        }
+    }
+}
+
+std::unique_ptr<RasterBitmap> CpuRasterBackend::CreateBitmap(int width, int height, RasterFormat format)
+{
+    if (width <= 0 || height <= 0) {
+        return nullptr;
+    }
+    return std::make_unique<CpuRasterBitmap>(width, height, format);
+}
+
+std::unique_ptr<RasterCanvas> CpuRasterBackend::CreateCanvas(RasterBitmap* bitmap)
+{
+    if (!bitmap) {
+        return nullptr;
+    }
+    return std::make_unique<CpuRasterCanvas>(static_cast<CpuRasterBitmap*>(bitmap));
+}
@@ -0,0 +1,87 @@
+//
+// Created on 2026/10/17.
+// 纯 C++ 的 CPU 渲染后端：位图在进程内存中，可在 Linux 上做测试与基准
+//
+
+#ifndef PAPERCUTTING_RASTER_BACKEND_CPU_H
+#define PAPERCUTTING_RASTER_BACKEND_CPU_H
+
+#include <memory>
+#include <vector>
+#include "coverage_rasterizer.h"
+#include "raster_backend.h"
+#include "scanline_filler.h"
+
+class CpuRasterBitmap : public RasterBitmap {
+public:
+    CpuRasterBitmap(int width, int height, RasterFormat format);
+
+    int GetWidth() const override { return width_; }
+    int GetHeight() const override { return height_; }
+    RasterFormat GetFormat() const override { return format_; }
+    void* GetPixels() override { return pixels_.data(); }
+    const void* GetPixels() const { return pixels_.data(); }
+    int GetBytesPerPixel() const { return format_ == RasterFormat::A8 ? 1 : 4; }
+
+private:
+    int width_;
+    int height_;
+    RasterFormat format_;
+    std::vector<uint8_t> pixels_;
+};
+
+// 裁剪以整幅 A8 覆盖率 mask 表示（写时复制，Save 只复制指针），另记录裁剪包围盒以跳过空行
+class CpuRasterCanvas : public RasterCanvas {
+public:
+    explicit CpuRasterCanvas(CpuRasterBitmap* target);
+
+    int GetWidth() const override { return target_->GetWidth(); }
+    int GetHeight() const override { return target_->GetHeight(); }
+    void Save() override;
+    void Restore() override;
+    void Translate(float dx, float dy) override;
+    void Scale(float sx, float sy) override;
+    void Rotate(float degrees) override;
+    void ClipPath(const RasterPath& path, RasterClipOp op, bool antiAlias) override;
+    void Clear(uint32_t color) override;
+    void DrawPath(const RasterPath& path, const RasterPaint& paint) override;
+    void DrawRect(float left, float top, float right, float bottom, const RasterPaint& paint) override;
+    void DrawBitmap(const RasterBitmap& bitmap, float left, float top, const RasterPaint* paint) override;
+    void DrawBitmapRect(const RasterBitmap& bitmap, const float src[4], const float dst[4], const RasterPaint* paint,
+                        bool linear) override;
+
+private:
+    struct State {
+        RasterMatrix matrix;
+        std::shared_ptr<const std::vector<uint8_t>> clipMask;  // 空表示无 mask（只受 clip 包围盒限制）
+        int clipLeft = 0;
+        int clipTop = 0;
+        int clipRight = 0;
+        int clipBottom = 0;
+    };
+
+    // 把路径（已展平到设备坐标的轮廓）转成覆盖率并按 paint 混合到目标
+    void FillContours(const std::vector<RasterPath::Contour>& contours, RasterFillRule rule, const RasterPaint& paint);
+    void BlendRow(int y, int x0, int x1, const uint8_t* coverage, const RasterPaint& paint);
+    // 在当前裁剪包围盒内扫描转换轮廓，逐行回调覆盖率
+    void Rasterize(const std::vector<RasterPath::Contour>& contours, RasterFillRule rule, bool antiAlias,
+                   const ScanlineFiller::SpanSink& sink);
+    void DrawBitmapMatrix(const RasterBitmap& bitmap, const RasterMatrix& matrix, const float src[4],
+                          const RasterPaint* paint, bool linear);
+
+    CpuRasterBitmap* target_;
+    State state_;
+    std::vector<State> stack_;
+    ScanlineFiller filler_;            // 光栅化缓冲在多次绘制之间复用
+    CoverageRasterizer rasterizer_;
+    std::vector<uint8_t> rowScratch_;  // 覆盖率乘裁剪 mask 的行缓冲
+};
+
+class CpuRasterBackend : public RasterBackend {
+public:
+    const char* GetName() const override { return "cpu"; }
+    std::unique_ptr<RasterBitmap> CreateBitmap(int width, int height, RasterFormat format) override;
+    std::unique_ptr<RasterCanvas> CreateCanvas(RasterBitmap* bitmap) override;
+};
+
+#endif // PAPERCUTTING_RASTER_BACKEND_CPU_H
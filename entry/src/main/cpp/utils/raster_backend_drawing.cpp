@@ -0,0 +1,262 @@
+//
+// Created on 2026/10/17.
+// native_drawing 渲染后端实现
+//
+
+#include "raster_backend_drawing.h"
+#include <native_drawing/drawing_rect.h>
+#include <native_drawing/drawing_sampling_options.h>
+
+namespace {
+OH_Drawing_BlendMode ToNativeBlend(RasterBlend blend)
+{
+    return blend == RasterBlend::CLEAR ? BLEND_MODE_CLEAR : BLEND_MODE_SRC_OVER;
+}
+
+OH_Drawing_PenLineCapStyle ToNativeCap(RasterLineCap cap)
+{
+    switch (cap) {
+        case RasterLineCap::ROUND:
+            return LINE_ROUND_CAP;
+        case RasterLineCap::SQUARE:
+            return LINE_SQUARE_CAP;
+        default:
+            return LINE_FLAT_CAP;
+    }
+}
+
+OH_Drawing_PenLineJoinStyle ToNativeJoin(RasterLineJoin join)
+{
+    switch (join) {
+        case RasterLineJoin::ROUND:
+            return LINE_ROUND_JOIN;
+        case RasterLineJoin::BEVEL:
+            return LINE_BEVEL_JOIN;
+        default:
+            return LINE_MITER_JOIN;
+    }
+}
+
+// 每次绘制时把后端无关的路径转换为 native 路径（代价与动词数成正比，远小于光栅化）
+OH_Drawing_Path* ToNativePath(const RasterPath& path)
+{
+    OH_Drawing_Path* native = OH_Drawing_PathCreate();
+    OH_Drawing_PathSetFillType(native, path.GetFillRule() == RasterFillRule::EVEN_ODD ? PATH_FILL_TYPE_EVEN_ODD
+                                                                                      : PATH_FILL_TYPE_WINDING);
+    const std::vector<RasterPoint>& pts = path.Points();
+    size_t p = 0;
+    for (RasterPath::Verb verb : path.Verbs()) {
+        switch (verb) {
+            case RasterPath::Verb::MOVE:
+                OH_Drawing_PathMoveTo(native, pts[p].x, pts[p].y);
+                p++;
+                break;
+            case RasterPath::Verb::LINE:
+                OH_Drawing_PathLineTo(native, pts[p].x, pts[p].y);
+                p++;
+                break;
+            case RasterPath::Verb::QUAD:
+                OH_Drawing_PathQuadTo(native, pts[p].x, pts[p].y, pts[p + 1].x, pts[p + 1].y);
+                p += 2;
+                break;
+            case RasterPath::Verb::ARC: {
+                const RasterPoint center = pts[p];
+                const RasterPoint radii = pts[p + 1];
+                const RasterPoint angles = pts[p + 2];
+                OH_Drawing_Rect* rect = OH_Drawing_RectCreate(center.x - radii.x, center.y - radii.y,
+                                                              center.x + radii.x, center.y + radii.y);
+                OH_Drawing_PathAddArc(native, rect, angles.x, angles.y);
+                OH_Drawing_RectDestroy(rect);
+                p += 3;
+                break;
+            }
+            case RasterPath::Verb::CLOSE:
+                OH_Drawing_PathClose(native);
+                break;
+        }
+    }
+    return native;
+}
+} // namespace
+
+DrawingRasterBitmap::DrawingRasterBitmap(int width, int height, RasterFormat format)
+    : bitmap_(OH_Drawing_BitmapCreate()), width_(width), height_(height), format_(format)
+{
+    OH_Drawing_BitmapFormat nativeFormat{
+        format == RasterFormat::A8 ? COLOR_FORMAT_ALPHA_8 : COLOR_FORMAT_RGBA_8888, ALPHA_FORMAT_PREMUL};
+    OH_Drawing_BitmapBuild(bitmap_, width, height, &nativeFormat);
+}
+
+DrawingRasterBitmap::~DrawingRasterBitmap()
+{
+    if (bitmap_) {
+        OH_Drawing_BitmapDestroy(bitmap_);
+        bitmap_ = nullptr;
+    }
+}
+
+void* DrawingRasterBitmap::GetPixels()
+{
+    return OH_Drawing_BitmapGetPixels(bitmap_);
+}
+
+DrawingRasterCanvas::DrawingRasterCanvas(OH_Drawing_Canvas* canvas, bool owned)
+    : canvas_(canvas), owned_(owned), brush_(OH_Drawing_BrushCreate()), pen_(OH_Drawing_PenCreate())
+{
+}
+
+DrawingRasterCanvas::~DrawingRasterCanvas()
+{
+    OH_Drawing_PenDestroy(pen_);
+    OH_Drawing_BrushDestroy(brush_);
+    if (owned_ && canvas_) {
+        OH_Drawing_CanvasDestroy(canvas_);
+    }
+    canvas_ = nullptr;
+}
+
+int DrawingRasterCanvas::GetWidth() const
+{
+    return OH_Drawing_CanvasGetWidth(canvas_);
+}
+
+int DrawingRasterCanvas::GetHeight() const
+{
+    return OH_Drawing_CanvasGetHeight(canvas_);
+}
+
+void DrawingRasterCanvas::Save()
+{
+    OH_Drawing_CanvasSave(canvas_);
+}
+
+void DrawingRasterCanvas::Restore()
+{
+    OH_Drawing_CanvasRestore(canvas_);
+}
+
+void DrawingRasterCanvas::Translate(float dx, float dy)
+{
+    OH_Drawing_CanvasTranslate(canvas_, dx, dy);
+}
+
+void DrawingRasterCanvas::Scale(float sx, float sy)
+{
+    OH_Drawing_CanvasScale(canvas_, sx, sy);
+}
+
+void DrawingRasterCanvas::Rotate(float degrees)
+{
+    OH_Drawing_CanvasRotate(canvas_, degrees, 0, 0);
+}
+
+void DrawingRasterCanvas::ClipPath(const RasterPath& path, RasterClipOp op, bool antiAlias)
+{
+    OH_Drawing_Path* native = ToNativePath(path);
+    OH_Drawing_CanvasClipPath(canvas_, native,
+                              op == RasterClipOp::DIFFERENCE ? OH_Drawing_CanvasClipOp::DIFFERENCE
+                                                             : OH_Drawing_CanvasClipOp::INTERSECT,
+                              antiAlias);
+    OH_Drawing_PathDestroy(native);
+}
+
+void DrawingRasterCanvas::Clear(uint32_t color)
+{
+    OH_Drawing_CanvasClear(canvas_, color);
+}
+
+void DrawingRasterCanvas::AttachPaint(const RasterPaint& paint)
+{
+    if (paint.style == RasterPaintStyle::STROKE) {
+        OH_Drawing_PenSetColor(pen_, paint.color);
+        OH_Drawing_PenSetWidth(pen_, paint.strokeWidth);
+        OH_Drawing_PenSetAntiAlias(pen_, paint.antiAlias);
+        OH_Drawing_PenSetBlendMode(pen_, ToNativeBlend(paint.blend));
+        OH_Drawing_PenSetCap(pen_, ToNativeCap(paint.cap));
+        OH_Drawing_PenSetJoin(pen_, ToNativeJoin(paint.join));
+        OH_Drawing_CanvasAttachPen(canvas_, pen_);
+    } else {
+        OH_Drawing_BrushSetColor(brush_, paint.color);
+        OH_Drawing_BrushSetAntiAlias(brush_, paint.antiAlias);
+        OH_Drawing_BrushSetBlendMode(brush_, ToNativeBlend(paint.blend));
+        OH_Drawing_CanvasAttachBrush(canvas_, brush_);
+    }
+}
+
+void DrawingRasterCanvas::DetachPaint(const RasterPaint& paint)
+{
+    if (paint.style == RasterPaintStyle::STROKE) {
+        OH_Drawing_CanvasDetachPen(canvas_);
+    } else {
+        OH_Drawing_CanvasDetachBrush(canvas_);
+    }
+}
+
+void DrawingRasterCanvas::DrawPath(const RasterPath& path, const RasterPaint& paint)
+{
+    OH_Drawing_Path* native = ToNativePath(path);
+    AttachPaint(paint);
+    OH_Drawing_CanvasDrawPath(canvas_, native);
+    DetachPaint(paint);
+    OH_Drawing_PathDestroy(native);
+}
+
+void DrawingRasterCanvas::DrawRect(float left, float top, float right, float bottom, const RasterPaint& paint)
+{
+    OH_Drawing_Rect* rect = OH_Drawing_RectCreate(left, top, right, bottom);
+    AttachPaint(paint);
+    OH_Drawing_CanvasDrawRect(canvas_, rect);
+    DetachPaint(paint);
+    OH_Drawing_RectDestroy(rect);
+}
+
+void DrawingRasterCanvas::DrawBitmap(const RasterBitmap& bitmap, float left, float top, const RasterPaint* paint)
+{
+    // 同一后端约定：位图一定是 DrawingRasterBitmap
+    const auto& native = static_cast<const DrawingRasterBitmap&>(bitmap);
+    if (paint) {
+        AttachPaint(*paint);
+    }
+    OH_Drawing_CanvasDrawBitmap(canvas_, native.GetNative(), left, top);
+    if (paint) {
+        DetachPaint(*paint);
+    }
+}
+
+void DrawingRasterCanvas::DrawBitmapRect(const RasterBitmap& bitmap, const float src[4], const float dst[4],
+                                         const RasterPaint* paint, bool linear)
+{
+    const auto& native = static_cast<const DrawingRasterBitmap&>(bitmap);
+    OH_Drawing_Rect* srcRect = OH_Drawing_RectCreate(src[0], src[1], src[2], src[3]);
+    OH_Drawing_Rect* dstRect = OH_Drawing_RectCreate(dst[0], dst[1], dst[2], dst[3]);
+    OH_Drawing_SamplingOptions* sampling =
+        OH_Drawing_SamplingOptionsCreate(linear ? FILTER_MODE_LINEAR : FILTER_MODE_NEAREST, MIPMAP_MODE_NONE);
+    if (paint) {
+        AttachPaint(*paint);
+    }
+    OH_Drawing_CanvasDrawBitmapRect(canvas_, native.GetNative(), srcRect, dstRect, sampling);
+    if (paint) {
+        DetachPaint(*paint);
+    }
+    OH_Drawing_SamplingOptionsDestroy(sampling);
+    OH_Drawing_RectDestroy(dstRect);
+    OH_Drawing_RectDestroy(srcRect);
+}
+
+std::unique_ptr<RasterBitmap> DrawingRasterBackend::CreateBitmap(int width, int height, RasterFormat format)
+{
+    if (width <= 0 || height <= 0) {
+        return nullptr;
+    }
+    return std::make_unique<DrawingRasterBitmap>(width, height, format);
+}
+
+std::unique_ptr<RasterCanvas> DrawingRasterBackend::CreateCanvas(RasterBitmap* bitmap)
+{
+    if (!bitmap) {
+        return nullptr;
+    }
+    OH_Drawing_Canvas* canvas = OH_Drawing_CanvasCreate();
+    OH_Drawing_CanvasBind(canvas, static_cast<DrawingRasterBitmap*>(bitmap)->GetNative());
+    return std::make_unique<DrawingRasterCanvas>(canvas, true);
+}
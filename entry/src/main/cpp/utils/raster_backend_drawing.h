@@ -0,0 +1,79 @@
+//
+// Created on 2026/10/17.
+// 基于 native_drawing 的渲染后端（设备默认后端）
+//
+
+#ifndef PAPERCUTTING_RASTER_BACKEND_DRAWING_H
+#define PAPERCUTTING_RASTER_BACKEND_DRAWING_H
+
+#include <native_drawing/drawing_bitmap.h>
+#include <native_drawing/drawing_brush.h>
+#include <native_drawing/drawing_canvas.h>
+#include <native_drawing/drawing_path.h>
+#include <native_drawing/drawing_pen.h>
+#include "raster_backend.h"
+
+class DrawingRasterBitmap : public RasterBitmap {
+public:
+    DrawingRasterBitmap(int width, int height, RasterFormat format);
+    ~DrawingRasterBitmap() override;
+
+    DrawingRasterBitmap(const DrawingRasterBitmap&) = delete;
+    DrawingRasterBitmap& operator=(const DrawingRasterBitmap&) = delete;
+
+    int GetWidth() const override { return width_; }
+    int GetHeight() const override { return height_; }
+    RasterFormat GetFormat() const override { return format_; }
+    void* GetPixels() override;
+    using RasterBitmap::GetPixels;
+    OH_Drawing_Bitmap* GetNative() const { return bitmap_; }
+
+private:
+    OH_Drawing_Bitmap* bitmap_;
+    int width_;
+    int height_;
+    RasterFormat format_;
+};
+
+class DrawingRasterCanvas : public RasterCanvas {
+public:
+    // 包装已有的 native 画布（例如 NativeWindowFrame 绑定到 buffer 的画布）；owned 为 true 时析构销毁
+    explicit DrawingRasterCanvas(OH_Drawing_Canvas* canvas, bool owned = false);
+    ~DrawingRasterCanvas() override;
+
+    DrawingRasterCanvas(const DrawingRasterCanvas&) = delete;
+    DrawingRasterCanvas& operator=(const DrawingRasterCanvas&) = delete;
+
+    int GetWidth() const override;
+    int GetHeight() const override;
+    void Save() override;
+    void Restore() override;
+    void Translate(float dx, float dy) override;
+    void Scale(float sx, float sy) override;
+    void Rotate(float degrees) override;
+    void ClipPath(const RasterPath& path, RasterClipOp op, bool antiAlias) override;
+    void Clear(uint32_t color) override;
+    void DrawPath(const RasterPath& path, const RasterPaint& paint) override;
+    void DrawRect(float left, float top, float right, float bottom, const RasterPaint& paint) override;
+    void DrawBitmap(const RasterBitmap& bitmap, float left, float top, const RasterPaint* paint) override;
+    void DrawBitmapRect(const RasterBitmap& bitmap, const float src[4], const float dst[4], const RasterPaint* paint,
+                        bool linear) override;
+
+private:
+    void AttachPaint(const RasterPaint& paint);
+    void DetachPaint(const RasterPaint& paint);
+
+    OH_Drawing_Canvas* canvas_;
+    bool owned_;
+    OH_Drawing_Brush* brush_;
+    OH_Drawing_Pen* pen_;
+};
+
+class DrawingRasterBackend : public RasterBackend {
+public:
+    const char* GetName() const override { return "native_drawing"; }
+    std::unique_ptr<RasterBitmap> CreateBitmap(int width, int height, RasterFormat format) override;
+    std::unique_ptr<RasterCanvas> CreateCanvas(RasterBitmap* bitmap) override;
+};
+
+#endif // PAPERCUTTING_RASTER_BACKEND_DRAWING_H
@@ -0,0 +1,220 @@
+//
+// Created on 2026/10/17.
+// 活动边表扫描线多边形填充实现
+//
+
+#include "scanline_filler.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include "coverage_span.h"
+
+namespace {
+constexpr int FULL_COVERAGE = 256;  // 一个像素被所有子扫描线完整覆盖时的累积值（输出时饱和到 255）
+
+inline bool IsInside(int winding, RasterFillRule rule)
+{
+    return rule == RasterFillRule::EVEN_ODD ? (winding & 1) != 0 : winding != 0;
+}
+} // namespace
+
+void ScanlineFiller::Begin(int clipLeft, int clipTop, int clipRight, int clipBottom)
+{
+    edges_.clear();
+    clipLeft_ = clipLeft;
+    clipTop_ = clipTop;
+    clipRight_ = clipRight;
+    clipBottom_ = clipBottom;
+    minX_ = INFINITY;
+    minY_ = INFINITY;
+    maxX_ = -INFINITY;
+    maxY_ = -INFINITY;
+}
+
+void ScanlineFiller::AddContour(const RasterPoint* points, size_t count)
+{
+    if (!points || count < 2) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        RasterPoint a = points[i];
+        RasterPoint b = points[(i + 1) % count];
+        if (!std::isfinite(a.x) || !std::isfinite(a.y) || !std::isfinite(b.x) || !std::isfinite(b.y)) {
+            continue;
+        }
+        minX_ = std::min(minX_, a.x);
+        maxX_ = std::max(maxX_, a.x);
+        minY_ = std::min(minY_, a.y);
+        maxY_ = std::max(maxY_, a.y);
+        if (a.y == b.y) {
+            continue;
+        }
+        int dir = 1;
+        if (a.y > b.y) {
+            std::swap(a, b);
+            dir = -1;
+        }
+        edges_.push_back({a.x, a.y, b.y, (b.x - a.x) / (b.y - a.y), dir, 0, 0});
+    }
+}
+
+void ScanlineFiller::AddContours(const std::vector<RasterPath::Contour>& contours)
+{
+    for (const auto& contour : contours) {
+        AddContour(contour.points.data(), contour.points.size());
+    }
+}
+
+void ScanlineFiller::SortActive()
+{
+    // 相邻子扫描线之间活动边顺序几乎不变，插入排序接近线性；
+    // 交叉很多（例如自相交的长剪刀路径）时移动次数超出预算就改用 std::sort
+    const size_t budget = active_.size() * 4 + 16;
+    size_t moves = 0;
+    for (size_t i = 1; i < active_.size(); i++) {
+        const ActiveEdge edge = active_[i];
+        size_t j = i;
+        while (j > 0 && active_[j - 1].x > edge.x) {
+            active_[j] = active_[j - 1];
+            --j;
+            if (++moves > budget) {
+                active_[j] = edge;
+                std::sort(active_.begin(), active_.end(),
+                          [](const ActiveEdge& lhs, const ActiveEdge& rhs) { return lhs.x < rhs.x; });
+                return;
+            }
+        }
+        active_[j] = edge;
+    }
+}
+
+void ScanlineFiller::AddSpan(double xa, double xb, int weight, bool antiAlias)
+{
+    xa = std::max(xa - left_, 0.0);
+    xb = std::min(xb - left_, static_cast<double>(width_));
+    if (xb <= xa) {
+        return;
+    }
+    int32_t* delta = delta_.data();
+    if (!antiAlias) {
+        // 像素中心落在跨度内才覆盖
+        const int i0 = static_cast<int>(std::ceil(xa - 0.5));
+        const int i1 = std::min(width_, static_cast<int>(std::ceil(xb - 0.5)));
+        if (i0 < i1) {
+            delta[i0] += 255;
+            delta[i1] -= 255;
+            spanMin_ = std::min(spanMin_, i0);
+            spanMax_ = std::max(spanMax_, i1);
+        }
+        return;
+    }
+    // 两端像素按跨度长度取部分覆盖，中间像素整像素覆盖；全部以差分写入
+    const int ia = static_cast<int>(xa);
+    const int ib = static_cast<int>(xb);
+    if (ia == ib) {
+        const int v = static_cast<int>((xb - xa) * weight + 0.5);
+        delta[ia] += v;
+        delta[ia + 1] -= v;
+    } else {
+        const int a = static_cast<int>((ia + 1 - xa) * weight + 0.5);
+        const int b = static_cast<int>((xb - ib) * weight + 0.5);
+        delta[ia] += a;
+        delta[ia + 1] += weight - a;
+        delta[ib] += b - weight;
+        delta[ib + 1] -= b;
+    }
+    spanMin_ = std::min(spanMin_, ia);
+    spanMax_ = std::max(spanMax_, std::min(width_, ib + 1));
+}
+
+void ScanlineFiller::Fill(RasterFillRule rule, bool antiAlias, const SpanSink& sink)
+{
+    if (edges_.empty()) {
+        return;
+    }
+    const int samples = antiAlias ? AA_SUBSAMPLES : 1;
+    const int weight = FULL_COVERAGE / samples;
+    const int top = std::max(clipTop_, static_cast<int>(std::floor(minY_)));
+    const int bottom = std::min(clipBottom_, static_cast<int>(std::ceil(maxY_)));
+    left_ = std::max(clipLeft_, static_cast<int>(std::floor(minX_)));
+    const int right = std::min(clipRight_, static_cast<int>(std::ceil(maxX_)) + 1);
+    if (top >= bottom || left_ >= right) {
+        return;
+    }
+    width_ = right - left_;
+
+    // 每条边覆盖的子扫描线：采样点 (k + 0.5) / samples 落在 [y0, y1) 内
+    const int kFirst = top * samples;
+    const int kLast = bottom * samples;
+    for (Edge& edge : edges_) {
+        edge.kStart = static_cast<int>(std::ceil(edge.y0 * samples - 0.5f));
+        edge.kEnd = static_cast<int>(std::ceil(edge.y1 * samples - 0.5f));
+    }
+    edges_.erase(std::remove_if(edges_.begin(), edges_.end(),
+                                [&](const Edge& edge) {
+                                    return edge.kStart >= edge.kEnd || edge.kEnd <= kFirst || edge.kStart >= kLast;
+                                }),
+                 edges_.end());
+    std::sort(edges_.begin(), edges_.end(),
+              [](const Edge& lhs, const Edge& rhs) { return lhs.kStart < rhs.kStart; });
+
+    // 差分缓冲在两行之间保持全零（AccumulateDeltas 读完即清零），只有变宽时才扩容
+    if (delta_.size() < static_cast<size_t>(width_) + 2) {
+        delta_.resize(static_cast<size_t>(width_) + 2, 0);
+        coverage_.resize(static_cast<size_t>(width_) + 2, 0);
+    }
+    active_.clear();
+    size_t next = 0;
+    for (int y = top; y < bottom; y++) {
+        if (active_.empty()) {
+            if (next >= edges_.size()) {
+                break;
+            }
+            // 跳过没有活动边的空行
+            y = std::max(y, edges_[next].kStart / samples);
+            if (y >= bottom) {
+                break;
+            }
+        }
+        spanMin_ = INT_MAX;
+        spanMax_ = INT_MIN;
+        for (int s = 0; s < samples; s++) {
+            const int k = y * samples + s;
+            const double sy = (k + 0.5) / samples;
+            active_.erase(std::remove_if(active_.begin(), active_.end(),
+                                         [k](const ActiveEdge& edge) { return edge.kEnd <= k; }),
+                          active_.end());
+            for (; next < edges_.size() && edges_[next].kStart <= k; next++) {
+                const Edge& edge = edges_[next];
+                if (edge.kEnd <= k) {
+                    continue;
+                }
+                active_.push_back({edge.x0 + (sy - edge.y0) * edge.dxdy, static_cast<double>(edge.dxdy) / samples,
+                                   edge.kEnd, edge.dir});
+            }
+            if (active_.empty()) {
+                continue;
+            }
+            SortActive();
+            int winding = 0;
+            double spanStart = 0.0;
+            for (ActiveEdge& edge : active_) {
+                const bool wasInside = IsInside(winding, rule);
+                winding += edge.dir;
+                const bool inside = IsInside(winding, rule);
+                if (!wasInside && inside) {
+                    spanStart = edge.x;
+                } else if (wasInside && !inside) {
+                    AddSpan(spanStart, edge.x, weight, antiAlias);
+                }
+                edge.x += edge.dx;
+            }
+        }
+        if (spanMin_ < spanMax_) {
+            // 多累积一个元素，顺带清零跨度终点处的差分
+            CoverageSpan::AccumulateDeltas(delta_.data() + spanMin_, coverage_.data() + spanMin_,
+                                           static_cast<size_t>(spanMax_ - spanMin_) + 1);
+            sink(y, left_ + spanMin_, left_ + spanMax_, coverage_.data() + spanMin_);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+//
+// Created on 2026/10/17.
+// 活动边表（AET）扫描线多边形填充：非零 / 奇偶规则，逐行输出 8 位覆盖率跨度
+//
+// 边表按起始子扫描线排序，活动边按 x 增量推进，每条子扫描线只处理与之相交的边；
+// 跨度以差分形式累积，整行结束后一次前缀和得到覆盖率（向量化见 coverage_span.h）。
+// 内部缓冲在多次填充之间复用，重复填充不分配内存。
+//
+
+#ifndef PAPERCUTTING_SCANLINE_FILLER_H
+#define PAPERCUTTING_SCANLINE_FILLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "raster_backend.h"
+
+class ScanlineFiller {
+public:
+    // coverage[i] 为像素 (x0 + i, y) 的覆盖率 0..255，只在回调期间有效
+    using SpanSink = std::function<void(int y, int x0, int x1, const uint8_t* coverage)>;
+
+    static constexpr int AA_SUBSAMPLES = 4;  // 抗锯齿时每像素行的子扫描线数（水平方向按精确跨度覆盖）
+
+    // 开始一个新多边形：清空边表并设置裁剪矩形（设备像素，右/下为开区间）
+    void Begin(int clipLeft, int clipTop, int clipRight, int clipBottom);
+    // 追加轮廓（设备坐标，总是隐式闭合）；水平边与非有限坐标被忽略
+    void AddContour(const RasterPoint* points, size_t count);
+    void AddContours(const std::vector<RasterPath::Contour>& contours);
+    // 扫描转换并按行回调。antiAlias 为 false 时按像素中心采样，覆盖率只有 0 / 255
+    void Fill(RasterFillRule rule, bool antiAlias, const SpanSink& sink);
+
+    size_t GetEdgeCount() const { return edges_.size(); }
+
+private:
+    struct Edge {
+        float x0;  // 上端点（y 较小）
+        float y0;
+        float y1;
+        float dxdy;
+        int dir;  // 原始方向：向下为 +1
+        int kStart;  // 覆盖的子扫描线 [kStart, kEnd)
+        int kEnd;
+    };
+    struct ActiveEdge {
+        double x;  // 长边逐行累加，double 避免误差累积
+        double dx;
+        int kEnd;
+        int dir;
+    };
+
+    void SortActive();
+    void AddSpan(double xa, double xb, int weight, bool antiAlias);
+
+    std::vector<Edge> edges_;
+    std::vector<ActiveEdge> active_;
+    std::vector<int32_t> delta_;     // 覆盖率差分，长度为裁剪宽度 + 2
+    std::vector<uint8_t> coverage_;  // 当前行输出
+    int clipLeft_ = 0;
+    int clipTop_ = 0;
+    int clipRight_ = 0;
+    int clipBottom_ = 0;
+    int left_ = 0;  // 当前填充的列范围 [left_, left_ + width_)
+    int width_ = 0;
+    float minX_ = 0.0f;
+    float maxX_ = 0.0f;
+    float minY_ = 0.0f;
+    float maxY_ = 0.0f;
+    int spanMin_ = 0;  // 当前行被触及的差分范围 [spanMin_, spanMax_]
+    int spanMax_ = 0;
+};
+
+#endif // PAPERCUTTING_SCANLINE_FILLER_H
@@ -0,0 +1,286 @@
+//
+// Created on 2026/10/17.
+// 草稿笔迹描边展开实现
+//
+
+#include "stroke_tessellator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr float PI_F = 3.14159265358979f;
+constexpr float POINT_EPSILON = 1e-4f;
+constexpr int MAX_CURVE_SEGMENTS = 4096;
+
+inline bool SamePoint(RasterPoint a, RasterPoint b)
+{
+    return std::fabs(a.x - b.x) <= POINT_EPSILON && std::fabs(a.y - b.y) <= POINT_EPSILON;
+}
+
+inline RasterPoint Direction(RasterPoint a, RasterPoint b)
+{
+    const float len = std::hypot(b.x - a.x, b.y - a.y);
+    return {(b.x - a.x) / len, (b.y - a.y) / len};
+}
+
+// 法线：方向 (1, 0) 对应 (0, 1)
+inline RasterPoint Normal(RasterPoint d)
+{
+    return {-d.y, d.x};
+}
+
+inline RasterPoint Offset(RasterPoint v, RasterPoint n, float distance)
+{
+    return {v.x + n.x * distance, v.y + n.y * distance};
+}
+} // namespace
+
+StrokeTessellator::StrokeTessellator(float width, float tolerance) : tolerance_(std::max(tolerance, 0.01f))
+{
+    Reset(width);
+}
+
+void StrokeTessellator::Reset(float width)
+{
+    width_ = std::max(width, 0.0f);
+    halfWidth_ = width_ * 0.5f;
+    arcStep_ = (halfWidth_ > tolerance_) ? 2.0f * std::acos(1.0f - tolerance_ / halfWidth_) : PI_F * 0.5f;
+    inputs_.clear();
+    center_.clear();
+    run_ = Run();
+    pendingStart_ = JoinEnd();
+    vertices_.clear();
+    pieces_.clear();
+    stableVertices_ = 0;
+    stablePieces_ = 0;
+    tailValid_ = false;
+}
+
+void StrokeTessellator::Append(const RasterPoint* points, size_t count)
+{
+    if (!points) {
+        return;
+    }
+    // 丢弃上次的尾部分片，新定稿的分片接在稳定前缀之后
+    vertices_.resize(stableVertices_);
+    pieces_.resize(stablePieces_);
+    tailValid_ = false;
+    for (size_t i = 0; i < count; i++) {
+        const RasterPoint p = points[i];
+        if (!std::isfinite(p.x) || !std::isfinite(p.y)) {
+            continue;
+        }
+        inputs_.push_back(p);
+        const size_t n = inputs_.size();
+        if (n == 1) {
+            center_.push_back(p);
+            continue;
+        }
+        if (n < 3) {
+            continue;
+        }
+        // 新点使上一段二次曲线（控制点为倒数第二个输入点，终点为两者中点）确定下来
+        const RasterPoint start = center_.back();
+        const RasterPoint c = inputs_[n - 2];
+        const RasterPoint e = {(c.x + p.x) * 0.5f, (c.y + p.y) * 0.5f};
+        // 二次曲线 n 段均匀细分的最大弦高为 |p0 - 2c + p2| / (4n²)
+        const float dd = std::hypot(start.x - 2.0f * c.x + e.x, start.y - 2.0f * c.y + e.y);
+        int segments = static_cast<int>(std::ceil(std::sqrt(dd / (4.0f * tolerance_))));
+        segments = std::max(1, std::min(segments, MAX_CURVE_SEGMENTS));
+        for (int k = 1; k <= segments; k++) {
+            const float t = static_cast<float>(k) / segments;
+            const float u = 1.0f - t;
+            AppendCenter({u * u * start.x + 2.0f * u * t * c.x + t * t * e.x,
+                          u * u * start.y + 2.0f * u * t * c.y + t * t * e.y});
+        }
+    }
+    stableVertices_ = vertices_.size();
+    stablePieces_ = pieces_.size();
+}
+
+void StrokeTessellator::AppendCenter(RasterPoint point)
+{
+    if (!center_.empty() && SamePoint(point, center_.back())) {
+        return;
+    }
+    center_.push_back(point);
+    // 新点确定了上一个顶点的连接；起点半圆在第一条线段出现时确定
+    const size_t n = center_.size();
+    if (n == 2) {
+        StartRun(&run_, center_[0], Direction(center_[0], point), true);
+    } else if (n > 2) {
+        pendingStart_ = Join(&run_, center_[n - 3], center_[n - 2], point, pendingStart_);
+    }
+}
+
+void StrokeTessellator::UpdateTail()
+{
+    if (tailValid_) {
+        return;
+    }
+    tailValid_ = true;
+    vertices_.resize(stableVertices_);
+    pieces_.resize(stablePieces_);
+    const size_t n = center_.size();
+    if (n == 0 || halfWidth_ <= 0.0f) {
+        return;
+    }
+    // 尾部：最后一条定稿线段、指向最后输入点的直线及其连接、终点半圆，在副本上完成
+    const RasterPoint end = inputs_.back();
+    const bool hasTail = !SamePoint(end, center_.back());
+    Run run;
+    if (n == 1) {
+        if (!hasTail) {
+            // 单点：整圆
+            const size_t first = vertices_.size();
+            vertices_.push_back({end.x + halfWidth_, end.y});
+            AppendArc(end, {1.0f, 0.0f}, {0.0f, 1.0f}, 2.0f * PI_F, &vertices_);
+            EndPiece(first);
+            return;
+        }
+        const RasterPoint d = Direction(center_[0], end);
+        StartRun(&run, center_[0], d, true);
+        CloseRun(&run, end, d, true);
+        return;
+    }
+    run = run_;
+    const RasterPoint a = center_[n - 2];
+    const RasterPoint v = center_[n - 1];
+    if (!hasTail) {
+        CloseRun(&run, v, Direction(a, v), true);
+        return;
+    }
+    Join(&run, a, v, end, pendingStart_);
+    CloseRun(&run, end, Direction(v, end), true);
+}
+
+const std::vector<StrokeTessellator::Piece>& StrokeTessellator::GetPieces()
+{
+    UpdateTail();
+    return pieces_;
+}
+
+const std::vector<RasterPoint>& StrokeTessellator::GetVertices()
+{
+    UpdateTail();
+    return vertices_;
+}
+
+void StrokeTessellator::StartRun(Run* run, RasterPoint v, RasterPoint direction, bool cap) const
+{
+    const RasterPoint n = Normal(direction);
+    run->left.assign(1, Offset(v, n, halfWidth_));
+    run->right.assign(1, Offset(v, n, -halfWidth_));
+    run->start.clear();
+    if (cap) {
+        AppendArc(v, {-n.x, -n.y}, {-direction.x, -direction.y}, PI_F, &run->start);
+    }
+}
+
+StrokeTessellator::JoinEnd StrokeTessellator::Join(Run* run, RasterPoint a, RasterPoint v, RasterPoint b,
+                                                   const JoinEnd& previous)
+{
+    JoinEnd join;
+    const RasterPoint d0 = Direction(a, v);
+    const RasterPoint d1 = Direction(v, b);
+    const RasterPoint n0 = Normal(d0);
+    const RasterPoint n1 = Normal(d1);
+    const float cross = d0.x * d1.y - d0.y * d1.x;
+    const float dot = std::min(1.0f, std::max(-1.0f, d0.x * d1.x + d0.y * d1.y));
+    if (std::fabs(cross) < 1e-6f && dot > 0.0f) {
+        // 共线：两侧直接延续
+        join.mitered = true;
+        run->left.push_back(Offset(v, n1, halfWidth_));
+        run->right.push_back(Offset(v, n1, -halfWidth_));
+        return join;
+    }
+    // 向法线侧转弯时法线侧为内侧；外侧从 n0 转到 n1
+    join.innerLeft = cross > 0.0f;
+    const float side = join.innerLeft ? -1.0f : 1.0f;
+    const RasterPoint from = {n0.x * side, n0.y * side};
+    RasterPoint toward = {n1.x * side - from.x * dot, n1.y * side - from.y * dot};
+    const float len = std::hypot(toward.x, toward.y);
+    if (len > 1e-6f) {
+        toward = {toward.x / len, toward.y / len};
+    } else {
+        toward = d0;  // 180° 折返：外侧圆弧绕过前进方向
+    }
+    const float sweep = std::acos(dot);
+
+    // 内侧斜接需要两条线段都还有 halfWidth * tan(θ / 2) 的长度可裁
+    const float trim = (1.0f + dot > 1e-6f) ? halfWidth_ * std::fabs(cross) / (1.0f + dot) : INFINITY;
+    const float usedA = (previous.mitered && previous.innerLeft == join.innerLeft) ? previous.trim : 0.0f;
+    const float lengthA = std::hypot(v.x - a.x, v.y - a.y) - usedA;
+    const float lengthB = std::hypot(b.x - v.x, b.y - v.y);
+    if (trim <= lengthA && trim <= lengthB) {
+        join.mitered = true;
+        join.trim = trim;
+        std::vector<RasterPoint>* inner = join.innerLeft ? &run->left : &run->right;
+        std::vector<RasterPoint>* outer = join.innerLeft ? &run->right : &run->left;
+        const RasterPoint innerPoint = Offset(v, n0, -side * halfWidth_);
+        inner->push_back({innerPoint.x - d0.x * trim, innerPoint.y - d0.y * trim});
+        outer->push_back(Offset(v, from, halfWidth_));
+        AppendArc(v, from, toward, sweep, outer);
+        outer->push_back(Offset(v, n1, side * halfWidth_));
+        return join;
+    }
+    // 无法斜接：平头封闭当前轮廓，外侧扇形单独成片，下一段从平头开始（内侧两段矩形重叠）
+    CloseRun(run, v, d0, false);
+    const size_t first = vertices_.size();
+    vertices_.push_back(v);
+    vertices_.push_back(Offset(v, from, halfWidth_));
+    AppendArc(v, from, toward, sweep, &vertices_);
+    vertices_.push_back(Offset(v, n1, side * halfWidth_));
+    EndPiece(first);
+    StartRun(run, v, d1, false);
+    return join;
+}
+
+void StrokeTessellator::CloseRun(Run* run, RasterPoint v, RasterPoint direction, bool cap)
+{
+    const RasterPoint n = Normal(direction);
+    run->left.push_back(Offset(v, n, halfWidth_));
+    run->right.push_back(Offset(v, n, -halfWidth_));
+    const size_t first = vertices_.size();
+    vertices_.insert(vertices_.end(), run->left.begin(), run->left.end());
+    if (cap) {
+        AppendArc(v, n, direction, PI_F, &vertices_);
+    }
+    vertices_.insert(vertices_.end(), run->right.rbegin(), run->right.rend());
+    vertices_.insert(vertices_.end(), run->start.begin(), run->start.end());
+    EndPiece(first);
+}
+
+void StrokeTessellator::AppendArc(RasterPoint v, RasterPoint from, RasterPoint toward, float sweep,
+                                  std::vector<RasterPoint>* out) const
+{
+    const int segments = std::max(1, static_cast<int>(std::ceil(sweep / arcStep_)));
+    // 逐段旋转 (cos φ, sin φ)，不对每个点求三角函数
+    const float step = sweep / segments;
+    const float cosStep = std::cos(step);
+    const float sinStep = std::sin(step);
+    float c = 1.0f;
+    float s = 0.0f;
+    for (int k = 1; k < segments; k++) {
+        const float nc = c * cosStep - s * sinStep;
+        s = s * cosStep + c * sinStep;
+        c = nc;
+        out->push_back({v.x + (from.x * c + toward.x * s) * halfWidth_, v.y + (from.y * c + toward.y * s) * halfWidth_});
+    }
+}
+
+void StrokeTessellator::EndPiece(size_t first)
+{
+    // 所有多边形统一为正向（与 CPU 后端描边片段一致），非零规则填充即为并集
+    float area = 0.0f;
+    const size_t count = vertices_.size() - first;
+    for (size_t i = 0; i < count; i++) {
+        const RasterPoint& a = vertices_[first + i];
+        const RasterPoint& b = vertices_[first + (i + 1) % count];
+        area += a.x * b.y - b.x * a.y;
+    }
+    if (area < 0.0f) {
+        std::reverse(vertices_.begin() + first, vertices_.end());
+    }
+    pieces_.push_back({static_cast<uint32_t>(first), static_cast<uint32_t>(count)});
+}
@@ -0,0 +1,90 @@
+//
+// Created on 2026/10/17.
+// 草稿笔迹描边展开：把输入折线平滑后展开成带圆角连接、圆头端点的多边形网格
+//
+// 中心线与 CreateSmoothStrokePath 相同（相邻输入点中点之间用二次曲线连接，最后一段直线）。
+// 相邻线段在内侧按两条偏移线的交点斜接、外侧补圆弧，连续斜接的一段中心线展开成一个简单外轮廓
+// （左侧正向 + 终点 + 右侧反向 + 起点，两端为圆头半圆）。转弯过急、线段长度不够斜接时
+// 在该顶点断开：前后两段以平头相接并在外侧补一个扇形，按非零规则求并。
+// 内侧经过顶点回折的单一轮廓在尖点 / 折返处会出现环绕数抵消的空洞，逐段矩形求并则在解析覆盖率下
+// 重复累加边缘像素，这里只在无法斜接的顶点退化为求并。
+// 追加输入点时只有最后一段直线及其连接会变化：已封闭的轮廓保留，只重建尾部；
+// 抬笔时整个对象交给命令缓存，重放不再展平曲线、不再计算偏移与圆弧。
+//
+
+#ifndef PAPERCUTTING_STROKE_TESSELLATOR_H
+#define PAPERCUTTING_STROKE_TESSELLATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "raster_backend.h"
+
+class StrokeTessellator {
+public:
+    // 一个闭合多边形：GetVertices() 中 [first, first + count)。所有多边形同为正向
+    struct Piece {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    StrokeTessellator() = default;
+    // tolerance 为曲线与圆弧展平的最大弦高（与输入点同一坐标系）
+    explicit StrokeTessellator(float width, float tolerance = 0.25f);
+
+    // 清空输入并设置新的线宽
+    void Reset(float width);
+    // 追加输入点（重合点保留，与 CreateSmoothStrokePath 的曲线完全一致）
+    void Append(const RasterPoint* points, size_t count);
+    void Append(RasterPoint point) { Append(&point, 1); }
+
+    // 展开结果；没有输入点时为空，只有 1 个点时为圆。尾部在两次 Append 之间只重建一次
+    const std::vector<Piece>& GetPieces();
+    const std::vector<RasterPoint>& GetVertices();
+
+    float GetWidth() const { return width_; }
+    size_t GetInputCount() const { return inputs_.size(); }
+
+private:
+    // 正在延伸的一段连续斜接轮廓
+    struct Run {
+        std::vector<RasterPoint> left;   // 法线侧偏移点（正向）
+        std::vector<RasterPoint> right;  // 另一侧偏移点（正向，封闭时反向接入）
+        std::vector<RasterPoint> start;  // 起点半圆弧（从右侧转回左侧，不含两端），平头为空
+    };
+    // 线段起点处连接的内侧裁剪，用于判断该线段还剩多少长度可供终点斜接
+    struct JoinEnd {
+        bool mitered = false;
+        bool innerLeft = false;  // 内侧是否为法线侧
+        float trim = 0.0f;       // 内侧偏移线被斜接裁掉的长度
+    };
+
+    void AppendCenter(RasterPoint point);
+    void UpdateTail();
+    void StartRun(Run* run, RasterPoint v, RasterPoint direction, bool cap) const;
+    // 顶点 v 处由线段 a -> v（起点连接为 previous）转向 v -> b；无法斜接时封闭 run 并另起一段
+    JoinEnd Join(Run* run, RasterPoint a, RasterPoint v, RasterPoint b, const JoinEnd& previous);
+    // 在 v 处结束 run（cap 为 false 时平头）并输出为一个多边形
+    void CloseRun(Run* run, RasterPoint v, RasterPoint direction, bool cap);
+    // 以 v 为圆心、从单位向量 from 经 toward 一侧转过 sweep 弧度的圆弧中间点（不含两端）
+    void AppendArc(RasterPoint v, RasterPoint from, RasterPoint toward, float sweep,
+                   std::vector<RasterPoint>* out) const;
+    void EndPiece(size_t first);
+
+    float width_ = 0.0f;
+    float halfWidth_ = 0.0f;
+    float tolerance_ = 0.25f;
+    float arcStep_ = 0.0f;  // 圆弧每段转角，保证弦高不超过 tolerance_
+
+    std::vector<RasterPoint> inputs_;
+    std::vector<RasterPoint> center_;  // 已定稿的中心线（展平到最后一个中点）
+    Run run_;                          // 已定稿部分末尾尚未封闭的轮廓，止于最后一条线段的起点
+    JoinEnd pendingStart_;             // center_ 最后一条线段起点处的连接
+    std::vector<RasterPoint> vertices_;
+    std::vector<Piece> pieces_;
+    size_t stableVertices_ = 0;  // 已封闭多边形占用的前缀，尾部总是追加在其后
+    size_t stablePieces_ = 0;
+    bool tailValid_ = false;
+};
+
+#endif // PAPERCUTTING_STROKE_TESSELLATOR_H
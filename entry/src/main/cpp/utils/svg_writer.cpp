@@ -0,0 +1,167 @@
+//
+// Created on 2026/10/17.
+// SVG 流式输出实现
+//
+
+#include "svg_writer.h"
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+constexpr size_t BUFFER_SIZE = 64 * 1024;
+constexpr size_t MAX_TOKEN = 32;  // 单个数字的最大长度
+constexpr float COORD_SCALE = 100.0f;
+
+inline int64_t ToHundredths(float v)
+{
+    return std::isfinite(v) ? static_cast<int64_t>(std::llround(v * COORD_SCALE)) : 0;
+}
+} // namespace
+
+SvgWriter::SvgWriter(int fd) : fd_(fd), buffer_(BUFFER_SIZE) {}
+
+void SvgWriter::Begin(float viewLeft, float viewTop, float viewWidth, float viewHeight, int width, int height)
+{
+    Put("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"");
+    PutInt(width);
+    Put("\" height=\"");
+    PutInt(height);
+    Put("\" viewBox=\"");
+    PutFixed(ToHundredths(viewLeft));
+    Put(" ");
+    PutFixed(ToHundredths(viewTop));
+    Put(" ");
+    PutFixed(ToHundredths(viewWidth));
+    Put(" ");
+    PutFixed(ToHundredths(viewHeight));
+    Put("\">\n");
+}
+
+void SvgWriter::AddPath(const std::vector<RasterPath::Contour>& contours, uint32_t argb, RasterFillRule rule)
+{
+    static const char HEX[] = "0123456789abcdef";
+    char color[8] = {'#'};
+    for (int i = 0; i < 6; i++) {
+        color[1 + i] = HEX[(argb >> (20 - 4 * i)) & 0xF];
+    }
+    Put("<path fill=\"");
+    Put(color, 7);
+    const uint32_t alpha = argb >> 24;
+    if (alpha != 0xFF) {
+        Put("\" fill-opacity=\"");
+        PutFixed((alpha * 100 + 127) / 255);
+    }
+    Put(rule == RasterFillRule::EVEN_ODD ? "\" fill-rule=\"evenodd\" d=\"" : "\" fill-rule=\"nonzero\" d=\"");
+    // 相对坐标：m 相对上一子路径的起点（Z 之后的当前点），其后的点对为相对 lineto
+    int64_t currentX = 0;
+    int64_t currentY = 0;
+    for (const auto& contour : contours) {
+        if (contour.points.size() < 3) {
+            continue;
+        }
+        char command = 'm';
+        int64_t lastX = currentX;
+        int64_t lastY = currentY;
+        for (size_t i = 0; i < contour.points.size(); i++) {
+            const int64_t x = ToHundredths(contour.points[i].x);
+            const int64_t y = ToHundredths(contour.points[i].y);
+            if (i > 0 && x == lastX && y == lastY) {
+                continue;
+            }
+            const int64_t dx = x - lastX;
+            const int64_t dy = y - lastY;
+            if (command != 0) {
+                Put(&command, 1);
+                command = 0;
+            } else if (dx >= 0) {
+                Put(" ");  // 负号本身可以作为分隔符
+            }
+            PutFixed(dx);
+            if (dy >= 0) {
+                Put(" ");
+            }
+            PutFixed(dy);
+            if (i == 0) {
+                currentX = x;
+                currentY = y;
+            }
+            lastX = x;
+            lastY = y;
+        }
+        Put("z");
+    }
+    Put("\"/>\n");
+}
+
+bool SvgWriter::Finish()
+{
+    Put("</svg>\n");
+    Flush();
+    return ok_;
+}
+
+void SvgWriter::Put(const char* text, size_t length)
+{
+    // 所有写入都是数字或固定的短标记，远小于缓冲大小
+    if (used_ + length > buffer_.size()) {
+        Flush();
+    }
+    std::memcpy(buffer_.data() + used_, text, length);
+    used_ += length;
+}
+
+void SvgWriter::Put(const char* text)
+{
+    Put(text, std::strlen(text));
+}
+
+void SvgWriter::PutInt(int64_t value)
+{
+    PutFixed(value * static_cast<int64_t>(COORD_SCALE));
+}
+
+void SvgWriter::PutFixed(int64_t hundredths)
+{
+    char digits[MAX_TOKEN];
+    char* end = digits + MAX_TOKEN;
+    char* p = end;
+    const bool negative = hundredths < 0;
+    uint64_t magnitude = negative ? static_cast<uint64_t>(-(hundredths + 1)) + 1 : static_cast<uint64_t>(hundredths);
+    const uint64_t whole = magnitude / 100;
+    const uint32_t fraction = static_cast<uint32_t>(magnitude % 100);
+    if (fraction != 0) {
+        if (fraction % 10 != 0) {
+            *--p = static_cast<char>('0' + fraction % 10);
+        }
+        *--p = static_cast<char>('0' + fraction / 10);
+        *--p = '.';
+    }
+    uint64_t rest = whole;
+    do {
+        *--p = static_cast<char>('0' + rest % 10);
+        rest /= 10;
+    } while (rest != 0);
+    if (negative) {
+        *--p = '-';
+    }
+    Put(p, static_cast<size_t>(end - p));
+}
+
+void SvgWriter::Flush()
+{
+    size_t written = 0;
+    while (ok_ && written < used_) {
+        const ssize_t n = write(fd_, buffer_.data() + written, used_ - written);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            ok_ = false;
+            break;
+        }
+        written += static_cast<size_t>(n);
+    }
+    used_ = 0;
+}
@@ -0,0 +1,42 @@
+//
+// Created on 2026/10/17.
+// SVG 流式输出：按固定大小的块写入文件描述符，不在内存中拼接整个文档
+//
+// 坐标量化到 1/100 用户单位，路径用相对坐标（m / 隐式 l）按整数差分输出，没有累积误差，
+// 文档大小与顶点数成正比，与导出分辨率无关。
+//
+
+#ifndef PAPERCUTTING_SVG_WRITER_H
+#define PAPERCUTTING_SVG_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "raster_backend.h"
+
+class SvgWriter {
+public:
+    // fd 由调用方打开和关闭
+    explicit SvgWriter(int fd);
+
+    // 文档头：viewBox 为用户坐标范围，width / height 为文档尺寸（像素）
+    void Begin(float viewLeft, float viewTop, float viewWidth, float viewHeight, int width, int height);
+    // 所有轮廓组成一条 <path>，argb 为填充色（alpha 不足 255 时输出 fill-opacity）
+    void AddPath(const std::vector<RasterPath::Contour>& contours, uint32_t argb, RasterFillRule rule);
+    // 结束标签并写出剩余缓冲；任意一次写入失败都返回 false
+    bool Finish();
+
+private:
+    void Put(const char* text, size_t length);
+    void Put(const char* text);
+    void PutInt(int64_t value);
+    void PutFixed(int64_t hundredths);  // 1/100 定点数，去掉末尾的 0
+    void Flush();
+
+    int fd_;
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+    bool ok_ = true;
+};
+
+#endif // PAPERCUTTING_SVG_WRITER_H
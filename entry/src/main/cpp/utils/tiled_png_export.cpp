@@ -0,0 +1,220 @@
+//
+// Created on 2026/10/17.
+// 分块高分辨率 PNG 导出实现
+//
+
+#include "tiled_png_export.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include "coverage_rasterizer.h"
+#include "job_system.h"
+#include "png_writer.h"
+
+namespace {
+using PngWriter::BYTES_PER_PIXEL;
+constexpr int FILTER_ROWS_PER_JOB = 4;
+
+struct ContourBounds {
+    float left;
+    float top;
+    float right;
+    float bottom;
+};
+
+struct Band {
+    int top = 0;
+    int rows = 0;
+    std::vector<uint8_t> pixels;    // 非预乘 RGBA，rows * width
+    std::vector<uint8_t> filtered;  // rows * (1 + width * 4)
+    std::vector<PngWriter::DeflatedRows> segments;
+    bool ok = false;
+};
+
+class TileRenderer {
+public:
+    TileRenderer(const std::vector<RasterPath::Contour>& contours, RasterFillRule rule, uint32_t argb, int width,
+                 int height)
+        : contours_(contours), rule_(rule), width_(width), height_(height)
+    {
+        bounds_.reserve(contours.size());
+        for (const auto& contour : contours) {
+            ContourBounds b = {INFINITY, INFINITY, -INFINITY, -INFINITY};
+            for (const RasterPoint& p : contour.points) {
+                b.left = std::min(b.left, p.x);
+                b.top = std::min(b.top, p.y);
+                b.right = std::max(b.right, p.x);
+                b.bottom = std::max(b.bottom, p.y);
+            }
+            bounds_.push_back(b);
+        }
+        // 覆盖率 -> 非预乘 RGBA（完全透明的像素颜色置 0，与缩略图编码一致）
+        const uint32_t alpha = argb >> 24;
+        for (int c = 0; c < 256; c++) {
+            uint8_t* px = colors_[c];
+            const uint32_t a = (c * alpha + 127) / 255;
+            px[0] = a ? static_cast<uint8_t>(argb >> 16) : 0;
+            px[1] = a ? static_cast<uint8_t>(argb >> 8) : 0;
+            px[2] = a ? static_cast<uint8_t>(argb) : 0;
+            px[3] = static_cast<uint8_t>(a);
+        }
+    }
+
+    // prevRow 为上一条带的最后一行（首条带为 nullptr），用于本条带首行的 Up/Average/Paeth 滤波；
+    // group 被取消时尽快返回（band->ok 为 false）
+    void Render(const TaskGroup& group, int top, Band* band, const uint8_t* prevRow)
+    {
+        const size_t rowBytes = static_cast<size_t>(width_) * BYTES_PER_PIXEL;
+        band->top = top;
+        band->rows = std::min(TiledPngExport::TILE_HEIGHT, height_ - top);
+        band->pixels.resize(rowBytes * band->rows);
+        band->filtered.resize((rowBytes + 1) * band->rows);
+
+        // 只有与本条带相交的轮廓参与
+        std::vector<int> active;
+        const float bandTop = static_cast<float>(top);
+        const float bandBottom = static_cast<float>(top + band->rows);
+        for (size_t i = 0; i < bounds_.size(); i++) {
+            if (bounds_[i].bottom > bandTop && bounds_[i].top < bandBottom) {
+                active.push_back(static_cast<int>(i));
+            }
+        }
+
+        const int tileCount = (width_ + TiledPngExport::TILE_WIDTH - 1) / TiledPngExport::TILE_WIDTH;
+        JobSystem& jobs = JobSystem::Get();
+        band->ok = false;
+        if (!jobs.ParallelFor(tileCount, 1, [&](int begin, int end) {
+                CoverageRasterizer rasterizer;
+                for (int tile = begin; tile < end; tile++) {
+                    RenderTile(&rasterizer, tile * TiledPngExport::TILE_WIDTH, band, active);
+                }
+            }, &group)) {
+            return;
+        }
+
+        // 行滤波只依赖本行与上一行的像素，按行并行
+        if (!jobs.ParallelFor(band->rows, FILTER_ROWS_PER_JOB, [&](int begin, int end) {
+                std::vector<uint8_t> scratch(rowBytes);
+                for (int row = begin; row < end; row++) {
+                    const uint8_t* pixels = band->pixels.data() + rowBytes * row;
+                    const uint8_t* prev = row > 0 ? pixels - rowBytes : prevRow;
+                    PngWriter::FilterRow(pixels, prev, rowBytes, scratch.data(),
+                                         band->filtered.data() + (rowBytes + 1) * row);
+                }
+            }, &group)) {
+            return;
+        }
+
+        // 分段压缩；整幅图像的最后一段结束 deflate 流
+        const int segmentCount = (band->rows + TiledPngExport::SEGMENT_HEIGHT - 1) / TiledPngExport::SEGMENT_HEIGHT;
+        const bool lastBand = (top + band->rows == height_);
+        band->segments.resize(segmentCount);
+        std::atomic<bool> ok(true);
+        const bool finished = jobs.ParallelFor(segmentCount, 1, [&](int begin, int end) {
+            for (int segment = begin; segment < end; segment++) {
+                const int first = segment * TiledPngExport::SEGMENT_HEIGHT;
+                const int rows = std::min(TiledPngExport::SEGMENT_HEIGHT, band->rows - first);
+                if (!PngWriter::DeflateRows(band->filtered.data() + (rowBytes + 1) * first, rows, width_,
+                                            lastBand && segment == segmentCount - 1, &band->segments[segment])) {
+                    ok = false;
+                }
+            }
+        }, &group);
+        band->ok = finished && ok;
+    }
+
+private:
+    void RenderTile(CoverageRasterizer* rasterizer, int left, Band* band, const std::vector<int>& active)
+    {
+        const int right = std::min(width_, left + TiledPngExport::TILE_WIDTH);
+        const size_t rowBytes = static_cast<size_t>(width_) * BYTES_PER_PIXEL;
+        const size_t tileBytes = static_cast<size_t>(right - left) * BYTES_PER_PIXEL;
+        for (int row = 0; row < band->rows; row++) {
+            std::memset(band->pixels.data() + rowBytes * row + left * BYTES_PER_PIXEL, 0, tileBytes);
+        }
+
+        // 完全在 tile 右侧的轮廓不影响覆盖率；左侧的边仍要参与（压到裁剪边界上贡献绕数）
+        rasterizer->Begin(left, band->top, right, band->top + band->rows);
+        const float tileRight = static_cast<float>(right);
+        bool any = false;
+        for (int index : active) {
+            if (bounds_[index].left < tileRight) {
+                const auto& contour = contours_[index];
+                rasterizer->AddContour(contour.points.data(), contour.points.size());
+                any = true;
+            }
+        }
+        if (!any) {
+            return;
+        }
+        rasterizer->Fill(rule_, [&](int y, int x0, int x1, const uint8_t* coverage) {
+            uint8_t* dst = band->pixels.data() + rowBytes * (y - band->top) + static_cast<size_t>(x0) * BYTES_PER_PIXEL;
+            for (int x = x0; x < x1; x++, dst += BYTES_PER_PIXEL) {
+                std::memcpy(dst, colors_[coverage[x - x0]], BYTES_PER_PIXEL);
+            }
+        });
+    }
+
+    const std::vector<RasterPath::Contour>& contours_;
+    RasterFillRule rule_;
+    int width_;
+    int height_;
+    std::vector<ContourBounds> bounds_;
+    uint8_t colors_[256][BYTES_PER_PIXEL];
+};
+} // namespace
+
+namespace TiledPngExport {
+
+bool Write(int fd, const Image& image)
+{
+    const int width = image.width;
+    const int height = image.height;
+    if (fd < 0 || width <= 0 || height <= 0 || width > MAX_SIZE || height > MAX_SIZE) {
+        return false;
+    }
+    PngWriter::StreamEncoder encoder(fd);
+    if (!encoder.Begin(width, height)) {
+        return false;
+    }
+    TileRenderer renderer(image.contours, image.rule, image.argb, width, height);
+    const size_t rowBytes = static_cast<size_t>(width) * BYTES_PER_PIXEL;
+
+    // 两条带轮换：主线程写出 bands[cur] 时，后台渲染下一条带到另一个缓冲
+    // 写入失败时取消正在渲染的下一条带
+    Band bands[2];
+    int cur = 0;
+    {
+        TaskGroup first;
+        renderer.Render(first, 0, &bands[cur], nullptr);
+    }
+    bool ok = true;
+    for (int top = 0; top < height; top += TILE_HEIGHT) {
+        Band& band = bands[cur];
+        const int nextTop = top + band.rows;
+        TaskGroup next;
+        if (nextTop < height) {
+            const uint8_t* lastRow = band.pixels.data() + rowBytes * (band.rows - 1);
+            Band* nextBand = &bands[cur ^ 1];
+            next.Run([&renderer, &next, nextTop, nextBand, lastRow]() {
+                renderer.Render(next, nextTop, nextBand, lastRow);
+            });
+        }
+        ok = band.ok;
+        for (size_t i = 0; ok && i < band.segments.size(); i++) {
+            ok = encoder.WriteDeflatedRows(band.segments[i]);
+        }
+        if (!ok) {
+            next.Cancel();
+        }
+        next.Wait();
+        if (!ok) {
+            break;
+        }
+        cur ^= 1;
+    }
+    return ok && encoder.Finish();
+}
+
+} // namespace TiledPngExport
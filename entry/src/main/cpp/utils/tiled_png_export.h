@@ -0,0 +1,37 @@
+//
+// Created on 2026/10/17.
+// 分块高分辨率 PNG 导出：矢量轮廓按固定大小的 tile 并行光栅化，逐条带滤波后流式写入 PNG
+//
+// 输出按 TILE_HEIGHT 行一条带（band）推进：条带内的 tile 在多个线程上用各自的 CoverageRasterizer
+// 填充，行滤波、按 SEGMENT_HEIGHT 行分段的 deflate 同样并行，主线程只按顺序写文件；
+// 下一条带的渲染与当前条带的写出重叠。同时驻留的只有两条带的像素、滤波与压缩结果，
+// 峰值内存 ≈ 4 * width * TILE_HEIGHT * 4 字节，与图像高度无关。
+//
+
+#ifndef PAPERCUTTING_TILED_PNG_EXPORT_H
+#define PAPERCUTTING_TILED_PNG_EXPORT_H
+
+#include <cstdint>
+#include <vector>
+#include "raster_backend.h"
+
+namespace TiledPngExport {
+constexpr int TILE_WIDTH = 512;
+constexpr int TILE_HEIGHT = 64;
+constexpr int SEGMENT_HEIGHT = 16;  // 独立压缩的行数：段越小并行度越高，段间不共享字典
+constexpr int MAX_SIZE = 65536;
+
+// 待导出的图像：contours 为输出像素坐标，覆盖区域用 argb 填充（覆盖率乘到 alpha 上），其余透明
+struct Image {
+    std::vector<RasterPath::Contour> contours;
+    RasterFillRule rule = RasterFillRule::NON_ZERO;
+    uint32_t argb = 0;
+    int width = 0;
+    int height = 0;
+};
+
+// 不访问任何共享状态，可在工作线程执行；fd 由调用方打开和关闭
+bool Write(int fd, const Image& image);
+} // namespace TiledPngExport
+
+#endif // PAPERCUTTING_TILED_PNG_EXPORT_H
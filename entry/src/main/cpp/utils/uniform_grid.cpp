@@ -0,0 +1,103 @@
+//
+// Created on 2026/10/17.
+// 均匀网格空间索引实现
+//
+
+#include "uniform_grid.h"
+#include <algorithm>
+
+void UniformGrid::Reset(int width, int height, int cellSize)
+{
+    width_ = std::max(0, width);
+    height_ = std::max(0, height);
+    cellSize_ = std::max(1, cellSize);
+    columns_ = std::max(1, (width_ + cellSize_ - 1) / cellSize_);
+    rows_ = std::max(1, (height_ + cellSize_ - 1) / cellSize_);
+    cells_.assign(static_cast<size_t>(columns_) * rows_, std::vector<uint32_t>());
+    rects_.clear();
+}
+
+bool UniformGrid::CellRange(const RasterIRect& rect, int* cx0, int* cy0, int* cx1, int* cy1) const
+{
+    if (rect.IsEmpty() || cells_.empty()) {
+        return false;
+    }
+    // 先限制到网格范围再相除，远离画布的矩形也落在边缘格子上
+    auto cell = [this](int v, int count) { return std::min(count - 1, std::max(0, v) / cellSize_); };
+    *cx0 = cell(rect.left, columns_);
+    *cy0 = cell(rect.top, rows_);
+    *cx1 = cell(rect.right - 1, columns_);
+    *cy1 = cell(rect.bottom - 1, rows_);
+    return true;
+}
+
+void UniformGrid::Append(const RasterIRect& rect)
+{
+    const uint32_t id = static_cast<uint32_t>(rects_.size());
+    rects_.push_back(rect);
+    int cx0 = 0;
+    int cy0 = 0;
+    int cx1 = 0;
+    int cy1 = 0;
+    if (!CellRange(rect, &cx0, &cy0, &cx1, &cy1)) {
+        return;
+    }
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            cells_[static_cast<size_t>(cy) * columns_ + cx].push_back(id);
+        }
+    }
+}
+
+void UniformGrid::Truncate(size_t count)
+{
+    if (count >= rects_.size()) {
+        return;
+    }
+    // 只需访问被删除条目占用的格子；格子内编号升序，删除的都在末尾
+    for (size_t id = count; id < rects_.size(); id++) {
+        int cx0 = 0;
+        int cy0 = 0;
+        int cx1 = 0;
+        int cy1 = 0;
+        if (!CellRange(rects_[id], &cx0, &cy0, &cx1, &cy1)) {
+            continue;
+        }
+        for (int cy = cy0; cy <= cy1; cy++) {
+            for (int cx = cx0; cx <= cx1; cx++) {
+                std::vector<uint32_t>& cell = cells_[static_cast<size_t>(cy) * columns_ + cx];
+                while (!cell.empty() && cell.back() >= count) {
+                    cell.pop_back();
+                }
+            }
+        }
+    }
+    rects_.resize(count);
+}
+
+void UniformGrid::Query(const RasterIRect& rect, size_t begin, size_t end, std::vector<uint32_t>* out) const
+{
+    out->clear();
+    end = std::min(end, rects_.size());
+    int cx0 = 0;
+    int cy0 = 0;
+    int cx1 = 0;
+    int cy1 = 0;
+    if (begin >= end || !CellRange(rect, &cx0, &cy0, &cx1, &cy1)) {
+        return;
+    }
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            const std::vector<uint32_t>& cell = cells_[static_cast<size_t>(cy) * columns_ + cx];
+            for (auto it = std::lower_bound(cell.begin(), cell.end(), static_cast<uint32_t>(begin));
+                 it != cell.end() && *it < end; ++it) {
+                if (rects_[*it].Intersects(rect)) {
+                    out->push_back(*it);
+                }
+            }
+        }
+    }
+    // 跨多个格子的条目会被收集多次
+    std::sort(out->begin(), out->end());
+    out->erase(std::unique(out->begin(), out->end()), out->end());
+}
@@ -0,0 +1,46 @@
+//
+// Created on 2026/10/17.
+// 均匀网格空间索引：按矩形登记连续编号的条目（命令在历史中的下标），查询与矩形相交的条目
+//
+// 条目只在末尾追加、按编号截断（与线性历史的推入/撤销一致），每个格子里的编号天然升序，
+// 查询只访问矩形覆盖的格子，代价与查询区域内的条目数成正比，与总条目数无关。
+//
+
+#ifndef PAPERCUTTING_UNIFORM_GRID_H
+#define PAPERCUTTING_UNIFORM_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "raster_backend.h"
+
+class UniformGrid {
+public:
+    // 覆盖 [0, width) x [0, height)，格子边长 cellSize；清空所有条目
+    void Reset(int width, int height, int cellSize);
+    int GetWidth() const { return width_; }
+    int GetHeight() const { return height_; }
+
+    // 追加编号为 GetCount() 的条目；rect 超出网格的部分压到边缘格子，空矩形只占编号
+    void Append(const RasterIRect& rect);
+    // 删除编号 >= count 的条目
+    void Truncate(size_t count);
+    size_t GetCount() const { return rects_.size(); }
+
+    // 编号在 [begin, end) 内且矩形与 rect 相交的条目，按编号升序写入 out（覆盖原内容）
+    void Query(const RasterIRect& rect, size_t begin, size_t end, std::vector<uint32_t>* out) const;
+
+private:
+    // rect 覆盖的格子范围（闭区间）；空矩形返回 false
+    bool CellRange(const RasterIRect& rect, int* cx0, int* cy0, int* cx1, int* cy1) const;
+
+    int width_ = 0;
+    int height_ = 0;
+    int cellSize_ = 1;
+    int columns_ = 0;
+    int rows_ = 0;
+    std::vector<std::vector<uint32_t>> cells_;
+    std::vector<RasterIRect> rects_;
+};
+
+#endif // PAPERCUTTING_UNIFORM_GRID_H
@@ -18,6 +18,19 @@ export interface Action {
   timestamp: number;
 }
 
+// setWorkBinary 返回的纸张参数（作品紧凑格式头部）
+export interface WorkPaperInfo {
+  foldMode: number;
+  paperType: number; // 0=CIRCLE, 1=SQUARE
+  paperColor: number; // ARGB
+}
+
+// getPaperMetrics 返回的剩余纸张精确几何量（模型像素）
+export interface PaperMetrics {
+  area: number;
+  perimeter: number;
+}
+
 export interface Point {
   x: number;
   y: number;
@@ -37,17 +50,31 @@ export interface NativeModule {
   setPreviewWindow: (nativeWindow: string | number) => void;
   startDrawing: (x: number, y: number) => void;
   addPoint: (x: number, y: number) => void;
+  addPoints: (points: Float32Array, screenSpace?: boolean) => void;
   finishDrawing: () => void;
   setToolMode: (mode: number) => void;
   setFoldMode: (mode: number) => void;
+  setPreviewUnfoldMode: (mode: number) => void;
   setPaperType: (type: number) => void;
   setPaperColor: (color: number) => void;
+  setBackgroundColor: (color: number) => void;
   undo: () => void;
   redo: () => void;
+  seekHistory: (index: number) => void;
+  getHistoryLength: () => number;
+  getHistoryIndex: () => number;
+  getPaperMetrics: () => PaperMetrics;
+  exportSvg: (fd: number, width?: number, height?: number) => boolean;
+  exportPng: (fd: number, width?: number, height?: number) => Promise<void>;
   clear: () => void;
   getActions: () => Action[];
   setActions: (actions: Action[]) => void;
+  getActionsBinary: () => ArrayBuffer;
+  setActionsBinary: (data: ArrayBuffer | Uint8Array) => void;
+  getWorkBinary: () => ArrayBuffer;
+  setWorkBinary: (data: ArrayBuffer | Uint8Array) => WorkPaperInfo | undefined;
   setZoom: (zoom: number) => void;
+  setInputEnabled: (enabled: boolean) => void;
   setPan: (x: number, y: number) => void;
 }
 
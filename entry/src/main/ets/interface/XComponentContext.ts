@@ -13,7 +13,7 @@
  * limitations under the License.
  */
 import { image } from '@kit.ImageKit';
-import { Action } from '../common/types';
+import { Action, PaperMetrics, WorkPaperInfo } from '../common/types';
 
 export default interface XComponentContext {
   draw(canvasType:string, shapeType: string):void;
@@ -24,16 +24,30 @@ export default interface XComponentContext {
   setPreviewWindow(nativeWindow: string | number): void;
   startDrawing(x: number, y: number): void;
   addPoint(x: number, y: number): void;
+  addPoints(points: Float32Array, screenSpace?: boolean): void;
   finishDrawing(): void;
   setToolMode(mode: number): void;
   setFoldMode(mode: number): void;
+  setPreviewUnfoldMode(mode: number): void;
   setPaperType(type: number): void;
   setPaperColor(color: number): void;
+  setBackgroundColor(color: number): void;
   undo(): void;
   redo(): void;
+  seekHistory(index: number): void;
+  getHistoryLength(): number;
+  getHistoryIndex(): number;
+  getPaperMetrics(): PaperMetrics;
+  exportSvg(fd: number, width?: number, height?: number): boolean;
+  exportPng(fd: number, width?: number, height?: number): Promise<void>;
   clear(): void;
   getActions(): Action[];
   setActions(actions: Action[]): void;
+  getActionsBinary(): ArrayBuffer;
+  setActionsBinary(data: ArrayBuffer | Uint8Array): void;
+  getWorkBinary(): ArrayBuffer;
+  setWorkBinary(data: ArrayBuffer | Uint8Array): WorkPaperInfo | undefined;
   setZoom(zoom: number): void;
+  setInputEnabled(enabled: boolean): void;
   setPan(x: number, y: number): void;
 };